@@ -0,0 +1,100 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_audio_config_dev.idl modified Thu May 17 10:21:36 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_AUDIO_CONFIG_DEV_H_
+#define PPAPI_C_DEV_PPB_AUDIO_CONFIG_DEV_H_
+
+#include "ppapi/c/pp_instance.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+#include "ppapi/c/ppb_audio_config.h"
+
+#define PPB_AUDIOCONFIG_DEV_INTERFACE_0_1 "PPB_AudioConfig(Dev);0.1"
+#define PPB_AUDIOCONFIG_DEV_INTERFACE PPB_AUDIOCONFIG_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_AudioConfig_Dev</code> interface, which adds
+ * sample formats other than 16-bit integers to <code>PPB_AudioConfig</code>.
+ */
+
+
+/**
+ * @addtogroup Enums
+ * @{
+ */
+/**
+ * The format of the samples the audio callback writes to its buffer.
+ */
+typedef enum {
+  /**
+   * Signed 16-bit integers in the native endian format of the platform. This
+   * is the format of configurations made with
+   * <code>PPB_AudioConfig.CreateStereo16Bit()</code>.
+   */
+  PP_AUDIOSAMPLEFORMAT_DEV_INT16 = 0,
+  /**
+   * 32-bit floats in the range [-1.0, 1.0]. Samples outside this range are
+   * clamped.
+   */
+  PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32 = 1
+} PP_AudioSampleFormat_Dev;
+PP_COMPILE_ASSERT_SIZE_IN_BYTES(PP_AudioSampleFormat_Dev, 4);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_AudioConfig_Dev_0_1 {
+  /**
+   * Creates a stereo audio configuration resource with 32-bit float samples.
+   * This is the same as <code>PPB_AudioConfig.CreateStereo16Bit()</code>,
+   * except that the buffer passed to the audio callback holds
+   * <code>float</code> samples, interleaved the same way. The buffer is
+   * <code>2 * sample_frame_count * sizeof(float)</code> bytes long.
+   *
+   * Producing floats saves the plugin a conversion if it mixes in float, and
+   * the browser converts float samples more cheaply than integer ones.
+   *
+   * @param[in] instance A <code>PP_Instance</code> identifying one instance
+   * of a module.
+   * @param[in] sample_rate A <code>PP_AudioSampleRate</code> which is either
+   * <code>PP_AUDIOSAMPLERATE_44100</code> or
+   * <code>PP_AUDIOSAMPLERATE_48000</code>.
+   * @param[in] sample_frame_count A <code>uint32_t</code> frame count returned
+   * from <code>PPB_AudioConfig.RecommendSampleFrameCount()</code>.
+   *
+   * @return A <code>PP_Resource</code> containing the audio config resource
+   * if successful, or a null resource if the sample rate or frame count is
+   * not supported.
+   */
+  PP_Resource (*CreateStereoFloat32)(PP_Instance instance,
+                                     PP_AudioSampleRate sample_rate,
+                                     uint32_t sample_frame_count);
+  /**
+   * Returns the sample format of an audio configuration resource.
+   *
+   * @param[in] config A <code>PP_Resource</code> corresponding to an audio
+   * config resource.
+   *
+   * @return The <code>PP_AudioSampleFormat_Dev</code> of the configuration.
+   * <code>PP_AUDIOSAMPLEFORMAT_DEV_INT16</code> is returned if
+   * <code>config</code> is not an audio config resource.
+   */
+  PP_AudioSampleFormat_Dev (*GetSampleFormat)(PP_Resource config);
+};
+
+typedef struct PPB_AudioConfig_Dev_0_1 PPB_AudioConfig_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_AUDIO_CONFIG_DEV_H_ */
@@ -0,0 +1,140 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_audio_dev.idl modified Fri May 18 11:42:08 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_AUDIO_DEV_H_
+#define PPAPI_C_DEV_PPB_AUDIO_DEV_H_
+
+#include "ppapi/c/pp_bool.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+#include "ppapi/c/pp_time.h"
+
+#define PPB_AUDIO_DEV_INTERFACE_0_1 "PPB_Audio(Dev);0.1"
+#define PPB_AUDIO_DEV_INTERFACE PPB_AUDIO_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_Audio_Dev</code> interface, which controls
+ * the scheduling of a <code>PPB_Audio</code> resource's callback thread and
+ * reports how well the callback keeps up.
+ */
+
+
+/**
+ * @addtogroup Enums
+ * @{
+ */
+/**
+ * The scheduling priority of the thread that runs the audio callback.
+ */
+typedef enum {
+  /**
+   * The default priority of plugin threads.
+   */
+  PP_AUDIOTHREADPRIORITY_DEV_NORMAL = 0,
+  /**
+   * Realtime scheduling, where the system allows it. Otherwise the thread
+   * runs at the highest priority the plugin is allowed to use.
+   */
+  PP_AUDIOTHREADPRIORITY_DEV_REALTIME = 1
+} PP_AudioThreadPriority_Dev;
+PP_COMPILE_ASSERT_SIZE_IN_BYTES(PP_AudioThreadPriority_Dev, 4);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * Statistics about the audio callback, accumulated since the resource was
+ * created. The counters are updated by the audio thread without stopping it,
+ * so they may be mutually a period out of date.
+ */
+struct PP_AudioStats_Dev {
+  /**
+   * The longest time a single callback took.
+   */
+  PP_TimeDelta max_callback_duration;
+  /**
+   * The total time spent in the callback.
+   */
+  PP_TimeDelta total_callback_duration;
+  /**
+   * The number of times the callback was run.
+   */
+  uint32_t callback_count;
+  /**
+   * The number of periods in which the callback, together with the
+   * conversion of its output, took longer than the period itself. When this
+   * happens the plugin can't keep up with playback, whatever the buffering.
+   */
+  uint32_t late_callback_count;
+  /**
+   * The number of buffers that were not ready by the time the audio device
+   * needed them, that is, that took longer to fill than the delay reported
+   * to the callback. Each of these is heard as a glitch.
+   */
+  uint32_t underrun_count;
+  /**
+   * <code>PP_TRUE</code> if the callback thread is currently running with
+   * realtime priority.
+   */
+  PP_Bool realtime;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_AudioStats_Dev, 32);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_Audio_Dev_0_1 {
+  /**
+   * Sets the scheduling priority of the audio callback thread. It can be
+   * called before or during playback, and lasts for the life of the resource.
+   * A thread that is already running changes priority before its next
+   * callback.
+   *
+   * Realtime scheduling makes glitches less likely on a loaded system, but a
+   * callback that doesn't return promptly can starve other threads. Check
+   * <code>PP_AudioStats_Dev.realtime</code> to see whether the request was
+   * granted.
+   *
+   * @param[in] audio A <code>PP_Resource</code> corresponding to an audio
+   * resource.
+   * @param[in] priority The <code>PP_AudioThreadPriority_Dev</code> to use.
+   *
+   * @return <code>PP_OK</code> on success, or
+   * <code>PP_ERROR_NOTSUPPORTED</code> if the plugin can't change the
+   * priority of its threads.
+   */
+  int32_t (*SetThreadPriority)(PP_Resource audio,
+                               PP_AudioThreadPriority_Dev priority);
+  /**
+   * Returns statistics about the audio callback.
+   *
+   * @param[in] audio A <code>PP_Resource</code> corresponding to an audio
+   * resource.
+   * @param[out] stats The <code>PP_AudioStats_Dev</code> to fill in.
+   *
+   * @return <code>PP_OK</code> on success, or an error code from
+   * <code>pp_errors.h</code>.
+   */
+  int32_t (*GetStats)(PP_Resource audio, struct PP_AudioStats_Dev* stats);
+};
+
+typedef struct PPB_Audio_Dev_0_1 PPB_Audio_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_AUDIO_DEV_H_ */
@@ -0,0 +1,182 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_file_io_dev.idl modified Tue Jul 10 11:48:19 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_FILE_IO_DEV_H_
+#define PPAPI_C_DEV_PPB_FILE_IO_DEV_H_
+
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+
+#define PPB_FILEIO_DEV_INTERFACE_0_1 "PPB_FileIO(Dev);0.1"
+#define PPB_FILEIO_DEV_INTERFACE PPB_FILEIO_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_FileIO_Dev</code> interface, which lets a
+ * plugin have several reads and writes pending on one
+ * <code>PPB_FileIO</code> resource at once, read and write several buffers
+ * with one operation, and map files into memory.
+ */
+
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * One buffer of a vectored read or write.
+ */
+struct PP_FileIOSegment_Dev {
+  /**
+   * The address of the buffer.
+   */
+  void* buffer;
+  /**
+   * The size of the buffer, in bytes.
+   */
+  int32_t size;
+};
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_FileIO_Dev_0_1 {
+  /**
+   * Sets how many <code>Read()</code>, <code>ReadToArray()</code> and
+   * <code>Write()</code> calls may be pending on a file at once, in any mix.
+   * By default reads and writes exclude each other, so a write issued while a
+   * read is pending fails with <code>PP_ERROR_INPROGRESS</code>, and every
+   * operation runs in the order it was issued.
+   *
+   * With a limit set, pending operations run in parallel on the browser's
+   * file threads. Operations whose byte ranges overlap, where at least one is
+   * a write, still run in the order they were issued; a write in append mode
+   * overlaps every other operation. Operations that don't overlap may
+   * complete in any order. Operations with a blocking callback are not
+   * ordered against pending ones.
+   *
+   * Other operations, such as <code>SetLength()</code> and
+   * <code>Flush()</code>, still need all reads and writes to have completed.
+   *
+   * @param[in] file_io A <code>PP_Resource</code> corresponding to a file
+   * FileIO.
+   * @param[in] max_pending_operations The most reads and writes that may be
+   * pending at once, up to 64. Zero restores the default behavior.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if
+   * <code>max_pending_operations</code> is over the limit, and
+   * <code>PP_ERROR_INPROGRESS</code> if an operation is pending.
+   */
+  int32_t (*SetMaxPendingOperations)(PP_Resource file_io,
+                                     uint32_t max_pending_operations);
+  /**
+   * Maps a range of a file into memory, read-only, so that the plugin can
+   * read it through a pointer instead of <code>Read()</code> calls. The file
+   * must have been opened with <code>PP_FILEOPENFLAG_READ</code>, and the
+   * range must lie within the file.
+   *
+   * The mapping shows the current contents of the file, including writes
+   * made after it was created. It stays valid until it is passed to
+   * <code>UnmapRange()</code>, the file is closed, or the FileIO resource is
+   * released. Accessing a part of the mapping that lies beyond the end of the
+   * file, after the file was made shorter, may crash the plugin.
+   *
+   * @param[in] file_io A <code>PP_Resource</code> corresponding to a file
+   * FileIO.
+   * @param[in] offset The offset into the file of the start of the range.
+   * @param[in] length The number of bytes in the range.
+   * @param[out] address The address of the first byte of the range. The
+   * memory must not be written to.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if the range isn't within the
+   * file, <code>PP_ERROR_NOACCESS</code> if the file wasn't opened for
+   * reading, and <code>PP_ERROR_FAILED</code> if the file isn't open or
+   * can't be mapped.
+   */
+  int32_t (*MapRange)(PP_Resource file_io,
+                      int64_t offset,
+                      int64_t length,
+                      void** address);
+  /**
+   * Unmaps a range mapped with <code>MapRange()</code>.
+   *
+   * @param[in] file_io A <code>PP_Resource</code> corresponding to a file
+   * FileIO.
+   * @param[in] address The address returned by <code>MapRange()</code>.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if <code>address</code> isn't a
+   * mapping of this file.
+   */
+  int32_t (*UnmapRange)(PP_Resource file_io, void* address);
+  /**
+   * Reads from an offset in the file into several buffers, in order, with a
+   * single operation. This is like one <code>Read()</code> into a buffer
+   * made of the segments laid end to end, and may read less than their total
+   * size, e.g. at the end of the file. It counts as one read towards the
+   * operations that may be pending.
+   *
+   * @param[in] file_io A <code>PP_Resource</code> corresponding to a file
+   * FileIO.
+   * @param[in] offset The offset into the file.
+   * @param[in] segments The buffers to read into. They must remain valid
+   * until after the callback runs. If you pass a blocking callback, they must
+   * remain valid until after <code>ReadV()</code> returns.
+   * @param[in] segment_count The number of segments, up to 1024.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion of <code>ReadV()</code>.
+   *
+   * @return The number of bytes read or an error code from
+   * <code>pp_errors.h</code>. If the return value is 0, then end-of-file was
+   * reached. Returns <code>PP_ERROR_BADARGUMENT</code> if there are no
+   * segments, too many, or one has a negative size.
+   */
+  int32_t (*ReadV)(PP_Resource file_io,
+                   int64_t offset,
+                   const struct PP_FileIOSegment_Dev segments[],
+                   uint32_t segment_count,
+                   struct PP_CompletionCallback callback);
+  /**
+   * Writes several buffers, in order, to an offset in the file with a single
+   * operation. This is like one <code>Write()</code> of a buffer made of the
+   * segments laid end to end: it needs one quota check, completes once, and
+   * may write less than their total size.
+   *
+   * @param[in] file_io A <code>PP_Resource</code> corresponding to a file
+   * FileIO.
+   * @param[in] offset The offset into the file.
+   * @param[in] segments The buffers to write. They are copied before the
+   * call returns, unless a blocking callback is passed.
+   * @param[in] segment_count The number of segments, up to 1024.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion of <code>WriteV()</code>.
+   *
+   * @return The number of bytes written or an error code from
+   * <code>pp_errors.h</code>. Returns <code>PP_ERROR_BADARGUMENT</code> if
+   * there are no segments, too many, or one has a negative size.
+   */
+  int32_t (*WriteV)(PP_Resource file_io,
+                    int64_t offset,
+                    const struct PP_FileIOSegment_Dev segments[],
+                    uint32_t segment_count,
+                    struct PP_CompletionCallback callback);
+};
+
+typedef struct PPB_FileIO_Dev_0_1 PPB_FileIO_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_FILE_IO_DEV_H_ */
@@ -0,0 +1,61 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_graphics_2d_dev.idl modified Mon Jul  9 10:12:44 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_GRAPHICS_2D_DEV_H_
+#define PPAPI_C_DEV_PPB_GRAPHICS_2D_DEV_H_
+
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_point.h"
+#include "ppapi/c/pp_rect.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+
+#define PPB_GRAPHICS2D_DEV_INTERFACE_0_1 "PPB_Graphics2D(Dev);0.1"
+#define PPB_GRAPHICS2D_DEV_INTERFACE PPB_GRAPHICS2D_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_Graphics2D_Dev</code> interface, which adds
+ * batched painting to <code>PPB_Graphics2D</code>.
+ */
+
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_Graphics2D_Dev_0_1 {
+  /**
+   * Enqueues paint commands for several parts of the same image, such as the
+   * dirty rects of a frame. It is equivalent to calling
+   * <code>PPB_Graphics2D.PaintImageData()</code> once for each rect, but the
+   * rects travel to the browser together. Like
+   * <code>PaintImageData()</code>, it has no effect until
+   * <code>Flush()</code> is called.
+   *
+   * @param[in] graphics_2d The 2D Graphics resource.
+   * @param[in] image_data The <code>ImageData</code> to paint from.
+   * @param[in] top_left A <code>Point</code> representing the
+   * <code>top_left</code> location where the <code>ImageData</code> will be
+   * painted.
+   * @param[in] src_rects An array of <code>num_rects</code> rects, in the
+   * coordinate system of the image, to paint.
+   * @param[in] num_rects The number of rects in <code>src_rects</code>.
+   */
+  void (*PaintImageDataRects)(PP_Resource graphics_2d,
+                              PP_Resource image_data,
+                              const struct PP_Point* top_left,
+                              const struct PP_Rect src_rects[],
+                              uint32_t num_rects);
+};
+
+typedef struct PPB_Graphics2D_Dev_0_1 PPB_Graphics2D_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_GRAPHICS_2D_DEV_H_ */
@@ -0,0 +1,106 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_image_data_dev.idl modified Fri Jul 13 11:02:18 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_IMAGE_DATA_DEV_H_
+#define PPAPI_C_DEV_PPB_IMAGE_DATA_DEV_H_
+
+#include "ppapi/c/pp_bool.h"
+#include "ppapi/c/pp_instance.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_size.h"
+#include "ppapi/c/pp_stdint.h"
+#include "ppapi/c/ppb_image_data.h"
+
+#define PPB_IMAGEDATA_DEV_INTERFACE_0_1 "PPB_ImageData(Dev);0.1"
+#define PPB_IMAGEDATA_DEV_INTERFACE PPB_IMAGEDATA_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_ImageData_Dev</code> interface, which
+ * controls the pool of image datas an instance keeps for re-use.
+ */
+
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * Counters for the image data pool of an instance, accumulated since the pool
+ * was first used.
+ */
+struct PP_ImageDataCacheStats_Dev {
+  /**
+   * The number of image data creations served from the pool.
+   */
+  uint64_t hits;
+  /**
+   * The number of image data creations that had to allocate.
+   */
+  uint64_t misses;
+  /**
+   * The number of pooled image datas dropped to stay within the budget.
+   */
+  uint64_t evictions;
+  /**
+   * The memory, in bytes, currently held by pooled image datas.
+   */
+  uint64_t bytes_cached;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_ImageDataCacheStats_Dev, 32);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_ImageData_Dev_0_1 {
+  /**
+   * Creates <code>count</code> image datas of the given format and size and
+   * adds them to the pool, so that the first frames painted with image datas
+   * like them don't have to allocate. Pre-warmed image datas expire like any
+   * other pooled one if they are not used. This does nothing if the browser
+   * doesn't pool image datas.
+   *
+   * @param[in] instance A <code>PP_Instance</code> identifying the instance.
+   * @param[in] format The format of the image datas.
+   * @param[in] size The size of the image datas.
+   * @param[in] count The number of image datas to create.
+   */
+  void (*PrewarmCache)(PP_Instance instance,
+                       PP_ImageDataFormat format,
+                       const struct PP_Size* size,
+                       uint32_t count);
+  /**
+   * Sets how much image memory the instance may keep in its pool. Pooled
+   * image datas are dropped, oldest first, to fit. The default is 32 MB.
+   *
+   * @param[in] instance A <code>PP_Instance</code> identifying the instance.
+   * @param[in] budget_bytes The budget, in bytes.
+   */
+  void (*SetCacheBudget)(PP_Instance instance, uint32_t budget_bytes);
+  /**
+   * Gets the counters for the pool of an instance.
+   *
+   * @param[in] instance A <code>PP_Instance</code> identifying the instance.
+   * @param[out] stats The counters.
+   *
+   * @return <code>PP_TRUE</code> on success, or <code>PP_FALSE</code> if the
+   * browser doesn't pool image datas.
+   */
+  PP_Bool (*GetCacheStats)(PP_Instance instance,
+                           struct PP_ImageDataCacheStats_Dev* stats);
+};
+
+typedef struct PPB_ImageData_Dev_0_1 PPB_ImageData_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_IMAGE_DATA_DEV_H_ */
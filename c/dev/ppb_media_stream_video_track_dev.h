@@ -0,0 +1,87 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_media_stream_video_track_dev.idl,
+ *   modified Wed Jun 27 10:41:18 2018.
+ */
+
+#ifndef PPAPI_C_DEV_PPB_MEDIA_STREAM_VIDEO_TRACK_DEV_H_
+#define PPAPI_C_DEV_PPB_MEDIA_STREAM_VIDEO_TRACK_DEV_H_
+
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+
+#define PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE_0_1 \
+    "PPB_MediaStreamVideoTrack(Dev);0.1"
+#define PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE \
+    PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_MediaStreamVideoTrack_Dev</code> interface,
+ * which adds batched frame operations to
+ * <code>PPB_MediaStreamVideoTrack</code>.
+ */
+
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_MediaStreamVideoTrack_Dev_0_1 {
+  /**
+   * Gets all the frames that are ready, up to <code>max_frames</code>, in one
+   * call. If no frame is ready, the call completes asynchronously as soon as
+   * at least one arrives, with every frame that has arrived by then. Each
+   * frame must be recycled with <code>RecycleFrame()</code> or
+   * <code>RecycleFrames()</code> once the plugin is done with it.
+   *
+   * @param[in] video_track A <code>PP_Resource</code> corresponding to a video
+   * resource.
+   * @param[out] frames An array of at least <code>max_frames</code> elements
+   * to store the <code>PPB_VideoFrame</code> resources in, oldest first.
+   * @param[in] max_frames The maximum number of frames to get.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion.
+   *
+   * @return A positive number on success to indicate how many frames have
+   * been stored in <code>frames</code>; otherwise, an error code from
+   * <code>pp_errors.h</code>. <code>PP_ERROR_INPROGRESS</code> is returned if
+   * a <code>GetFrame()</code> or <code>GetFrames()</code> is pending.
+   */
+  int32_t (*GetFrames)(PP_Resource video_track,
+                       PP_Resource frames[],
+                       uint32_t max_frames,
+                       struct PP_CompletionCallback callback);
+  /**
+   * Recycles several frames returned by <code>GetFrame()</code> or
+   * <code>GetFrames()</code> to the track, with at most one message to the
+   * browser when the track passes frames through shared memory. The frames
+   * are recycled even if some of them are invalid.
+   *
+   * @param[in] video_track A <code>PP_Resource</code> corresponding to a video
+   * resource.
+   * @param[in] frames An array of <code>num_frames</code>
+   * <code>PPB_VideoFrame</code> resources to recycle.
+   * @param[in] num_frames The number of frames to recycle.
+   *
+   * @return An int32_t containing a result code from <code>pp_errors.h</code>.
+   * <code>PP_ERROR_BADARGUMENT</code> is returned if <code>frames</code> is
+   * null or <code>num_frames</code> is 0. <code>PP_ERROR_BADRESOURCE</code> is
+   * returned if any of the frames was not one of this track's.
+   */
+  int32_t (*RecycleFrames)(PP_Resource video_track,
+                           const PP_Resource frames[],
+                           uint32_t num_frames);
+};
+
+typedef struct PPB_MediaStreamVideoTrack_Dev_0_1 PPB_MediaStreamVideoTrack_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_MEDIA_STREAM_VIDEO_TRACK_DEV_H_ */
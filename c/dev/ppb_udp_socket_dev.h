@@ -0,0 +1,135 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_udp_socket_dev.idl modified Tue May 15 14:03:52 2018. */
+
+#ifndef PPAPI_C_DEV_PPB_UDP_SOCKET_DEV_H_
+#define PPAPI_C_DEV_PPB_UDP_SOCKET_DEV_H_
+
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+
+#define PPB_UDPSOCKET_DEV_INTERFACE_0_1 "PPB_UDPSocket(Dev);0.1"
+#define PPB_UDPSOCKET_DEV_INTERFACE PPB_UDPSOCKET_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_UDPSocket_Dev</code> interface, which adds
+ * batched operations to <code>PPB_UDPSocket</code>.
+ */
+
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * Describes one datagram received by <code>RecvFromBatch()</code> or sent by
+ * <code>SendToBatch()</code>.
+ */
+struct PP_UDPSocket_Datagram_Dev {
+  /**
+   * Offset of the datagram's payload in the buffer passed to
+   * <code>RecvFromBatch()</code> or <code>SendToBatch()</code>.
+   */
+  int32_t offset;
+  /**
+   * Size of the payload in bytes.
+   */
+  int32_t size;
+  /**
+   * A <code>PPB_NetAddress</code> resource. For <code>RecvFromBatch()</code>
+   * it holds the source address, and the caller owns a reference to it. For
+   * <code>SendToBatch()</code> it holds the destination address.
+   */
+  PP_Resource addr;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_UDPSocket_Datagram_Dev, 12);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_UDPSocket_Dev_0_1 {
+  /**
+   * Receives as many datagrams as are available, up to
+   * <code>max_datagrams</code>, in one call. The socket must be bound. If no
+   * datagram is available, the call completes asynchronously as soon as at
+   * least one arrives, with every datagram that has arrived by then.
+   *
+   * The payloads are stored back to back in <code>buffer</code>, and each
+   * datagram's position, size and source address are written to
+   * <code>datagrams</code>. Reception stops early at a datagram that doesn't
+   * fit in the rest of <code>buffer</code>; it is returned by a later call.
+   * A buffer of <code>max_datagrams</code> times the largest expected
+   * datagram size never stops early.
+   *
+   * @param[in] udp_socket A <code>PP_Resource</code> corresponding to a UDP
+   * socket.
+   * @param[out] buffer The buffer to store the received payloads in. It must
+   * be at least as large as <code>num_bytes</code>.
+   * @param[in] num_bytes The size of <code>buffer</code>.
+   * @param[out] datagrams An array of at least <code>max_datagrams</code>
+   * elements describing the datagrams received.
+   * @param[in] max_datagrams The maximum number of datagrams to receive.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion.
+   *
+   * @return A positive number on success to indicate how many datagrams have
+   * been received; otherwise, an error code from <code>pp_errors.h</code>.
+   * <code>PP_ERROR_MESSAGE_TOO_BIG</code> is returned if the first datagram
+   * doesn't fit in <code>buffer</code>.
+   */
+  int32_t (*RecvFromBatch)(PP_Resource udp_socket,
+                           char* buffer,
+                           int32_t num_bytes,
+                           struct PP_UDPSocket_Datagram_Dev datagrams[],
+                           uint32_t max_datagrams,
+                           struct PP_CompletionCallback callback);
+  /**
+   * Sends several datagrams with a single completion. The socket must be
+   * bound. The payloads are copied out of <code>buffer</code> before the call
+   * returns, so the buffer can be reused right away.
+   *
+   * The datagrams are sent in order. If one fails, the ones after it are not
+   * sent, although some of them may already be on their way. A large batch
+   * may be cut short; as with a partial write, the caller sends the datagrams
+   * that weren't counted in the result with another call.
+   *
+   * @param[in] udp_socket A <code>PP_Resource</code> corresponding to a UDP
+   * socket.
+   * @param[in] buffer The buffer containing the payloads to send.
+   * @param[in] num_bytes The size of <code>buffer</code>.
+   * @param[in] datagrams An array of <code>num_datagrams</code> elements giving
+   * the position, size and destination of each datagram.
+   * @param[in] num_datagrams The number of datagrams to send.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion.
+   *
+   * @return A positive number on success to indicate how many datagrams, from
+   * the start of <code>datagrams</code>, have been sent; otherwise, the error
+   * code from <code>pp_errors.h</code> for the first datagram.
+   * <code>PP_ERROR_INPROGRESS</code> is returned if another
+   * <code>SendToBatch()</code> is pending.
+   */
+  int32_t (*SendToBatch)(PP_Resource udp_socket,
+                         const char* buffer,
+                         int32_t num_bytes,
+                         const struct PP_UDPSocket_Datagram_Dev datagrams[],
+                         uint32_t num_datagrams,
+                         struct PP_CompletionCallback callback);
+};
+
+typedef struct PPB_UDPSocket_Dev_0_1 PPB_UDPSocket_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_UDP_SOCKET_DEV_H_ */
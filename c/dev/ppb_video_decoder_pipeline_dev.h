@@ -0,0 +1,228 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_video_decoder_pipeline_dev.idl,
+ *   modified Thu Jul  5 16:22:37 2018.
+ */
+
+#ifndef PPAPI_C_DEV_PPB_VIDEO_DECODER_PIPELINE_DEV_H_
+#define PPAPI_C_DEV_PPB_VIDEO_DECODER_PIPELINE_DEV_H_
+
+#include "ppapi/c/pp_bool.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+#include "ppapi/c/pp_time.h"
+
+#define PPB_VIDEODECODERPIPELINE_DEV_INTERFACE_0_1 \
+    "PPB_VideoDecoderPipeline(Dev);0.1"
+#define PPB_VIDEODECODERPIPELINE_DEV_INTERFACE \
+    PPB_VIDEODECODERPIPELINE_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_VideoDecoderPipeline_Dev</code> interface,
+ * which sizes the pipeline of bitstream buffers between a
+ * <code>PPB_VideoDecoder</code> resource and the decoder, reports how full it
+ * is kept, and lets the plugin write bitstream data straight into it.
+ */
+
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * Options for the bitstream buffer pipeline of a video decoder. A zero field
+ * selects the default.
+ */
+struct PP_VideoDecoderPipelineOptions_Dev {
+  /**
+   * The maximum number of <code>Decode()</code> calls that may be pending
+   * before <code>Decode()</code> completes asynchronously. This is also the
+   * number of shared memory buffers the decoder may allocate. The default is
+   * 8, and the limit is 32.
+   */
+  uint32_t max_pending_decodes;
+  /**
+   * The largest bitstream buffer, in bytes, that can be passed to
+   * <code>Decode()</code>. The default is 4 MB, and the limit is 16 MB.
+   */
+  uint32_t bitstream_buffer_size;
+  /**
+   * If <code>PP_TRUE</code>, all <code>max_pending_decodes</code> buffers are
+   * allocated, at <code>bitstream_buffer_size</code> bytes each, when the
+   * decoder is initialized. Otherwise buffers are allocated and grown as
+   * <code>Decode()</code> needs them.
+   */
+  PP_Bool preallocate_buffers;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_VideoDecoderPipelineOptions_Dev, 12);
+
+/**
+ * Statistics about the bitstream buffer pipeline of a video decoder,
+ * accumulated since it was initialized.
+ */
+struct PP_VideoDecoderPipelineStats_Dev {
+  /**
+   * The total time the plugin spent waiting for a <code>Decode()</code> or
+   * <code>AcquireBitstreamBuffer()</code> call to complete because all the
+   * buffers were in use.
+   */
+  PP_TimeDelta buffer_wait_time;
+  /**
+   * The average number of decodes pending, sampled each time a buffer is
+   * sent to the decoder, counting the new one.
+   */
+  double average_pending_decodes;
+  /**
+   * The number of buffers sent to the decoder, by <code>Decode()</code> or
+   * <code>SubmitBitstreamBuffer()</code>.
+   */
+  uint32_t decode_count;
+  /**
+   * The number of decodes currently pending.
+   */
+  uint32_t pending_decodes;
+  /**
+   * The highest number of decodes that have been pending at once.
+   */
+  uint32_t peak_pending_decodes;
+  /**
+   * The number of <code>Decode()</code> and
+   * <code>AcquireBitstreamBuffer()</code> calls that completed asynchronously
+   * because all the buffers were in use.
+   */
+  uint32_t buffer_wait_count;
+  /**
+   * The number of shared memory buffers allocated.
+   */
+  uint32_t shm_buffer_count;
+  /**
+   * The total size of the shared memory buffers, in bytes.
+   */
+  uint32_t shm_buffer_size;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_VideoDecoderPipelineStats_Dev, 40);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_VideoDecoderPipeline_Dev_0_1 {
+  /**
+   * Sets the options for the bitstream buffer pipeline of a video decoder. It
+   * must be called before <code>Initialize()</code>.
+   *
+   * @param[in] video_decoder A <code>PP_Resource</code> identifying the video
+   * decoder.
+   * @param[in] options A <code>PP_VideoDecoderPipelineOptions_Dev</code>
+   * holding the options to use.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if an option is over its limit,
+   * <code>PP_ERROR_FAILED</code> if the decoder has already been initialized,
+   * and <code>PP_ERROR_NOTSUPPORTED</code> if the browser can't use the
+   * options.
+   */
+  int32_t (*SetOptions)(
+      PP_Resource video_decoder,
+      const struct PP_VideoDecoderPipelineOptions_Dev* options);
+  /**
+   * Returns statistics about the bitstream buffer pipeline of a video decoder.
+   *
+   * @param[in] video_decoder A <code>PP_Resource</code> identifying the video
+   * decoder.
+   * @param[out] stats The <code>PP_VideoDecoderPipelineStats_Dev</code> to
+   * fill in.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   */
+  int32_t (*GetStats)(PP_Resource video_decoder,
+                      struct PP_VideoDecoderPipelineStats_Dev* stats);
+  /**
+   * Acquires a bitstream buffer of at least <code>size</code> bytes from the
+   * decoder's shared memory pool. The plugin writes the bitstream data into
+   * it and passes it to <code>SubmitBitstreamBuffer()</code>, which saves the
+   * copy <code>Decode()</code> makes. A buffer that won't be submitted must be
+   * returned with <code>ReleaseBitstreamBuffer()</code>.
+   *
+   * If all the buffers are in use, the call completes asynchronously when one
+   * is free, like <code>Decode()</code>. Only one <code>Decode()</code> or
+   * <code>AcquireBitstreamBuffer()</code> call may be pending at a time.
+   * Buffers held by the plugin count against
+   * <code>max_pending_decodes</code>, so <code>Decode()</code> fails with
+   * <code>PP_ERROR_NOMEMORY</code> if the plugin holds all the free ones.
+   *
+   * @param[in] video_decoder A <code>PP_Resource</code> identifying the video
+   * decoder.
+   * @param[in] size The number of bytes the plugin needs.
+   * @param[out] buffer_id The id of the buffer, to pass to
+   * <code>SubmitBitstreamBuffer()</code> or
+   * <code>ReleaseBitstreamBuffer()</code>.
+   * @param[out] buffer The address of the buffer. It stays valid until the
+   * buffer is submitted or released.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called on
+   * completion.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_NOMEMORY</code> if <code>size</code> is larger than
+   * the bitstream buffer size, and <code>PP_ERROR_INPROGRESS</code> if a
+   * <code>Decode()</code> or <code>AcquireBitstreamBuffer()</code> call is
+   * pending.
+   */
+  int32_t (*AcquireBitstreamBuffer)(PP_Resource video_decoder,
+                                    uint32_t size,
+                                    uint32_t* buffer_id,
+                                    void** buffer,
+                                    struct PP_CompletionCallback callback);
+  /**
+   * Decodes a bitstream buffer acquired with
+   * <code>AcquireBitstreamBuffer()</code>. The buffer goes back to the pool
+   * once the decoder is done with it, and must not be used by the plugin after
+   * this call.
+   *
+   * @param[in] video_decoder A <code>PP_Resource</code> identifying the video
+   * decoder.
+   * @param[in] buffer_id The id of the buffer.
+   * @param[in] decode_id An optional value, chosen by the client, that can be
+   * used to associate calls with the pictures returned by
+   * <code>GetPicture()</code>, as for <code>Decode()</code>.
+   * @param[in] size The number of bytes of bitstream data in the buffer.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if the buffer isn't one the
+   * plugin has acquired, or <code>size</code> is larger than the buffer.
+   */
+  int32_t (*SubmitBitstreamBuffer)(PP_Resource video_decoder,
+                                   uint32_t buffer_id,
+                                   uint32_t decode_id,
+                                   uint32_t size);
+  /**
+   * Returns a bitstream buffer acquired with
+   * <code>AcquireBitstreamBuffer()</code> to the pool without decoding it.
+   *
+   * @param[in] video_decoder A <code>PP_Resource</code> identifying the video
+   * decoder.
+   * @param[in] buffer_id The id of the buffer.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   * Returns <code>PP_ERROR_BADARGUMENT</code> if the buffer isn't one the
+   * plugin has acquired.
+   */
+  int32_t (*ReleaseBitstreamBuffer)(PP_Resource video_decoder,
+                                    uint32_t buffer_id);
+};
+
+typedef struct PPB_VideoDecoderPipeline_Dev_0_1 PPB_VideoDecoderPipeline_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_VIDEO_DECODER_PIPELINE_DEV_H_ */
@@ -0,0 +1,138 @@
+/* Copyright 2018 The Chromium Authors. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+/* From dev/ppb_video_encoder_stream_dev.idl,
+ *   modified Fri Jul  6 11:04:52 2018.
+ */
+
+#ifndef PPAPI_C_DEV_PPB_VIDEO_ENCODER_STREAM_DEV_H_
+#define PPAPI_C_DEV_PPB_VIDEO_ENCODER_STREAM_DEV_H_
+
+#include "ppapi/c/pp_codecs.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_macros.h"
+#include "ppapi/c/pp_resource.h"
+#include "ppapi/c/pp_stdint.h"
+#include "ppapi/c/pp_time.h"
+
+#define PPB_VIDEOENCODERSTREAM_DEV_INTERFACE_0_1 \
+    "PPB_VideoEncoderStream(Dev);0.1"
+#define PPB_VIDEOENCODERSTREAM_DEV_INTERFACE \
+    PPB_VIDEOENCODERSTREAM_DEV_INTERFACE_0_1
+
+/**
+ * @file
+ * This file defines the <code>PPB_VideoEncoderStream_Dev</code> interface,
+ * which lets a plugin take several encoded bitstream buffers from a
+ * <code>PPB_VideoEncoder</code> resource at once, and reports how deep the
+ * encoder's queue is and how long frames take to encode.
+ */
+
+
+/**
+ * @addtogroup Structs
+ * @{
+ */
+/**
+ * Statistics about a video encoder, accumulated since it was initialized.
+ */
+struct PP_VideoEncoderStats_Dev {
+  /**
+   * The total time taken to encode frames, from each <code>Encode()</code>
+   * call to its completion. Dividing this by <code>encode_count</code> gives
+   * the average encode latency.
+   */
+  PP_TimeDelta total_encode_time;
+  /**
+   * The longest time taken to encode a frame.
+   */
+  PP_TimeDelta max_encode_time;
+  /**
+   * The time taken to encode the most recent frame.
+   */
+  PP_TimeDelta last_encode_time;
+  /**
+   * The number of <code>Encode()</code> calls that have completed.
+   */
+  uint32_t encode_count;
+  /**
+   * The number of <code>Encode()</code> calls currently pending, i.e. the
+   * depth of the encoder's input queue.
+   */
+  uint32_t pending_encodes;
+  /**
+   * The highest number of <code>Encode()</code> calls that have been pending
+   * at once.
+   */
+  uint32_t peak_pending_encodes;
+  /**
+   * The number of encoded bitstream buffers waiting to be returned by
+   * <code>GetBitstreamBuffer()</code> or <code>GetBitstreamBuffers()</code>.
+   */
+  uint32_t ready_bitstream_buffers;
+  /**
+   * The number of bitstream buffers returned to the plugin that haven't been
+   * recycled yet.
+   */
+  uint32_t held_bitstream_buffers;
+  /**
+   * The number of bitstream buffers shared with the encoder.
+   */
+  uint32_t bitstream_buffer_count;
+};
+PP_COMPILE_ASSERT_STRUCT_SIZE_IN_BYTES(PP_VideoEncoderStats_Dev, 48);
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup Interfaces
+ * @{
+ */
+struct PPB_VideoEncoderStream_Dev_0_1 {
+  /**
+   * Gets all the encoded bitstream buffers that are ready, up to
+   * <code>max_buffers</code>, in one call. If no buffer is ready, the call
+   * completes asynchronously as soon as at least one arrives, with every
+   * buffer that has arrived by then. Each buffer must be recycled with
+   * <code>RecycleBitstreamBuffer()</code> once the plugin is done with it.
+   *
+   * @param[in] video_encoder A <code>PP_Resource</code> identifying the video
+   * encoder.
+   * @param[out] buffers An array of at least <code>max_buffers</code> elements
+   * to store the <code>PP_BitstreamBuffer</code>s in, in encoding order.
+   * @param[in] max_buffers The maximum number of buffers to get.
+   * @param[in] callback A <code>PP_CompletionCallback</code> to be called upon
+   * completion.
+   *
+   * @return A positive number on success to indicate how many buffers have
+   * been stored in <code>buffers</code>; otherwise, an error code from
+   * <code>pp_errors.h</code>. <code>PP_ERROR_INPROGRESS</code> is returned if
+   * a <code>GetBitstreamBuffer()</code> or <code>GetBitstreamBuffers()</code>
+   * is pending.
+   */
+  int32_t (*GetBitstreamBuffers)(PP_Resource video_encoder,
+                                 struct PP_BitstreamBuffer buffers[],
+                                 uint32_t max_buffers,
+                                 struct PP_CompletionCallback callback);
+  /**
+   * Returns statistics about a video encoder.
+   *
+   * @param[in] video_encoder A <code>PP_Resource</code> identifying the video
+   * encoder.
+   * @param[out] stats The <code>PP_VideoEncoderStats_Dev</code> to fill in.
+   *
+   * @return An int32_t containing an error code from <code>pp_errors.h</code>.
+   */
+  int32_t (*GetStats)(PP_Resource video_encoder,
+                      struct PP_VideoEncoderStats_Dev* stats);
+};
+
+typedef struct PPB_VideoEncoderStream_Dev_0_1 PPB_VideoEncoderStream_Dev;
+/**
+ * @}
+ */
+
+#endif  /* PPAPI_C_DEV_PPB_VIDEO_ENCODER_STREAM_DEV_H_ */
@@ -43,6 +43,15 @@ AudioConfig::AudioConfig(const InstanceHandle& instance,
   }
 }
 
+AudioConfig::AudioConfig(PassRef,
+                         PP_Resource resource,
+                         PP_AudioSampleRate sample_rate,
+                         uint32_t sample_frame_count)
+    : Resource(PASS_REF, resource),
+      sample_rate_(sample_rate),
+      sample_frame_count_(sample_frame_count) {
+}
+
 // static
 PP_AudioSampleRate AudioConfig::RecommendSampleRate(
     const InstanceHandle& instance) {
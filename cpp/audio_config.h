@@ -121,6 +121,14 @@ class AudioConfig : public Resource {
   /// @return A uint32_t containing the sample frame count.
   uint32_t sample_frame_count() const { return sample_frame_count_; }
 
+ protected:
+  /// A constructor used by derived classes that create the resource through
+  /// another interface. It takes over the reference to <code>resource</code>.
+  AudioConfig(PassRef,
+              PP_Resource resource,
+              PP_AudioSampleRate sample_rate,
+              uint32_t sample_frame_count);
+
  private:
   PP_AudioSampleRate sample_rate_;
   uint32_t sample_frame_count_;
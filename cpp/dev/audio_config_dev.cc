@@ -0,0 +1,55 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/audio_config_dev.h"
+
+#include "ppapi/cpp/instance_handle.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_AudioConfig_Dev_0_1>() {
+  return PPB_AUDIOCONFIG_DEV_INTERFACE_0_1;
+}
+
+PP_Resource CreateConfig(const InstanceHandle& instance,
+                         PP_AudioSampleRate sample_rate,
+                         uint32_t sample_frame_count,
+                         PP_AudioSampleFormat_Dev sample_format) {
+  if (sample_format == PP_AUDIOSAMPLEFORMAT_DEV_INT16)
+    return AudioConfig(instance, sample_rate, sample_frame_count).detach();
+  if (sample_format == PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32 &&
+      has_interface<PPB_AudioConfig_Dev_0_1>()) {
+    return get_interface<PPB_AudioConfig_Dev_0_1>()->CreateStereoFloat32(
+        instance.pp_instance(), sample_rate, sample_frame_count);
+  }
+  return 0;
+}
+
+}  // namespace
+
+AudioConfigDev::AudioConfigDev()
+    : sample_format_(PP_AUDIOSAMPLEFORMAT_DEV_INT16) {
+}
+
+AudioConfigDev::AudioConfigDev(const InstanceHandle& instance,
+                               PP_AudioSampleRate sample_rate,
+                               uint32_t sample_frame_count,
+                               PP_AudioSampleFormat_Dev sample_format)
+    : AudioConfig(PASS_REF,
+                  CreateConfig(instance, sample_rate, sample_frame_count,
+                               sample_format),
+                  sample_rate,
+                  sample_frame_count),
+      sample_format_(sample_format) {
+}
+
+// static
+bool AudioConfigDev::IsAvailable() {
+  return has_interface<PPB_AudioConfig_Dev_0_1>();
+}
+
+}  // namespace pp
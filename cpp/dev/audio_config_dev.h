@@ -0,0 +1,59 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_AUDIO_CONFIG_DEV_H_
+#define PPAPI_CPP_DEV_AUDIO_CONFIG_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
+#include "ppapi/cpp/audio_config.h"
+
+namespace pp {
+
+class InstanceHandle;
+
+/// <code>AudioConfigDev</code> is a version of <code>AudioConfig</code> that
+/// can use the under-development sample formats. It can be passed anywhere an
+/// <code>AudioConfig</code> is expected.
+class AudioConfigDev : public AudioConfig {
+ public:
+  /// An empty constructor for an <code>AudioConfigDev</code> resource.
+  AudioConfigDev();
+
+  /// A constructor that creates a stereo audio config with samples in
+  /// <code>sample_format</code>. If the format, rate or frame count isn't
+  /// supported, the resulting resource will be is_null().
+  ///
+  /// @param[in] instance The instance associated with this resource.
+  /// @param[in] sample_rate A <code>PP_AudioSampleRate</code> which is either
+  /// <code>PP_AUDIOSAMPLERATE_44100</code> or
+  /// <code>PP_AUDIOSAMPLERATE_48000</code>.
+  /// @param[in] sample_frame_count A uint32_t frame count returned from the
+  /// <code>RecommendSampleFrameCount</code> function.
+  /// @param[in] sample_format The <code>PP_AudioSampleFormat_Dev</code> of
+  /// the buffer passed to the audio callback.
+  AudioConfigDev(const InstanceHandle& instance,
+                 PP_AudioSampleRate sample_rate,
+                 uint32_t sample_frame_count,
+                 PP_AudioSampleFormat_Dev sample_format);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_AudioConfig_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Getter function for returning the sample format.
+  ///
+  /// @return The <code>PP_AudioSampleFormat_Dev</code> of this config.
+  PP_AudioSampleFormat_Dev sample_format() const { return sample_format_; }
+
+ private:
+  PP_AudioSampleFormat_Dev sample_format_;
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_AUDIO_CONFIG_DEV_H_
@@ -0,0 +1,44 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/audio_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_Audio_Dev_0_1>() {
+  return PPB_AUDIO_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+AudioDev::AudioDev() {
+}
+
+AudioDev::AudioDev(const Audio& audio) : Audio(audio) {
+}
+
+// static
+bool AudioDev::IsAvailable() {
+  return has_interface<PPB_Audio_Dev_0_1>();
+}
+
+int32_t AudioDev::SetThreadPriority(PP_AudioThreadPriority_Dev priority) {
+  if (!has_interface<PPB_Audio_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_Audio_Dev_0_1>()->SetThreadPriority(pp_resource(),
+                                                               priority);
+}
+
+int32_t AudioDev::GetStats(PP_AudioStats_Dev* stats) {
+  if (!has_interface<PPB_Audio_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_Audio_Dev_0_1>()->GetStats(pp_resource(), stats);
+}
+
+}  // namespace pp
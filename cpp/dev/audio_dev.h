@@ -0,0 +1,50 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_AUDIO_DEV_H_
+#define PPAPI_CPP_DEV_AUDIO_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_audio_dev.h"
+#include "ppapi/cpp/audio.h"
+
+namespace pp {
+
+/// <code>AudioDev</code> adds the under-development scheduling and statistics
+/// functions to an <code>Audio</code> resource.
+class AudioDev : public Audio {
+ public:
+  /// An empty constructor for an <code>AudioDev</code> resource.
+  AudioDev();
+
+  /// Wraps the resource of an existing <code>Audio</code>.
+  explicit AudioDev(const Audio& audio);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_Audio_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Sets the scheduling priority of the audio callback thread. See
+  /// <code>PPB_Audio_Dev.SetThreadPriority()</code>.
+  ///
+  /// @param[in] priority The <code>PP_AudioThreadPriority_Dev</code> to use.
+  ///
+  /// @return <code>PP_OK</code> on success, or
+  /// <code>PP_ERROR_NOTSUPPORTED</code> if the priority can't be changed.
+  int32_t SetThreadPriority(PP_AudioThreadPriority_Dev priority);
+
+  /// Returns statistics about the audio callback.
+  ///
+  /// @param[out] stats The <code>PP_AudioStats_Dev</code> to fill in.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t GetStats(PP_AudioStats_Dev* stats);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_AUDIO_DEV_H_
@@ -0,0 +1,81 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/file_io_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_FileIO_Dev_0_1>() {
+  return PPB_FILEIO_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+FileIODev::FileIODev() {
+}
+
+FileIODev::FileIODev(const FileIO& file_io) : FileIO(file_io) {
+}
+
+// static
+bool FileIODev::IsAvailable() {
+  return has_interface<PPB_FileIO_Dev_0_1>();
+}
+
+int32_t FileIODev::SetMaxPendingOperations(uint32_t max_pending_operations) {
+  if (!has_interface<PPB_FileIO_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_FileIO_Dev_0_1>()->SetMaxPendingOperations(
+      pp_resource(), max_pending_operations);
+}
+
+int32_t FileIODev::MapRange(int64_t offset,
+                            int64_t length,
+                            const void** address) {
+  *address = NULL;
+  if (!has_interface<PPB_FileIO_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  void* mapped = NULL;
+  int32_t result = get_interface<PPB_FileIO_Dev_0_1>()->MapRange(
+      pp_resource(), offset, length, &mapped);
+  *address = mapped;
+  return result;
+}
+
+int32_t FileIODev::UnmapRange(const void* address) {
+  if (!has_interface<PPB_FileIO_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_FileIO_Dev_0_1>()->UnmapRange(
+      pp_resource(), const_cast<void*>(address));
+}
+
+int32_t FileIODev::ReadV(int64_t offset,
+                         const PP_FileIOSegment_Dev segments[],
+                         uint32_t segment_count,
+                         const CompletionCallback& cc) {
+  if (!has_interface<PPB_FileIO_Dev_0_1>())
+    return cc.MayForce(PP_ERROR_NOINTERFACE);
+  return get_interface<PPB_FileIO_Dev_0_1>()->ReadV(
+      pp_resource(), offset, segments, segment_count,
+      cc.pp_completion_callback());
+}
+
+int32_t FileIODev::WriteV(int64_t offset,
+                          const PP_FileIOSegment_Dev segments[],
+                          uint32_t segment_count,
+                          const CompletionCallback& cc) {
+  if (!has_interface<PPB_FileIO_Dev_0_1>())
+    return cc.MayForce(PP_ERROR_NOINTERFACE);
+  return get_interface<PPB_FileIO_Dev_0_1>()->WriteV(
+      pp_resource(), offset, segments, segment_count,
+      cc.pp_completion_callback());
+}
+
+}  // namespace pp
@@ -0,0 +1,102 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_FILE_IO_DEV_H_
+#define PPAPI_CPP_DEV_FILE_IO_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_file_io_dev.h"
+#include "ppapi/cpp/file_io.h"
+
+namespace pp {
+
+/// <code>FileIODev</code> adds the under-development functions for having
+/// several operations pending at once, for vectored reads and writes, and for
+/// mapping files into memory, to a <code>FileIO</code> resource.
+class FileIODev : public FileIO {
+ public:
+  /// An empty constructor for a <code>FileIODev</code> resource.
+  FileIODev();
+
+  /// Wraps the resource of an existing <code>FileIO</code>.
+  explicit FileIODev(const FileIO& file_io);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_FileIO_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Sets how many reads and writes may be pending on the file at once, in
+  /// any mix. Operations on overlapping byte ranges, where one is a write,
+  /// still run in the order they were issued; others may complete in any
+  /// order. See <code>PPB_FileIO_Dev.SetMaxPendingOperations()</code>.
+  ///
+  /// @param[in] max_pending_operations The most reads and writes that may be
+  /// pending at once, up to 64. Zero restores the default behavior.
+  ///
+  /// @return An int32_t containing an error code from
+  /// <code>pp_errors.h</code>. Returns <code>PP_ERROR_NOINTERFACE</code> if
+  /// the browser doesn't support the interface.
+  int32_t SetMaxPendingOperations(uint32_t max_pending_operations);
+
+  /// Maps a range of the file into memory, read-only. The mapping stays valid
+  /// until it is passed to <code>UnmapRange()</code>, the file is closed, or
+  /// the resource is released. See <code>PPB_FileIO_Dev.MapRange()</code>.
+  ///
+  /// @param[in] offset The offset into the file of the start of the range.
+  /// @param[in] length The number of bytes in the range.
+  /// @param[out] address The address of the first byte of the range.
+  ///
+  /// @return An int32_t containing an error code from
+  /// <code>pp_errors.h</code>. Returns <code>PP_ERROR_NOINTERFACE</code> if
+  /// the browser doesn't support the interface.
+  int32_t MapRange(int64_t offset, int64_t length, const void** address);
+
+  /// Unmaps a range mapped with <code>MapRange()</code>.
+  ///
+  /// @param[in] address The address returned by <code>MapRange()</code>.
+  ///
+  /// @return An int32_t containing an error code from
+  /// <code>pp_errors.h</code>.
+  int32_t UnmapRange(const void* address);
+
+  /// Reads from an offset in the file into several buffers, in order, with a
+  /// single operation. See <code>PPB_FileIO_Dev.ReadV()</code>.
+  ///
+  /// @param[in] offset The offset into the file.
+  /// @param[in] segments The buffers to read into. They must remain valid
+  /// until the callback runs.
+  /// @param[in] segment_count The number of segments, up to 1024.
+  /// @param[in] cc A <code>CompletionCallback</code> to be called upon
+  /// completion of <code>ReadV()</code>.
+  ///
+  /// @return The number of bytes read or an error code from
+  /// <code>pp_errors.h</code>.
+  int32_t ReadV(int64_t offset,
+                const PP_FileIOSegment_Dev segments[],
+                uint32_t segment_count,
+                const CompletionCallback& cc);
+
+  /// Writes several buffers, in order, to an offset in the file with a single
+  /// operation. See <code>PPB_FileIO_Dev.WriteV()</code>.
+  ///
+  /// @param[in] offset The offset into the file.
+  /// @param[in] segments The buffers to write.
+  /// @param[in] segment_count The number of segments, up to 1024.
+  /// @param[in] cc A <code>CompletionCallback</code> to be called upon
+  /// completion of <code>WriteV()</code>.
+  ///
+  /// @return The number of bytes written or an error code from
+  /// <code>pp_errors.h</code>.
+  int32_t WriteV(int64_t offset,
+                 const PP_FileIOSegment_Dev segments[],
+                 uint32_t segment_count,
+                 const CompletionCallback& cc);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_FILE_IO_DEV_H_
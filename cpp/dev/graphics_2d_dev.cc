@@ -0,0 +1,56 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/graphics_2d_dev.h"
+
+#include <stddef.h>
+
+#include "ppapi/c/dev/ppb_graphics_2d_dev.h"
+#include "ppapi/cpp/image_data.h"
+#include "ppapi/cpp/module_impl.h"
+#include "ppapi/cpp/point.h"
+#include "ppapi/cpp/rect.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_Graphics2D_Dev_0_1>() {
+  return PPB_GRAPHICS2D_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+Graphics2DDev::Graphics2DDev() {
+}
+
+Graphics2DDev::Graphics2DDev(const Graphics2D& graphics_2d)
+    : Graphics2D(graphics_2d) {
+}
+
+// static
+bool Graphics2DDev::IsAvailable() {
+  return has_interface<PPB_Graphics2D_Dev_0_1>();
+}
+
+void Graphics2DDev::PaintImageDataRects(const ImageData& image,
+                                        const Point& top_left,
+                                        const std::vector<Rect>& src_rects) {
+  if (src_rects.empty())
+    return;
+  if (!has_interface<PPB_Graphics2D_Dev_0_1>()) {
+    for (size_t i = 0; i < src_rects.size(); ++i)
+      PaintImageData(image, top_left, src_rects[i]);
+    return;
+  }
+
+  std::vector<PP_Rect> rects(src_rects.size());
+  for (size_t i = 0; i < src_rects.size(); ++i)
+    rects[i] = src_rects[i].pp_rect();
+  get_interface<PPB_Graphics2D_Dev_0_1>()->PaintImageDataRects(
+      pp_resource(), image.pp_resource(), &top_left.pp_point(), &rects[0],
+      static_cast<uint32_t>(rects.size()));
+}
+
+}  // namespace pp
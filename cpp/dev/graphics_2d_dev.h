@@ -0,0 +1,52 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_GRAPHICS_2D_DEV_H_
+#define PPAPI_CPP_DEV_GRAPHICS_2D_DEV_H_
+
+#include <vector>
+
+#include "ppapi/cpp/graphics_2d.h"
+
+namespace pp {
+
+class ImageData;
+class Point;
+class Rect;
+
+/// <code>Graphics2DDev</code> adds the under-development batched painting
+/// function to a <code>Graphics2D</code> resource.
+class Graphics2DDev : public Graphics2D {
+ public:
+  /// An empty constructor for a <code>Graphics2DDev</code> resource.
+  Graphics2DDev();
+
+  /// Wraps the resource of an existing <code>Graphics2D</code>.
+  explicit Graphics2DDev(const Graphics2D& graphics_2d);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_Graphics2D_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Enqueues paint commands for several parts of the same image, such as the
+  /// dirty rects of a frame. It is equivalent to calling
+  /// <code>PaintImageData()</code> once for each rect, which is what it does
+  /// if the browser doesn't support the interface.
+  ///
+  /// @param[in] image The <code>ImageData</code> to paint from.
+  /// @param[in] top_left A <code>Point</code> representing the
+  /// <code>top_left</code> location where the <code>ImageData</code> will be
+  /// painted.
+  /// @param[in] src_rects The rects, in the coordinate system of the image, to
+  /// paint.
+  void PaintImageDataRects(const ImageData& image,
+                           const Point& top_left,
+                           const std::vector<Rect>& src_rects);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_GRAPHICS_2D_DEV_H_
@@ -0,0 +1,62 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/media_stream_video_track_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/module_impl.h"
+#include "ppapi/cpp/video_frame.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_MediaStreamVideoTrack_Dev_0_1>() {
+  return PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+MediaStreamVideoTrackDev::MediaStreamVideoTrackDev() {
+}
+
+MediaStreamVideoTrackDev::MediaStreamVideoTrackDev(
+    const MediaStreamVideoTrack& other)
+    : MediaStreamVideoTrack(other) {
+}
+
+MediaStreamVideoTrackDev::~MediaStreamVideoTrackDev() {
+}
+
+// static
+bool MediaStreamVideoTrackDev::IsAvailable() {
+  return has_interface<PPB_MediaStreamVideoTrack_Dev_0_1>();
+}
+
+int32_t MediaStreamVideoTrackDev::GetFrames(
+    PP_Resource frames[],
+    uint32_t max_frames,
+    const CompletionCallback& callback) {
+  if (has_interface<PPB_MediaStreamVideoTrack_Dev_0_1>()) {
+    return get_interface<PPB_MediaStreamVideoTrack_Dev_0_1>()->GetFrames(
+        pp_resource(), frames, max_frames, callback.pp_completion_callback());
+  }
+  return callback.MayForce(PP_ERROR_NOINTERFACE);
+}
+
+int32_t MediaStreamVideoTrackDev::RecycleFrames(
+    const std::vector<VideoFrame>& frames) {
+  if (!has_interface<PPB_MediaStreamVideoTrack_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  std::vector<PP_Resource> resources;
+  resources.reserve(frames.size());
+  for (const VideoFrame& frame : frames)
+    resources.push_back(frame.pp_resource());
+  return get_interface<PPB_MediaStreamVideoTrack_Dev_0_1>()->RecycleFrames(
+      pp_resource(), resources.data(),
+      static_cast<uint32_t>(resources.size()));
+}
+
+}  // namespace pp
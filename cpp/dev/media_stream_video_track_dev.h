@@ -0,0 +1,73 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_MEDIA_STREAM_VIDEO_TRACK_DEV_H_
+#define PPAPI_CPP_DEV_MEDIA_STREAM_VIDEO_TRACK_DEV_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ppapi/c/dev/ppb_media_stream_video_track_dev.h"
+#include "ppapi/cpp/media_stream_video_track.h"
+
+namespace pp {
+
+class CompletionCallback;
+class VideoFrame;
+
+/// <code>MediaStreamVideoTrackDev</code> is a version of
+/// <code>MediaStreamVideoTrack</code> that exposes the under-development
+/// batched frame operations.
+class MediaStreamVideoTrackDev : public MediaStreamVideoTrack {
+ public:
+  /// Default constructor for creating an is_null()
+  /// <code>MediaStreamVideoTrackDev</code> object.
+  MediaStreamVideoTrackDev();
+
+  /// A constructor used to get the batched operations of an existing track.
+  ///
+  /// @param[in] other A <code>MediaStreamVideoTrack</code>.
+  explicit MediaStreamVideoTrackDev(const MediaStreamVideoTrack& other);
+
+  ~MediaStreamVideoTrackDev();
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_MediaStreamVideoTrack_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Gets all the frames that are ready, up to <code>max_frames</code>, in one
+  /// call. If no frame is ready, the call completes as soon as at least one
+  /// arrives, with every frame that has arrived by then. The frames are
+  /// <code>PPB_VideoFrame</code> resources that the caller owns; wrap them
+  /// with <code>VideoFrame(PASS_REF, ...)</code>.
+  ///
+  /// @param[out] frames An array of at least <code>max_frames</code> elements
+  /// to store the frames in, oldest first. It must stay valid until the
+  /// callback runs.
+  /// @param[in] max_frames The maximum number of frames to get.
+  /// @param[in] callback A <code>CompletionCallback</code> to be called upon
+  /// completion.
+  ///
+  /// @return A positive number on success to indicate how many frames have
+  /// been stored in <code>frames</code>; otherwise, an error code from
+  /// <code>pp_errors.h</code>.
+  int32_t GetFrames(PP_Resource frames[],
+                    uint32_t max_frames,
+                    const CompletionCallback& callback);
+
+  /// Recycles several frames to the track, with at most one message to the
+  /// browser when the track passes frames through shared memory.
+  ///
+  /// @param[in] frames The <code>VideoFrame</code>s to recycle.
+  ///
+  /// @return An int32_t containing a result code from <code>pp_errors.h</code>.
+  int32_t RecycleFrames(const std::vector<VideoFrame>& frames);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_MEDIA_STREAM_VIDEO_TRACK_DEV_H_
@@ -0,0 +1,65 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/udp_socket_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_UDPSocket_Dev_0_1>() {
+  return PPB_UDPSOCKET_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+UDPSocketDev::UDPSocketDev() {
+}
+
+UDPSocketDev::UDPSocketDev(const InstanceHandle& instance)
+    : UDPSocket(instance) {
+}
+
+UDPSocketDev::UDPSocketDev(const UDPSocket& other) : UDPSocket(other) {
+}
+
+UDPSocketDev::~UDPSocketDev() {
+}
+
+// static
+bool UDPSocketDev::IsAvailable() {
+  return UDPSocket::IsAvailable() && has_interface<PPB_UDPSocket_Dev_0_1>();
+}
+
+int32_t UDPSocketDev::RecvFromBatch(char* buffer,
+                                    int32_t num_bytes,
+                                    PP_UDPSocket_Datagram_Dev datagrams[],
+                                    uint32_t max_datagrams,
+                                    const CompletionCallback& callback) {
+  if (has_interface<PPB_UDPSocket_Dev_0_1>()) {
+    return get_interface<PPB_UDPSocket_Dev_0_1>()->RecvFromBatch(
+        pp_resource(), buffer, num_bytes, datagrams, max_datagrams,
+        callback.pp_completion_callback());
+  }
+  return callback.MayForce(PP_ERROR_NOINTERFACE);
+}
+
+int32_t UDPSocketDev::SendToBatch(const char* buffer,
+                                  int32_t num_bytes,
+                                  const PP_UDPSocket_Datagram_Dev datagrams[],
+                                  uint32_t num_datagrams,
+                                  const CompletionCallback& callback) {
+  if (has_interface<PPB_UDPSocket_Dev_0_1>()) {
+    return get_interface<PPB_UDPSocket_Dev_0_1>()->SendToBatch(
+        pp_resource(), buffer, num_bytes, datagrams, num_datagrams,
+        callback.pp_completion_callback());
+  }
+  return callback.MayForce(PP_ERROR_NOINTERFACE);
+}
+
+}  // namespace pp
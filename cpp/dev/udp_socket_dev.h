@@ -0,0 +1,103 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_UDP_SOCKET_DEV_H_
+#define PPAPI_CPP_DEV_UDP_SOCKET_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
+#include "ppapi/cpp/udp_socket.h"
+
+namespace pp {
+
+class CompletionCallback;
+
+/// <code>UDPSocketDev</code> is a version of <code>UDPSocket</code> that
+/// exposes the under-development batched operations.
+class UDPSocketDev : public UDPSocket {
+ public:
+  /// Default constructor for creating an is_null()
+  /// <code>UDPSocketDev</code> object.
+  UDPSocketDev();
+
+  /// A constructor used to create a <code>UDPSocketDev</code> object.
+  ///
+  /// @param[in] instance The instance with which this resource will be
+  /// associated.
+  explicit UDPSocketDev(const InstanceHandle& instance);
+
+  /// A constructor used to get the batched operations of an existing socket.
+  ///
+  /// @param[in] other A <code>UDPSocket</code>.
+  explicit UDPSocketDev(const UDPSocket& other);
+
+  virtual ~UDPSocketDev();
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_UDPSocket_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Receives as many datagrams as are available, up to
+  /// <code>max_datagrams</code>, in one call. The socket must be bound. If no
+  /// datagram is available, the call completes as soon as at least one
+  /// arrives, with every datagram that has arrived by then.
+  ///
+  /// The payloads are stored back to back in <code>buffer</code>, and each
+  /// datagram's position, size and source address are written to
+  /// <code>datagrams</code>. The addresses are <code>PPB_NetAddress</code>
+  /// resources that the caller owns; wrap them with
+  /// <code>NetAddress(PASS_REF, ...)</code>.
+  ///
+  /// The same caveats about the buffer's lifetime as for
+  /// <code>RecvFrom()</code> apply to both <code>buffer</code> and
+  /// <code>datagrams</code>.
+  ///
+  /// @param[out] buffer The buffer to store the received payloads in. It must
+  /// be at least as large as <code>num_bytes</code>.
+  /// @param[in] num_bytes The size of <code>buffer</code>.
+  /// @param[out] datagrams An array of at least <code>max_datagrams</code>
+  /// elements describing the datagrams received.
+  /// @param[in] max_datagrams The maximum number of datagrams to receive.
+  /// @param[in] callback A <code>CompletionCallback</code> to be called upon
+  /// completion.
+  ///
+  /// @return A positive number on success to indicate how many datagrams have
+  /// been received; otherwise, an error code from <code>pp_errors.h</code>.
+  int32_t RecvFromBatch(char* buffer,
+                        int32_t num_bytes,
+                        PP_UDPSocket_Datagram_Dev datagrams[],
+                        uint32_t max_datagrams,
+                        const CompletionCallback& callback);
+
+  /// Sends several datagrams with a single completion. The socket must be
+  /// bound. The payloads are copied out of <code>buffer</code> before the
+  /// call returns, so the buffer can be reused right away.
+  ///
+  /// The datagrams are sent in order. If one fails, the ones after it are not
+  /// sent, although some of them may already be on their way.
+  ///
+  /// @param[in] buffer The buffer containing the payloads to send.
+  /// @param[in] num_bytes The size of <code>buffer</code>.
+  /// @param[in] datagrams An array of <code>num_datagrams</code> elements
+  /// giving the position, size and destination of each datagram.
+  /// @param[in] num_datagrams The number of datagrams to send.
+  /// @param[in] callback A <code>CompletionCallback</code> to be called upon
+  /// completion.
+  ///
+  /// @return A positive number on success to indicate how many datagrams,
+  /// from the start of <code>datagrams</code>, have been sent; otherwise, the
+  /// error code from <code>pp_errors.h</code> for the first datagram.
+  int32_t SendToBatch(const char* buffer,
+                      int32_t num_bytes,
+                      const PP_UDPSocket_Datagram_Dev datagrams[],
+                      uint32_t num_datagrams,
+                      const CompletionCallback& callback);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_UDP_SOCKET_DEV_H_
@@ -0,0 +1,78 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/video_decoder_pipeline_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_VideoDecoderPipeline_Dev_0_1>() {
+  return PPB_VIDEODECODERPIPELINE_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+VideoDecoderPipelineDev::VideoDecoderPipelineDev() {
+}
+
+VideoDecoderPipelineDev::VideoDecoderPipelineDev(
+    const VideoDecoder& video_decoder)
+    : VideoDecoder(video_decoder) {
+}
+
+// static
+bool VideoDecoderPipelineDev::IsAvailable() {
+  return has_interface<PPB_VideoDecoderPipeline_Dev_0_1>();
+}
+
+int32_t VideoDecoderPipelineDev::SetOptions(
+    const PP_VideoDecoderPipelineOptions_Dev& options) {
+  if (!has_interface<PPB_VideoDecoderPipeline_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_VideoDecoderPipeline_Dev_0_1>()->SetOptions(
+      pp_resource(), &options);
+}
+
+int32_t VideoDecoderPipelineDev::GetStats(
+    PP_VideoDecoderPipelineStats_Dev* stats) {
+  if (!has_interface<PPB_VideoDecoderPipeline_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_VideoDecoderPipeline_Dev_0_1>()->GetStats(
+      pp_resource(), stats);
+}
+
+int32_t VideoDecoderPipelineDev::AcquireBitstreamBuffer(
+    uint32_t size,
+    uint32_t* buffer_id,
+    void** buffer,
+    const CompletionCallback& cc) {
+  if (!has_interface<PPB_VideoDecoderPipeline_Dev_0_1>())
+    return cc.MayForce(PP_ERROR_NOINTERFACE);
+  return get_interface<PPB_VideoDecoderPipeline_Dev_0_1>()
+      ->AcquireBitstreamBuffer(pp_resource(), size, buffer_id, buffer,
+                               cc.pp_completion_callback());
+}
+
+int32_t VideoDecoderPipelineDev::SubmitBitstreamBuffer(uint32_t buffer_id,
+                                                       uint32_t decode_id,
+                                                       uint32_t size) {
+  if (!has_interface<PPB_VideoDecoderPipeline_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_VideoDecoderPipeline_Dev_0_1>()
+      ->SubmitBitstreamBuffer(pp_resource(), buffer_id, decode_id, size);
+}
+
+int32_t VideoDecoderPipelineDev::ReleaseBitstreamBuffer(uint32_t buffer_id) {
+  if (!has_interface<PPB_VideoDecoderPipeline_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_VideoDecoderPipeline_Dev_0_1>()
+      ->ReleaseBitstreamBuffer(pp_resource(), buffer_id);
+}
+
+}  // namespace pp
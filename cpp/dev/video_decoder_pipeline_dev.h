@@ -0,0 +1,93 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_VIDEO_DECODER_PIPELINE_DEV_H_
+#define PPAPI_CPP_DEV_VIDEO_DECODER_PIPELINE_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_video_decoder_pipeline_dev.h"
+#include "ppapi/cpp/video_decoder.h"
+
+namespace pp {
+
+class CompletionCallback;
+
+/// <code>VideoDecoderPipelineDev</code> adds the under-development bitstream
+/// buffer pipeline functions to a <code>VideoDecoder</code> resource.
+class VideoDecoderPipelineDev : public VideoDecoder {
+ public:
+  /// An empty constructor for a <code>VideoDecoderPipelineDev</code>
+  /// resource.
+  VideoDecoderPipelineDev();
+
+  /// Wraps the resource of an existing <code>VideoDecoder</code>.
+  explicit VideoDecoderPipelineDev(const VideoDecoder& video_decoder);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_VideoDecoderPipeline_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Sets the options for the bitstream buffer pipeline. It must be called
+  /// before <code>Initialize()</code>. See
+  /// <code>PPB_VideoDecoderPipeline_Dev.SetOptions()</code>.
+  ///
+  /// @param[in] options The <code>PP_VideoDecoderPipelineOptions_Dev</code> to
+  /// use.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t SetOptions(const PP_VideoDecoderPipelineOptions_Dev& options);
+
+  /// Returns statistics about the bitstream buffer pipeline.
+  ///
+  /// @param[out] stats The <code>PP_VideoDecoderPipelineStats_Dev</code> to
+  /// fill in.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t GetStats(PP_VideoDecoderPipelineStats_Dev* stats);
+
+  /// Acquires a bitstream buffer from the decoder's shared memory pool, for
+  /// the plugin to write bitstream data into without the copy made by
+  /// <code>Decode()</code>. See
+  /// <code>PPB_VideoDecoderPipeline_Dev.AcquireBitstreamBuffer()</code>.
+  ///
+  /// @param[in] size The number of bytes the plugin needs.
+  /// @param[out] buffer_id The id of the buffer.
+  /// @param[out] buffer The address of the buffer.
+  /// @param[in] cc A <code>CompletionCallback</code> to be called on
+  /// completion.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t AcquireBitstreamBuffer(uint32_t size,
+                                 uint32_t* buffer_id,
+                                 void** buffer,
+                                 const CompletionCallback& cc);
+
+  /// Decodes a bitstream buffer acquired with
+  /// <code>AcquireBitstreamBuffer()</code>.
+  ///
+  /// @param[in] buffer_id The id of the buffer.
+  /// @param[in] decode_id An optional value, chosen by the client, as for
+  /// <code>Decode()</code>.
+  /// @param[in] size The number of bytes of bitstream data in the buffer.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t SubmitBitstreamBuffer(uint32_t buffer_id,
+                                uint32_t decode_id,
+                                uint32_t size);
+
+  /// Returns a bitstream buffer acquired with
+  /// <code>AcquireBitstreamBuffer()</code> without decoding it.
+  ///
+  /// @param[in] buffer_id The id of the buffer.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t ReleaseBitstreamBuffer(uint32_t buffer_id);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_VIDEO_DECODER_PIPELINE_DEV_H_
@@ -0,0 +1,50 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/cpp/dev/video_encoder_stream_dev.h"
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/module_impl.h"
+
+namespace pp {
+
+namespace {
+
+template <> const char* interface_name<PPB_VideoEncoderStream_Dev_0_1>() {
+  return PPB_VIDEOENCODERSTREAM_DEV_INTERFACE_0_1;
+}
+
+}  // namespace
+
+VideoEncoderStreamDev::VideoEncoderStreamDev() {
+}
+
+VideoEncoderStreamDev::VideoEncoderStreamDev(const VideoEncoder& video_encoder)
+    : VideoEncoder(video_encoder) {
+}
+
+// static
+bool VideoEncoderStreamDev::IsAvailable() {
+  return has_interface<PPB_VideoEncoderStream_Dev_0_1>();
+}
+
+int32_t VideoEncoderStreamDev::GetBitstreamBuffers(
+    PP_BitstreamBuffer buffers[],
+    uint32_t max_buffers,
+    const CompletionCallback& cc) {
+  if (!has_interface<PPB_VideoEncoderStream_Dev_0_1>())
+    return cc.MayForce(PP_ERROR_NOINTERFACE);
+  return get_interface<PPB_VideoEncoderStream_Dev_0_1>()->GetBitstreamBuffers(
+      pp_resource(), buffers, max_buffers, cc.pp_completion_callback());
+}
+
+int32_t VideoEncoderStreamDev::GetStats(PP_VideoEncoderStats_Dev* stats) {
+  if (!has_interface<PPB_VideoEncoderStream_Dev_0_1>())
+    return PP_ERROR_NOINTERFACE;
+  return get_interface<PPB_VideoEncoderStream_Dev_0_1>()->GetStats(
+      pp_resource(), stats);
+}
+
+}  // namespace pp
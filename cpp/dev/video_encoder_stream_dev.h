@@ -0,0 +1,63 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_CPP_DEV_VIDEO_ENCODER_STREAM_DEV_H_
+#define PPAPI_CPP_DEV_VIDEO_ENCODER_STREAM_DEV_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_video_encoder_stream_dev.h"
+#include "ppapi/cpp/video_encoder.h"
+
+namespace pp {
+
+class CompletionCallback;
+
+/// <code>VideoEncoderStreamDev</code> adds the under-development streaming
+/// output and statistics functions to a <code>VideoEncoder</code> resource.
+class VideoEncoderStreamDev : public VideoEncoder {
+ public:
+  /// An empty constructor for a <code>VideoEncoderStreamDev</code> resource.
+  VideoEncoderStreamDev();
+
+  /// Wraps the resource of an existing <code>VideoEncoder</code>.
+  explicit VideoEncoderStreamDev(const VideoEncoder& video_encoder);
+
+  /// Static function for determining whether the browser supports the
+  /// <code>PPB_VideoEncoderStream_Dev</code> interface.
+  ///
+  /// @return true if the interface is available, false otherwise.
+  static bool IsAvailable();
+
+  /// Gets all the encoded bitstream buffers that are ready, up to
+  /// <code>max_buffers</code>, in one call. If no buffer is ready, the call
+  /// completes as soon as at least one arrives, with every buffer that has
+  /// arrived by then. Each buffer must be recycled with
+  /// <code>RecycleBitstreamBuffer()</code>.
+  ///
+  /// @param[out] buffers An array of at least <code>max_buffers</code>
+  /// elements to store the buffers in, in encoding order. It must stay valid
+  /// until the callback runs.
+  /// @param[in] max_buffers The maximum number of buffers to get.
+  /// @param[in] cc A <code>CompletionCallback</code> to be called upon
+  /// completion.
+  ///
+  /// @return A positive number on success to indicate how many buffers have
+  /// been stored in <code>buffers</code>; otherwise, an error code from
+  /// <code>pp_errors.h</code>.
+  int32_t GetBitstreamBuffers(PP_BitstreamBuffer buffers[],
+                              uint32_t max_buffers,
+                              const CompletionCallback& cc);
+
+  /// Returns statistics about the encoder.
+  ///
+  /// @param[out] stats The <code>PP_VideoEncoderStats_Dev</code> to fill in.
+  ///
+  /// @return An int32_t containing an error code from <code>pp_errors.h</code>.
+  int32_t GetStats(PP_VideoEncoderStats_Dev* stats);
+};
+
+}  // namespace pp
+
+#endif  // PPAPI_CPP_DEV_VIDEO_ENCODER_STREAM_DEV_H_
@@ -11,12 +11,17 @@
 #include "ppapi/c/dev/ppb_audio_output_dev.h"
 #include "ppapi/c/dev/ppb_device_ref_dev.h"
 #include "ppapi/c/dev/ppb_file_chooser_dev.h"
+#include "ppapi/c/dev/ppb_file_io_dev.h"
 #include "ppapi/c/dev/ppb_ime_input_event_dev.h"
+#include "ppapi/c/dev/ppb_media_stream_video_track_dev.h"
 #include "ppapi/c/dev/ppb_printing_dev.h"
 #include "ppapi/c/dev/ppb_truetype_font_dev.h"
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
 #include "ppapi/c/dev/ppb_url_util_dev.h"
 #include "ppapi/c/dev/ppb_video_capture_dev.h"
 #include "ppapi/c/dev/ppb_video_decoder_dev.h"
+#include "ppapi/c/dev/ppb_video_decoder_pipeline_dev.h"
+#include "ppapi/c/dev/ppb_video_encoder_stream_dev.h"
 #include "ppapi/c/ppb_audio_encoder.h"
 #include "ppapi/c/ppb_compositor.h"
 #include "ppapi/c/ppb_compositor_layer.h"
@@ -155,14 +160,19 @@ static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_AudioOutput_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_DeviceRef_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_FileChooser_Dev_0_5;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_FileChooser_Dev_0_6;
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_2;
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_MediaStreamVideoTrack_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_Printing_Dev_0_7;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_TrueTypeFont_Dev_0_1;
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_UDPSocket_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_URLUtil_Dev_0_6;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_URLUtil_Dev_0_7;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoCapture_Dev_0_3;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoDecoder_Dev_0_16;
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1;
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoEncoderStream_Dev_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_CameraDevice_Private_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_DisplayColorProfile_Private_0_1;
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_Ext_CrxFileSystem_Private_0_1;
@@ -2685,6 +2695,10 @@ static void Pnacl_M14_PPP_Messaging_HandleMessage(PP_Instance instance, struct P
 
 /* Not generating wrapper methods for PPB_URLLoaderTrusted_0_3 */
 
+/* Not generating wrapper methods for PPB_AudioConfig_Dev_0_1 */
+
+/* Not generating wrapper methods for PPB_Audio_Dev_0_1 */
+
 /* Begin wrapper methods for PPB_AudioInput_Dev_0_3 */
 
 static PP_Resource Pnacl_M25_PPB_AudioInput_Dev_Create(PP_Instance instance) {
@@ -2900,6 +2914,39 @@ static int32_t Pnacl_M19_PPB_FileChooser_Dev_Show(PP_Resource chooser, struct PP
 
 /* End wrapper methods for PPB_FileChooser_Dev_0_6 */
 
+/* Begin wrapper methods for PPB_FileIO_Dev_0_1 */
+
+static int32_t Pnacl_M69_PPB_FileIO_Dev_SetMaxPendingOperations(PP_Resource file_io, uint32_t max_pending_operations) {
+  const struct PPB_FileIO_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1.real_iface;
+  return iface->SetMaxPendingOperations(file_io, max_pending_operations);
+}
+
+static int32_t Pnacl_M69_PPB_FileIO_Dev_MapRange(PP_Resource file_io, int64_t offset, int64_t length, void** address) {
+  const struct PPB_FileIO_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1.real_iface;
+  return iface->MapRange(file_io, offset, length, address);
+}
+
+static int32_t Pnacl_M69_PPB_FileIO_Dev_UnmapRange(PP_Resource file_io, void* address) {
+  const struct PPB_FileIO_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1.real_iface;
+  return iface->UnmapRange(file_io, address);
+}
+
+static int32_t Pnacl_M69_PPB_FileIO_Dev_ReadV(PP_Resource file_io, int64_t offset, const struct PP_FileIOSegment_Dev segments[], uint32_t segment_count, struct PP_CompletionCallback* callback) {
+  const struct PPB_FileIO_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1.real_iface;
+  return iface->ReadV(file_io, offset, segments, segment_count, *callback);
+}
+
+static int32_t Pnacl_M69_PPB_FileIO_Dev_WriteV(PP_Resource file_io, int64_t offset, const struct PP_FileIOSegment_Dev segments[], uint32_t segment_count, struct PP_CompletionCallback* callback) {
+  const struct PPB_FileIO_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1.real_iface;
+  return iface->WriteV(file_io, offset, segments, segment_count, *callback);
+}
+
+/* End wrapper methods for PPB_FileIO_Dev_0_1 */
+
+/* Not generating wrapper methods for PPB_Graphics2D_Dev_0_1 */
+
+/* Not generating wrapper methods for PPB_ImageData_Dev_0_1 */
+
 /* Begin wrapper methods for PPB_IMEInputEvent_Dev_0_1 */
 
 static PP_Bool Pnacl_M16_PPB_IMEInputEvent_Dev_IsIMEInputEvent(PP_Resource resource) {
@@ -2973,6 +3020,20 @@ static void Pnacl_M21_PPB_IMEInputEvent_Dev_GetSelection(PP_Resource ime_event,
 
 /* End wrapper methods for PPB_IMEInputEvent_Dev_0_2 */
 
+/* Begin wrapper methods for PPB_MediaStreamVideoTrack_Dev_0_1 */
+
+static int32_t Pnacl_M69_PPB_MediaStreamVideoTrack_Dev_GetFrames(PP_Resource video_track, PP_Resource frames[], uint32_t max_frames, struct PP_CompletionCallback* callback) {
+  const struct PPB_MediaStreamVideoTrack_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_MediaStreamVideoTrack_Dev_0_1.real_iface;
+  return iface->GetFrames(video_track, frames, max_frames, *callback);
+}
+
+static int32_t Pnacl_M69_PPB_MediaStreamVideoTrack_Dev_RecycleFrames(PP_Resource video_track, const PP_Resource frames[], uint32_t num_frames) {
+  const struct PPB_MediaStreamVideoTrack_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_MediaStreamVideoTrack_Dev_0_1.real_iface;
+  return iface->RecycleFrames(video_track, frames, num_frames);
+}
+
+/* End wrapper methods for PPB_MediaStreamVideoTrack_Dev_0_1 */
+
 /* Not generating wrapper methods for PPB_Memory_Dev_0_1 */
 
 /* Not generating wrapper methods for PPB_OpenGLES2DrawBuffers_Dev_1_0 */
@@ -3038,6 +3099,20 @@ static int32_t Pnacl_M26_PPB_TrueTypeFont_Dev_GetTable(PP_Resource font, uint32_
 
 /* End wrapper methods for PPB_TrueTypeFont_Dev_0_1 */
 
+/* Begin wrapper methods for PPB_UDPSocket_Dev_0_1 */
+
+static int32_t Pnacl_M67_PPB_UDPSocket_Dev_RecvFromBatch(PP_Resource udp_socket, char* buffer, int32_t num_bytes, struct PP_UDPSocket_Datagram_Dev datagrams[], uint32_t max_datagrams, struct PP_CompletionCallback* callback) {
+  const struct PPB_UDPSocket_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_UDPSocket_Dev_0_1.real_iface;
+  return iface->RecvFromBatch(udp_socket, buffer, num_bytes, datagrams, max_datagrams, *callback);
+}
+
+static int32_t Pnacl_M67_PPB_UDPSocket_Dev_SendToBatch(PP_Resource udp_socket, const char* buffer, int32_t num_bytes, const struct PP_UDPSocket_Datagram_Dev datagrams[], uint32_t num_datagrams, struct PP_CompletionCallback* callback) {
+  const struct PPB_UDPSocket_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_UDPSocket_Dev_0_1.real_iface;
+  return iface->SendToBatch(udp_socket, buffer, num_bytes, datagrams, num_datagrams, *callback);
+}
+
+/* End wrapper methods for PPB_UDPSocket_Dev_0_1 */
+
 /* Begin wrapper methods for PPB_URLUtil_Dev_0_6 */
 
 static void Pnacl_M17_PPB_URLUtil_Dev_Canonicalize(struct PP_Var* _struct_result, struct PP_Var* url, struct PP_URLComponents_Dev* components) {
@@ -3224,6 +3299,49 @@ static void Pnacl_M14_PPB_VideoDecoder_Dev_Destroy(PP_Resource video_decoder) {
 
 /* End wrapper methods for PPB_VideoDecoder_Dev_0_16 */
 
+/* Begin wrapper methods for PPB_VideoDecoderPipeline_Dev_0_1 */
+
+static int32_t Pnacl_M69_PPB_VideoDecoderPipeline_Dev_SetOptions(PP_Resource video_decoder, const struct PP_VideoDecoderPipelineOptions_Dev* options) {
+  const struct PPB_VideoDecoderPipeline_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1.real_iface;
+  return iface->SetOptions(video_decoder, options);
+}
+
+static int32_t Pnacl_M69_PPB_VideoDecoderPipeline_Dev_GetStats(PP_Resource video_decoder, struct PP_VideoDecoderPipelineStats_Dev* stats) {
+  const struct PPB_VideoDecoderPipeline_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1.real_iface;
+  return iface->GetStats(video_decoder, stats);
+}
+
+static int32_t Pnacl_M69_PPB_VideoDecoderPipeline_Dev_AcquireBitstreamBuffer(PP_Resource video_decoder, uint32_t size, uint32_t* buffer_id, void** buffer, struct PP_CompletionCallback* callback) {
+  const struct PPB_VideoDecoderPipeline_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1.real_iface;
+  return iface->AcquireBitstreamBuffer(video_decoder, size, buffer_id, buffer, *callback);
+}
+
+static int32_t Pnacl_M69_PPB_VideoDecoderPipeline_Dev_SubmitBitstreamBuffer(PP_Resource video_decoder, uint32_t buffer_id, uint32_t decode_id, uint32_t size) {
+  const struct PPB_VideoDecoderPipeline_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1.real_iface;
+  return iface->SubmitBitstreamBuffer(video_decoder, buffer_id, decode_id, size);
+}
+
+static int32_t Pnacl_M69_PPB_VideoDecoderPipeline_Dev_ReleaseBitstreamBuffer(PP_Resource video_decoder, uint32_t buffer_id) {
+  const struct PPB_VideoDecoderPipeline_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1.real_iface;
+  return iface->ReleaseBitstreamBuffer(video_decoder, buffer_id);
+}
+
+/* End wrapper methods for PPB_VideoDecoderPipeline_Dev_0_1 */
+
+/* Begin wrapper methods for PPB_VideoEncoderStream_Dev_0_1 */
+
+static int32_t Pnacl_M69_PPB_VideoEncoderStream_Dev_GetBitstreamBuffers(PP_Resource video_encoder, struct PP_BitstreamBuffer buffers[], uint32_t max_buffers, struct PP_CompletionCallback* callback) {
+  const struct PPB_VideoEncoderStream_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoEncoderStream_Dev_0_1.real_iface;
+  return iface->GetBitstreamBuffers(video_encoder, buffers, max_buffers, *callback);
+}
+
+static int32_t Pnacl_M69_PPB_VideoEncoderStream_Dev_GetStats(PP_Resource video_encoder, struct PP_VideoEncoderStats_Dev* stats) {
+  const struct PPB_VideoEncoderStream_Dev_0_1 *iface = Pnacl_WrapperInfo_PPB_VideoEncoderStream_Dev_0_1.real_iface;
+  return iface->GetStats(video_encoder, stats);
+}
+
+/* End wrapper methods for PPB_VideoEncoderStream_Dev_0_1 */
+
 /* Not generating wrapper methods for PPB_View_Dev_0_1 */
 
 /* Not generating wrapper methods for PPP_NetworkState_Dev_0_1 */
@@ -5166,6 +5284,10 @@ static const struct PPP_Messaging_1_0 Pnacl_Wrappers_PPP_Messaging_1_0 = {
 
 /* Not generating wrapper interface for PPB_URLLoaderTrusted_0_3 */
 
+/* Not generating wrapper interface for PPB_AudioConfig_Dev_0_1 */
+
+/* Not generating wrapper interface for PPB_Audio_Dev_0_1 */
+
 static const struct PPB_AudioInput_Dev_0_3 Pnacl_Wrappers_PPB_AudioInput_Dev_0_3 = {
     .Create = (PP_Resource (*)(PP_Instance instance))&Pnacl_M25_PPB_AudioInput_Dev_Create,
     .IsAudioInput = (PP_Bool (*)(PP_Resource resource))&Pnacl_M25_PPB_AudioInput_Dev_IsAudioInput,
@@ -5227,6 +5349,18 @@ static const struct PPB_FileChooser_Dev_0_6 Pnacl_Wrappers_PPB_FileChooser_Dev_0
     .Show = (int32_t (*)(PP_Resource chooser, struct PP_ArrayOutput output, struct PP_CompletionCallback callback))&Pnacl_M19_PPB_FileChooser_Dev_Show
 };
 
+static const struct PPB_FileIO_Dev_0_1 Pnacl_Wrappers_PPB_FileIO_Dev_0_1 = {
+    .SetMaxPendingOperations = (int32_t (*)(PP_Resource file_io, uint32_t max_pending_operations))&Pnacl_M69_PPB_FileIO_Dev_SetMaxPendingOperations,
+    .MapRange = (int32_t (*)(PP_Resource file_io, int64_t offset, int64_t length, void** address))&Pnacl_M69_PPB_FileIO_Dev_MapRange,
+    .UnmapRange = (int32_t (*)(PP_Resource file_io, void* address))&Pnacl_M69_PPB_FileIO_Dev_UnmapRange,
+    .ReadV = (int32_t (*)(PP_Resource file_io, int64_t offset, const struct PP_FileIOSegment_Dev segments[], uint32_t segment_count, struct PP_CompletionCallback callback))&Pnacl_M69_PPB_FileIO_Dev_ReadV,
+    .WriteV = (int32_t (*)(PP_Resource file_io, int64_t offset, const struct PP_FileIOSegment_Dev segments[], uint32_t segment_count, struct PP_CompletionCallback callback))&Pnacl_M69_PPB_FileIO_Dev_WriteV
+};
+
+/* Not generating wrapper interface for PPB_Graphics2D_Dev_0_1 */
+
+/* Not generating wrapper interface for PPB_ImageData_Dev_0_1 */
+
 static const struct PPB_IMEInputEvent_Dev_0_1 Pnacl_Wrappers_PPB_IMEInputEvent_Dev_0_1 = {
     .IsIMEInputEvent = (PP_Bool (*)(PP_Resource resource))&Pnacl_M16_PPB_IMEInputEvent_Dev_IsIMEInputEvent,
     .GetText = (struct PP_Var (*)(PP_Resource ime_event))&Pnacl_M16_PPB_IMEInputEvent_Dev_GetText,
@@ -5246,6 +5380,11 @@ static const struct PPB_IMEInputEvent_Dev_0_2 Pnacl_Wrappers_PPB_IMEInputEvent_D
     .GetSelection = (void (*)(PP_Resource ime_event, uint32_t* start, uint32_t* end))&Pnacl_M21_PPB_IMEInputEvent_Dev_GetSelection
 };
 
+static const struct PPB_MediaStreamVideoTrack_Dev_0_1 Pnacl_Wrappers_PPB_MediaStreamVideoTrack_Dev_0_1 = {
+    .GetFrames = (int32_t (*)(PP_Resource video_track, PP_Resource frames[], uint32_t max_frames, struct PP_CompletionCallback callback))&Pnacl_M69_PPB_MediaStreamVideoTrack_Dev_GetFrames,
+    .RecycleFrames = (int32_t (*)(PP_Resource video_track, const PP_Resource frames[], uint32_t num_frames))&Pnacl_M69_PPB_MediaStreamVideoTrack_Dev_RecycleFrames
+};
+
 /* Not generating wrapper interface for PPB_Memory_Dev_0_1 */
 
 /* Not generating wrapper interface for PPB_OpenGLES2DrawBuffers_Dev_1_0 */
@@ -5273,6 +5412,11 @@ static const struct PPB_TrueTypeFont_Dev_0_1 Pnacl_Wrappers_PPB_TrueTypeFont_Dev
     .GetTable = (int32_t (*)(PP_Resource font, uint32_t table, int32_t offset, int32_t max_data_length, struct PP_ArrayOutput output, struct PP_CompletionCallback callback))&Pnacl_M26_PPB_TrueTypeFont_Dev_GetTable
 };
 
+static const struct PPB_UDPSocket_Dev_0_1 Pnacl_Wrappers_PPB_UDPSocket_Dev_0_1 = {
+    .RecvFromBatch = (int32_t (*)(PP_Resource udp_socket, char* buffer, int32_t num_bytes, struct PP_UDPSocket_Datagram_Dev datagrams[], uint32_t max_datagrams, struct PP_CompletionCallback callback))&Pnacl_M67_PPB_UDPSocket_Dev_RecvFromBatch,
+    .SendToBatch = (int32_t (*)(PP_Resource udp_socket, const char* buffer, int32_t num_bytes, const struct PP_UDPSocket_Datagram_Dev datagrams[], uint32_t num_datagrams, struct PP_CompletionCallback callback))&Pnacl_M67_PPB_UDPSocket_Dev_SendToBatch
+};
+
 static const struct PPB_URLUtil_Dev_0_6 Pnacl_Wrappers_PPB_URLUtil_Dev_0_6 = {
     .Canonicalize = (struct PP_Var (*)(struct PP_Var url, struct PP_URLComponents_Dev* components))&Pnacl_M17_PPB_URLUtil_Dev_Canonicalize,
     .ResolveRelativeToURL = (struct PP_Var (*)(struct PP_Var base_url, struct PP_Var relative_string, struct PP_URLComponents_Dev* components))&Pnacl_M17_PPB_URLUtil_Dev_ResolveRelativeToURL,
@@ -5319,6 +5463,19 @@ static const struct PPB_VideoDecoder_Dev_0_16 Pnacl_Wrappers_PPB_VideoDecoder_De
     .Destroy = (void (*)(PP_Resource video_decoder))&Pnacl_M14_PPB_VideoDecoder_Dev_Destroy
 };
 
+static const struct PPB_VideoDecoderPipeline_Dev_0_1 Pnacl_Wrappers_PPB_VideoDecoderPipeline_Dev_0_1 = {
+    .SetOptions = (int32_t (*)(PP_Resource video_decoder, const struct PP_VideoDecoderPipelineOptions_Dev* options))&Pnacl_M69_PPB_VideoDecoderPipeline_Dev_SetOptions,
+    .GetStats = (int32_t (*)(PP_Resource video_decoder, struct PP_VideoDecoderPipelineStats_Dev* stats))&Pnacl_M69_PPB_VideoDecoderPipeline_Dev_GetStats,
+    .AcquireBitstreamBuffer = (int32_t (*)(PP_Resource video_decoder, uint32_t size, uint32_t* buffer_id, void** buffer, struct PP_CompletionCallback callback))&Pnacl_M69_PPB_VideoDecoderPipeline_Dev_AcquireBitstreamBuffer,
+    .SubmitBitstreamBuffer = (int32_t (*)(PP_Resource video_decoder, uint32_t buffer_id, uint32_t decode_id, uint32_t size))&Pnacl_M69_PPB_VideoDecoderPipeline_Dev_SubmitBitstreamBuffer,
+    .ReleaseBitstreamBuffer = (int32_t (*)(PP_Resource video_decoder, uint32_t buffer_id))&Pnacl_M69_PPB_VideoDecoderPipeline_Dev_ReleaseBitstreamBuffer
+};
+
+static const struct PPB_VideoEncoderStream_Dev_0_1 Pnacl_Wrappers_PPB_VideoEncoderStream_Dev_0_1 = {
+    .GetBitstreamBuffers = (int32_t (*)(PP_Resource video_encoder, struct PP_BitstreamBuffer buffers[], uint32_t max_buffers, struct PP_CompletionCallback callback))&Pnacl_M69_PPB_VideoEncoderStream_Dev_GetBitstreamBuffers,
+    .GetStats = (int32_t (*)(PP_Resource video_encoder, struct PP_VideoEncoderStats_Dev* stats))&Pnacl_M69_PPB_VideoEncoderStream_Dev_GetStats
+};
+
 /* Not generating wrapper interface for PPB_View_Dev_0_1 */
 
 /* Not generating wrapper interface for PPP_NetworkState_Dev_0_1 */
@@ -6070,6 +6227,12 @@ static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_FileChooser_Dev_0_6 = {
   .real_iface = NULL
 };
 
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1 = {
+  .iface_macro = PPB_FILEIO_DEV_INTERFACE_0_1,
+  .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_FileIO_Dev_0_1,
+  .real_iface = NULL
+};
+
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_1 = {
   .iface_macro = PPB_IME_INPUT_EVENT_DEV_INTERFACE_0_1,
   .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_IMEInputEvent_Dev_0_1,
@@ -6082,6 +6245,12 @@ static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_2 = {
   .real_iface = NULL
 };
 
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_MediaStreamVideoTrack_Dev_0_1 = {
+  .iface_macro = PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE_0_1,
+  .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_MediaStreamVideoTrack_Dev_0_1,
+  .real_iface = NULL
+};
+
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_Printing_Dev_0_7 = {
   .iface_macro = PPB_PRINTING_DEV_INTERFACE_0_7,
   .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_Printing_Dev_0_7,
@@ -6094,6 +6263,12 @@ static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_TrueTypeFont_Dev_0_1 = {
   .real_iface = NULL
 };
 
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_UDPSocket_Dev_0_1 = {
+  .iface_macro = PPB_UDPSOCKET_DEV_INTERFACE_0_1,
+  .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_UDPSocket_Dev_0_1,
+  .real_iface = NULL
+};
+
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_URLUtil_Dev_0_6 = {
   .iface_macro = PPB_URLUTIL_DEV_INTERFACE_0_6,
   .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_URLUtil_Dev_0_6,
@@ -6118,6 +6293,18 @@ static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoDecoder_Dev_0_16 = {
   .real_iface = NULL
 };
 
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1 = {
+  .iface_macro = PPB_VIDEODECODERPIPELINE_DEV_INTERFACE_0_1,
+  .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_VideoDecoderPipeline_Dev_0_1,
+  .real_iface = NULL
+};
+
+static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_VideoEncoderStream_Dev_0_1 = {
+  .iface_macro = PPB_VIDEOENCODERSTREAM_DEV_INTERFACE_0_1,
+  .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_VideoEncoderStream_Dev_0_1,
+  .real_iface = NULL
+};
+
 static struct __PnaclWrapperInfo Pnacl_WrapperInfo_PPB_CameraDevice_Private_0_1 = {
   .iface_macro = PPB_CAMERADEVICE_PRIVATE_INTERFACE_0_1,
   .wrapped_iface = (const void *) &Pnacl_Wrappers_PPB_CameraDevice_Private_0_1,
@@ -6377,14 +6564,19 @@ static struct __PnaclWrapperInfo *s_ppb_wrappers[] = {
   &Pnacl_WrapperInfo_PPB_DeviceRef_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_FileChooser_Dev_0_5,
   &Pnacl_WrapperInfo_PPB_FileChooser_Dev_0_6,
+  &Pnacl_WrapperInfo_PPB_FileIO_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_IMEInputEvent_Dev_0_2,
+  &Pnacl_WrapperInfo_PPB_MediaStreamVideoTrack_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_Printing_Dev_0_7,
   &Pnacl_WrapperInfo_PPB_TrueTypeFont_Dev_0_1,
+  &Pnacl_WrapperInfo_PPB_UDPSocket_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_URLUtil_Dev_0_6,
   &Pnacl_WrapperInfo_PPB_URLUtil_Dev_0_7,
   &Pnacl_WrapperInfo_PPB_VideoCapture_Dev_0_3,
   &Pnacl_WrapperInfo_PPB_VideoDecoder_Dev_0_16,
+  &Pnacl_WrapperInfo_PPB_VideoDecoderPipeline_Dev_0_1,
+  &Pnacl_WrapperInfo_PPB_VideoEncoderStream_Dev_0_1,
   &Pnacl_WrapperInfo_PPB_CameraDevice_Private_0_1,
   &Pnacl_WrapperInfo_PPB_DisplayColorProfile_Private_0_1,
   &Pnacl_WrapperInfo_PPB_Ext_CrxFileSystem_Private_0_1,
@@ -333,6 +333,10 @@ int32_t AudioInputResource::CommonOpen(
                                                                       true);
   if (enter_config.failed())
     return PP_ERROR_BADARGUMENT;
+  // Capture only delivers 16-bit samples.
+  if (enter_config.object()->GetSampleFormat() !=
+      PP_AUDIOSAMPLEFORMAT_DEV_INT16)
+    return PP_ERROR_NOTSUPPORTED;
 
   config_ = config;
   audio_input_callback_0_3_ = audio_input_callback_0_3;
@@ -14,6 +14,7 @@
 #include "ppapi/proxy/ppapi_messages.h"
 #include "ppapi/proxy/resource_message_params.h"
 #include "ppapi/proxy/serialized_handle.h"
+#include "ppapi/shared_impl/audio_sample_conversion.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 #include "ppapi/shared_impl/ppb_audio_config_shared.h"
 #include "ppapi/shared_impl/resource_tracker.h"
@@ -35,6 +36,7 @@ AudioOutputResource::AudioOutputResource(Connection connection,
       enumeration_helper_(this),
       bytes_per_second_(0),
       sample_frame_count_(0),
+      sample_format_(PP_AUDIOSAMPLEFORMAT_DEV_INT16),
       client_buffer_size_bytes_(0) {
   SendCreate(RENDERER, PpapiHostMsg_AudioOutput_Create());
 }
@@ -189,9 +191,9 @@ void AudioOutputResource::SetStreamInfo(
   audio_bus_ = media::AudioBus::WrapMemory(kAudioOutputChannels,
                                            sample_frame_count_, buffer->audio);
 
-  // Setup integer audio buffer for user audio data
+  // Setup the interleaved buffer for user audio data.
   client_buffer_size_bytes_ = audio_bus_->frames() * audio_bus_->channels() *
-                              kBitsPerAudioOutputSample / 8;
+                              BytesPerAudioSample(sample_format_);
   client_buffer_.reset(new uint8_t[client_buffer_size_bytes_]);
 }
 
@@ -253,8 +255,8 @@ void AudioOutputResource::Run() {
     }
 
     // Deinterleave the audio data into the shared memory as floats.
-    audio_bus_->FromInterleaved(client_buffer_.get(), audio_bus_->frames(),
-                                kBitsPerAudioOutputSample / 8);
+    DeinterleaveToAudioBus(client_buffer_.get(), sample_format_,
+                           audio_bus_.get());
 
     // Inform other side that we have read the data from the shared memory.
     // Let the other end know which buffer we just filled.  The buffer index is
@@ -302,7 +304,9 @@ int32_t AudioOutputResource::CommonOpen(
   audio_output_callback_ = audio_output_callback;
   user_data_ = user_data;
   open_callback_ = callback;
-  bytes_per_second_ = kAudioOutputChannels * (kBitsPerAudioOutputSample / 8) *
+  sample_format_ = enter_config.object()->GetSampleFormat();
+  bytes_per_second_ = kAudioOutputChannels *
+                      BytesPerAudioSample(sample_format_) *
                       enter_config.object()->GetSampleRate();
   sample_frame_count_ = enter_config.object()->GetSampleFrameCount();
 
@@ -16,6 +16,7 @@
 #include "base/memory/unsafe_shared_memory_region.h"
 #include "base/sync_socket.h"
 #include "base/threading/simple_thread.h"
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/proxy/device_enumeration_resource_helper.h"
 #include "ppapi/proxy/plugin_resource.h"
@@ -135,7 +136,10 @@ class AudioOutputResource : public PluginResource,
   std::unique_ptr<media::AudioBus> audio_bus_;
   int sample_frame_count_;
 
-  // Internal buffer for client's integer audio data.
+  // Format of the samples in |client_buffer_|.
+  PP_AudioSampleFormat_Dev sample_format_;
+
+  // Internal buffer for client's interleaved audio data.
   int client_buffer_size_bytes_;
   std::unique_ptr<uint8_t[]> client_buffer_;
 
@@ -0,0 +1,47 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/proxy/byte_chunk_queue.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace ppapi {
+namespace proxy {
+
+ByteChunkQueue::ByteChunkQueue() : front_offset_(0), size_(0) {}
+
+ByteChunkQueue::~ByteChunkQueue() {}
+
+void ByteChunkQueue::Append(const char* data, size_t length) {
+  if (!length)
+    return;
+  chunks_.emplace_back(data, length);
+  size_ += length;
+}
+
+size_t ByteChunkQueue::Read(char* out, size_t max_length) {
+  size_t total = 0;
+  while (total < max_length && !chunks_.empty()) {
+    const std::string& front = chunks_.front();
+    DCHECK_LT(front_offset_, front.size());
+    size_t to_copy =
+        std::min(front.size() - front_offset_, max_length - total);
+    memcpy(out + total, front.data() + front_offset_, to_copy);
+    total += to_copy;
+    front_offset_ += to_copy;
+    if (front_offset_ == front.size()) {
+      chunks_.pop_front();
+      front_offset_ = 0;
+    }
+  }
+  size_ -= total;
+  return total;
+}
+
+}  // namespace proxy
+}  // namespace ppapi
@@ -0,0 +1,53 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_PROXY_BYTE_CHUNK_QUEUE_H_
+#define PPAPI_PROXY_BYTE_CHUNK_QUEUE_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "ppapi/proxy/ppapi_proxy_export.h"
+
+namespace ppapi {
+namespace proxy {
+
+// A FIFO of bytes that keeps data in the chunks it was appended in, so that
+// appending and reading are each a single memcpy per chunk rather than work
+// per byte. Used to buffer streamed data (e.g. URL response bodies) until the
+// plugin reads it.
+class PPAPI_PROXY_EXPORT ByteChunkQueue {
+ public:
+  ByteChunkQueue();
+  ~ByteChunkQueue();
+
+  // Copies |length| bytes from |data| to the end of the queue.
+  void Append(const char* data, size_t length);
+
+  // Moves up to |max_length| bytes from the front of the queue into |out|.
+  // Returns the number of bytes moved.
+  size_t Read(char* out, size_t max_length);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  base::circular_deque<std::string> chunks_;
+
+  // Number of bytes already read from the front chunk.
+  size_t front_offset_;
+
+  // Number of unread bytes in the queue.
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ByteChunkQueue);
+};
+
+}  // namespace proxy
+}  // namespace ppapi
+
+#endif  // PPAPI_PROXY_BYTE_CHUNK_QUEUE_H_
@@ -0,0 +1,101 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/containers/circular_deque.h"
+#include "base/format_macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "ppapi/proxy/byte_chunk_queue.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ppapi {
+namespace proxy {
+namespace {
+
+// The URLLoaderResource buffer before ByteChunkQueue, kept as the baseline.
+class DequeBuffer {
+ public:
+  void Append(const char* data, size_t length) {
+    buffer_.insert(buffer_.end(), data, data + length);
+  }
+
+  size_t Read(char* out, size_t max_length) {
+    size_t bytes_to_copy = std::min(buffer_.size(), max_length);
+    std::copy(buffer_.begin(), buffer_.begin() + bytes_to_copy, out);
+    buffer_.erase(buffer_.begin(), buffer_.begin() + bytes_to_copy);
+    return bytes_to_copy;
+  }
+
+  size_t size() const { return buffer_.size(); }
+
+ private:
+  base::circular_deque<char> buffer_;
+};
+
+int GetTotalMegabytes() {
+  int megabytes = 256;
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line && command_line->HasSwitch("megabytes")) {
+    base::StringToInt(command_line->GetSwitchValueASCII("megabytes"),
+                      &megabytes);
+  }
+  return megabytes;
+}
+
+// Streams the given amount of data through |buffer| the way URLLoaderResource
+// does: chunks arrive from the renderer (32K each, like the renderer's data
+// messages) and the plugin reads them out in |read_size| pieces, keeping at
+// most a few chunks buffered.
+template <typename BufferT>
+void Stream(const char* name, size_t read_size) {
+  const size_t kChunkSize = 32 * 1024;
+  const size_t kMaxBuffered = 4 * kChunkSize;
+  size_t total = static_cast<size_t>(GetTotalMegabytes()) * 1024 * 1024;
+  std::string chunk(kChunkSize, 'x');
+  std::vector<char> out(read_size);
+  BufferT buffer;
+
+  base::PerfTimeLogger logger(
+      base::StringPrintf("ByteChunkQueuePerfTest.%s_%" PRIuS "ByteReads",
+                         name, read_size)
+          .c_str());
+  size_t received = 0;
+  size_t read = 0;
+  while (read < total) {
+    while (received < total && buffer.size() < kMaxBuffered) {
+      buffer.Append(chunk.data(), chunk.size());
+      received += chunk.size();
+    }
+    read += buffer.Read(out.data(), out.size());
+  }
+  logger.Done();
+  EXPECT_EQ(total, read);
+}
+
+const size_t kReadSizes[] = {4 * 1024, 64 * 1024, 1024 * 1024};
+
+}  // namespace
+
+// Measures URL body buffering throughput with the chunked queue.
+TEST(ByteChunkQueuePerfTest, ChunkQueue) {
+  for (size_t read_size : kReadSizes)
+    Stream<ByteChunkQueue>("ChunkQueue", read_size);
+}
+
+// Same as above with the per-byte deque URLLoaderResource used before.
+TEST(ByteChunkQueuePerfTest, CircularDeque) {
+  for (size_t read_size : kReadSizes)
+    Stream<DequeBuffer>("CircularDeque", read_size);
+}
+
+}  // namespace proxy
+}  // namespace ppapi
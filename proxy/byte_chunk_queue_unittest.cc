@@ -0,0 +1,45 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/proxy/byte_chunk_queue.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ppapi {
+namespace proxy {
+
+TEST(ByteChunkQueueTest, ReadAcrossChunks) {
+  ByteChunkQueue queue;
+  EXPECT_TRUE(queue.empty());
+  queue.Append("abc", 3);
+  queue.Append("", 0);
+  queue.Append("defgh", 5);
+  EXPECT_EQ(8u, queue.size());
+
+  char out[8];
+  // Part of the first chunk.
+  EXPECT_EQ(2u, queue.Read(out, 2));
+  EXPECT_EQ("ab", std::string(out, 2));
+  EXPECT_EQ(6u, queue.size());
+
+  // The rest of the first chunk and part of the second.
+  EXPECT_EQ(4u, queue.Read(out, 4));
+  EXPECT_EQ("cdef", std::string(out, 4));
+
+  // Asking for more than is buffered returns what's there.
+  EXPECT_EQ(2u, queue.Read(out, sizeof(out)));
+  EXPECT_EQ("gh", std::string(out, 2));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.Read(out, sizeof(out)));
+
+  // The queue is usable again after being drained.
+  queue.Append("ij", 2);
+  EXPECT_EQ(2u, queue.Read(out, sizeof(out)));
+  EXPECT_EQ("ij", std::string(out, 2));
+}
+
+}  // namespace proxy
+}  // namespace ppapi
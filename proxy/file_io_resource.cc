@@ -8,7 +8,9 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/task_runner_util.h"
+#include "build/build_config.h"
 #include "ipc/ipc_message.h"
 #include "ppapi/c/pp_errors.h"
 #include "ppapi/proxy/ppapi_messages.h"
@@ -23,6 +25,12 @@
 #include "ppapi/thunk/ppb_file_ref_api.h"
 #include "ppapi/thunk/ppb_file_system_api.h"
 
+#if defined(OS_LINUX)
+#include <sys/uio.h>
+
+#include "base/posix/eintr_wrapper.h"
+#endif
+
 using ppapi::thunk::EnterResourceNoLock;
 using ppapi::thunk::PPB_FileIO_API;
 using ppapi::thunk::PPB_FileRef_API;
@@ -36,6 +44,20 @@ namespace {
 // or write.
 static const int32_t kMaxReadWriteSize = 32 * 1024 * 1024;  // 32MB
 
+// The most reads and writes that may be pending at once when concurrent
+// operations are enabled.
+static const uint32_t kMaxPendingOperations = 64;
+
+// Reads whose destination isn't known up front go through pooled buffers. Up
+// to this many, of up to this many bytes in total, are kept for reuse by all
+// the FileIOs in the process.
+static const size_t kMaxPooledReadBuffers = 4;
+static const int32_t kMaxPooledReadBytes = 16 * 1024 * 1024;  // 16MB
+
+// The most segments a ReadV() or WriteV() may have. This is IOV_MAX on Linux,
+// so each one maps onto a single preadv() or pwritev().
+static const uint32_t kMaxSegments = 1024;
+
 // An adapter to let Read() share the same implementation with ReadToArray().
 void* DummyGetDataBuffer(void* user_data, uint32_t count, uint32_t size) {
   return user_data;
@@ -45,6 +67,143 @@ void* DummyGetDataBuffer(void* user_data, uint32_t count, uint32_t size) {
 void DoClose(base::File auto_close_file) {
 }
 
+std::vector<PP_FileIOSegment_Dev> SingleSegment(const char* buffer,
+                                                int32_t size) {
+  std::vector<PP_FileIOSegment_Dev> segments(1);
+  segments[0].buffer = const_cast<char*>(buffer);
+  segments[0].size = size;
+  return segments;
+}
+
+// Copies the ReadV() or WriteV() |segments| into |validated|, leaving out empty
+// ones and trimming them to |max_size| bytes in all, which are returned in
+// |total_size|.
+int32_t ValidateSegments(const PP_FileIOSegment_Dev segments[],
+                         uint32_t segment_count,
+                         int32_t max_size,
+                         std::vector<PP_FileIOSegment_Dev>* validated,
+                         int32_t* total_size) {
+  if (!segments || segment_count == 0 || segment_count > kMaxSegments)
+    return PP_ERROR_BADARGUMENT;
+  *total_size = 0;
+  for (uint32_t i = 0; i < segment_count; ++i) {
+    if (segments[i].size < 0 || (segments[i].size > 0 && !segments[i].buffer))
+      return PP_ERROR_BADARGUMENT;
+    int32_t size = std::min(segments[i].size, max_size - *total_size);
+    if (size == 0)
+      continue;
+    validated->push_back(segments[i]);
+    validated->back().size = size;
+    *total_size += size;
+  }
+  return PP_OK;
+}
+
+// Reads into |segments| in order, starting at |offset|. Returns the number of
+// bytes read, which is less than their total size at the end of the file, or
+// -1 on error.
+int32_t ReadSegments(base::File* file,
+                     int64_t offset,
+                     const std::vector<PP_FileIOSegment_Dev>& segments) {
+#if defined(OS_LINUX)
+  if (segments.size() > 1) {
+    std::vector<struct iovec> iov(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+      iov[i].iov_base = segments[i].buffer;
+      iov[i].iov_len = segments[i].size;
+    }
+    return static_cast<int32_t>(HANDLE_EINTR(preadv(
+        file->GetPlatformFile(), &iov[0], static_cast<int>(iov.size()),
+        offset)));
+  }
+#endif
+  int32_t total = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    int32_t result = file->Read(offset + total,
+                                static_cast<char*>(segments[i].buffer),
+                                segments[i].size);
+    if (result < 0)
+      return total > 0 ? total : result;
+    total += result;
+    if (result < segments[i].size)
+      break;
+  }
+  return total;
+}
+
+// Writes |segments| in order, starting at |offset| or, if |append| is true, at
+// the end of the file. Returns the number of bytes written, or -1 on error.
+int32_t WriteSegments(base::File* file,
+                      int64_t offset,
+                      bool append,
+                      const std::vector<PP_FileIOSegment_Dev>& segments) {
+#if defined(OS_LINUX)
+  if (segments.size() > 1) {
+    std::vector<struct iovec> iov(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+      iov[i].iov_base = segments[i].buffer;
+      iov[i].iov_len = segments[i].size;
+    }
+    // Appends go through writev(), as Linux's pwritev() ignores the offset of
+    // a file opened for appending.
+    int iov_count = static_cast<int>(iov.size());
+    if (append) {
+      return static_cast<int32_t>(HANDLE_EINTR(
+          writev(file->GetPlatformFile(), &iov[0], iov_count)));
+    }
+    return static_cast<int32_t>(HANDLE_EINTR(
+        pwritev(file->GetPlatformFile(), &iov[0], iov_count, offset)));
+  }
+#endif
+  int32_t total = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const char* data = static_cast<const char*>(segments[i].buffer);
+    // In append mode, we can't call Write, since NaCl doesn't implement fcntl,
+    // causing the function to call pwrite, which is incorrect.
+    int32_t result =
+        append ? file->WriteAtCurrentPos(data, segments[i].size)
+               : file->Write(offset + total, data, segments[i].size);
+    if (result < 0)
+      return total > 0 ? total : result;
+    total += result;
+    if (result < segments[i].size)
+      break;
+  }
+  return total;
+}
+
+// Copies |segments|, which hold |size| bytes in all, into one buffer.
+std::unique_ptr<char[]> GatherSegments(
+    const std::vector<PP_FileIOSegment_Dev>& segments,
+    int32_t size) {
+  std::unique_ptr<char[]> buffer(new char[size]);
+  int32_t position = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    memcpy(buffer.get() + position, segments[i].buffer, segments[i].size);
+    position += segments[i].size;
+  }
+  DCHECK_EQ(size, position);
+  return buffer;
+}
+
+// Returns the range, with an exclusive |end|, that a read or write of |size|
+// bytes at |offset| occupies in the conflict queue. Appends and invalid
+// offsets are ordered against everything.
+void GetOperationRange(int64_t offset,
+                       int64_t size,
+                       bool append,
+                       int64_t* start,
+                       int64_t* end) {
+  const int64_t kMaxOffset = std::numeric_limits<int64_t>::max();
+  if (append || offset < 0) {
+    *start = 0;
+    *end = kMaxOffset;
+  } else {
+    *start = offset;
+    *end = size > kMaxOffset - offset ? kMaxOffset : offset + size;
+  }
+}
+
 }  // namespace
 
 namespace ppapi {
@@ -62,22 +221,105 @@ int32_t FileIOResource::QueryOp::DoWork() {
   return file_holder_->file()->GetInfo(&file_info_) ? PP_OK : PP_ERROR_FAILED;
 }
 
-FileIOResource::ReadOp::ReadOp(scoped_refptr<FileHolder> file_holder,
-                               int64_t offset,
-                               int32_t bytes_to_read)
+FileIOResource::ReadBufferPool::Buffer::Buffer() : capacity(0) {}
+
+FileIOResource::ReadBufferPool::Buffer::Buffer(Buffer&& other) = default;
+
+FileIOResource::ReadBufferPool::Buffer::~Buffer() {}
+
+FileIOResource::ReadBufferPool::Buffer&
+FileIOResource::ReadBufferPool::Buffer::operator=(Buffer&& other) = default;
+
+FileIOResource::ReadBufferPool::ReadBufferPool() : total_capacity_(0) {}
+
+FileIOResource::ReadBufferPool::~ReadBufferPool() {}
+
+// static
+FileIOResource::ReadBufferPool* FileIOResource::ReadBufferPool::Get() {
+  // Leaked, since reads may still be returning buffers at shutdown.
+  static ReadBufferPool* pool = new ReadBufferPool;
+  return pool;
+}
+
+std::unique_ptr<char[]> FileIOResource::ReadBufferPool::Take(
+    int32_t size,
+    int32_t* capacity) {
+  {
+    base::AutoLock acquire(lock_);
+    // Use the smallest buffer that is big enough.
+    size_t best = buffers_.size();
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+      if (buffers_[i].capacity >= size &&
+          (best == buffers_.size() ||
+           buffers_[i].capacity < buffers_[best].capacity)) {
+        best = i;
+      }
+    }
+    if (best != buffers_.size()) {
+      std::unique_ptr<char[]> data = std::move(buffers_[best].data);
+      *capacity = buffers_[best].capacity;
+      total_capacity_ -= *capacity;
+      buffers_.erase(buffers_.begin() + best);
+      return data;
+    }
+  }
+  *capacity = size;
+  return std::unique_ptr<char[]>(new char[size]);
+}
+
+void FileIOResource::ReadBufferPool::Return(std::unique_ptr<char[]> buffer,
+                                            int32_t capacity) {
+  if (capacity > kMaxPooledReadBytes)
+    return;
+  base::AutoLock acquire(lock_);
+  Buffer pooled;
+  pooled.data = std::move(buffer);
+  pooled.capacity = capacity;
+  buffers_.push_back(std::move(pooled));
+  total_capacity_ += capacity;
+  // Drop the oldest buffers when over the limits.
+  while (buffers_.size() > kMaxPooledReadBuffers ||
+         total_capacity_ > kMaxPooledReadBytes) {
+    total_capacity_ -= buffers_.front().capacity;
+    buffers_.erase(buffers_.begin());
+  }
+}
+
+FileIOResource::ReadOp::ReadOp(
+    scoped_refptr<FileHolder> file_holder,
+    int64_t offset,
+    int32_t bytes_to_read,
+    const std::vector<PP_FileIOSegment_Dev>& segments)
   : file_holder_(file_holder),
     offset_(offset),
-    bytes_to_read_(bytes_to_read) {
+    bytes_to_read_(bytes_to_read),
+    segments_(segments),
+    buffer_capacity_(0),
+    cancelled_(false) {
   DCHECK(file_holder_.get());
 }
 
 FileIOResource::ReadOp::~ReadOp() {
+  if (buffer_.get())
+    ReadBufferPool::Get()->Return(std::move(buffer_), buffer_capacity_);
 }
 
 int32_t FileIOResource::ReadOp::DoWork() {
-  DCHECK(!buffer_.get());
-  buffer_.reset(new char[bytes_to_read_]);
-  return file_holder_->file()->Read(offset_, buffer_.get(), bytes_to_read_);
+  if (segments_.empty()) {
+    DCHECK(!buffer_.get());
+    buffer_ = ReadBufferPool::Get()->Take(bytes_to_read_, &buffer_capacity_);
+    return file_holder_->file()->Read(offset_, buffer_.get(), bytes_to_read_);
+  }
+
+  base::AutoLock acquire(read_lock_);
+  if (cancelled_)
+    return PP_ERROR_ABORTED;
+  return ReadSegments(file_holder_->file(), offset_, segments_);
+}
+
+void FileIOResource::ReadOp::Cancel() {
+  base::AutoLock acquire(read_lock_);
+  cancelled_ = true;
 }
 
 FileIOResource::WriteOp::WriteOp(scoped_refptr<FileHolder> file_holder,
@@ -105,6 +347,20 @@ int32_t FileIOResource::WriteOp::DoWork() {
   }
 }
 
+FileIOResource::ScheduledOp::ScheduledOp()
+    : id(0), offset(0), end(0), is_write(false) {}
+
+FileIOResource::ScheduledOp::ScheduledOp(const ScheduledOp& other) = default;
+
+FileIOResource::ScheduledOp::~ScheduledOp() {}
+
+bool FileIOResource::ScheduledOp::ConflictsWith(
+    const ScheduledOp& other) const {
+  if (!is_write && !other.is_write)
+    return false;
+  return offset < other.end && other.offset < end;
+}
+
 FileIOResource::FileIOResource(Connection connection, PP_Instance instance)
     : PluginResource(connection, instance),
       file_system_type_(PP_FILESYSTEMTYPE_INVALID),
@@ -112,7 +368,9 @@ FileIOResource::FileIOResource(Connection connection, PP_Instance instance)
       max_written_offset_(0),
       append_mode_write_amount_(0),
       check_quota_(false),
-      called_close_(false) {
+      called_close_(false),
+      next_op_id_(0),
+      next_file_task_runner_(0) {
   SendCreate(BROWSER, PpapiHostMsg_FileIO_Create());
 }
 
@@ -249,7 +507,8 @@ int32_t FileIOResource::Read(int64_t offset,
   PP_ArrayOutput output_adapter;
   output_adapter.GetDataBuffer = &DummyGetDataBuffer;
   output_adapter.user_data = buffer;
-  return ReadValidated(offset, bytes_to_read, output_adapter, callback);
+  return ReadValidated(offset, bytes_to_read, output_adapter, buffer,
+                       callback);
 }
 
 int32_t FileIOResource::ReadToArray(int64_t offset,
@@ -262,7 +521,8 @@ int32_t FileIOResource::ReadToArray(int64_t offset,
   if (rv != PP_OK)
     return rv;
 
-  return ReadValidated(offset, max_read_length, *array_output, callback);
+  return ReadValidated(offset, max_read_length, *array_output, NULL,
+                       callback);
 }
 
 int32_t FileIOResource::Write(int64_t offset,
@@ -281,6 +541,15 @@ int32_t FileIOResource::Write(int64_t offset,
   if (rv != PP_OK)
     return rv;
 
+  return WriteWithQuota(offset, SingleSegment(buffer, bytes_to_write),
+                        bytes_to_write, callback);
+}
+
+int32_t FileIOResource::WriteWithQuota(
+    int64_t offset,
+    const std::vector<PP_FileIOSegment_Dev>& segments,
+    int32_t bytes_to_write,
+    scoped_refptr<TrackedCallback> callback) {
   state_manager_.SetPendingOperation(FileIOStateManager::OPERATION_WRITE);
 
   if (check_quota_) {
@@ -290,7 +559,7 @@ int32_t FileIOResource::Write(int64_t offset,
     if (append) {
       increase = bytes_to_write;
     } else {
-      uint64_t max_offset = offset + bytes_to_write;
+      max_offset = offset + bytes_to_write;
       if (max_offset >
           static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
         return PP_ERROR_FAILED;  // amount calculation would overflow.
@@ -299,22 +568,36 @@ int32_t FileIOResource::Write(int64_t offset,
     }
 
     if (increase > 0) {
-      // Request a quota reservation. This makes the Write asynchronous, so we
-      // must copy the plugin's buffer.
-      std::unique_ptr<char[]> copy(new char[bytes_to_write]);
-      memcpy(copy.get(), buffer, bytes_to_write);
-      int64_t result =
-          file_system_resource_->AsPPB_FileSystem_API()->RequestQuota(
-              increase,
-              base::Bind(&FileIOResource::OnRequestWriteQuotaComplete,
-                         this,
-                         offset,
-                         base::Passed(&copy),
-                         bytes_to_write,
-                         callback));
-      if (result == PP_OK_COMPLETIONPENDING)
-        return PP_OK_COMPLETIONPENDING;
-      DCHECK(result == increase);
+      PPB_FileSystem_API* file_system_api =
+          file_system_resource_->AsPPB_FileSystem_API();
+      // The file system reserves quota ahead of demand, so this usually
+      // succeeds without waiting for the host.
+      if (!file_system_api->ConsumeReservedQuota(increase)) {
+        // Request a quota reservation. This makes the Write asynchronous, so
+        // we must copy the plugin's buffer.
+        std::unique_ptr<char[]> copy =
+            GatherSegments(segments, bytes_to_write);
+        // Take the write's place among concurrent reads and writes now, so
+        // that later overlapping ones wait for it rather than for the quota.
+        uint32_t op_id = 0;
+        if (state_manager_.concurrent_read_write() && !callback->is_blocking())
+          op_id = ScheduleFileOperation(offset, bytes_to_write, true, append,
+                                        callback);
+        int64_t result = file_system_api->RequestQuota(
+            increase,
+            base::Bind(&FileIOResource::OnRequestWriteQuotaComplete,
+                       this,
+                       op_id,
+                       offset,
+                       base::Passed(&copy),
+                       bytes_to_write,
+                       callback));
+        if (result == PP_OK_COMPLETIONPENDING)
+          return PP_OK_COMPLETIONPENDING;
+        DCHECK(result == increase);
+        if (op_id)
+          CancelFileOperation(op_id);
+      }
 
       if (append)
         append_mode_write_amount_ += bytes_to_write;
@@ -322,7 +605,7 @@ int32_t FileIOResource::Write(int64_t offset,
         max_written_offset_ = max_offset;
     }
   }
-  return WriteValidated(offset, buffer, bytes_to_write, callback);
+  return WriteValidated(offset, segments, bytes_to_write, callback);
 }
 
 int32_t FileIOResource::SetLength(int64_t length,
@@ -403,6 +686,7 @@ void FileIOResource::Close() {
 
   if (file_holder_.get())
     file_holder_ = NULL;
+  mappings_.clear();
 
   Post(BROWSER, PpapiHostMsg_FileIO_Close(
       FileGrowth(max_written_offset_, append_mode_write_amount_)));
@@ -425,6 +709,150 @@ int32_t FileIOResource::RequestOSFileHandle(
   return PP_OK_COMPLETIONPENDING;
 }
 
+int32_t FileIOResource::SetMaxPendingOperations(
+    uint32_t max_pending_operations) {
+  if (max_pending_operations > kMaxPendingOperations)
+    return PP_ERROR_BADARGUMENT;
+  if (state_manager_.get_pending_operation() !=
+      FileIOStateManager::OPERATION_NONE) {
+    return PP_ERROR_INPROGRESS;
+  }
+  state_manager_.SetConcurrentReadWrite(
+      static_cast<int>(max_pending_operations));
+  return PP_OK;
+}
+
+int32_t FileIOResource::MapRange(int64_t offset,
+                                 int64_t length,
+                                 void** address) {
+  if (!address)
+    return PP_ERROR_BADARGUMENT;
+  *address = NULL;
+  if (!FileHolder::IsValid(file_holder_))
+    return PP_ERROR_FAILED;
+  if (!(open_flags_ & PP_FILEOPENFLAG_READ))
+    return PP_ERROR_NOACCESS;
+  if (offset < 0 || length <= 0 ||
+      static_cast<uint64_t>(length) > std::numeric_limits<size_t>::max()) {
+    return PP_ERROR_BADARGUMENT;
+  }
+
+  int64_t file_length = file_holder_->file()->GetLength();
+  if (file_length < 0)
+    return PP_ERROR_FAILED;
+  if (offset > file_length || length > file_length - offset)
+    return PP_ERROR_BADARGUMENT;
+
+  // The mapping keeps its own handle to the file, so that it outlives any
+  // pending operation's use of |file_holder_|.
+  base::File file = file_holder_->file()->Duplicate();
+  if (!file.IsValid())
+    return PP_ERROR_FAILED;
+  base::MemoryMappedFile::Region region;
+  region.offset = offset;
+  region.size = static_cast<size_t>(length);
+  std::unique_ptr<base::MemoryMappedFile> mapping(new base::MemoryMappedFile);
+  if (!mapping->Initialize(std::move(file), region))
+    return PP_ERROR_FAILED;
+
+  *address = const_cast<uint8_t*>(mapping->data());
+  mappings_.push_back(std::move(mapping));
+  return PP_OK;
+}
+
+int32_t FileIOResource::UnmapRange(void* address) {
+  for (size_t i = 0; i < mappings_.size(); ++i) {
+    if (mappings_[i]->data() == address) {
+      mappings_.erase(mappings_.begin() + i);
+      return PP_OK;
+    }
+  }
+  return PP_ERROR_BADARGUMENT;
+}
+
+int32_t FileIOResource::ReadV(int64_t offset,
+                              const PP_FileIOSegment_Dev segments[],
+                              uint32_t segment_count,
+                              scoped_refptr<TrackedCallback> callback) {
+  int32_t rv = state_manager_.CheckOperationState(
+      FileIOStateManager::OPERATION_READ, true);
+  if (rv != PP_OK)
+    return rv;
+
+  std::vector<PP_FileIOSegment_Dev> validated;
+  int32_t bytes_to_read = 0;
+  rv = ValidateSegments(segments, segment_count, kMaxReadWriteSize, &validated,
+                        &bytes_to_read);
+  if (rv != PP_OK)
+    return rv;
+  if (!FileHolder::IsValid(file_holder_))
+    return PP_ERROR_FAILED;
+  if (validated.empty())
+    return 0;
+
+  state_manager_.SetPendingOperation(FileIOStateManager::OPERATION_READ);
+
+  if (callback->is_blocking()) {
+    uint32_t op_id = 0;
+    if (!BeginBlockingOperation(offset, bytes_to_read, false, false, &op_id)) {
+      state_manager_.SetOperationFinished();
+      return PP_ERROR_INPROGRESS;
+    }
+    int32_t result;
+    // The plugin could release its reference to this instance when we release
+    // the proxy lock below.
+    scoped_refptr<FileIOResource> protect(this);
+    {
+      // Release the proxy lock while making a potentially slow file call.
+      ProxyAutoUnlock unlock;
+      result = ReadSegments(file_holder_->file(), offset, validated);
+    }
+    if (result < 0)
+      result = PP_ERROR_FAILED;
+    FinishBlockingOperation(op_id);
+    state_manager_.SetOperationFinished();
+    return result;
+  }
+
+  // For the non-blocking case, post a task to the file thread that reads
+  // straight into the segments, which stay valid until the callback runs. As
+  // for Read(), an aborted callback waits for a read that is still running.
+  scoped_refptr<ReadOp> read_op(new ReadOp(file_holder_, offset, bytes_to_read,
+                                           validated));
+  PostFileOperation(offset, bytes_to_read, false, false,
+                    Bind(&FileIOResource::ReadOp::DoWork, read_op), callback);
+  PP_ArrayOutput unused_output = {NULL, NULL};
+  callback->set_completion_task(
+      Bind(&FileIOResource::OnReadComplete, this, read_op, unused_output));
+
+  return PP_OK_COMPLETIONPENDING;
+}
+
+int32_t FileIOResource::WriteV(int64_t offset,
+                               const PP_FileIOSegment_Dev segments[],
+                               uint32_t segment_count,
+                               scoped_refptr<TrackedCallback> callback) {
+  std::vector<PP_FileIOSegment_Dev> validated;
+  int32_t bytes_to_write = 0;
+  int32_t rv = ValidateSegments(segments, segment_count, kMaxReadWriteSize,
+                                &validated, &bytes_to_write);
+  if (rv != PP_OK)
+    return rv;
+  if (offset < 0)
+    return PP_ERROR_FAILED;
+  if (!FileHolder::IsValid(file_holder_))
+    return PP_ERROR_FAILED;
+
+  rv = state_manager_.CheckOperationState(
+      FileIOStateManager::OPERATION_WRITE, true);
+  if (rv != PP_OK)
+    return rv;
+  if (validated.empty())
+    return 0;
+
+  return WriteWithQuota(offset, validated, bytes_to_write, callback);
+}
+
 FileIOResource::FileHolder::FileHolder(PP_FileHandle file_handle)
     : file_(file_handle) {
 }
@@ -447,6 +875,7 @@ FileIOResource::FileHolder::~FileHolder() {
 int32_t FileIOResource::ReadValidated(int64_t offset,
                                       int32_t bytes_to_read,
                                       const PP_ArrayOutput& array_output,
+                                      char* buffer,
                                       scoped_refptr<TrackedCallback> callback) {
   if (bytes_to_read < 0)
     return PP_ERROR_FAILED;
@@ -457,31 +886,39 @@ int32_t FileIOResource::ReadValidated(int64_t offset,
 
   bytes_to_read = std::min(bytes_to_read, kMaxReadWriteSize);
   if (callback->is_blocking()) {
-    char* buffer = static_cast<char*>(
+    uint32_t op_id = 0;
+    if (!BeginBlockingOperation(offset, bytes_to_read, false, false, &op_id)) {
+      state_manager_.SetOperationFinished();
+      return PP_ERROR_INPROGRESS;
+    }
+    char* output_buffer = static_cast<char*>(
         array_output.GetDataBuffer(array_output.user_data, bytes_to_read, 1));
     int32_t result = PP_ERROR_FAILED;
     // The plugin could release its reference to this instance when we release
     // the proxy lock below.
     scoped_refptr<FileIOResource> protect(this);
-    if (buffer) {
+    if (output_buffer) {
       // Release the proxy lock while making a potentially slow file call.
       ProxyAutoUnlock unlock;
-      result = file_holder_->file()->Read(offset, buffer, bytes_to_read);
+      result = file_holder_->file()->Read(offset, output_buffer, bytes_to_read);
       if (result < 0)
         result = PP_ERROR_FAILED;
     }
+    FinishBlockingOperation(op_id);
     state_manager_.SetOperationFinished();
     return result;
   }
 
-  // For the non-blocking case, post a task to the file thread.
-  scoped_refptr<ReadOp> read_op(
-      new ReadOp(file_holder_, offset, bytes_to_read));
-  base::PostTaskAndReplyWithResult(
-      PpapiGlobals::Get()->GetFileTaskRunner(),
-      FROM_HERE,
-      Bind(&FileIOResource::ReadOp::DoWork, read_op),
-      RunWhileLocked(Bind(&TrackedCallback::Run, callback)));
+  // For the non-blocking case, post a task to the file thread. Read() has the
+  // caller's buffer, which must stay valid until the callback runs, so the
+  // data goes straight into it.
+  std::vector<PP_FileIOSegment_Dev> segments;
+  if (buffer)
+    segments = SingleSegment(buffer, bytes_to_read);
+  scoped_refptr<ReadOp> read_op(new ReadOp(file_holder_, offset, bytes_to_read,
+                                           segments));
+  PostFileOperation(offset, bytes_to_read, false, false,
+                    Bind(&FileIOResource::ReadOp::DoWork, read_op), callback);
   callback->set_completion_task(
       Bind(&FileIOResource::OnReadComplete, this, read_op, array_output));
 
@@ -490,45 +927,182 @@ int32_t FileIOResource::ReadValidated(int64_t offset,
 
 int32_t FileIOResource::WriteValidated(
     int64_t offset,
-    const char* buffer,
+    const std::vector<PP_FileIOSegment_Dev>& segments,
     int32_t bytes_to_write,
     scoped_refptr<TrackedCallback> callback) {
   bool append = (open_flags_ & PP_FILEOPENFLAG_APPEND) != 0;
   if (callback->is_blocking()) {
+    uint32_t op_id = 0;
+    if (!BeginBlockingOperation(offset, bytes_to_write, true, append, &op_id)) {
+      state_manager_.SetOperationFinished();
+      return PP_ERROR_INPROGRESS;
+    }
     int32_t result;
     {
       // Release the proxy lock while making a potentially slow file call.
       ProxyAutoUnlock unlock;
-      if (append) {
-        result = file_holder_->file()->WriteAtCurrentPos(buffer,
-                                                         bytes_to_write);
-      } else {
-        result = file_holder_->file()->Write(offset, buffer, bytes_to_write);
-      }
+      result = WriteSegments(file_holder_->file(), offset, append, segments);
     }
     if (result < 0)
       result = PP_ERROR_FAILED;
 
+    FinishBlockingOperation(op_id);
     state_manager_.SetOperationFinished();
     return result;
   }
 
   // For the non-blocking case, post a task to the file thread. We must copy the
-  // plugin's buffer at this point.
-  std::unique_ptr<char[]> copy(new char[bytes_to_write]);
-  memcpy(copy.get(), buffer, bytes_to_write);
+  // plugin's buffers at this point, and gathering them into one lets the file
+  // thread write them with a single call.
+  std::unique_ptr<char[]> copy = GatherSegments(segments, bytes_to_write);
   scoped_refptr<WriteOp> write_op(new WriteOp(
       file_holder_, offset, std::move(copy), bytes_to_write, append));
-  base::PostTaskAndReplyWithResult(
-      PpapiGlobals::Get()->GetFileTaskRunner(),
-      FROM_HERE,
-      Bind(&FileIOResource::WriteOp::DoWork, write_op),
-      RunWhileLocked(Bind(&TrackedCallback::Run, callback)));
+  PostFileOperation(offset, bytes_to_write, true, append,
+                    Bind(&FileIOResource::WriteOp::DoWork, write_op),
+                    callback);
   callback->set_completion_task(Bind(&FileIOResource::OnWriteComplete, this));
 
   return PP_OK_COMPLETIONPENDING;
 }
 
+void FileIOResource::PostFileOperation(
+    int64_t offset,
+    int64_t size,
+    bool is_write,
+    bool append,
+    const base::Callback<int32_t(void)>& work,
+    scoped_refptr<TrackedCallback> callback) {
+  if (!state_manager_.concurrent_read_write()) {
+    base::PostTaskAndReplyWithResult(
+        PpapiGlobals::Get()->GetFileTaskRunner(),
+        FROM_HERE,
+        work,
+        RunWhileLocked(Bind(&TrackedCallback::Run, callback)));
+    return;
+  }
+
+  SetFileOperationWork(
+      ScheduleFileOperation(offset, size, is_write, append, callback), work);
+}
+
+uint32_t FileIOResource::ScheduleFileOperation(
+    int64_t offset,
+    int64_t size,
+    bool is_write,
+    bool append,
+    scoped_refptr<TrackedCallback> callback) {
+  DCHECK(state_manager_.concurrent_read_write());
+  ScheduledOp op;
+  // Ids start at 1 so that 0 can mean "not queued".
+  op.id = ++next_op_id_;
+  GetOperationRange(offset, size, append, &op.offset, &op.end);
+  op.is_write = is_write;
+  op.callback = callback;
+  waiting_ops_.push_back(op);
+  return op.id;
+}
+
+void FileIOResource::SetFileOperationWork(
+    uint32_t op_id,
+    const base::Callback<int32_t(void)>& work) {
+  for (ScheduledOp& op : waiting_ops_) {
+    if (op.id == op_id) {
+      op.work = work;
+      break;
+    }
+  }
+  StartWaitingOperations();
+}
+
+void FileIOResource::CancelFileOperation(uint32_t op_id) {
+  for (std::deque<ScheduledOp>::iterator it = waiting_ops_.begin();
+       it != waiting_ops_.end(); ++it) {
+    if (it->id == op_id) {
+      waiting_ops_.erase(it);
+      break;
+    }
+  }
+  StartWaitingOperations();
+}
+
+void FileIOResource::StartWaitingOperations() {
+  std::deque<ScheduledOp>::iterator it = waiting_ops_.begin();
+  while (it != waiting_ops_.end()) {
+    bool blocked = false;
+    for (std::deque<ScheduledOp>::iterator earlier = waiting_ops_.begin();
+         earlier != it && !blocked; ++earlier) {
+      blocked = it->ConflictsWith(*earlier);
+    }
+    for (std::map<uint32_t, ScheduledOp>::const_iterator running =
+             running_ops_.begin();
+         running != running_ops_.end() && !blocked; ++running) {
+      blocked = it->ConflictsWith(running->second);
+    }
+    // An op without work yet still holds back the ops after it above.
+    if (blocked || it->work.is_null()) {
+      ++it;
+      continue;
+    }
+
+    uint32_t op_id = it->id;
+    base::PostTaskAndReplyWithResult(
+        PpapiGlobals::Get()->GetParallelFileTaskRunner(
+            next_file_task_runner_++),
+        FROM_HERE,
+        it->work,
+        RunWhileLocked(Bind(&FileIOResource::OnScheduledOperationComplete,
+                            this, op_id)));
+    // The work callback holds the buffers and the file; the running op only
+    // needs its range and completion callback.
+    it->work.Reset();
+    running_ops_[op_id] = *it;
+    it = waiting_ops_.erase(it);
+  }
+}
+
+bool FileIOResource::BeginBlockingOperation(int64_t offset,
+                                            int64_t size,
+                                            bool is_write,
+                                            bool append,
+                                            uint32_t* op_id) {
+  *op_id = 0;
+  if (!state_manager_.concurrent_read_write())
+    return true;
+
+  ScheduledOp op;
+  GetOperationRange(offset, size, append, &op.offset, &op.end);
+  op.is_write = is_write;
+  for (const ScheduledOp& waiting : waiting_ops_) {
+    if (op.ConflictsWith(waiting))
+      return false;
+  }
+  for (const auto& running : running_ops_) {
+    if (op.ConflictsWith(running.second))
+      return false;
+  }
+  op.id = ++next_op_id_;
+  running_ops_[op.id] = op;
+  *op_id = op.id;
+  return true;
+}
+
+void FileIOResource::FinishBlockingOperation(uint32_t op_id) {
+  if (!op_id)
+    return;
+  running_ops_.erase(op_id);
+  StartWaitingOperations();
+}
+
+void FileIOResource::OnScheduledOperationComplete(uint32_t op_id,
+                                                  int32_t result) {
+  std::map<uint32_t, ScheduledOp>::iterator it = running_ops_.find(op_id);
+  DCHECK(it != running_ops_.end());
+  scoped_refptr<TrackedCallback> callback = it->second.callback;
+  running_ops_.erase(it);
+  StartWaitingOperations();
+  callback->Run(result);
+}
+
 void FileIOResource::SetLengthValidated(
     int64_t length,
     scoped_refptr<TrackedCallback> callback) {
@@ -564,8 +1138,21 @@ int32_t FileIOResource::OnReadComplete(scoped_refptr<ReadOp> read_op,
                                        PP_ArrayOutput array_output,
                                        int32_t result) {
   DCHECK(state_manager_.get_pending_operation() ==
-         FileIOStateManager::OPERATION_READ);
-  if (result >= 0) {
+         FileIOStateManager::OPERATION_READ ||
+         state_manager_.get_pending_operation() ==
+         FileIOStateManager::OPERATION_READ_WRITE);
+  if (read_op->reads_in_place()) {
+    // The data is already in the caller's buffer. If the callback was aborted
+    // before the read finished, make sure the read is done with the buffer
+    // before the plugin gets it back.
+    if (result == PP_ERROR_ABORTED) {
+      // Release the proxy lock while waiting for a running read.
+      ProxyAutoUnlock unlock;
+      read_op->Cancel();
+    }
+    if (result < 0)
+      result = PP_ERROR_FAILED;
+  } else if (result >= 0) {
     ArrayWriter output;
     output.set_pp_array_output(array_output);
     if (output.is_valid())
@@ -581,6 +1168,7 @@ int32_t FileIOResource::OnReadComplete(scoped_refptr<ReadOp> read_op,
 }
 
 void FileIOResource::OnRequestWriteQuotaComplete(
+    uint32_t op_id,
     int64_t offset,
     std::unique_ptr<char[]> buffer,
     int32_t bytes_to_write,
@@ -588,6 +1176,8 @@ void FileIOResource::OnRequestWriteQuotaComplete(
     int64_t granted) {
   DCHECK(granted >= 0);
   if (granted == 0) {
+    if (op_id)
+      CancelFileOperation(op_id);
     callback->Run(PP_ERROR_NOQUOTA);
     return;
   }
@@ -603,20 +1193,24 @@ void FileIOResource::OnRequestWriteQuotaComplete(
   }
 
   if (callback->is_blocking()) {
-    int32_t result =
-        WriteValidated(offset, buffer.get(), bytes_to_write, callback);
+    int32_t result = WriteValidated(
+        offset, SingleSegment(buffer.get(), bytes_to_write), bytes_to_write,
+        callback);
     DCHECK(result != PP_OK_COMPLETIONPENDING);
     callback->Run(result);
   } else {
     bool append = (open_flags_ & PP_FILEOPENFLAG_APPEND) != 0;
     scoped_refptr<WriteOp> write_op(new WriteOp(
         file_holder_, offset, std::move(buffer), bytes_to_write, append));
-    base::PostTaskAndReplyWithResult(
-        PpapiGlobals::Get()->GetFileTaskRunner(),
-        FROM_HERE,
-        Bind(&FileIOResource::WriteOp::DoWork, write_op),
-        RunWhileLocked(Bind(&TrackedCallback::Run, callback)));
     callback->set_completion_task(Bind(&FileIOResource::OnWriteComplete, this));
+    base::Callback<int32_t(void)> work =
+        Bind(&FileIOResource::WriteOp::DoWork, write_op);
+    if (op_id) {
+      // The write already holds its place in the queue.
+      SetFileOperationWork(op_id, work);
+    } else {
+      PostFileOperation(offset, bytes_to_write, true, append, work, callback);
+    }
   }
 }
 
@@ -638,7 +1232,9 @@ void FileIOResource::OnRequestSetLengthQuotaComplete(
 
 int32_t FileIOResource::OnWriteComplete(int32_t result) {
   DCHECK(state_manager_.get_pending_operation() ==
-         FileIOStateManager::OPERATION_WRITE);
+         FileIOStateManager::OPERATION_WRITE ||
+         state_manager_.get_pending_operation() ==
+         FileIOStateManager::OPERATION_READ_WRITE);
   // |result| is the return value of WritePlatformFile; -1 indicates failure.
   if (result < 0)
     result = PP_ERROR_FAILED;
@@ -7,12 +7,17 @@
 
 #include <stdint.h>
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/files/file.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "ppapi/c/private/pp_file_handle.h"
 #include "ppapi/proxy/connection.h"
 #include "ppapi/proxy/plugin_resource.h"
@@ -22,6 +27,10 @@
 #include "ppapi/shared_impl/scoped_pp_resource.h"
 #include "ppapi/thunk/ppb_file_io_api.h"
 
+namespace base {
+class MemoryMappedFile;
+}
+
 namespace ppapi {
 
 class TrackedCallback;
@@ -69,6 +78,17 @@ class PPAPI_PROXY_EXPORT FileIOResource
   void Close() override;
   int32_t RequestOSFileHandle(PP_FileHandle* handle,
                               scoped_refptr<TrackedCallback> callback) override;
+  int32_t SetMaxPendingOperations(uint32_t max_pending_operations) override;
+  int32_t MapRange(int64_t offset, int64_t length, void** address) override;
+  int32_t UnmapRange(void* address) override;
+  int32_t ReadV(int64_t offset,
+                const PP_FileIOSegment_Dev segments[],
+                uint32_t segment_count,
+                scoped_refptr<TrackedCallback> callback) override;
+  int32_t WriteV(int64_t offset,
+                 const PP_FileIOSegment_Dev segments[],
+                 uint32_t segment_count,
+                 scoped_refptr<TrackedCallback> callback) override;
 
   // FileHolder is used to guarantee that file operations will have a valid FD
   // to operate on, even if they're in a different thread.
@@ -127,17 +147,62 @@ class PPAPI_PROXY_EXPORT FileIOResource
     base::File::Info file_info_;
   };
 
+  // Buffers for reads whose destination isn't known until they complete,
+  // kept for reuse so that a run of reads doesn't allocate for each one. One
+  // pool is shared by every FileIO in the process.
+  class ReadBufferPool {
+   public:
+    ReadBufferPool();
+    ~ReadBufferPool();
+
+    // Returns the process-wide pool.
+    static ReadBufferPool* Get();
+
+    // Returns a buffer of at least |size| bytes, and its size in |capacity|.
+    std::unique_ptr<char[]> Take(int32_t size, int32_t* capacity);
+    // Gives back a buffer returned by Take(), which may keep it for reuse.
+    void Return(std::unique_ptr<char[]> buffer, int32_t capacity);
+
+   private:
+    struct Buffer {
+      Buffer();
+      Buffer(Buffer&& other);
+      ~Buffer();
+      Buffer& operator=(Buffer&& other);
+
+      std::unique_ptr<char[]> data;
+      int32_t capacity;
+    };
+
+    base::Lock lock_;
+    std::vector<Buffer> buffers_;
+    int64_t total_capacity_;
+
+    DISALLOW_COPY_AND_ASSIGN(ReadBufferPool);
+  };
+
   // Class to perform file read operations across multiple threads.
   class ReadOp : public base::RefCountedThreadSafe<ReadOp> {
    public:
+    // If |segments| isn't empty, the data is read straight into them, and
+    // they must stay valid until the operation completes. Otherwise
+    // |bytes_to_read| bytes are read into a buffer from the ReadBufferPool.
     ReadOp(scoped_refptr<FileHolder> file_holder,
            int64_t offset,
-           int32_t bytes_to_read);
+           int32_t bytes_to_read,
+           const std::vector<PP_FileIOSegment_Dev>& segments);
 
     // Reads the file. Called on the file thread (non-blocking) or the plugin
     // thread (blocking). This should not be called when we hold the proxy lock.
     int32_t DoWork();
 
+    // Keeps a read that hasn't started yet from running, and waits for one
+    // that is already running, so that the caller's buffer is never touched
+    // afterwards. Used when the callback is aborted before the read is done.
+    // This should not be called when we hold the proxy lock.
+    void Cancel();
+
+    bool reads_in_place() const { return !segments_.empty(); }
     char* buffer() const { return buffer_.get(); }
 
    private:
@@ -147,7 +212,14 @@ class PPAPI_PROXY_EXPORT FileIOResource
     scoped_refptr<FileHolder> file_holder_;
     int64_t offset_;
     int32_t bytes_to_read_;
+    std::vector<PP_FileIOSegment_Dev> segments_;
     std::unique_ptr<char[]> buffer_;
+    int32_t buffer_capacity_;
+
+    // Held by in-place reads while they run, so that Cancel() can wait for
+    // them. |cancelled_| is checked under it before the read starts.
+    base::Lock read_lock_;
+    bool cancelled_;
   };
 
   // Class to perform file write operations across multiple threads.
@@ -174,7 +246,78 @@ class PPAPI_PROXY_EXPORT FileIOResource
     bool append_;
   };
 
-  void OnRequestWriteQuotaComplete(int64_t offset,
+  // A read or write waiting to run, or running, on a file thread while
+  // concurrent reads and writes are enabled. |end| is exclusive. A waiting op
+  // with no |work| yet, such as a write waiting for quota, holds its place in
+  // the order but doesn't start until the work is supplied.
+  struct ScheduledOp {
+    ScheduledOp();
+    ScheduledOp(const ScheduledOp& other);
+    ~ScheduledOp();
+
+    // Returns true if this op and |other| must not run at the same time, that
+    // is, if either is a write and their ranges overlap.
+    bool ConflictsWith(const ScheduledOp& other) const;
+
+    uint32_t id;
+    int64_t offset;
+    int64_t end;
+    bool is_write;
+    base::Callback<int32_t(void)> work;
+    scoped_refptr<TrackedCallback> callback;
+  };
+
+  // Runs |work| on a file thread and then |callback| with its result. Unless
+  // concurrent reads and writes are enabled, this posts to the single file
+  // task runner, so operations run in order. Otherwise operations are spread
+  // over the parallel file task runners, and an operation is held back only
+  // while it conflicts with one that is running or was issued before it.
+  // |size| is ignored for appending writes, which conflict with everything.
+  void PostFileOperation(int64_t offset,
+                         int64_t size,
+                         bool is_write,
+                         bool append,
+                         const base::Callback<int32_t(void)>& work,
+                         scoped_refptr<TrackedCallback> callback);
+  // Queues an operation like PostFileOperation() before its work is known,
+  // and returns its id. Only used when concurrent reads and writes are
+  // enabled. The operation starts once SetFileOperationWork() is called and
+  // no earlier operation conflicts with it; CancelFileOperation() drops it.
+  uint32_t ScheduleFileOperation(int64_t offset,
+                                 int64_t size,
+                                 bool is_write,
+                                 bool append,
+                                 scoped_refptr<TrackedCallback> callback);
+  void SetFileOperationWork(uint32_t op_id,
+                            const base::Callback<int32_t(void)>& work);
+  void CancelFileOperation(uint32_t op_id);
+  // Starts every waiting operation that no longer conflicts.
+  void StartWaitingOperations();
+  // Blocking reads and writes run on the calling thread rather than through
+  // the queue. While concurrent reads and writes are enabled, this fails if
+  // the range conflicts with a queued or running operation, and otherwise
+  // marks it as running until FinishBlockingOperation(), so that later
+  // operations wait for it.
+  bool BeginBlockingOperation(int64_t offset,
+                              int64_t size,
+                              bool is_write,
+                              bool append,
+                              uint32_t* op_id);
+  void FinishBlockingOperation(uint32_t op_id);
+  void OnScheduledOperationComplete(uint32_t op_id, int32_t result);
+
+  // Writes |segments|, which hold |bytes_to_write| bytes in all, once any
+  // quota they need has been granted. Called by Write() and WriteV() after
+  // they have checked their arguments and the operation state.
+  int32_t WriteWithQuota(int64_t offset,
+                         const std::vector<PP_FileIOSegment_Dev>& segments,
+                         int32_t bytes_to_write,
+                         scoped_refptr<TrackedCallback> callback);
+
+  // |op_id| is the queued operation holding the write's place while
+  // concurrent reads and writes are enabled.
+  void OnRequestWriteQuotaComplete(uint32_t op_id,
+                                   int64_t offset,
                                    std::unique_ptr<char[]> buffer,
                                    int32_t bytes_to_write,
                                    scoped_refptr<TrackedCallback> callback,
@@ -183,12 +326,17 @@ class PPAPI_PROXY_EXPORT FileIOResource
                                        scoped_refptr<TrackedCallback> callback,
                                        int64_t granted);
 
+  // |buffer| is the caller's buffer for Read(), which non-blocking reads fill
+  // directly, or NULL for ReadToArray().
   int32_t ReadValidated(int64_t offset,
                         int32_t bytes_to_read,
                         const PP_ArrayOutput& array_output,
+                        char* buffer,
                         scoped_refptr<TrackedCallback> callback);
+  // Blocking writes go straight from |segments|; non-blocking ones copy them
+  // into one buffer first.
   int32_t WriteValidated(int64_t offset,
-                         const char* buffer,
+                         const std::vector<PP_FileIOSegment_Dev>& segments,
                          int32_t bytes_to_write,
                          scoped_refptr<TrackedCallback> callback);
   void SetLengthValidated(int64_t length,
@@ -228,6 +376,17 @@ class PPAPI_PROXY_EXPORT FileIOResource
   bool check_quota_;
   bool called_close_;
 
+  // Operations waiting for a conflicting one to finish, in issue order, and
+  // the operations running, by id. Only used when concurrent reads and writes
+  // are enabled.
+  std::deque<ScheduledOp> waiting_ops_;
+  std::map<uint32_t, ScheduledOp> running_ops_;
+  uint32_t next_op_id_;
+  size_t next_file_task_runner_;
+
+  // Ranges mapped with MapRange(), released on Close().
+  std::vector<std::unique_ptr<base::MemoryMappedFile>> mappings_;
+
   DISALLOW_COPY_AND_ASSIGN(FileIOResource);
 };
 
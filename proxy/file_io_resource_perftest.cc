@@ -0,0 +1,482 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures random read throughput of a FileIO resource at several queue
+// depths, with the default behavior, where reads run one at a time on the
+// file thread, and with concurrent operations enabled through
+// PPB_FileIO_Dev.SetMaxPendingOperations(). Also measures large sequential
+// reads through Read(), which fills the caller's buffer directly, and through
+// ReadToArray(), which reads into a pooled buffer and copies, and random
+// reads from a mapping made with PPB_FileIO_Dev.MapRange(). Finally, measures
+// writing records made of a header, payload and trailer in separate buffers,
+// as three Write() calls or as one PPB_FileIO_Dev.WriteV().
+//
+// A temporary file is used by default, which is likely to be in the page
+// cache. --file-path=<file> reads an existing file instead, e.g. one on a
+// device with deep hardware queues.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "ipc/ipc_platform_file.h"
+#include "ppapi/c/dev/ppb_file_io_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/c/ppb_file_io.h"
+#include "ppapi/c/ppb_file_ref.h"
+#include "ppapi/c/ppb_file_system.h"
+#include "ppapi/proxy/locking_resource_releaser.h"
+#include "ppapi/proxy/plugin_message_filter.h"
+#include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/proxy/serialized_handle.h"
+#include "ppapi/thunk/thunk.h"
+#include "testing/perf/perf_test.h"
+
+namespace ppapi {
+namespace proxy {
+namespace {
+
+int GetIntSwitch(const char* name, int default_value) {
+  int value = default_value;
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line && command_line->HasSwitch(name))
+    base::StringToInt(command_line->GetSwitchValueASCII(name), &value);
+  return value;
+}
+
+enum ReadPattern { READ_RANDOM, READ_SEQUENTIAL };
+enum ReadOutput { OUTPUT_BUFFER, OUTPUT_ARRAY };
+
+// Keeps |queue_depth| reads of |read_size| bytes pending until |total_reads|
+// have completed.
+class ReadRunner {
+ public:
+  ReadRunner(PP_Resource file_io,
+             int64_t file_size,
+             int32_t read_size,
+             int queue_depth,
+             int total_reads,
+             ReadPattern pattern,
+             ReadOutput output)
+      : file_io_iface_(thunk::GetPPB_FileIO_1_1_Thunk()),
+        file_io_(file_io),
+        file_size_(file_size),
+        read_size_(read_size),
+        pattern_(pattern),
+        output_(output),
+        next_block_(0),
+        reads_to_issue_(total_reads),
+        reads_pending_(0),
+        failures_(0),
+        random_state_(12345),
+        slots_(queue_depth) {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      slots_[i].runner = this;
+      slots_[i].buffer.reset(new char[read_size]);
+    }
+  }
+
+  // Returns the number of reads that failed.
+  int Run() {
+    for (size_t i = 0; i < slots_.size(); ++i)
+      IssueRead(&slots_[i]);
+    if (reads_pending_ > 0)
+      run_loop_.Run();
+    return failures_;
+  }
+
+ private:
+  struct Slot {
+    ReadRunner* runner;
+    std::unique_ptr<char[]> buffer;
+  };
+
+  static void* GetDataBuffer(void* user_data, uint32_t count, uint32_t size) {
+    Slot* slot = static_cast<Slot*>(user_data);
+    DCHECK_LE(count * size, static_cast<uint32_t>(slot->runner->read_size_));
+    return slot->buffer.get();
+  }
+
+  static void OnReadComplete(void* user_data, int32_t result) {
+    Slot* slot = static_cast<Slot*>(user_data);
+    ReadRunner* runner = slot->runner;
+    if (result != runner->read_size_)
+      runner->failures_++;
+    runner->reads_pending_--;
+    runner->IssueRead(slot);
+    if (runner->reads_pending_ == 0)
+      runner->run_loop_.Quit();
+  }
+
+  void IssueRead(Slot* slot) {
+    if (reads_to_issue_ == 0)
+      return;
+    reads_to_issue_--;
+
+    int64_t blocks = file_size_ / read_size_;
+    int64_t block = 0;
+    if (pattern_ == READ_SEQUENTIAL) {
+      block = next_block_++ % blocks;
+    } else {
+      random_state_ = random_state_ * 1103515245 + 12345;
+      block = (random_state_ >> 8) % blocks;
+    }
+    int64_t offset = block * read_size_;
+
+    int32_t result;
+    PP_CompletionCallback callback =
+        PP_MakeCompletionCallback(&OnReadComplete, slot);
+    if (output_ == OUTPUT_ARRAY) {
+      PP_ArrayOutput array_output = {&GetDataBuffer, slot};
+      result = file_io_iface_->ReadToArray(file_io_, offset, read_size_,
+                                           &array_output, callback);
+    } else {
+      result = file_io_iface_->Read(file_io_, offset, slot->buffer.get(),
+                                    read_size_, callback);
+    }
+    if (result == PP_OK_COMPLETIONPENDING)
+      reads_pending_++;
+    else
+      failures_++;
+  }
+
+  const PPB_FileIO_1_1* file_io_iface_;
+  PP_Resource file_io_;
+  int64_t file_size_;
+  int32_t read_size_;
+  ReadPattern pattern_;
+  ReadOutput output_;
+  int64_t next_block_;
+  int reads_to_issue_;
+  int reads_pending_;
+  int failures_;
+  uint32_t random_state_;
+  std::vector<Slot> slots_;
+  base::RunLoop run_loop_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadRunner);
+};
+
+class FileIOResourcePerfTest : public PluginProxyTest {
+ public:
+  FileIOResourcePerfTest()
+      : file_system_iface_(thunk::GetPPB_FileSystem_1_0_Thunk()),
+        file_ref_iface_(thunk::GetPPB_FileRef_1_1_Thunk()),
+        file_io_iface_(thunk::GetPPB_FileIO_1_1_Thunk()),
+        file_io_dev_iface_(thunk::GetPPB_FileIO_Dev_0_1_Thunk()),
+        file_size_(0) {}
+
+  void SetUp() override {
+    PluginProxyTest::SetUp();
+
+    base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+    if (command_line && command_line->HasSwitch("file-path")) {
+      file_path_ = command_line->GetSwitchValuePath("file-path");
+      ASSERT_TRUE(base::GetFileSize(file_path_, &file_size_));
+      return;
+    }
+
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_path_ = temp_dir_.GetPath().AppendASCII("data");
+    const int kChunkSize = 1024 * 1024;
+    std::string chunk(kChunkSize, 'x');
+    base::File file(file_path_,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    int megabytes = GetIntSwitch("file-megabytes", 64);
+    for (int i = 0; i < megabytes; ++i)
+      ASSERT_EQ(kChunkSize, file.WriteAtCurrentPos(chunk.data(), kChunkSize));
+    file_size_ = static_cast<int64_t>(megabytes) * kChunkSize;
+  }
+
+  // Runs the reads through a newly opened FileIO resource, with at most
+  // |max_pending_operations| pending at once if it is non-zero, and reports
+  // the throughput.
+  void RunReads(const std::string& name,
+                uint32_t max_pending_operations,
+                int queue_depth,
+                int32_t read_size,
+                int total_reads,
+                ReadPattern pattern,
+                ReadOutput output) {
+    ASSERT_GE(file_size_, read_size);
+
+    LockingResourceReleaser file_system(file_system_iface_->Create(
+        pp_instance(), PP_FILESYSTEMTYPE_LOCALTEMPORARY));
+    LockingResourceReleaser file_ref(
+        file_ref_iface_->Create(file_system.get(), "/data"));
+    LockingResourceReleaser file_io(file_io_iface_->Create(pp_instance()));
+    OpenFile(file_io.get(), file_ref.get(), file_path_, PP_FILEOPENFLAG_READ);
+    if (max_pending_operations) {
+      ASSERT_EQ(PP_OK, file_io_dev_iface_->SetMaxPendingOperations(
+                           file_io.get(), max_pending_operations));
+    }
+
+    std::string trace = base::StringPrintf("%s_depth%d", name.c_str(),
+                                           queue_depth);
+    ReadRunner runner(file_io.get(), file_size_, read_size, queue_depth,
+                      total_reads, pattern, output);
+    base::PerfTimeLogger logger(("FileIOResourcePerfTest." + trace).c_str());
+    base::TimeTicks start = base::TimeTicks::Now();
+    ASSERT_EQ(0, runner.Run());
+    double seconds = (base::TimeTicks::Now() - start).InSecondsF();
+    logger.Done();
+
+    double megabytes = static_cast<double>(read_size) * total_reads /
+                       (1024 * 1024);
+    perf_test::PrintResult("FileIOResourcePerfTest", "", trace + "_throughput",
+                           megabytes / seconds, "MB/s", true);
+  }
+
+  // Maps the whole file and copies |total_reads| blocks of |read_size| bytes
+  // at random offsets out of the mapping, and reports the throughput.
+  void RunMappedReads(int32_t read_size, int total_reads) {
+    ASSERT_GE(file_size_, read_size);
+
+    LockingResourceReleaser file_system(file_system_iface_->Create(
+        pp_instance(), PP_FILESYSTEMTYPE_LOCALTEMPORARY));
+    LockingResourceReleaser file_ref(
+        file_ref_iface_->Create(file_system.get(), "/data"));
+    LockingResourceReleaser file_io(file_io_iface_->Create(pp_instance()));
+    OpenFile(file_io.get(), file_ref.get(), file_path_, PP_FILEOPENFLAG_READ);
+
+    base::PerfTimeLogger logger("FileIOResourcePerfTest.MappedRandomRead");
+    base::TimeTicks start = base::TimeTicks::Now();
+    void* address = NULL;
+    ASSERT_EQ(PP_OK, file_io_dev_iface_->MapRange(file_io.get(), 0,
+                                                  file_size_, &address));
+    const char* data = static_cast<const char*>(address);
+    std::unique_ptr<char[]> buffer(new char[read_size]);
+    uint32_t random_state = 12345;
+    int64_t blocks = file_size_ / read_size;
+    for (int i = 0; i < total_reads; ++i) {
+      random_state = random_state * 1103515245 + 12345;
+      int64_t offset = ((random_state >> 8) % blocks) * read_size;
+      memcpy(buffer.get(), data + offset, read_size);
+    }
+    ASSERT_EQ(PP_OK, file_io_dev_iface_->UnmapRange(file_io.get(), address));
+    double seconds = (base::TimeTicks::Now() - start).InSecondsF();
+    logger.Done();
+
+    double megabytes = static_cast<double>(read_size) * total_reads /
+                       (1024 * 1024);
+    perf_test::PrintResult("FileIOResourcePerfTest", "",
+                           "MappedRandomRead_throughput", megabytes / seconds,
+                           "MB/s", true);
+  }
+
+  // Writes |total_records| records one after another to a new file, each
+  // waiting for the previous one, and reports the rate. A record is written
+  // as three Write() calls, or as one WriteV() if |vectored| is true.
+  void RunRecordWrites(const std::string& name,
+                       bool vectored,
+                       int32_t payload_size,
+                       int total_records) {
+    if (!temp_dir_.IsValid())
+      ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath path = temp_dir_.GetPath().AppendASCII("records");
+
+    LockingResourceReleaser file_system(file_system_iface_->Create(
+        pp_instance(), PP_FILESYSTEMTYPE_LOCALTEMPORARY));
+    LockingResourceReleaser file_ref(
+        file_ref_iface_->Create(file_system.get(), "/records"));
+    LockingResourceReleaser file_io(file_io_iface_->Create(pp_instance()));
+    OpenFile(file_io.get(), file_ref.get(), path,
+             PP_FILEOPENFLAG_READ | PP_FILEOPENFLAG_WRITE);
+
+    const int32_t kHeaderSize = 64;
+    const int32_t kTrailerSize = 16;
+    std::vector<char> header(kHeaderSize, 'h');
+    std::vector<char> payload(payload_size, 'p');
+    std::vector<char> trailer(kTrailerSize, 't');
+    PP_FileIOSegment_Dev segments[] = {{&header[0], kHeaderSize},
+                                       {&payload[0], payload_size},
+                                       {&trailer[0], kTrailerSize}};
+    int32_t record_size = kHeaderSize + payload_size + kTrailerSize;
+
+    base::PerfTimeLogger logger(("FileIOResourcePerfTest." + name).c_str());
+    base::TimeTicks start = base::TimeTicks::Now();
+    int64_t offset = 0;
+    for (int i = 0; i < total_records; ++i) {
+      if (vectored) {
+        ASSERT_EQ(record_size,
+                  WriteAndWait(file_io.get(), offset, segments,
+                               arraysize(segments), true));
+        offset += record_size;
+        continue;
+      }
+      for (size_t j = 0; j < arraysize(segments); ++j) {
+        ASSERT_EQ(segments[j].size,
+                  WriteAndWait(file_io.get(), offset, &segments[j], 1, false));
+        offset += segments[j].size;
+      }
+    }
+    double seconds = (base::TimeTicks::Now() - start).InSecondsF();
+    logger.Done();
+
+    perf_test::PrintResult("FileIOResourcePerfTest", "", name + "_rate",
+                           total_records / seconds, "records/s", true);
+  }
+
+ private:
+  struct WriteWaiter {
+    int32_t result;
+    base::RunLoop run_loop;
+  };
+
+  // Writes |segments| at |offset|, with WriteV() if |vectored| is true and
+  // otherwise with Write(), which only takes one segment, and waits for the
+  // result.
+  int32_t WriteAndWait(PP_Resource file_io,
+                       int64_t offset,
+                       const PP_FileIOSegment_Dev segments[],
+                       uint32_t segment_count,
+                       bool vectored) {
+    WriteWaiter waiter;
+    PP_CompletionCallback callback =
+        PP_MakeCompletionCallback(&OnWriteComplete, &waiter);
+    int32_t result;
+    if (vectored) {
+      result = file_io_dev_iface_->WriteV(file_io, offset, segments,
+                                          segment_count, callback);
+    } else {
+      DCHECK_EQ(1u, segment_count);
+      result = file_io_iface_->Write(
+          file_io, offset, static_cast<const char*>(segments[0].buffer),
+          segments[0].size, callback);
+    }
+    if (result != PP_OK_COMPLETIONPENDING)
+      return result;
+    waiter.run_loop.Run();
+    return waiter.result;
+  }
+
+  static void OnWriteComplete(void* user_data, int32_t result) {
+    WriteWaiter* waiter = static_cast<WriteWaiter*>(user_data);
+    waiter->result = result;
+    waiter->run_loop.Quit();
+  }
+
+  // Opens |file_io| with |open_flags|, replying to the open message with a
+  // handle to the file at |path|, which is created if it is opened for
+  // writing.
+  void OpenFile(PP_Resource file_io,
+                PP_Resource file_ref,
+                const base::FilePath& path,
+                int32_t open_flags) {
+    int32_t result = file_io_iface_->Open(
+        file_io, file_ref, open_flags,
+        PP_MakeCompletionCallback(&OnOpenComplete, &open_result_));
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, result);
+
+    ResourceMessageCallParams params;
+    IPC::Message msg;
+    ASSERT_TRUE(sink().GetFirstResourceCallMatching(
+        PpapiHostMsg_FileIO_Open::ID, &params, &msg));
+    sink().ClearMessages();
+
+    uint32_t file_flags = base::File::FLAG_OPEN | base::File::FLAG_READ;
+    if (open_flags & PP_FILEOPENFLAG_WRITE) {
+      file_flags = base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_READ |
+                   base::File::FLAG_WRITE;
+    }
+    base::File file(path, file_flags);
+    ASSERT_TRUE(file.IsValid());
+    SerializedHandle handle;
+    handle.set_file_handle(IPC::TakePlatformFileForTransit(std::move(file)),
+                           open_flags, file_io);
+    ResourceMessageReplyParams reply_params(params.pp_resource(),
+                                            params.sequence());
+    reply_params.set_result(PP_OK);
+    reply_params.AppendHandle(handle);
+    open_result_ = PP_OK_COMPLETIONPENDING;
+    PluginMessageFilter::DispatchResourceReplyForTest(
+        reply_params,
+        PpapiPluginMsg_FileIO_OpenReply(0 /* quota_file_system */,
+                                        file_size_));
+    ASSERT_EQ(PP_OK, open_result_);
+  }
+
+  static void OnOpenComplete(void* user_data, int32_t result) {
+    *static_cast<int32_t*>(user_data) = result;
+  }
+
+  const PPB_FileSystem_1_0* file_system_iface_;
+  const PPB_FileRef_1_1* file_ref_iface_;
+  const PPB_FileIO_1_1* file_io_iface_;
+  const PPB_FileIO_Dev_0_1* file_io_dev_iface_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath file_path_;
+  int64_t file_size_;
+  int32_t open_result_;
+};
+
+const int kQueueDepths[] = {1, 4, 16};
+
+}  // namespace
+
+// Reads run one at a time whatever the queue depth, as before
+// PPB_FileIO_Dev.
+TEST_F(FileIOResourcePerfTest, SerializedRandomRead) {
+  const int32_t kReadSize = GetIntSwitch("read-kilobytes", 64) * 1024;
+  const int kTotalReads = GetIntSwitch("reads", 4096);
+  for (size_t i = 0; i < arraysize(kQueueDepths); ++i) {
+    RunReads("Serialized", 0, kQueueDepths[i], kReadSize, kTotalReads,
+             READ_RANDOM, OUTPUT_BUFFER);
+  }
+}
+
+TEST_F(FileIOResourcePerfTest, ConcurrentRandomRead) {
+  const int32_t kReadSize = GetIntSwitch("read-kilobytes", 64) * 1024;
+  const int kTotalReads = GetIntSwitch("reads", 4096);
+  for (size_t i = 0; i < arraysize(kQueueDepths); ++i) {
+    RunReads("Concurrent", kQueueDepths[i], kQueueDepths[i], kReadSize,
+             kTotalReads, READ_RANDOM, OUTPUT_BUFFER);
+  }
+}
+
+// The same reads as the RandomRead tests, copied out of a mapping of the file.
+TEST_F(FileIOResourcePerfTest, MappedRandomRead) {
+  RunMappedReads(GetIntSwitch("read-kilobytes", 64) * 1024,
+                 GetIntSwitch("reads", 4096));
+}
+
+// Large sequential reads, one at a time.
+TEST_F(FileIOResourcePerfTest, SequentialRead) {
+  const int32_t kReadSize = 4 * 1024 * 1024;
+  const int kTotalReads = GetIntSwitch("sequential-reads", 256);
+  RunReads("SequentialBuffer", 0, 1, kReadSize, kTotalReads, READ_SEQUENTIAL,
+           OUTPUT_BUFFER);
+  RunReads("SequentialArray", 0, 1, kReadSize, kTotalReads, READ_SEQUENTIAL,
+           OUTPUT_ARRAY);
+}
+
+// Records as written by a log-structured store.
+TEST_F(FileIOResourcePerfTest, RecordWrite) {
+  const int32_t kPayloadSize = GetIntSwitch("payload-kilobytes", 4) * 1024;
+  const int kTotalRecords = GetIntSwitch("records", 4096);
+  RunRecordWrites("SeparateRecordWrite", false, kPayloadSize, kTotalRecords);
+  RunRecordWrites("VectoredRecordWrite", true, kPayloadSize, kTotalRecords);
+}
+
+}  // namespace proxy
+}  // namespace ppapi
@@ -4,6 +4,8 @@
 
 #include "ppapi/proxy/file_system_resource.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/stl_util.h"
 #include "ipc/ipc_message.h"
@@ -21,6 +23,16 @@ using ppapi::thunk::PPB_FileSystem_API;
 namespace ppapi {
 namespace proxy {
 
+namespace {
+
+// Quota is reserved ahead of demand. The first reservation asks for just what
+// is needed; each one after it asks for this much more, doubling up to the
+// maximum, so that a run of growing writes needs fewer and fewer round trips.
+const int64_t kMinQuotaReservationHeadroom = 256 * 1024;  // 256KB
+const int64_t kMaxQuotaReservationHeadroom = 16 * 1024 * 1024;  // 16MB
+
+}  // namespace
+
 FileSystemResource::QuotaRequest::QuotaRequest(
     int64_t amount_arg,
     const RequestQuotaCallback& callback_arg)
@@ -39,8 +51,14 @@ FileSystemResource::FileSystemResource(Connection connection,
       called_open_(false),
       callback_count_(0),
       callback_result_(PP_OK),
+      pending_quota_amount_(0),
       reserved_quota_(0),
-      reserving_quota_(false) {
+      reserving_quota_(false),
+      reserving_headroom_(0),
+      next_headroom_(0),
+      immediate_quota_grants_(0),
+      deferred_quota_requests_(0),
+      quota_reservations_(0) {
   DCHECK(type_ != PP_FILESYSTEMTYPE_INVALID);
   SendCreate(RENDERER, PpapiHostMsg_FileSystem_Create(type_));
   SendCreate(BROWSER, PpapiHostMsg_FileSystem_Create(type_));
@@ -56,8 +74,14 @@ FileSystemResource::FileSystemResource(Connection connection,
       called_open_(true),
       callback_count_(0),
       callback_result_(PP_OK),
+      pending_quota_amount_(0),
       reserved_quota_(0),
-      reserving_quota_(false) {
+      reserving_quota_(false),
+      reserving_headroom_(0),
+      next_headroom_(0),
+      immediate_quota_grants_(0),
+      deferred_quota_requests_(0),
+      quota_reservations_(0) {
   DCHECK(type_ != PP_FILESYSTEMTYPE_INVALID);
   AttachToPendingHost(RENDERER, pending_renderer_id);
   AttachToPendingHost(BROWSER, pending_browser_id);
@@ -104,21 +128,29 @@ void FileSystemResource::CloseQuotaFile(PP_Resource file_io) {
   files_.erase(file_io);
 }
 
+bool FileSystemResource::ConsumeReservedQuota(int64_t amount) {
+  DCHECK(amount >= 0);
+  if (reserving_quota_ || reserved_quota_ < amount)
+    return false;
+  reserved_quota_ -= amount;
+  ++immediate_quota_grants_;
+  return true;
+}
+
 int64_t FileSystemResource::RequestQuota(
     int64_t amount,
     const RequestQuotaCallback& callback) {
-  DCHECK(amount >= 0);
-  if (!reserving_quota_ && reserved_quota_ >= amount) {
-    reserved_quota_ -= amount;
+  if (ConsumeReservedQuota(amount))
     return amount;
-  }
 
   // Queue up a pending quota request.
   pending_quota_requests_.push(QuotaRequest(amount, callback));
+  pending_quota_amount_ += amount;
+  ++deferred_quota_requests_;
 
   // Reserve more quota if we haven't already.
   if (!reserving_quota_)
-    ReserveQuota(amount);
+    ReserveQuota(NextQuotaReservationHeadroom());
 
   return PP_OK_COMPLETIONPENDING;
 }
@@ -171,9 +203,11 @@ void FileSystemResource::InitIsolatedFileSystemComplete(
     callback.Run(callback_result_);
 }
 
-void FileSystemResource::ReserveQuota(int64_t amount) {
+void FileSystemResource::ReserveQuota(int64_t headroom) {
   DCHECK(!reserving_quota_);
   reserving_quota_ = true;
+  reserving_headroom_ = headroom;
+  ++quota_reservations_;
 
   FileGrowthMap file_growths;
   for (std::set<PP_Resource>::iterator it = files_.begin();
@@ -189,7 +223,8 @@ void FileSystemResource::ReserveQuota(int64_t amount) {
         file_io_api->GetAppendModeWriteAmount());
   }
   Call<PpapiPluginMsg_FileSystem_ReserveQuotaReply>(BROWSER,
-      PpapiHostMsg_FileSystem_ReserveQuota(amount, file_growths),
+      PpapiHostMsg_FileSystem_ReserveQuota(pending_quota_amount_ + headroom,
+                                           file_growths),
       base::Bind(&FileSystemResource::ReserveQuotaComplete,
                  this));
 }
@@ -216,26 +251,49 @@ void FileSystemResource::ReserveQuotaComplete(
   }
 
   DCHECK(!pending_quota_requests_.empty());
+  bool insufficient = reserved_quota_ < pending_quota_requests_.front().amount;
+  if (insufficient && reserving_headroom_ > 0) {
+    // The host may have turned down the reservation only because of the
+    // headroom, e.g. near the quota limit. Ask again for just what is needed,
+    // and start growing the headroom from scratch.
+    next_headroom_ = 0;
+    ReserveQuota(NextQuotaReservationHeadroom());
+    return;
+  }
+
   // If we can't grant the first request after refreshing reserved_quota_, then
   // fail all pending quota requests to avoid an infinite refresh/fail loop.
-  bool fail_all = reserved_quota_ < pending_quota_requests_.front().amount;
+  bool fail_all = insufficient;
   while (!pending_quota_requests_.empty()) {
     QuotaRequest& request = pending_quota_requests_.front();
     if (fail_all) {
+      pending_quota_amount_ -= request.amount;
       request.callback.Run(0);
       pending_quota_requests_.pop();
     } else if (reserved_quota_ >= request.amount) {
       reserved_quota_ -= request.amount;
+      pending_quota_amount_ -= request.amount;
       request.callback.Run(request.amount);
       pending_quota_requests_.pop();
     } else {
-      // Refresh the quota reservation for the first pending request that we
-      // can't satisfy.
-      ReserveQuota(request.amount);
+      // Refresh the quota reservation for the pending requests that we can't
+      // satisfy.
+      ReserveQuota(NextQuotaReservationHeadroom());
       break;
     }
   }
 }
 
+int64_t FileSystemResource::NextQuotaReservationHeadroom() {
+  int64_t headroom = next_headroom_;
+  if (next_headroom_ == 0) {
+    next_headroom_ = kMinQuotaReservationHeadroom;
+  } else {
+    next_headroom_ =
+        std::min(next_headroom_ * 2, kMaxQuotaReservationHeadroom);
+  }
+  return headroom;
+}
+
 }  // namespace proxy
 }  // namespace ppapi
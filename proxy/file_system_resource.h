@@ -55,10 +55,18 @@ class PPAPI_PROXY_EXPORT FileSystemResource : public PluginResource,
   PP_FileSystemType GetType() override;
   void OpenQuotaFile(PP_Resource file_io) override;
   void CloseQuotaFile(PP_Resource file_io) override;
+  bool ConsumeReservedQuota(int64_t amount) override;
   typedef base::Callback<void(int64_t)> RequestQuotaCallback;
   int64_t RequestQuota(int64_t amount,
                        const RequestQuotaCallback& callback) override;
 
+  // The number of quota requests granted from the reserved quota without
+  // waiting, the number that had to wait for a reservation, and the number of
+  // reservation round trips to the host.
+  uint32_t immediate_quota_grants() const { return immediate_quota_grants_; }
+  uint32_t deferred_quota_requests() const { return deferred_quota_requests_; }
+  uint32_t quota_reservations() const { return quota_reservations_; }
+
   int32_t InitIsolatedFileSystem(const std::string& fsid,
                                  PP_IsolatedFileSystemType_Private type,
                                  const base::Callback<void(int32_t)>& callback);
@@ -81,7 +89,12 @@ class PPAPI_PROXY_EXPORT FileSystemResource : public PluginResource,
       const base::Callback<void(int32_t)>& callback,
       const ResourceMessageReplyParams& params);
 
-  void ReserveQuota(int64_t amount);
+  // Asks the host to reserve enough quota for the pending requests, plus
+  // |headroom| bytes for the requests expected to follow.
+  void ReserveQuota(int64_t headroom);
+  // Returns the headroom to ask for in the next reservation, and grows the
+  // one after it.
+  int64_t NextQuotaReservationHeadroom();
   typedef std::map<int32_t, int64_t> OffsetMap;
   void ReserveQuotaComplete(const ResourceMessageReplyParams& params,
                             int64_t amount,
@@ -94,8 +107,18 @@ class PPAPI_PROXY_EXPORT FileSystemResource : public PluginResource,
 
   std::set<PP_Resource> files_;
   base::queue<QuotaRequest> pending_quota_requests_;
+  // The total amount of |pending_quota_requests_|.
+  int64_t pending_quota_amount_;
   int64_t reserved_quota_;
   bool reserving_quota_;
+  // The headroom asked for in the reservation that is pending, and to ask for
+  // in the next one.
+  int64_t reserving_headroom_;
+  int64_t next_headroom_;
+
+  uint32_t immediate_quota_grants_;
+  uint32_t deferred_quota_requests_;
+  uint32_t quota_reservations_;
 
   DISALLOW_COPY_AND_ASSIGN(FileSystemResource);
 };
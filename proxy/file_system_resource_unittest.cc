@@ -4,6 +4,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "ppapi/c/pp_errors.h"
 #include "ppapi/c/ppb_file_io.h"
 #include "ppapi/c/ppb_file_ref.h"
@@ -280,7 +282,7 @@ TEST_F(FileSystemResourceTest, RequestQuota) {
   cb2.Reset();
 
   // All requests should fail when insufficient quota is returned to satisfy
-  // the first request.
+  // the first request, once a reservation without headroom has been tried.
   result = file_system_api->RequestQuota(
       kQuotaRequestAmount1,
       base::Bind(&MockRequestQuotaCallback::Callback, base::Unretained(&cb1)));
@@ -303,6 +305,23 @@ TEST_F(FileSystemResourceTest, RequestQuota) {
                   kQuotaRequestAmount1 - 1,
                   FileGrowthMapToFileSizeMapForTesting(file_growths)));
   }
+  // The reservation asked for headroom, so it is retried for just the amount
+  // of the requests.
+  ASSERT_FALSE(cb1.called());
+  ASSERT_TRUE(sink().GetFirstResourceCallMatching(
+      PpapiHostMsg_FileSystem_ReserveQuota::ID, &params, &msg));
+  sink().ClearMessages();
+  ASSERT_TRUE(UnpackMessage<PpapiHostMsg_FileSystem_ReserveQuota>(
+      msg, &amount, &file_growths));
+  ASSERT_EQ(kQuotaRequestAmount1 + kQuotaRequestAmount2, amount);
+  {
+    ProxyAutoUnlock unlock_to_prevent_deadlock;
+    SendReply(params,
+              PP_OK,
+              PpapiPluginMsg_FileSystem_ReserveQuotaReply(
+                  kQuotaRequestAmount1 - 1,
+                  FileGrowthMapToFileSizeMapForTesting(file_growths)));
+  }
   ASSERT_TRUE(cb1.called());
   ASSERT_EQ(0, cb1.result());
   ASSERT_TRUE(cb2.called());
@@ -366,5 +385,80 @@ TEST_F(FileSystemResourceTest, RequestQuota) {
   ASSERT_EQ(kQuotaRequestAmount1, result);
 }
 
+// Test that quota is reserved ahead of demand, so that most requests are
+// granted without a round trip.
+TEST_F(FileSystemResourceTest, RequestQuotaAhead) {
+  LockingResourceReleaser file_system(
+      file_system_iface->Create(pp_instance(),
+                                PP_FILESYSTEMTYPE_LOCALTEMPORARY));
+
+  OpenFileSystem(file_system.get());
+
+  LockingResourceReleaser file_ref(
+      file_ref_iface->Create(file_system.get(), "/file"));
+  LockingResourceReleaser file_io(file_io_iface->Create(pp_instance()));
+  OpenFile(file_io.get(), file_ref.get(), file_system.get());
+
+  EnterResource<PPB_FileSystem_API> enter(file_system.get(), true);
+  ASSERT_FALSE(enter.failed());
+  FileSystemResource* file_system_resource =
+      static_cast<FileSystemResource*>(enter.object());
+
+  // Make requests like a run of appends, granting every reservation in full.
+  const int64_t kAppendSize = 4096;
+  const int kAppends = 1000;
+  std::vector<int64_t> reserved_amounts;
+  for (int i = 0; i < kAppends; ++i) {
+    MockRequestQuotaCallback cb;
+    int64_t result = file_system_resource->RequestQuota(
+        kAppendSize,
+        base::Bind(&MockRequestQuotaCallback::Callback,
+                   base::Unretained(&cb)));
+    if (result == kAppendSize)
+      continue;
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, result);
+
+    ResourceMessageCallParams params;
+    IPC::Message msg;
+    ASSERT_TRUE(sink().GetFirstResourceCallMatching(
+        PpapiHostMsg_FileSystem_ReserveQuota::ID, &params, &msg));
+    sink().ClearMessages();
+    int64_t amount = 0;
+    FileGrowthMap file_growths;
+    ASSERT_TRUE(UnpackMessage<PpapiHostMsg_FileSystem_ReserveQuota>(
+        msg, &amount, &file_growths));
+    reserved_amounts.push_back(amount);
+    {
+      ProxyAutoUnlock unlock_to_prevent_deadlock;
+      SendReply(params,
+                PP_OK,
+                PpapiPluginMsg_FileSystem_ReserveQuotaReply(
+                    amount,
+                    FileGrowthMapToFileSizeMapForTesting(file_growths)));
+    }
+    ASSERT_TRUE(cb.called());
+    ASSERT_EQ(kAppendSize, cb.result());
+  }
+
+  // The first reservation is for just the first request, and each one after it
+  // reserves more ahead of demand.
+  ASSERT_LT(1U, reserved_amounts.size());
+  ASSERT_EQ(kAppendSize, reserved_amounts[0]);
+  for (size_t i = 1; i < reserved_amounts.size(); ++i)
+    ASSERT_LT(reserved_amounts[i - 1], reserved_amounts[i]);
+
+  ASSERT_EQ(reserved_amounts.size(),
+            file_system_resource->quota_reservations());
+  ASSERT_EQ(reserved_amounts.size(),
+            file_system_resource->deferred_quota_requests());
+  ASSERT_EQ(kAppends - reserved_amounts.size(),
+            file_system_resource->immediate_quota_grants());
+  // 4MB of appends need only a handful of round trips.
+  ASSERT_GE(6U, file_system_resource->quota_reservations());
+
+  // Enough quota is left for a request to be granted without waiting.
+  ASSERT_TRUE(file_system_resource->ConsumeReservedQuota(kAppendSize));
+}
+
 }  // namespace proxy
 }  // namespace ppapi
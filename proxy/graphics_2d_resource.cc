@@ -4,6 +4,8 @@
 
 #include "ppapi/proxy/graphics_2d_resource.h"
 
+#include <string.h>
+
 #include "ppapi/c/pp_bool.h"
 #include "ppapi/c/pp_point.h"
 #include "ppapi/c/pp_rect.h"
@@ -29,7 +31,8 @@ Graphics2DResource::Graphics2DResource(Connection connection,
     : PluginResource(connection, instance),
       size_(size),
       is_always_opaque_(is_always_opaque),
-      scale_(1.0f) {
+      scale_(1.0f),
+      batch_operations_(false) {
   // These checks are copied from PPB_ImageData_Impl::Init to make tests passed.
   // Let's remove/refactor this when start to refactor ImageData.
   bool bad_args =
@@ -55,9 +58,29 @@ thunk::PPB_Graphics2D_API* Graphics2DResource::AsPPB_Graphics2D_API() {
   return this;
 }
 
+void Graphics2DResource::OnReplyReceived(
+    const ResourceMessageReplyParams& params,
+    const IPC::Message& msg) {
+  PPAPI_BEGIN_MESSAGE_MAP(Graphics2DResource, msg)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_0(
+        PpapiPluginMsg_Graphics2D_EnableOperations,
+        OnPluginMsgEnableOperations)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_UNHANDLED(
+        PluginResource::OnReplyReceived(params, msg))
+  PPAPI_END_MESSAGE_MAP()
+}
+
 void Graphics2DResource::PaintImageData(PP_Resource image_data,
                                         const PP_Point* top_left,
                                         const PP_Rect* src_rect) {
+  if (batch_operations_) {
+    if (!QueuePaint(image_data, *top_left, src_rect, src_rect ? 1 : 0)) {
+      Log(PP_LOGLEVEL_ERROR,
+          "Graphics2DResource.PaintImageData: Bad image resource.");
+    }
+    return;
+  }
+
   Resource* image_object =
       PpapiGlobals::Get()->GetResourceTracker()->GetResource(image_data);
   if (!image_object || pp_instance() != image_object->pp_instance()) {
@@ -75,10 +98,20 @@ void Graphics2DResource::PaintImageData(PP_Resource image_data,
 
 void Graphics2DResource::Scroll(const PP_Rect* clip_rect,
                                 const PP_Point* amount) {
-  PP_Rect dummy;
-  memset(&dummy, 0, sizeof(PP_Rect));
-  Post(RENDERER, PpapiHostMsg_Graphics2D_Scroll(
-      !!clip_rect, clip_rect ? *clip_rect : dummy, *amount));
+  if (!batch_operations_) {
+    PP_Rect dummy;
+    memset(&dummy, 0, sizeof(PP_Rect));
+    Post(RENDERER, PpapiHostMsg_Graphics2D_Scroll(
+        !!clip_rect, clip_rect ? *clip_rect : dummy, *amount));
+    return;
+  }
+
+  PPB_Graphics2D_Operation operation;
+  operation.type = PPB_Graphics2D_Operation::TYPE_SCROLL;
+  operation.point = *amount;
+  if (clip_rect)
+    operation.rects.push_back(*clip_rect);
+  pending_operations_.push_back(operation);
 }
 
 void Graphics2DResource::ReplaceContents(PP_Resource image_data) {
@@ -97,6 +130,7 @@ void Graphics2DResource::ReplaceContents(PP_Resource image_data) {
   }
   enter_image.object()->SetIsCandidateForReuse();
 
+  SendPendingOperations();
   Post(RENDERER, PpapiHostMsg_Graphics2D_ReplaceContents(
       image_object->host_resource()));
 }
@@ -122,6 +156,8 @@ PP_Bool Graphics2DResource::SetLayerTransform(float scale,
   PP_FloatPoint translate_with_origin;
   translate_with_origin.x = (1 - scale) * origin->x - translate->x;
   translate_with_origin.y = (1 - scale) * origin->y - translate->y;
+  // The host queues the transform along with paints and scrolls.
+  SendPendingOperations();
   Post(RENDERER,
        PpapiHostMsg_Graphics2D_SetLayerTransform(scale, translate_with_origin));
   return PP_TRUE;
@@ -130,13 +166,17 @@ PP_Bool Graphics2DResource::SetLayerTransform(float scale,
 int32_t Graphics2DResource::Flush(scoped_refptr<TrackedCallback> callback) {
   // If host is not even created, return failure immediately.  This can happen
   // when failed to initialize (in constructor).
-  if (!sent_create_to_renderer())
+  if (!sent_create_to_renderer()) {
+    pending_operations_.clear();
+    pending_images_.clear();
     return PP_ERROR_FAILED;
+  }
 
   if (TrackedCallback::IsPending(current_flush_callback_))
     return PP_ERROR_INPROGRESS;  // Can't have >1 flush pending.
   current_flush_callback_ = callback;
 
+  SendPendingOperations();
   Call<PpapiPluginMsg_Graphics2D_FlushAck>(
       RENDERER,
       PpapiHostMsg_Graphics2D_Flush(),
@@ -144,6 +184,23 @@ int32_t Graphics2DResource::Flush(scoped_refptr<TrackedCallback> callback) {
   return PP_OK_COMPLETIONPENDING;
 }
 
+void Graphics2DResource::PaintImageDataRects(PP_Resource image_data,
+                                             const PP_Point* top_left,
+                                             const PP_Rect src_rects[],
+                                             uint32_t num_rects) {
+  if (!src_rects || num_rects == 0)
+    return;
+  if (!batch_operations_) {
+    for (uint32_t i = 0; i < num_rects; ++i)
+      PaintImageData(image_data, top_left, &src_rects[i]);
+    return;
+  }
+  if (!QueuePaint(image_data, *top_left, src_rects, num_rects)) {
+    Log(PP_LOGLEVEL_ERROR,
+        "Graphics2DResource.PaintImageDataRects: Bad image resource.");
+  }
+}
+
 bool Graphics2DResource::ReadImageData(PP_Resource image,
                                        const PP_Point* top_left) {
   if (!top_left)
@@ -154,10 +211,61 @@ bool Graphics2DResource::ReadImageData(PP_Resource image,
   return result == PP_OK;
 }
 
+bool Graphics2DResource::QueuePaint(PP_Resource image_data,
+                                    const PP_Point& top_left,
+                                    const PP_Rect* src_rects,
+                                    uint32_t num_rects) {
+  Resource* image_object =
+      PpapiGlobals::Get()->GetResourceTracker()->GetResource(image_data);
+  if (!image_object || pp_instance() != image_object->pp_instance())
+    return false;
+  const HostResource& host_resource = image_object->host_resource();
+
+  if (!pending_operations_.empty()) {
+    PPB_Graphics2D_Operation& last = pending_operations_.back();
+    if (last.type == PPB_Graphics2D_Operation::TYPE_PAINT &&
+        !(last.image_data != host_resource) &&
+        last.point.x == top_left.x && last.point.y == top_left.y) {
+      // The host only reads the image at Flush() time, so painting the whole
+      // image covers any part of it painted at the same place.
+      if (last.rects.empty())
+        return true;
+      if (src_rects)
+        last.rects.insert(last.rects.end(), src_rects, src_rects + num_rects);
+      else
+        last.rects.clear();
+      return true;
+    }
+  }
+
+  PPB_Graphics2D_Operation operation;
+  operation.type = PPB_Graphics2D_Operation::TYPE_PAINT;
+  operation.image_data = host_resource;
+  operation.point = top_left;
+  if (src_rects)
+    operation.rects.assign(src_rects, src_rects + num_rects);
+  pending_operations_.push_back(operation);
+  pending_images_.push_back(image_object);
+  return true;
+}
+
+void Graphics2DResource::SendPendingOperations() {
+  if (pending_operations_.empty())
+    return;
+  Post(RENDERER, PpapiHostMsg_Graphics2D_Operations(pending_operations_));
+  pending_operations_.clear();
+  pending_images_.clear();
+}
+
 void Graphics2DResource::OnPluginMsgFlushACK(
     const ResourceMessageReplyParams& params) {
   current_flush_callback_->Run(params.result());
 }
 
+void Graphics2DResource::OnPluginMsgEnableOperations(
+    const ResourceMessageReplyParams& params) {
+  batch_operations_ = true;
+}
+
 }  // namespace proxy
 }  // namespace ppapi
@@ -7,10 +7,14 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "ppapi/proxy/plugin_resource.h"
 #include "ppapi/proxy/ppapi_proxy_export.h"
+#include "ppapi/proxy/serialized_structs.h"
 #include "ppapi/thunk/ppb_graphics_2d_api.h"
 
 namespace ppapi {
@@ -32,6 +36,10 @@ class PPAPI_PROXY_EXPORT Graphics2DResource : public PluginResource,
   // Resource overrides.
   thunk::PPB_Graphics2D_API* AsPPB_Graphics2D_API() override;
 
+  // PluginResource overrides.
+  void OnReplyReceived(const ResourceMessageReplyParams& params,
+                       const IPC::Message& msg) override;
+
   // PPB_Graphics2D_API overrides.
   PP_Bool Describe(PP_Size* size, PP_Bool* is_always_opaque) override;
   void PaintImageData(PP_Resource image_data,
@@ -45,10 +53,25 @@ class PPAPI_PROXY_EXPORT Graphics2DResource : public PluginResource,
                             const PP_Point* origin,
                             const PP_Point* translate) override;
   int32_t Flush(scoped_refptr<TrackedCallback> callback) override;
+  void PaintImageDataRects(PP_Resource image_data,
+                           const PP_Point* top_left,
+                           const PP_Rect src_rects[],
+                           uint32_t num_rects) override;
   bool ReadImageData(PP_Resource image, const PP_Point* top_left) override;
 
  private:
+  // Queues a paint of |num_rects| rects of |image_data|, or of the whole image
+  // if |src_rects| is null. Returns false if |image_data| is bad.
+  bool QueuePaint(PP_Resource image_data,
+                  const PP_Point& top_left,
+                  const PP_Rect* src_rects,
+                  uint32_t num_rects);
+  // Sends the queued paints and scrolls to the host. Called before Flush(),
+  // and before any other call the host orders against them.
+  void SendPendingOperations();
+
   void OnPluginMsgFlushACK(const ResourceMessageReplyParams& params);
+  void OnPluginMsgEnableOperations(const ResourceMessageReplyParams& params);
 
   const PP_Size size_;
   const PP_Bool is_always_opaque_;
@@ -56,6 +79,19 @@ class PPAPI_PROXY_EXPORT Graphics2DResource : public PluginResource,
 
   scoped_refptr<TrackedCallback> current_flush_callback_;
 
+  // Whether the host handles PpapiHostMsg_Graphics2D_Operations. Until it
+  // says so, paints and scrolls are sent as they are made.
+  bool batch_operations_;
+
+  // PaintImageData() and Scroll() calls since the last Flush(), when
+  // |batch_operations_| is set. They are sent in one message rather than one
+  // each, and consecutive paints from the same image at the same place are
+  // merged into one operation.
+  std::vector<PPB_Graphics2D_Operation> pending_operations_;
+  // The images painted by |pending_operations_|, kept alive until the
+  // operations are sent in case the plugin releases them before Flush().
+  std::vector<scoped_refptr<Resource>> pending_images_;
+
   DISALLOW_COPY_AND_ASSIGN(Graphics2DResource);
 };
 
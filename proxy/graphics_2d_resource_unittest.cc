@@ -0,0 +1,129 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ppapi/c/dev/ppb_graphics_2d_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/c/ppb_graphics_2d.h"
+#include "ppapi/proxy/locking_resource_releaser.h"
+#include "ppapi/proxy/plugin_message_filter.h"
+#include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/proxy/ppb_image_data_proxy.h"
+#include "ppapi/shared_impl/proxy_lock.h"
+#include "ppapi/thunk/thunk.h"
+
+namespace ppapi {
+namespace proxy {
+
+namespace {
+
+typedef PluginProxyTest Graphics2DResourceTest;
+
+const PP_Size kSize = { 16, 16 };
+
+void Callback(void* user_data, int32_t result) {}
+
+// Makes a plugin-side image data resource with a fake host resource.
+PP_Resource CreateImageData(PP_Instance instance) {
+  ProxyAutoLock lock;
+  HostResource host_resource;
+  host_resource.SetHostResource(instance, 1);
+  PP_ImageDataDesc desc;
+  desc.format = PP_IMAGEDATAFORMAT_BGRA_PREMUL;
+  desc.size = kSize;
+  desc.stride = kSize.width * 4;
+  return (new SimpleImageData(host_resource, desc,
+                              base::SharedMemoryHandle()))->GetReference();
+}
+
+}  // namespace
+
+// Until the host says it handles batches, each paint and scroll is sent as
+// its own message.
+TEST_F(Graphics2DResourceTest, SendsOperationsSeparately) {
+  const PPB_Graphics2D_1_2* graphics_iface =
+      thunk::GetPPB_Graphics2D_1_2_Thunk();
+  const PPB_Graphics2D_Dev_0_1* graphics_dev_iface =
+      thunk::GetPPB_Graphics2D_Dev_0_1_Thunk();
+  LockingResourceReleaser graphics(
+      graphics_iface->Create(pp_instance(), &kSize, PP_FALSE));
+  LockingResourceReleaser image(CreateImageData(pp_instance()));
+
+  PP_Point top_left = { 0, 0 };
+  PP_Rect rects[2] = { { { 0, 0 }, { 4, 4 } }, { { 8, 8 }, { 4, 4 } } };
+  graphics_iface->PaintImageData(graphics.get(), image.get(), &top_left,
+                                 NULL);
+  graphics_dev_iface->PaintImageDataRects(graphics.get(), image.get(),
+                                          &top_left, rects, 2);
+  PP_Point amount = { 1, 1 };
+  graphics_iface->Scroll(graphics.get(), NULL, &amount);
+
+  EXPECT_EQ(3u, sink().GetAllResourceCallsMatching(
+      PpapiHostMsg_Graphics2D_PaintImageData::ID).size());
+  EXPECT_EQ(1u, sink().GetAllResourceCallsMatching(
+      PpapiHostMsg_Graphics2D_Scroll::ID).size());
+
+  EXPECT_EQ(PP_OK_COMPLETIONPENDING,
+            graphics_iface->Flush(graphics.get(),
+                                  PP_MakeCompletionCallback(&Callback, NULL)));
+  EXPECT_TRUE(sink().GetAllResourceCallsMatching(
+      PpapiHostMsg_Graphics2D_Operations::ID).empty());
+}
+
+// Once the host says it handles batches, the operations are held until the
+// flush and sent in one message.
+TEST_F(Graphics2DResourceTest, BatchesOperations) {
+  const PPB_Graphics2D_1_2* graphics_iface =
+      thunk::GetPPB_Graphics2D_1_2_Thunk();
+  const PPB_Graphics2D_Dev_0_1* graphics_dev_iface =
+      thunk::GetPPB_Graphics2D_Dev_0_1_Thunk();
+  LockingResourceReleaser graphics(
+      graphics_iface->Create(pp_instance(), &kSize, PP_FALSE));
+  LockingResourceReleaser image(CreateImageData(pp_instance()));
+
+  ResourceMessageReplyParams reply_params(graphics.get(), 0);
+  PluginMessageFilter::DispatchResourceReplyForTest(
+      reply_params, PpapiPluginMsg_Graphics2D_EnableOperations());
+
+  PP_Point top_left = { 0, 0 };
+  PP_Rect rect = { { 0, 0 }, { 4, 4 } };
+  PP_Rect rects[2] = { { { 8, 8 }, { 4, 4 } }, { { 12, 0 }, { 4, 4 } } };
+  graphics_iface->PaintImageData(graphics.get(), image.get(), &top_left,
+                                 &rect);
+  graphics_dev_iface->PaintImageDataRects(graphics.get(), image.get(),
+                                          &top_left, rects, 2);
+  PP_Point amount = { 1, 1 };
+  graphics_iface->Scroll(graphics.get(), NULL, &amount);
+
+  EXPECT_TRUE(sink().GetAllResourceCallsMatching(
+      PpapiHostMsg_Graphics2D_PaintImageData::ID).empty());
+  EXPECT_TRUE(sink().GetAllResourceCallsMatching(
+      PpapiHostMsg_Graphics2D_Scroll::ID).empty());
+
+  EXPECT_EQ(PP_OK_COMPLETIONPENDING,
+            graphics_iface->Flush(graphics.get(),
+                                  PP_MakeCompletionCallback(&Callback, NULL)));
+
+  ResourceMessageCallParams params;
+  IPC::Message msg;
+  ASSERT_TRUE(sink().GetFirstResourceCallMatching(
+      PpapiHostMsg_Graphics2D_Operations::ID, &params, &msg));
+  std::vector<PPB_Graphics2D_Operation> operations;
+  ASSERT_TRUE(UnpackMessage<PpapiHostMsg_Graphics2D_Operations>(
+      msg, &operations));
+
+  // The three rects painted from the same place become one operation.
+  ASSERT_EQ(2u, operations.size());
+  EXPECT_EQ(PPB_Graphics2D_Operation::TYPE_PAINT, operations[0].type);
+  EXPECT_EQ(3u, operations[0].rects.size());
+  EXPECT_EQ(PPB_Graphics2D_Operation::TYPE_SCROLL, operations[1].type);
+  EXPECT_TRUE(operations[1].rects.empty());
+}
+
+}  // namespace proxy
+}  // namespace ppapi
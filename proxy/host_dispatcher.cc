@@ -6,15 +6,25 @@
 
 #include <stddef.h>
 
+#include <memory>
+#include <utility>
+
 #include "base/logging.h"
+#include "base/memory/shared_memory.h"
 #include "base/trace_event/trace_event.h"
+#include "ppapi/c/pp_errors.h"
 #include "ppapi/c/ppb_var.h"
 #include "ppapi/c/private/ppb_proxy_private.h"
 #include "ppapi/proxy/host_var_serialization_rules.h"
 #include "ppapi/proxy/interface_list.h"
 #include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/raw_var_data.h"
 #include "ppapi/proxy/resource_creation_proxy.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
+#include "ppapi/shared_impl/scoped_pp_resource.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppb_buffer_api.h"
+#include "ppapi/thunk/resource_creation_api.h"
 
 namespace ppapi {
 namespace proxy {
@@ -45,6 +55,44 @@ PP_Bool ReserveInstanceID(PP_Module module, PP_Instance instance) {
   return PP_FromBool(usable);
 }
 
+// Creates the shared memory for var graphs sent to the plugin. Like
+// PPB_Buffer_Proxy, this takes it from a buffer resource, since the host var
+// tracker doesn't create shared memory itself. The region keeps a mapping of
+// its own, so the buffer can go away.
+bool CreateGraphRegion(PP_Instance instance,
+                       uint32_t size,
+                       std::unique_ptr<base::SharedMemory>* region,
+                       base::SharedMemoryHandle* plugin_handle) {
+  HostDispatcher* dispatcher = HostDispatcher::GetForInstance(instance);
+  if (!dispatcher)
+    return false;
+  thunk::EnterResourceCreationNoLock enter(instance);
+  if (enter.failed())
+    return false;
+  ScopedPPResource buffer(ScopedPPResource::PassRef(),
+                          enter.functions()->CreateBuffer(instance, size));
+  if (!buffer.get())
+    return false;
+  thunk::EnterResourceNoLock<thunk::PPB_Buffer_API> enter_buffer(buffer.get(),
+                                                                 false);
+  if (enter_buffer.failed())
+    return false;
+  base::SharedMemory* buffer_shm;
+  if (enter_buffer.object()->GetSharedMemory(&buffer_shm) != PP_OK)
+    return false;
+
+  std::unique_ptr<base::SharedMemory> mapping(
+      new base::SharedMemory(buffer_shm->handle().Duplicate(), false));
+  if (!mapping->Map(size))
+    return false;
+  *plugin_handle =
+      dispatcher->ShareSharedMemoryHandleWithRemote(buffer_shm->handle());
+  if (!plugin_handle->IsValid())
+    return false;
+  *region = std::move(mapping);
+  return true;
+}
+
 // Saves the state of the given bool and puts it back when it goes out of
 // scope.
 class BoolRestorer {
@@ -74,6 +122,7 @@ HostDispatcher::HostDispatcher(PP_Module module,
   (*g_module_to_dispatcher)[pp_module_] = this;
 
   SetSerializationRules(new HostVarSerializationRules);
+  RawVarDataGraph::SetHostGraphRegionCreator(&CreateGraphRegion);
 
   ppb_proxy_ = reinterpret_cast<const PPB_Proxy_Private*>(
       local_get_interface(PPB_PROXY_PRIVATE_INTERFACE));
@@ -211,6 +260,17 @@ bool HostDispatcher::OnMessageReceived(const IPC::Message& msg) {
 void HostDispatcher::OnChannelError() {
   Dispatcher::OnChannelError();  // Stop using the channel.
 
+  // Var graphs in flight to or from the plugin will never be read now, so
+  // drop the shared memory they were sent in.
+  if (g_instance_to_host_dispatcher) {
+    for (InstanceToHostDispatcherMap::const_iterator it =
+             g_instance_to_host_dispatcher->begin();
+         it != g_instance_to_host_dispatcher->end(); ++it) {
+      if (it->second == this)
+        RawVarDataGraph::DidDeleteInstance(it->first);
+    }
+  }
+
   // Tell the host about the crash so it can clean up and display notification.
   ppb_proxy_->PluginCrashed(pp_module());
 }
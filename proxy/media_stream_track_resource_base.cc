@@ -37,9 +37,25 @@ MediaStreamTrackResourceBase::~MediaStreamTrackResourceBase() {
 
 void MediaStreamTrackResourceBase::SendEnqueueBufferMessageToHost(
     int32_t index) {
-  DCHECK_GE(index, 0);
-  DCHECK_LT(index, buffer_manager()->number_of_buffers());
-  Post(RENDERER, PpapiHostMsg_MediaStreamTrack_EnqueueBuffer(index));
+  SendEnqueueBuffersMessageToHost(std::vector<int32_t>(1, index));
+}
+
+void MediaStreamTrackResourceBase::SendEnqueueBuffersMessageToHost(
+    const std::vector<int32_t>& indices) {
+  bool wake_up_host = false;
+  for (int32_t index : indices) {
+    DCHECK_GE(index, 0);
+    DCHECK_LT(index, buffer_manager()->number_of_buffers());
+    bool wake_up = false;
+    if (buffer_manager_.has_rings() &&
+        buffer_manager_.PushBufferToPeer(index, &wake_up)) {
+      wake_up_host |= wake_up;
+    } else {
+      Post(RENDERER, PpapiHostMsg_MediaStreamTrack_EnqueueBuffer(index));
+    }
+  }
+  if (wake_up_host)
+    Post(RENDERER, PpapiHostMsg_MediaStreamTrack_WakeUp());
 }
 
 void MediaStreamTrackResourceBase::OnReplyReceived(
@@ -53,6 +69,11 @@ void MediaStreamTrackResourceBase::OnReplyReceived(
     PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL(
         PpapiPluginMsg_MediaStreamTrack_EnqueueBuffers,
         OnPluginMsgEnqueueBuffers)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL(
+        PpapiPluginMsg_MediaStreamTrack_InitBuffersWithRings,
+        OnPluginMsgInitBuffersWithRings)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_0(
+        PpapiPluginMsg_MediaStreamTrack_WakeUp, OnPluginMsgWakeUp)
     PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_UNHANDLED(
         PluginResource::OnReplyReceived(params, msg))
   PPAPI_END_MESSAGE_MAP()
@@ -78,6 +99,24 @@ void MediaStreamTrackResourceBase::OnPluginMsgInitBuffers(
                              false);
 }
 
+void MediaStreamTrackResourceBase::OnPluginMsgInitBuffersWithRings(
+    const ResourceMessageReplyParams& params,
+    int32_t number_of_buffers,
+    int32_t buffer_size) {
+  base::SharedMemoryHandle shm_handle;
+  params.TakeSharedMemoryHandleAtIndex(0, &shm_handle);
+  buffer_manager_.SetBuffersWithRings(
+      number_of_buffers, buffer_size,
+      std::unique_ptr<base::SharedMemory>(
+          new base::SharedMemory(shm_handle, false)),
+      false, MediaStreamBufferManager::RING_SIDE_PLUGIN);
+}
+
+void MediaStreamTrackResourceBase::OnPluginMsgWakeUp(
+    const ResourceMessageReplyParams& params) {
+  buffer_manager_.OnWakeUp();
+}
+
 void MediaStreamTrackResourceBase::OnPluginMsgEnqueueBuffer(
     const ResourceMessageReplyParams& params,
     int32_t index) {
@@ -87,8 +126,7 @@ void MediaStreamTrackResourceBase::OnPluginMsgEnqueueBuffer(
 void MediaStreamTrackResourceBase::OnPluginMsgEnqueueBuffers(
     const ResourceMessageReplyParams& params,
     const std::vector<int32_t>& indices) {
-  for (size_t i = 0; i < indices.size(); ++i)
-    buffer_manager_.EnqueueBuffer(indices[i]);
+  buffer_manager_.EnqueueBuffers(indices);
 }
 
 }  // namespace proxy
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "base/macros.h"
 #include "ppapi/proxy/plugin_resource.h"
 #include "ppapi/proxy/ppapi_proxy_export.h"
@@ -38,12 +40,18 @@ class PPAPI_PROXY_EXPORT MediaStreamTrackResourceBase
 
   void CloseInternal();
 
-  // Sends a buffer index to the corresponding PepperMediaStreamTrackHostBase
-  // via an IPC message. The host adds the buffer index into its
+  // Sends a buffer index to the corresponding PepperMediaStreamTrackHostBase,
+  // through the shared memory ring if the host set one up and via an IPC
+  // message otherwise. The host adds the buffer index into its
   // |buffer_manager_| for reading or writing.
   // Also see |MediaStreamBufferManager|.
   void SendEnqueueBufferMessageToHost(int32_t index);
 
+  // Like SendEnqueueBufferMessageToHost(), but for several buffers at once.
+  // Through the ring this costs at most one IPC message; otherwise each
+  // buffer is still sent in its own message.
+  void SendEnqueueBuffersMessageToHost(const std::vector<int32_t>& indices);
+
   // PluginResource overrides:
   void OnReplyReceived(const ResourceMessageReplyParams& params,
                        const IPC::Message& msg) override;
@@ -54,6 +62,10 @@ class PPAPI_PROXY_EXPORT MediaStreamTrackResourceBase
                               int32_t number_of_buffers,
                               int32_t buffer_size,
                               bool readonly);
+  void OnPluginMsgInitBuffersWithRings(const ResourceMessageReplyParams& params,
+                                       int32_t number_of_buffers,
+                                       int32_t buffer_size);
+  void OnPluginMsgWakeUp(const ResourceMessageReplyParams& params);
   void OnPluginMsgEnqueueBuffer(const ResourceMessageReplyParams& params,
                                 int32_t index);
   void OnPluginMsgEnqueueBuffers(const ResourceMessageReplyParams& params,
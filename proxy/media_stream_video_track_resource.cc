@@ -4,6 +4,9 @@
 
 #include "ppapi/proxy/media_stream_video_track_resource.h"
 
+#include <limits>
+#include <vector>
+
 #include "base/logging.h"
 #include "ppapi/proxy/ppapi_messages.h"
 #include "ppapi/proxy/video_frame_resource.h"
@@ -21,14 +24,18 @@ MediaStreamVideoTrackResource::MediaStreamVideoTrackResource(
     const std::string& id)
     : MediaStreamTrackResourceBase(
         connection, instance, pending_renderer_id, id),
-      get_frame_output_(NULL) {
+      get_frame_output_(NULL),
+      get_frames_output_(NULL),
+      get_frames_max_(0) {
 }
 
 MediaStreamVideoTrackResource::MediaStreamVideoTrackResource(
     Connection connection,
     PP_Instance instance)
     : MediaStreamTrackResourceBase(connection, instance),
-      get_frame_output_(NULL) {
+      get_frame_output_(NULL),
+      get_frames_output_(NULL),
+      get_frames_max_(0) {
   SendCreate(RENDERER, PpapiHostMsg_MediaStreamVideoTrack_Create());
 }
 
@@ -55,10 +62,8 @@ int32_t MediaStreamVideoTrackResource::Configure(
   if (has_ended())
     return PP_ERROR_FAILED;
 
-  if (TrackedCallback::IsPending(configure_callback_) ||
-      TrackedCallback::IsPending(get_frame_callback_)) {
+  if (TrackedCallback::IsPending(configure_callback_) || HasPendingGetFrame())
     return PP_ERROR_INPROGRESS;
-  }
 
   // Do not support configure, if frames are hold by plugin.
   if (!frames_.empty())
@@ -111,10 +116,8 @@ int32_t MediaStreamVideoTrackResource::GetFrame(
   if (has_ended())
     return PP_ERROR_FAILED;
 
-  if (TrackedCallback::IsPending(configure_callback_) ||
-      TrackedCallback::IsPending(get_frame_callback_)) {
+  if (TrackedCallback::IsPending(configure_callback_) || HasPendingGetFrame())
     return PP_ERROR_INPROGRESS;
-  }
 
   *frame = GetVideoFrame();
   if (*frame)
@@ -126,21 +129,7 @@ int32_t MediaStreamVideoTrackResource::GetFrame(
 }
 
 int32_t MediaStreamVideoTrackResource::RecycleFrame(PP_Resource frame) {
-  FrameMap::iterator it = frames_.find(frame);
-  if (it == frames_.end())
-    return PP_ERROR_BADRESOURCE;
-
-  scoped_refptr<VideoFrameResource> frame_resource = it->second;
-  frames_.erase(it);
-
-  if (has_ended())
-    return PP_OK;
-
-  DCHECK_GE(frame_resource->GetBufferIndex(), 0);
-
-  SendEnqueueBufferMessageToHost(frame_resource->GetBufferIndex());
-  frame_resource->Invalidate();
-  return PP_OK;
+  return RecycleFrames(&frame, 1);
 }
 
 void MediaStreamVideoTrackResource::Close() {
@@ -153,6 +142,11 @@ void MediaStreamVideoTrackResource::Close() {
     get_frame_callback_ = NULL;
     get_frame_output_ = 0;
   }
+  if (TrackedCallback::IsPending(get_frames_callback_)) {
+    get_frames_callback_->PostAbort();
+    get_frames_callback_ = NULL;
+    get_frames_output_ = NULL;
+  }
 
   ReleaseFrames();
   MediaStreamTrackResourceBase::CloseInternal();
@@ -169,7 +163,73 @@ int32_t MediaStreamVideoTrackResource::PutFrame(PP_Resource frame) {
   return RecycleFrame(frame);
 }
 
+int32_t MediaStreamVideoTrackResource::GetFrames(
+    PP_Resource frames[],
+    uint32_t max_frames,
+    scoped_refptr<TrackedCallback> callback) {
+  if (has_ended())
+    return PP_ERROR_FAILED;
+
+  if (!frames || max_frames == 0 ||
+      max_frames > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()))
+    return PP_ERROR_BADARGUMENT;
+
+  if (TrackedCallback::IsPending(configure_callback_) || HasPendingGetFrame())
+    return PP_ERROR_INPROGRESS;
+
+  uint32_t count = GetVideoFrames(frames, max_frames);
+  if (count > 0)
+    return static_cast<int32_t>(count);
+
+  get_frames_output_ = frames;
+  get_frames_max_ = max_frames;
+  get_frames_callback_ = callback;
+  return PP_OK_COMPLETIONPENDING;
+}
+
+int32_t MediaStreamVideoTrackResource::RecycleFrames(
+    const PP_Resource frames[],
+    uint32_t num_frames) {
+  if (!frames || num_frames == 0)
+    return PP_ERROR_BADARGUMENT;
+
+  int32_t result = PP_OK;
+  std::vector<int32_t> indices;
+  indices.reserve(num_frames);
+  for (uint32_t i = 0; i < num_frames; ++i) {
+    FrameMap::iterator it = frames_.find(frames[i]);
+    if (it == frames_.end()) {
+      result = PP_ERROR_BADRESOURCE;
+      continue;
+    }
+
+    scoped_refptr<VideoFrameResource> frame_resource = it->second;
+    frames_.erase(it);
+
+    if (has_ended())
+      continue;
+
+    DCHECK_GE(frame_resource->GetBufferIndex(), 0);
+    indices.push_back(frame_resource->GetBufferIndex());
+    frame_resource->Invalidate();
+  }
+
+  if (!indices.empty())
+    SendEnqueueBuffersMessageToHost(indices);
+  return result;
+}
+
 void MediaStreamVideoTrackResource::OnNewBufferEnqueued() {
+  if (TrackedCallback::IsPending(get_frames_callback_)) {
+    uint32_t count = GetVideoFrames(get_frames_output_, get_frames_max_);
+    int32_t result = count > 0 ? static_cast<int32_t>(count) : PP_ERROR_FAILED;
+    get_frames_output_ = NULL;
+    scoped_refptr<TrackedCallback> callback;
+    callback.swap(get_frames_callback_);
+    callback->Run(result);
+    return;
+  }
+
   if (!TrackedCallback::IsPending(get_frame_callback_))
     return;
 
@@ -197,6 +257,23 @@ PP_Resource MediaStreamVideoTrackResource::GetVideoFrame() {
   return resource->GetReference();
 }
 
+uint32_t MediaStreamVideoTrackResource::GetVideoFrames(PP_Resource frames[],
+                                                      uint32_t max_frames) {
+  uint32_t count = 0;
+  while (count < max_frames) {
+    PP_Resource frame = GetVideoFrame();
+    if (!frame)
+      break;
+    frames[count++] = frame;
+  }
+  return count;
+}
+
+bool MediaStreamVideoTrackResource::HasPendingGetFrame() const {
+  return TrackedCallback::IsPending(get_frame_callback_) ||
+         TrackedCallback::IsPending(get_frames_callback_);
+}
+
 void MediaStreamVideoTrackResource::ReleaseFrames() {
   for (FrameMap::iterator it = frames_.begin(); it != frames_.end(); ++it) {
     // Just invalidate and release VideoFrameResorce, but keep PP_Resource.
@@ -51,6 +51,11 @@ class PPAPI_PROXY_EXPORT MediaStreamVideoTrackResource
   int32_t GetEmptyFrame(PP_Resource* frame,
                         scoped_refptr<TrackedCallback> callback) override;
   int32_t PutFrame(PP_Resource frame) override;
+  int32_t GetFrames(PP_Resource frames[],
+                    uint32_t max_frames,
+                    scoped_refptr<TrackedCallback> callback) override;
+  int32_t RecycleFrames(const PP_Resource frames[],
+                        uint32_t num_frames) override;
 
   // MediaStreamBufferManager::Delegate overrides:
   void OnNewBufferEnqueued() override;
@@ -58,6 +63,11 @@ class PPAPI_PROXY_EXPORT MediaStreamVideoTrackResource
  private:
   PP_Resource GetVideoFrame();
 
+  // Stores up to |max_frames| frames in |frames|, and returns how many.
+  uint32_t GetVideoFrames(PP_Resource frames[], uint32_t max_frames);
+
+  bool HasPendingGetFrame() const;
+
   void ReleaseFrames();
 
   // IPC message handlers.
@@ -71,6 +81,10 @@ class PPAPI_PROXY_EXPORT MediaStreamVideoTrackResource
   PP_Resource* get_frame_output_;
   scoped_refptr<TrackedCallback> get_frame_callback_;
 
+  PP_Resource* get_frames_output_;
+  uint32_t get_frames_max_;
+  scoped_refptr<TrackedCallback> get_frames_callback_;
+
   scoped_refptr<TrackedCallback> configure_callback_;
 
   DISALLOW_COPY_AND_ASSIGN(MediaStreamVideoTrackResource);
@@ -4,11 +4,15 @@
 
 #include "ppapi/proxy/plugin_globals.h"
 
+#include "base/command_line.h"
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
 #include "base/task_runner.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "build/build_config.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_sender.h"
 #include "ppapi/proxy/plugin_dispatcher.h"
@@ -19,12 +23,21 @@
 #include "ppapi/proxy/resource_reply_thread_registrar.h"
 #include "ppapi/proxy/udp_socket_filter.h"
 #include "ppapi/shared_impl/ppapi_constants.h"
+#include "ppapi/shared_impl/ppapi_switches.h"
 #include "ppapi/shared_impl/proxy_lock.h"
 #include "ppapi/thunk/enter.h"
 
 namespace ppapi {
 namespace proxy {
 
+namespace {
+
+// The number of threads that file operations able to run in parallel are
+// spread over.
+const size_t kParallelFileThreadCount = 4;
+
+}  // namespace
+
 // It performs necessary locking/unlocking of the proxy lock, and forwards all
 // messages to the underlying sender.
 class PluginGlobals::BrowserSender : public IPC::Sender {
@@ -69,6 +82,12 @@ PluginGlobals::PluginGlobals(
   DCHECK(!plugin_globals_);
   plugin_globals_ = this;
 
+#if !defined(OS_NACL)
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableProxyLockInstrumentation))
+    ProxyLock::EnableInstrumentation();
+#endif
+
   // ResourceTracker asserts that we have the lock when we add new resources,
   // so we lock when creating the MessageLoopResource even though there is no
   // chance of race conditions.
@@ -92,6 +111,8 @@ PluginGlobals::PluginGlobals(
 
 PluginGlobals::~PluginGlobals() {
   DCHECK(plugin_globals_ == this || !plugin_globals_);
+  if (ProxyLock::IsInstrumentationEnabled())
+    VLOG(1) << "ProxyLock usage:\n" << ProxyLock::GetInstrumentationReport();
   {
     ProxyAutoLock lock;
     // Release the main-thread message loop. We should have the last reference
@@ -180,6 +201,24 @@ base::TaskRunner* PluginGlobals::GetFileTaskRunner() {
   return file_thread_->task_runner().get();
 }
 
+base::TaskRunner* PluginGlobals::GetParallelFileTaskRunner(size_t index) {
+  index %= kParallelFileThreadCount;
+  if (index == 0)
+    return GetFileTaskRunner();
+
+  if (parallel_file_threads_.empty())
+    parallel_file_threads_.resize(kParallelFileThreadCount - 1);
+  std::unique_ptr<base::Thread>& thread = parallel_file_threads_[index - 1];
+  if (!thread) {
+    thread.reset(new base::Thread(
+        base::StringPrintf("Plugin::File%d", static_cast<int>(index))));
+    base::Thread::Options options;
+    options.message_loop_type = base::MessageLoop::TYPE_IO;
+    thread->StartWithOptions(options);
+  }
+  return thread->task_runner().get();
+}
+
 IPC::Sender* PluginGlobals::GetBrowserSender() {
   // CAUTION: This function is called without the ProxyLock. See also
   // InterfaceList::GetInterfaceForPPB.
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
@@ -77,6 +78,7 @@ class PPAPI_PROXY_EXPORT PluginGlobals : public PpapiGlobals {
                               const std::string& value) override;
   MessageLoopShared* GetCurrentMessageLoop() override;
   base::TaskRunner* GetFileTaskRunner() override;
+  base::TaskRunner* GetParallelFileTaskRunner(size_t index) override;
 
   // Returns the channel for sending to the browser.
   IPC::Sender* GetBrowserSender();
@@ -182,6 +184,10 @@ class PPAPI_PROXY_EXPORT PluginGlobals : public PpapiGlobals {
   // lazily, since it might not be needed.
   std::unique_ptr<base::Thread> file_thread_;
 
+  // Further threads for file operations that may run in parallel, also
+  // created lazily. |file_thread_| is the first of the set.
+  std::vector<std::unique_ptr<base::Thread>> parallel_file_threads_;
+
   scoped_refptr<ResourceReplyThreadRegistrar> resource_reply_thread_registrar_;
 
   scoped_refptr<UDPSocketFilter> udp_socket_filter_;
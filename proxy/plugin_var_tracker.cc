@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <utility>
+
 #include "base/memory/ref_counted.h"
 #include "base/memory/singleton.h"
 #include "ipc/ipc_message.h"
@@ -20,6 +22,7 @@
 #include "ppapi/proxy/plugin_resource_var.h"
 #include "ppapi/proxy/ppapi_messages.h"
 #include "ppapi/proxy/proxy_object_var.h"
+#include "ppapi/proxy/raw_var_data.h"
 #include "ppapi/shared_impl/api_id.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 #include "ppapi/shared_impl/proxy_lock.h"
@@ -290,6 +293,8 @@ void PluginVarTracker::DidDeleteInstance(PP_Instance instance) {
       found->second.instance = 0;
     }
   }
+
+  RawVarDataGraph::DidDeleteInstance(instance);
 }
 
 void PluginVarTracker::DidDeleteDispatcher(PluginDispatcher* dispatcher) {
@@ -513,5 +518,32 @@ bool PluginVarTracker::StopTrackingSharedMemoryHandle(
   return false;
 }
 
+bool PluginVarTracker::CreateSharedMemoryForTransfer(
+    PP_Instance instance,
+    uint32_t size_in_bytes,
+    std::unique_ptr<base::SharedMemory>* shm,
+    int* host_handle_id,
+    base::SharedMemoryHandle* plugin_handle) {
+  PluginDispatcher* dispatcher = PluginDispatcher::GetForInstance(instance);
+  if (!dispatcher)
+    return false;
+
+  // The host creates the region and keeps it under |host_handle_id| until the
+  // message naming it arrives; we keep our own mapping to write into.
+  SerializedHandle handle;
+  dispatcher->Send(new PpapiHostMsg_SharedMemory_CreateSharedMemory(
+      instance, size_in_bytes, host_handle_id, &handle));
+  if (!handle.IsHandleValid() || !handle.is_shmem() || *host_handle_id == -1)
+    return false;
+
+  std::unique_ptr<base::SharedMemory> region(
+      new base::SharedMemory(handle.shmem(), false));
+  if (!region->Map(size_in_bytes))
+    return false;
+  *shm = std::move(region);
+  *plugin_handle = base::SharedMemoryHandle();
+  return true;
+}
+
 }  // namesace proxy
 }  // namespace ppapi
@@ -6,6 +6,7 @@
 #define PPAPI_PROXY_PLUGIN_VAR_TRACKER_H_
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "base/compiler_specific.h"
@@ -75,6 +76,12 @@ class PPAPI_PROXY_EXPORT PluginVarTracker : public VarTracker {
                                       PP_Instance instance,
                                       base::SharedMemoryHandle* handle,
                                       uint32_t* size_in_bytes) override;
+  bool CreateSharedMemoryForTransfer(
+      PP_Instance instance,
+      uint32_t size_in_bytes,
+      std::unique_ptr<base::SharedMemory>* shm,
+      int* host_handle_id,
+      base::SharedMemoryHandle* plugin_handle) override;
 
   // Notification that a plugin-implemented object (PPP_Class) was created by
   // the plugin or deallocated by WebKit over IPC.
@@ -147,6 +147,8 @@ IPC_ENUM_TRAITS_MAX_VALUE(PP_HardwareAcceleration, PP_HARDWAREACCELERATION_LAST)
 IPC_ENUM_TRAITS_MAX_VALUE(PP_AudioProfile, PP_AUDIOPROFILE_MAX)
 IPC_ENUM_TRAITS_MAX_VALUE(PP_VideoProfile, PP_VIDEOPROFILE_MAX)
 IPC_ENUM_TRAITS_MAX_VALUE(PP_PrivateDirection, PP_PRIVATEDIRECTION_LAST)
+IPC_ENUM_TRAITS_MAX_VALUE(ppapi::proxy::PPB_Graphics2D_Operation::Type,
+                          ppapi::proxy::PPB_Graphics2D_Operation::TYPE_LAST)
 
 IPC_STRUCT_TRAITS_BEGIN(PP_Point)
   IPC_STRUCT_TRAITS_MEMBER(x)
@@ -529,6 +531,13 @@ IPC_STRUCT_TRAITS_BEGIN(ppapi::CompositorLayerData::Transform)
   IPC_STRUCT_TRAITS_MEMBER(matrix)
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(ppapi::proxy::PPB_Graphics2D_Operation)
+  IPC_STRUCT_TRAITS_MEMBER(type)
+  IPC_STRUCT_TRAITS_MEMBER(image_data)
+  IPC_STRUCT_TRAITS_MEMBER(point)
+  IPC_STRUCT_TRAITS_MEMBER(rects)
+IPC_STRUCT_TRAITS_END()
+
 #if !defined(OS_NACL) && !defined(NACL_WIN64)
 
 IPC_STRUCT_TRAITS_BEGIN(ppapi::proxy::PPPDecryptor_Buffer)
@@ -1630,6 +1639,16 @@ IPC_MESSAGE_CONTROL1(PpapiHostMsg_Graphics2D_SetScale,
 IPC_MESSAGE_CONTROL2(PpapiHostMsg_Graphics2D_SetLayerTransform,
                      float /* scale */,
                      PP_FloatPoint /* translate */)
+// The PaintImageData and Scroll calls made since the last flush, in order.
+// Handled as if each had been sent as its own message.
+IPC_MESSAGE_CONTROL1(
+    PpapiHostMsg_Graphics2D_Operations,
+    std::vector<ppapi::proxy::PPB_Graphics2D_Operation> /* operations */)
+
+// Graphics2D, host -> plugin
+// Sent by a host that handles PpapiHostMsg_Graphics2D_Operations. Until it
+// arrives the plugin sends each PaintImageData and Scroll as its own message.
+IPC_MESSAGE_CONTROL0(PpapiPluginMsg_Graphics2D_EnableOperations)
 
 // Graphics2D, plugin -> host -> plugin
 IPC_MESSAGE_CONTROL0(PpapiHostMsg_Graphics2D_Flush)
@@ -1689,6 +1708,15 @@ IPC_MESSAGE_CONTROL1(PpapiHostMsg_MediaStreamTrack_EnqueueBuffer,
                      int32_t /* index */)
 IPC_MESSAGE_CONTROL1(PpapiPluginMsg_MediaStreamTrack_EnqueueBuffers,
                      std::vector<int32_t> /* indices */)
+// Like InitBuffers, but the shared memory is writable and also holds the index
+// rings laid out by MediaStreamBufferManager::SetBuffersWithRings(). Buffers
+// are then passed through the rings, and the WakeUp messages are only sent to
+// a side that is waiting for buffers.
+IPC_MESSAGE_CONTROL2(PpapiPluginMsg_MediaStreamTrack_InitBuffersWithRings,
+                     int32_t /* number_of_buffers */,
+                     int32_t /* buffer_size */)
+IPC_MESSAGE_CONTROL0(PpapiPluginMsg_MediaStreamTrack_WakeUp)
+IPC_MESSAGE_CONTROL0(PpapiHostMsg_MediaStreamTrack_WakeUp)
 IPC_MESSAGE_CONTROL0(PpapiHostMsg_MediaStreamTrack_Close)
 
 // NetworkMonitor.
@@ -1848,6 +1876,19 @@ IPC_MESSAGE_CONTROL2(PpapiHostMsg_UDPSocket_SendTo,
                      PP_NetAddress_Private /* net_addr */)
 IPC_MESSAGE_CONTROL1(PpapiPluginMsg_UDPSocket_SendToReply,
                      int32_t /* bytes_written */)
+// Sends the datagrams in order, as if each had been sent with SendTo. The
+// payloads are stored back to back in |data|, which the plugin keeps under
+// UDPSocketResourceConstants::kMaxSendBatchSize. The reply's result is that of
+// the first datagram that failed, if any.
+IPC_MESSAGE_CONTROL3(PpapiHostMsg_UDPSocket_SendToBatch,
+                     std::string /* data */,
+                     std::vector<uint32_t> /* sizes */,
+                     std::vector<PP_NetAddress_Private> /* net_addrs */)
+IPC_MESSAGE_CONTROL1(PpapiPluginMsg_UDPSocket_SendToBatchReply,
+                     uint32_t /* datagrams_sent */)
+// Sent by a host that handles PpapiHostMsg_UDPSocket_SendToBatch. Until it
+// arrives the plugin sends each datagram of a batch as its own SendTo message.
+IPC_MESSAGE_CONTROL0(PpapiPluginMsg_UDPSocket_EnableSendToBatch)
 IPC_MESSAGE_CONTROL0(PpapiHostMsg_UDPSocket_Close)
 IPC_MESSAGE_CONTROL1(PpapiHostMsg_UDPSocket_JoinGroup,
                      PP_NetAddress_Private /* net_addr */)
@@ -2039,6 +2080,12 @@ IPC_MESSAGE_CONTROL4(PpapiHostMsg_VideoDecoder_Initialize,
                      PP_HardwareAcceleration /* acceleration */,
                      uint32_t /* min_picture_count */)
 IPC_MESSAGE_CONTROL0(PpapiPluginMsg_VideoDecoder_InitializeReply)
+// Sent before Initialize to replace kMaximumPendingDecodes and
+// kMaximumBitstreamBufferSize for this decoder.
+IPC_MESSAGE_CONTROL2(PpapiHostMsg_VideoDecoder_SetPipelineOptions,
+                     uint32_t /* max_pending_decodes */,
+                     uint32_t /* max_bitstream_buffer_size */)
+IPC_MESSAGE_CONTROL0(PpapiPluginMsg_VideoDecoder_SetPipelineOptionsReply)
 IPC_MESSAGE_CONTROL2(PpapiHostMsg_VideoDecoder_GetShm,
                      uint32_t /* shm_id */,
                      uint32_t /* shm_size */)
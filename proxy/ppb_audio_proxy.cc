@@ -327,6 +327,10 @@ void PPB_Audio_Proxy::OnMsgNotifyAudioStreamCreated(
   } else {
     EnterResourceNoLock<PPB_AudioConfig_API> config(
         static_cast<Audio*>(enter.object())->GetCurrentConfig(), true);
+    if (config.succeeded()) {
+      static_cast<Audio*>(enter.object())
+          ->SetSampleFormat(config.object()->GetSampleFormat());
+    }
     static_cast<Audio*>(enter.object())
         ->SetStreamInfo(enter.resource()->pp_instance(),
                         base::UnsafeSharedMemoryRegion::Deserialize(
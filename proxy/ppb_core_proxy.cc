@@ -27,14 +27,22 @@ namespace proxy {
 
 namespace {
 
+// These only take the ProxyLock if the plugin refcount goes to or from zero;
+// see ResourceTracker::AddRefResourceWithoutProxyLock.
 void AddRefResource(PP_Resource resource) {
+  ResourceTracker* tracker = PpapiGlobals::Get()->GetResourceTracker();
+  if (tracker->AddRefResourceWithoutProxyLock(resource))
+    return;
   ppapi::ProxyAutoLock lock;
-  PpapiGlobals::Get()->GetResourceTracker()->AddRefResource(resource);
+  tracker->AddRefResource(resource);
 }
 
 void ReleaseResource(PP_Resource resource) {
+  ResourceTracker* tracker = PpapiGlobals::Get()->GetResourceTracker();
+  if (tracker->ReleaseResourceWithoutProxyLock(resource))
+    return;
   ppapi::ProxyAutoLock lock;
-  PpapiGlobals::Get()->GetResourceTracker()->ReleaseResource(resource);
+  tracker->ReleaseResource(resource);
 }
 
 double GetTime() {
@@ -6,7 +6,9 @@
 
 #include <string.h>  // For memcpy
 
+#include <deque>
 #include <map>
+#include <tuple>
 #include <vector>
 
 #include "base/logging.h"
@@ -63,8 +65,7 @@ namespace {
 //    it as usable.
 // 6. When the plugin requests a new image data, we check our queue and if there
 //    is a usable ImageData of the right size and format, we'll return it
-//    instead of making a new one. It's important that caching is only requested
-//    when the size is unlikely to change, so cache hits are high.
+//    instead of making a new one.
 //
 // Some notes:
 //
@@ -89,22 +90,41 @@ namespace {
 //  - We generate new resource IDs when re-use happens to try to avoid weird
 //    problems if the plugin messes up its refcounting.
 
+//  - Each instance has a pool of image datas bucketed by type, format and
+//    size, so plugins that alternate between several sizes (e.g. tiles) still
+//    get re-use. The pool is bounded by a memory budget; when adding an image
+//    would exceed it, the oldest images are dropped first.
+//
+//  - The pool can be pre-warmed with image datas of a given size so that the
+//    first frames don't have to allocate either. Pre-warmed images age like
+//    any other entry, and their creation doesn't count as a cache miss.
+
 // Keep a cache entry for this many seconds before expiring it. We get an entry
 // back from the renderer after an ImageData is swapped out, so it means the
 // plugin has to be painting at least two frames for this time interval to
 // get caching.
 static const int kMaxAgeSeconds = 2;
 
+// The default amount of image memory each instance may keep for re-use.
+static const size_t kDefaultCacheBudgetBytes = 32 * 1024 * 1024;
+
+size_t GetImageDataByteSize(const ImageData* image_data) {
+  const PP_ImageDataDesc& desc = image_data->desc();
+  return static_cast<size_t>(desc.stride) * desc.size.height;
+}
+
 // ImageDataCacheEntry ---------------------------------------------------------
 
 struct ImageDataCacheEntry {
   ImageDataCacheEntry() : usable(false) {}
-  explicit ImageDataCacheEntry(ImageData* i)
-      : added_time(base::TimeTicks::Now()), usable(false), image(i) {}
+  ImageDataCacheEntry(ImageData* i, bool usable)
+      : added_time(base::TimeTicks::Now()), usable(usable), image(i) {}
 
   base::TimeTicks added_time;
 
   // Set to true when the renderer tells us that it's OK to re-use this iamge.
+  // Images from PrewarmCache() were never sent to the renderer, so they are
+  // usable right away.
   bool usable;
 
   scoped_refptr<ImageData> image;
@@ -112,108 +132,158 @@ struct ImageDataCacheEntry {
 
 // ImageDataInstanceCache ------------------------------------------------------
 
-// Per-instance cache of image datas.
+// Per-instance pool of image datas.
 class ImageDataInstanceCache {
  public:
-  ImageDataInstanceCache() : next_insertion_point_(0) {}
+  ImageDataInstanceCache()
+      : bytes_(0), budget_(kDefaultCacheBudgetBytes), stats_() {}
 
   // These functions have the same spec as the ones in ImageDataCache.
   scoped_refptr<ImageData> Get(PPB_ImageData_Shared::ImageDataType type,
                                int width, int height,
                                PP_ImageDataFormat format);
-  void Add(ImageData* image_data);
+  void Add(ImageData* image_data, bool usable);
   void ImageDataUsable(ImageData* image_data);
+  void SetBudget(size_t budget_bytes);
+  // Returns true if |bytes| more fit in the budget without evicting anything.
+  bool HasRoomFor(size_t bytes) const {
+    return bytes <= budget_ && bytes_ <= budget_ - bytes;
+  }
 
-  // Expires old entries. Returns true if there are still entries in the list,
-  // false if this instance cache is now empty.
+  // Expires old entries. Returns true if there are still entries in the pool,
+  // false if it is now empty.
   bool ExpireEntries();
 
+  const PP_ImageDataCacheStats_Dev& stats() const { return stats_; }
+
  private:
-  void IncrementInsertionPoint();
+  struct BucketKey {
+    BucketKey(PPB_ImageData_Shared::ImageDataType type,
+              PP_ImageDataFormat format,
+              int width,
+              int height)
+        : type(type), format(format), width(width), height(height) {}
+    explicit BucketKey(const ImageData* image_data)
+        : type(image_data->type()),
+          format(image_data->desc().format),
+          width(image_data->desc().size.width),
+          height(image_data->desc().size.height) {}
+
+    bool operator<(const BucketKey& other) const {
+      return std::tie(type, format, width, height) <
+             std::tie(other.type, other.format, other.width, other.height);
+    }
+
+    PPB_ImageData_Shared::ImageDataType type;
+    PP_ImageDataFormat format;
+    int width;
+    int height;
+  };
+  // Entries in each bucket are kept in the order they were added.
+  typedef std::map<BucketKey, std::deque<ImageDataCacheEntry>> BucketMap;
 
-  // We'll store this many ImageDatas per instance.
-  static const size_t kCacheSize = 2;
+  // Drops the oldest entries until |incoming_bytes| more fit in the budget.
+  // Returns false if that isn't possible.
+  bool EvictToFit(size_t incoming_bytes);
+  void Remove(BucketMap::iterator bucket, size_t index);
 
-  ImageDataCacheEntry images_[kCacheSize];
+  BucketMap buckets_;
 
-  // Index into cache where the next item will go.
-  size_t next_insertion_point_;
+  // The total size of the images in |buckets_|.
+  size_t bytes_;
+  size_t budget_;
+
+  PP_ImageDataCacheStats_Dev stats_;
 };
 
 scoped_refptr<ImageData> ImageDataInstanceCache::Get(
     PPB_ImageData_Shared::ImageDataType type,
     int width, int height,
     PP_ImageDataFormat format) {
-  // Just do a brute-force search since the cache is so small.
-  for (size_t i = 0; i < kCacheSize; i++) {
-    if (!images_[i].usable)
-      continue;
-    if (images_[i].image->type() != type)
-      continue;
-    const PP_ImageDataDesc& desc = images_[i].image->desc();
-    if (desc.format == format &&
-        desc.size.width == width && desc.size.height == height) {
-      scoped_refptr<ImageData> ret(images_[i].image);
-      images_[i] = ImageDataCacheEntry();
-
-      // Since we just removed an item, this entry is the best place to insert
-      // a subsequent one.
-      next_insertion_point_ = i;
+  BucketMap::iterator bucket =
+      buckets_.find(BucketKey(type, format, width, height));
+  if (bucket != buckets_.end()) {
+    for (size_t i = 0; i < bucket->second.size(); i++) {
+      if (!bucket->second[i].usable)
+        continue;
+      scoped_refptr<ImageData> ret(bucket->second[i].image);
+      Remove(bucket, i);
+      stats_.hits++;
       return ret;
     }
   }
+  stats_.misses++;
   return scoped_refptr<ImageData>();
 }
 
-void ImageDataInstanceCache::Add(ImageData* image_data) {
-  images_[next_insertion_point_] = ImageDataCacheEntry(image_data);
-  IncrementInsertionPoint();
+void ImageDataInstanceCache::Add(ImageData* image_data, bool usable) {
+  if (!EvictToFit(GetImageDataByteSize(image_data)))
+    return;
+  buckets_[BucketKey(image_data)].push_back(
+      ImageDataCacheEntry(image_data, usable));
+  bytes_ += GetImageDataByteSize(image_data);
+  stats_.bytes_cached = bytes_;
 }
 
 void ImageDataInstanceCache::ImageDataUsable(ImageData* image_data) {
-  for (size_t i = 0; i < kCacheSize; i++) {
-    if (images_[i].image.get() == image_data) {
-      images_[i].usable = true;
-
-      // This test is important. The renderer doesn't guarantee how many image
-      // datas it has or when it notifies us when one is usable. Its possible
-      // to get into situations where it's always telling us the old one is
-      // usable, and then the older one immediately gets expired. Therefore,
-      // if the next insertion would overwrite this now-usable entry, make the
-      // next insertion overwrite some other entry to avoid the replacement.
-      if (next_insertion_point_ == i)
-        IncrementInsertionPoint();
+  BucketMap::iterator bucket = buckets_.find(BucketKey(image_data));
+  if (bucket == buckets_.end())
+    return;
+  for (size_t i = 0; i < bucket->second.size(); i++) {
+    if (bucket->second[i].image.get() == image_data) {
+      bucket->second[i].usable = true;
       return;
     }
   }
 }
 
+void ImageDataInstanceCache::SetBudget(size_t budget_bytes) {
+  budget_ = budget_bytes;
+  EvictToFit(0);
+}
+
 bool ImageDataInstanceCache::ExpireEntries() {
   base::TimeTicks threshold_time =
       base::TimeTicks::Now() - base::TimeDelta::FromSeconds(kMaxAgeSeconds);
 
-  bool has_entry = false;
-  for (size_t i = 0; i < kCacheSize; i++) {
-    if (images_[i].image.get()) {
-      // Entry present.
-      if (images_[i].added_time <= threshold_time) {
-        // Found an entry to expire.
-        images_[i] = ImageDataCacheEntry();
-        next_insertion_point_ = i;
-      } else {
-        // Found an entry that we're keeping.
-        has_entry = true;
-      }
+  for (BucketMap::iterator bucket = buckets_.begin();
+       bucket != buckets_.end();) {
+    // Removing may erase the bucket, so move on to the next one first.
+    BucketMap::iterator current = bucket++;
+    for (size_t i = current->second.size(); i > 0; i--) {
+      const ImageDataCacheEntry& entry = current->second[i - 1];
+      if (entry.added_time <= threshold_time)
+        Remove(current, i - 1);
     }
   }
-  return has_entry;
+  return !buckets_.empty();
+}
+
+bool ImageDataInstanceCache::EvictToFit(size_t incoming_bytes) {
+  if (incoming_bytes > budget_)
+    return false;
+  while (bytes_ + incoming_bytes > budget_) {
+    // Buckets are few, so just look for the oldest entry across them.
+    BucketMap::iterator oldest = buckets_.end();
+    for (BucketMap::iterator it = buckets_.begin(); it != buckets_.end();
+         ++it) {
+      if (oldest == buckets_.end() ||
+          it->second.front().added_time < oldest->second.front().added_time)
+        oldest = it;
+    }
+    DCHECK(oldest != buckets_.end());
+    Remove(oldest, 0);
+    stats_.evictions++;
+  }
+  return true;
 }
 
-void ImageDataInstanceCache::IncrementInsertionPoint() {
-  // Go to the next location, wrapping around to get LRU.
-  next_insertion_point_++;
-  if (next_insertion_point_ >= kCacheSize)
-    next_insertion_point_ = 0;
+void ImageDataInstanceCache::Remove(BucketMap::iterator bucket, size_t index) {
+  bytes_ -= GetImageDataByteSize(bucket->second[index].image.get());
+  stats_.bytes_cached = bytes_;
+  bucket->second.erase(bucket->second.begin() + index);
+  if (bucket->second.empty())
+    buckets_.erase(bucket);
 }
 
 // ImageDataCache --------------------------------------------------------------
@@ -233,12 +303,18 @@ class ImageDataCache {
                                PP_ImageDataFormat format);
 
   // Adds the given image data to the cache. There should be no plugin
-  // references to it. This may delete an older item from the cache.
-  void Add(ImageData* image_data);
+  // references to it. This may delete older items from the cache. Unless
+  // |usable| is set, it can't be handed out again until the renderer says
+  // it's done with it.
+  void Add(ImageData* image_data, bool usable);
 
   // Notification from the renderer that the given image data is usable.
   void ImageDataUsable(ImageData* image_data);
 
+  void SetBudget(PP_Instance instance, size_t budget_bytes);
+  bool HasRoomFor(PP_Instance instance, size_t bytes);
+  PP_ImageDataCacheStats_Dev GetStats(PP_Instance instance);
+
   void DidDeleteInstance(PP_Instance instance);
 
  private:
@@ -270,14 +346,20 @@ scoped_refptr<ImageData> ImageDataCache::Get(
     PPB_ImageData_Shared::ImageDataType type,
     int width, int height,
     PP_ImageDataFormat format) {
+  // Misses are only counted once the instance has a pool. Looking it up
+  // with operator[] would bring back the pool of a deleted instance.
   CacheMap::iterator found = cache_.find(instance);
   if (found == cache_.end())
     return scoped_refptr<ImageData>();
   return found->second.Get(type, width, height, format);
 }
 
-void ImageDataCache::Add(ImageData* image_data) {
-  cache_[image_data->pp_instance()].Add(image_data);
+void ImageDataCache::Add(ImageData* image_data, bool usable) {
+  // An image outlives its instance if the plugin still holds it; it has no
+  // instance by the time it's released.
+  if (!image_data->pp_instance())
+    return;
+  cache_[image_data->pp_instance()].Add(image_data, usable);
 
   // Schedule a timer to invalidate this entry.
   PpapiGlobals::Get()->GetMainThreadMessageLoop()->PostDelayedTask(
@@ -294,18 +376,36 @@ void ImageDataCache::ImageDataUsable(ImageData* image_data) {
     found->second.ImageDataUsable(image_data);
 }
 
+void ImageDataCache::SetBudget(PP_Instance instance, size_t budget_bytes) {
+  // The budget may be set before anything is cached, so this creates the
+  // pool. Callers check that the instance is live first.
+  cache_[instance].SetBudget(budget_bytes);
+}
+
+bool ImageDataCache::HasRoomFor(PP_Instance instance, size_t bytes) {
+  CacheMap::iterator found = cache_.find(instance);
+  if (found == cache_.end())
+    return bytes <= kDefaultCacheBudgetBytes;
+  return found->second.HasRoomFor(bytes);
+}
+
+PP_ImageDataCacheStats_Dev ImageDataCache::GetStats(PP_Instance instance) {
+  CacheMap::iterator found = cache_.find(instance);
+  if (found == cache_.end())
+    return PP_ImageDataCacheStats_Dev();
+  return found->second.stats();
+}
+
 void ImageDataCache::DidDeleteInstance(PP_Instance instance) {
   cache_.erase(instance);
 }
 
 void ImageDataCache::OnTimer(PP_Instance instance) {
+  // The instance's pool is kept even when it becomes empty so that its budget
+  // and stats survive; it's removed in DidDeleteInstance.
   CacheMap::iterator found = cache_.find(instance);
-  if (found == cache_.end())
-    return;
-  if (!found->second.ExpireEntries()) {
-    // There are no more entries for this instance, remove it from the cache.
-    cache_.erase(found);
-  }
+  if (found != cache_.end())
+    found->second.ExpireEntries();
 }
 
 }  // namespace
@@ -333,7 +433,7 @@ void ImageData::LastPluginRefWasDeleted() {
   // been used in a ReplaceContents. These are the ImageDatas that the renderer
   // will send back ImageDataUsable messages for.
   if (is_candidate_for_reuse_)
-    ImageDataCache::GetInstance()->Add(this);
+    ImageDataCache::GetInstance()->Add(this, false);
 }
 
 void ImageData::InstanceWasDeleted() {
@@ -452,41 +552,29 @@ PPB_ImageData_Proxy::PPB_ImageData_Proxy(Dispatcher* dispatcher)
 PPB_ImageData_Proxy::~PPB_ImageData_Proxy() {
 }
 
-// static
-PP_Resource PPB_ImageData_Proxy::CreateProxyResource(
+namespace {
+
+// Asks the renderer for a new image data for |instance|. Returns null on
+// failure.
+scoped_refptr<ImageData> CreatePluginImageData(
+    PluginDispatcher* dispatcher,
     PP_Instance instance,
     PPB_ImageData_Shared::ImageDataType type,
     PP_ImageDataFormat format,
     const PP_Size& size,
     PP_Bool init_to_zero) {
-  PluginDispatcher* dispatcher = PluginDispatcher::GetForInstance(instance);
-  if (!dispatcher)
-    return 0;
-
-  // Check the cache.
-  scoped_refptr<ImageData> cached_image_data =
-      ImageDataCache::GetInstance()->Get(instance, type,
-                                         size.width, size.height, format);
-  if (cached_image_data.get()) {
-    // We have one we can re-use rather than allocating a new one.
-    cached_image_data->RecycleToPlugin(PP_ToBool(init_to_zero));
-    return cached_image_data->GetReference();
-  }
-
   HostResource result;
   PP_ImageDataDesc desc;
   switch (type) {
     case PPB_ImageData_Shared::SIMPLE: {
       ppapi::proxy::SerializedHandle image_handle_wrapper;
       dispatcher->Send(new PpapiHostMsg_PPBImageData_CreateSimple(
-          kApiID, instance, format, size, init_to_zero,
+          PPB_ImageData_Proxy::kApiID, instance, format, size, init_to_zero,
           &result, &desc, &image_handle_wrapper));
       if (image_handle_wrapper.is_shmem()) {
         base::SharedMemoryHandle image_handle = image_handle_wrapper.shmem();
-        if (!result.is_null()) {
-          return
-              (new SimpleImageData(result, desc, image_handle))->GetReference();
-        }
+        if (!result.is_null())
+          return new SimpleImageData(result, desc, image_handle);
       }
       break;
     }
@@ -494,12 +582,10 @@ PP_Resource PPB_ImageData_Proxy::CreateProxyResource(
 #if !defined(OS_NACL)
       ImageHandle image_handle = PlatformImageData::NullHandle();
       dispatcher->Send(new PpapiHostMsg_PPBImageData_CreatePlatform(
-          kApiID, instance, format, size, init_to_zero,
+          PPB_ImageData_Proxy::kApiID, instance, format, size, init_to_zero,
           &result, &desc, &image_handle));
-      if (!result.is_null()) {
-        return
-            (new PlatformImageData(result, desc, image_handle))->GetReference();
-      }
+      if (!result.is_null())
+        return new PlatformImageData(result, desc, image_handle);
 #else
       // PlatformImageData shouldn't be created in untrusted code.
       NOTREACHED();
@@ -508,7 +594,82 @@ PP_Resource PPB_ImageData_Proxy::CreateProxyResource(
     }
   }
 
-  return 0;
+  return scoped_refptr<ImageData>();
+}
+
+}  // namespace
+
+// static
+PP_Resource PPB_ImageData_Proxy::CreateProxyResource(
+    PP_Instance instance,
+    PPB_ImageData_Shared::ImageDataType type,
+    PP_ImageDataFormat format,
+    const PP_Size& size,
+    PP_Bool init_to_zero) {
+  PluginDispatcher* dispatcher = PluginDispatcher::GetForInstance(instance);
+  if (!dispatcher)
+    return 0;
+
+  // Check the cache.
+  scoped_refptr<ImageData> cached_image_data =
+      ImageDataCache::GetInstance()->Get(instance, type,
+                                         size.width, size.height, format);
+  if (cached_image_data.get()) {
+    // We have one we can re-use rather than allocating a new one.
+    cached_image_data->RecycleToPlugin(PP_ToBool(init_to_zero));
+    return cached_image_data->GetReference();
+  }
+
+  scoped_refptr<ImageData> image_data = CreatePluginImageData(
+      dispatcher, instance, type, format, size, init_to_zero);
+  return image_data.get() ? image_data->GetReference() : 0;
+}
+
+// static
+void PPB_ImageData_Proxy::PrewarmCache(PP_Instance instance,
+                                       PPB_ImageData_Shared::ImageDataType type,
+                                       PP_ImageDataFormat format,
+                                       const PP_Size& size,
+                                       uint32_t count) {
+  PluginDispatcher* dispatcher = PluginDispatcher::GetForInstance(instance);
+  if (!dispatcher)
+    return;
+
+  // These go straight to the renderer rather than through
+  // CreateProxyResource(), so they neither count as misses nor take images
+  // out of the pool. The plugin never held them, so they are usable at once.
+  // Stop once the pool's budget is used up rather than evicting images made
+  // here; the size of an image is only known once the first one exists.
+  ImageDataCache* cache = ImageDataCache::GetInstance();
+  size_t image_bytes = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (i > 0 && !cache->HasRoomFor(instance, image_bytes))
+      break;
+    scoped_refptr<ImageData> image_data = CreatePluginImageData(
+        dispatcher, instance, type, format, size, PP_TRUE);
+    if (!image_data.get())
+      break;
+    image_bytes = GetImageDataByteSize(image_data.get());
+    if (!cache->HasRoomFor(instance, image_bytes))
+      break;
+    cache->Add(image_data.get(), true);
+  }
+}
+
+// static
+void PPB_ImageData_Proxy::SetCacheBudget(PP_Instance instance,
+                                         uint32_t budget_bytes) {
+  // Don't create a pool for an instance that is gone or never existed;
+  // nothing would remove it.
+  if (!PluginDispatcher::GetForInstance(instance))
+    return;
+  ImageDataCache::GetInstance()->SetBudget(instance, budget_bytes);
+}
+
+// static
+PP_ImageDataCacheStats_Dev PPB_ImageData_Proxy::GetCacheStats(
+    PP_Instance instance) {
+  return ImageDataCache::GetInstance()->GetStats(instance);
 }
 
 bool PPB_ImageData_Proxy::OnMessageReceived(const IPC::Message& msg) {
@@ -5,6 +5,7 @@
 #ifndef PPAPI_PPB_IMAGE_DATA_PROXY_H_
 #define PPAPI_PPB_IMAGE_DATA_PROXY_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -13,6 +14,7 @@
 #include "base/memory/shared_memory.h"
 #include "build/build_config.h"
 #include "ipc/ipc_platform_file.h"
+#include "ppapi/c/dev/ppb_image_data_dev.h"
 #include "ppapi/c/pp_bool.h"
 #include "ppapi/c/pp_completion_callback.h"
 #include "ppapi/c/pp_instance.h"
@@ -143,6 +145,28 @@ class PPB_ImageData_Proxy : public InterfaceProxy {
       const PP_Size& size,
       PP_Bool init_to_zero);
 
+  // These implement PPB_ImageData_Dev. They must be called with the
+  // ProxyLock held.
+  //
+  // PrewarmCache() creates |count| image datas with the given properties and
+  // puts them in the re-use pool for |instance|, so that creating image datas
+  // like them later doesn't have to allocate.
+  PPAPI_PROXY_EXPORT static void PrewarmCache(
+      PP_Instance instance,
+      PPB_ImageData_Shared::ImageDataType type,
+      PP_ImageDataFormat format,
+      const PP_Size& size,
+      uint32_t count);
+
+  // SetCacheBudget() sets how much image memory |instance| may keep in its
+  // re-use pool, dropping pooled image datas if needed.
+  PPAPI_PROXY_EXPORT static void SetCacheBudget(PP_Instance instance,
+                                                uint32_t budget_bytes);
+
+  // GetCacheStats() returns the re-use pool counters for |instance|.
+  PPAPI_PROXY_EXPORT static PP_ImageDataCacheStats_Dev GetCacheStats(
+      PP_Instance instance);
+
   // InterfaceProxy implementation.
   bool OnMessageReceived(const IPC::Message& msg) override;
 
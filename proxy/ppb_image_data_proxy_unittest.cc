@@ -0,0 +1,191 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <tuple>
+
+#include "base/memory/shared_memory.h"
+#include "ipc/ipc_listener.h"
+#include "ipc/ipc_sync_message.h"
+#include "ppapi/c/dev/ppb_image_data_dev.h"
+#include "ppapi/proxy/locking_resource_releaser.h"
+#include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/proxy/ppb_image_data_proxy.h"
+#include "ppapi/proxy/resource_message_test_sink.h"
+#include "ppapi/proxy/serialized_handle.h"
+#include "ppapi/shared_impl/proxy_lock.h"
+
+namespace ppapi {
+namespace proxy {
+
+namespace {
+
+const PP_Size kSize = { 16, 16 };
+const uint32_t kImageBytes = 16 * 16 * 4;
+
+// Answers the plugin's requests for new image datas like the renderer would,
+// handing out a fresh host resource and shared memory each time.
+class CreateImageDataHandler : public IPC::Listener {
+ public:
+  explicit CreateImageDataHandler(ResourceMessageTestSink* test_sink)
+      : test_sink_(test_sink), created_(0) {}
+
+  // IPC::Listener.
+  bool OnMessageReceived(const IPC::Message& msg) override {
+    if (msg.type() != PpapiHostMsg_PPBImageData_CreateSimple::ID)
+      return false;
+    PpapiHostMsg_PPBImageData_CreateSimple::Schema::SendParam send_params;
+    if (!PpapiHostMsg_PPBImageData_CreateSimple::ReadSendParam(&msg,
+                                                               &send_params))
+      return false;
+    created_++;
+
+    HostResource result;
+    result.SetHostResource(std::get<0>(send_params), created_);
+    PP_ImageDataDesc desc;
+    desc.format = static_cast<PP_ImageDataFormat>(std::get<1>(send_params));
+    desc.size = std::get<2>(send_params);
+    desc.stride = desc.size.width * 4;
+    uint32_t byte_count = desc.stride * desc.size.height;
+    base::SharedMemory shm;
+    shm.CreateAnonymous(byte_count);
+    SerializedHandle handle(shm.handle().Duplicate(), byte_count);
+
+    IPC::Message* reply_msg = IPC::SyncMessage::GenerateReply(&msg);
+    PpapiHostMsg_PPBImageData_CreateSimple::WriteReplyParams(
+        reply_msg, result, desc, handle);
+    test_sink_->SetSyncReplyMessage(reply_msg);
+    return true;
+  }
+
+  int created() const { return created_; }
+
+ private:
+  ResourceMessageTestSink* test_sink_;
+  int created_;
+};
+
+PP_Resource CreateImageData(PP_Instance instance) {
+  ProxyAutoLock lock;
+  return PPB_ImageData_Proxy::CreateProxyResource(
+      instance, PPB_ImageData_Shared::SIMPLE, PP_IMAGEDATAFORMAT_BGRA_PREMUL,
+      kSize, PP_FALSE);
+}
+
+void PrewarmCache(PP_Instance instance, uint32_t count) {
+  ProxyAutoLock lock;
+  PPB_ImageData_Proxy::PrewarmCache(instance, PPB_ImageData_Shared::SIMPLE,
+                                    PP_IMAGEDATAFORMAT_BGRA_PREMUL, kSize,
+                                    count);
+}
+
+void SetCacheBudget(PP_Instance instance, uint32_t budget_bytes) {
+  ProxyAutoLock lock;
+  PPB_ImageData_Proxy::SetCacheBudget(instance, budget_bytes);
+}
+
+PP_ImageDataCacheStats_Dev GetCacheStats(PP_Instance instance) {
+  ProxyAutoLock lock;
+  return PPB_ImageData_Proxy::GetCacheStats(instance);
+}
+
+}  // namespace
+
+// The pool is per process and outlives the tests, so each test ends by
+// deleting the instance, which drops the pool along with its stats.
+class ImageDataCacheTest : public PluginProxyTest {
+ public:
+  ImageDataCacheTest() : handler_(&sink()) {}
+
+  void SetUp() override {
+    PluginProxyTest::SetUp();
+    sink().AddFilter(&handler_);
+  }
+
+  void TearDown() override {
+    DeleteInstance();
+    PluginProxyTest::TearDown();
+  }
+
+ protected:
+  void DeleteInstance() {
+    ProxyAutoLock lock;
+    resource_tracker().DidDeleteInstance(pp_instance());
+  }
+
+  CreateImageDataHandler handler_;
+};
+
+TEST_F(ImageDataCacheTest, BudgetEviction) {
+  // Pre-warming stops once the budget is used up.
+  SetCacheBudget(pp_instance(), 2 * kImageBytes);
+  PrewarmCache(pp_instance(), 3);
+  EXPECT_EQ(2, handler_.created());
+  PP_ImageDataCacheStats_Dev stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(2u * kImageBytes, stats.bytes_cached);
+
+  // Lowering the budget drops images right away.
+  SetCacheBudget(pp_instance(), kImageBytes);
+  stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(kImageBytes, stats.bytes_cached);
+
+  // An image bigger than the whole budget isn't kept at all.
+  SetCacheBudget(pp_instance(), kImageBytes - 1);
+  PrewarmCache(pp_instance(), 1);
+  EXPECT_EQ(3, handler_.created());
+  stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(2u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes_cached);
+}
+
+TEST_F(ImageDataCacheTest, Prewarm) {
+  PrewarmCache(pp_instance(), 2);
+  EXPECT_EQ(2, handler_.created());
+
+  // Pre-warming isn't a lookup, so it's neither a hit nor a miss.
+  PP_ImageDataCacheStats_Dev stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(2u * kImageBytes, stats.bytes_cached);
+
+  // The pre-warmed images are handed out without asking the renderer.
+  LockingResourceReleaser first(CreateImageData(pp_instance()));
+  LockingResourceReleaser second(CreateImageData(pp_instance()));
+  EXPECT_NE(0, first.get());
+  EXPECT_NE(0, second.get());
+  EXPECT_EQ(2, handler_.created());
+  stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.bytes_cached);
+
+  // Once the pool is empty, a new image is allocated.
+  LockingResourceReleaser third(CreateImageData(pp_instance()));
+  EXPECT_NE(0, third.get());
+  EXPECT_EQ(3, handler_.created());
+  stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+}
+
+TEST_F(ImageDataCacheTest, InstanceTeardown) {
+  PrewarmCache(pp_instance(), 2);
+  LockingResourceReleaser image(CreateImageData(pp_instance()));
+  EXPECT_EQ(kImageBytes, GetCacheStats(pp_instance()).bytes_cached);
+
+  // Deleting the instance drops its pool, including the image the plugin
+  // was holding. Looking the pool up afterwards must not bring it back.
+  DeleteInstance();
+  PP_ImageDataCacheStats_Dev stats = GetCacheStats(pp_instance());
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.bytes_cached);
+}
+
+}  // namespace proxy
+}  // namespace ppapi
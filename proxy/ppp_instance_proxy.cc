@@ -21,6 +21,7 @@
 #include "ppapi/proxy/plugin_proxy_delegate.h"
 #include "ppapi/proxy/plugin_resource_tracker.h"
 #include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/raw_var_data.h"
 #include "ppapi/proxy/url_loader_resource.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 #include "ppapi/shared_impl/ppb_view_shared.h"
@@ -64,6 +65,7 @@ PP_Bool DidCreate(PP_Instance instance,
 void DidDestroy(PP_Instance instance) {
   HostDispatcher::GetForInstance(instance)->Send(
       new PpapiMsg_PPPInstance_DidDestroy(API_ID_PPP_INSTANCE, instance));
+  RawVarDataGraph::DidDeleteInstance(instance);
 }
 
 void DidChangeView(PP_Instance instance, PP_Resource view_resource) {
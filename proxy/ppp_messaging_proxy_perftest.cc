@@ -2,17 +2,47 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/format_macros.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/shared_memory.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "ipc/ipc_listener.h"
+#include "ipc/ipc_message.h"
+#include "ipc/ipc_sync_message.h"
 #include "ppapi/c/ppp_messaging.h"
 #include "ppapi/proxy/ppapi_messages.h"
 #include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/proxy/raw_var_data.h"
+#include "ppapi/proxy/resource_message_test_sink.h"
+#include "ppapi/proxy/serialized_handle.h"
 #include "ppapi/proxy/serialized_var.h"
+#include "ppapi/shared_impl/array_var.h"
+#include "ppapi/shared_impl/dictionary_var.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 #include "ppapi/shared_impl/proxy_lock.h"
+#include "ppapi/shared_impl/resource.h"
+#include "ppapi/shared_impl/scoped_pp_var.h"
 #include "ppapi/shared_impl/var.h"
 #include "ppapi/shared_impl/var_tracker.h"
+#include "testing/perf/perf_test.h"
 
 namespace ppapi {
 namespace proxy {
@@ -25,15 +55,16 @@ base::WaitableEvent handle_message_called(
 void HandleMessage(PP_Instance /* instance */, PP_Var message_data) {
   ppapi::ProxyAutoLock lock;
   StringVar* string_var = StringVar::FromPPVar(message_data);
-  DCHECK(string_var);
-  // Retrieve the string to make sure the proxy can't "optimize away" sending
-  // the actual contents of the string (e.g., by doing a lazy retrieve or
-  // something). Note that this test is for performance only, and assumes
-  // other tests check for correctness.
-  std::string s = string_var->value();
-  // Do something simple with the string so the compiler won't complain.
-  if (s.length() > 0)
-    s[0] = 'a';
+  if (string_var) {
+    // Retrieve the string to make sure the proxy can't "optimize away" sending
+    // the actual contents of the string (e.g., by doing a lazy retrieve or
+    // something). Note that this test is for performance only, and assumes
+    // other tests check for correctness.
+    std::string s = string_var->value();
+    // Do something simple with the string so the compiler won't complain.
+    if (s.length() > 0)
+      s[0] = 'a';
+  }
   PpapiGlobals::Get()->GetVarTracker()->ReleaseVar(message_data);
   handle_message_called.Signal();
 }
@@ -42,12 +73,225 @@ PPP_Messaging ppp_messaging_mock = {
   &HandleMessage
 };
 
+int GetIntSwitch(const char* name, int default_value) {
+  int value = default_value;
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line && command_line->HasSwitch(name))
+    base::StringToInt(command_line->GetSwitchValueASCII(name), &value);
+  return value;
+}
+
+// Collects per-message latencies and reports percentiles and throughput in
+// the format understood by the perf dashboards.
+class LatencyRecorder {
+ public:
+  explicit LatencyRecorder(const std::string& trace) : trace_(trace) {}
+
+  void AddSample(base::TimeDelta latency, size_t bytes) {
+    samples_.push_back(latency);
+    total_time_ += latency;
+    total_bytes_ += bytes;
+  }
+
+  void Report() {
+    ASSERT_FALSE(samples_.empty());
+    std::sort(samples_.begin(), samples_.end());
+    PrintPercentile("latency_p50", 50);
+    PrintPercentile("latency_p90", 90);
+    PrintPercentile("latency_p99", 99);
+    perf_test::PrintResult("PppMessagingPerfTest", "", trace_ + "_latency_max",
+                           samples_.back().InMicrosecondsF(), "us", false);
+    if (total_bytes_ && !total_time_.is_zero()) {
+      perf_test::PrintResult(
+          "PppMessagingPerfTest", "", trace_ + "_throughput",
+          total_bytes_ / total_time_.InSecondsF() / (1024 * 1024), "MB/s",
+          true);
+    }
+  }
+
+ private:
+  void PrintPercentile(const char* name, size_t percentile) {
+    size_t index = (samples_.size() - 1) * percentile / 100;
+    perf_test::PrintResult("PppMessagingPerfTest", "", trace_ + "_" + name,
+                           samples_[index].InMicrosecondsF(), "us",
+                           percentile == 50);
+  }
+
+  std::string trace_;
+  std::vector<base::TimeDelta> samples_;
+  base::TimeDelta total_time_;
+  uint64_t total_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyRecorder);
+};
+
+// Builds |depth| levels of dictionaries, each holding a few primitives, a
+// string and an array of |fanout| child dictionaries (or numbers at the
+// leaves). Returns the root with a ref for the caller.
+PP_Var MakeNestedVar(int depth, int fanout) {
+  scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+  dictionary->SetWithStringKey("id", PP_MakeInt32(depth));
+  dictionary->SetWithStringKey("weight", PP_MakeDouble(depth * 0.25));
+  dictionary->SetWithStringKey("visible", PP_MakeBool(PP_TRUE));
+  ScopedPPVar name(ScopedPPVar::PassRef(),
+                   StringVar::StringToPPVar("a node in the tree"));
+  dictionary->SetWithStringKey("name", name.get());
+  scoped_refptr<ArrayVar> children(new ArrayVar);
+  for (int i = 0; i < fanout; ++i) {
+    ScopedPPVar child(ScopedPPVar::PassRef(),
+                      depth > 1 ? MakeNestedVar(depth - 1, fanout)
+                                : PP_MakeInt32(i));
+    children->Set(i, child.get());
+  }
+  ScopedPPVar children_var(ScopedPPVar::PassRef(), children->GetPPVar());
+  dictionary->SetWithStringKey("children", children_var.get());
+  return dictionary->GetPPVar();
+}
+
+// Answers the plugin's requests for shared memory like the renderer would,
+// keeping each region under an id until the message that names it arrives.
+class CreateSharedMemoryHandler : public IPC::Listener {
+ public:
+  explicit CreateSharedMemoryHandler(ResourceMessageTestSink* test_sink)
+      : test_sink_(test_sink), last_id_(0) {}
+  ~CreateSharedMemoryHandler() override {
+    for (auto& region : regions_)
+      region.second.first.Close();
+  }
+
+  // IPC::Listener.
+  bool OnMessageReceived(const IPC::Message& msg) override {
+    if (msg.type() != PpapiHostMsg_SharedMemory_CreateSharedMemory::ID)
+      return false;
+    PpapiHostMsg_SharedMemory_CreateSharedMemory::Schema::SendParam
+        send_params;
+    if (!PpapiHostMsg_SharedMemory_CreateSharedMemory::ReadSendParam(
+            &msg, &send_params)) {
+      return false;
+    }
+    uint32_t size = std::get<1>(send_params);
+
+    int id = -1;
+    SerializedHandle handle;
+    base::SharedMemory shm;
+    if (shm.CreateAnonymous(size)) {
+      id = ++last_id_;
+      regions_[id] = std::make_pair(shm.handle().Duplicate(), size);
+      handle = SerializedHandle(shm.handle().Duplicate(), size);
+    }
+
+    IPC::Message* reply_msg = IPC::SyncMessage::GenerateReply(&msg);
+    PpapiHostMsg_SharedMemory_CreateSharedMemory::WriteReplyParams(
+        reply_msg, id, handle);
+    test_sink_->SetSyncReplyMessage(reply_msg);
+    return true;
+  }
+
+  // Takes the most recently created region, as the host does when the
+  // message naming it is read. Returns false if it has already been taken.
+  bool TakeLastRegion(base::SharedMemoryHandle* handle, uint32_t* size) {
+    auto found = regions_.find(last_id_);
+    if (found == regions_.end())
+      return false;
+    *handle = found->second.first;
+    *size = found->second.second;
+    regions_.erase(found);
+    return true;
+  }
+
+ private:
+  ResourceMessageTestSink* test_sink_;
+  int last_id_;
+  std::map<int, std::pair<base::SharedMemoryHandle, uint32_t>> regions_;
+
+  DISALLOW_COPY_AND_ASSIGN(CreateSharedMemoryHandler);
+};
+
 class PppMessagingPerfTest : public TwoWayTest {
  public:
   PppMessagingPerfTest() : TwoWayTest(TwoWayTest::TEST_PPP_INTERFACE) {
     plugin().RegisterTestInterface(PPP_MESSAGING_INTERFACE,
                                    &ppp_messaging_mock);
   }
+
+  // Sends |var| to the plugin |count| times and records how long each takes
+  // to be delivered to PPP_Messaging.
+  void SendMessages(const PP_Var& var, int count, LatencyRecorder* recorder) {
+    for (int i = 0; i < count; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      // We don't have a host-side PPP_Messaging interface; just send the
+      // message directly like the proxy does.
+      host().host_dispatcher()->Send(new PpapiMsg_PPPMessaging_HandleMessage(
+          ppapi::API_ID_PPP_MESSAGING, pp_instance(),
+          ppapi::proxy::SerializedVarSendInput(host().host_dispatcher(), var)));
+      handle_message_called.Wait();
+      recorder->AddSample(base::TimeTicks::Now() - start, 0);
+    }
+  }
+};
+
+// Serializes vars through RawVarDataGraph on the plugin side, which (unlike
+// the host side of the test harness) can create array buffers and resource
+// vars. Requests for shared memory are answered by |shared_memory_handler_|.
+class RawVarDataPerfTest : public PluginProxyTest {
+ public:
+  RawVarDataPerfTest() : shared_memory_handler_(&sink()) {}
+
+  void SetUp() override {
+    PluginProxyTest::SetUp();
+    sink().AddFilter(&shared_memory_handler_);
+  }
+
+  void TearDown() override {
+    sink().RemoveFilter(&shared_memory_handler_);
+    PluginProxyTest::TearDown();
+  }
+
+  // Writes |var| for |instance| to a message and reads it back |count| times,
+  // recording the time for each round. Must be called with the ProxyLock held.
+  void RoundTrip(const PP_Var& var,
+                 PP_Instance instance,
+                 int count,
+                 size_t bytes,
+                 LatencyRecorder* recorder) {
+    for (int i = 0; i < count; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      std::unique_ptr<RawVarDataGraph> graph(
+          RawVarDataGraph::Create(var, instance));
+      ASSERT_TRUE(graph);
+      IPC::Message m;
+      graph->Write(&m, base::Bind(&RawVarDataPerfTest::WriteHandle));
+      base::PickleIterator iter(m);
+      std::unique_ptr<RawVarDataGraph> read_graph(
+          RawVarDataGraph::Read(&m, &iter));
+      ASSERT_TRUE(read_graph);
+      ScopedPPVar result;
+      base::SharedMemoryHandle handle;
+      uint32_t size_in_bytes;
+      if (shared_memory_handler_.TakeLastRegion(&handle, &size_in_bytes)) {
+        // The array buffer went in shared memory. Only the host can look its
+        // id up, so receive it the way the host does: map the region.
+        result = ScopedPPVar(
+            ScopedPPVar::PassRef(),
+            PpapiGlobals::Get()->GetVarTracker()->MakeArrayBufferPPVar(
+                size_in_bytes, handle));
+        ArrayBufferVar* buffer = ArrayBufferVar::FromPPVar(result.get());
+        ASSERT_TRUE(buffer && buffer->Map());
+      } else {
+        result = ScopedPPVar(ScopedPPVar::PassRef(),
+                             read_graph->CreatePPVar(instance));
+      }
+      recorder->AddSample(base::TimeTicks::Now() - start, bytes);
+      ASSERT_EQ(var.type, result.get().type);
+    }
+  }
+
+ private:
+  static void WriteHandle(base::Pickle* m, const SerializedHandle& handle) {
+    IPC::ParamTraits<SerializedHandle>::Write(m, handle);
+  }
+
+  CreateSharedMemoryHandler shared_memory_handler_;
 };
 
 }  // namespace
@@ -55,24 +299,9 @@ class PppMessagingPerfTest : public TwoWayTest {
 // Tests the performance of sending strings through the proxy.
 TEST_F(PppMessagingPerfTest, StringPerformance) {
   const PP_Instance kTestInstance = pp_instance();
-  int seed = 123;
-  int string_count = 1000;
-  int max_string_size = 1000000;
-  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
-  if (command_line) {
-    if (command_line->HasSwitch("seed")) {
-      base::StringToInt(command_line->GetSwitchValueASCII("seed"),
-                        &seed);
-    }
-    if (command_line->HasSwitch("string_count")) {
-      base::StringToInt(command_line->GetSwitchValueASCII("string_count"),
-                        &string_count);
-    }
-    if (command_line->HasSwitch("max_string_size")) {
-      base::StringToInt(command_line->GetSwitchValueASCII("max_string_size"),
-                        &max_string_size);
-    }
-  }
+  int seed = GetIntSwitch("seed", 123);
+  int string_count = GetIntSwitch("string_count", 1000);
+  int max_string_size = GetIntSwitch("max_string_size", 1000000);
   srand(seed);
   base::PerfTimeLogger logger("PppMessagingPerfTest.StringPerformance");
   for (int i = 0; i < string_count; ++i) {
@@ -90,6 +319,100 @@ TEST_F(PppMessagingPerfTest, StringPerformance) {
   }
 }
 
+// Tests the latency of sending nested dictionaries and arrays to the plugin.
+TEST_F(PppMessagingPerfTest, NestedVarPerformance) {
+  int message_count = GetIntSwitch("message_count", 200);
+  // (depth, fanout) pairs, from a flat record to a few thousand nodes.
+  const int kShapes[][2] = {{1, 8}, {3, 4}, {5, 4}, {8, 2}};
+  for (const auto& shape : kShapes) {
+    ScopedPPVar var(ScopedPPVar::PassRef(), MakeNestedVar(shape[0], shape[1]));
+    LatencyRecorder recorder(
+        base::StringPrintf("Nested_depth%d_fanout%d", shape[0], shape[1]));
+    SendMessages(var.get(), message_count, &recorder);
+    recorder.Report();
+  }
+}
+
+// Tests the round trip time of a blocking PostMessageAndAwaitResponse. No
+// message handler is registered, so this measures the proxy and the
+// serialization of the message and the reply rather than plugin code.
+TEST_F(PppMessagingPerfTest, BlockingMessagePerformance) {
+  int message_count = GetIntSwitch("message_count", 200);
+  const size_t kStringSizes[] = {16, 1024, 64 * 1024, 1024 * 1024};
+  for (size_t size : kStringSizes) {
+    ScopedPPVar var(ScopedPPVar::PassRef(),
+                    StringVar::StringToPPVar(std::string(size, 'a')));
+    LatencyRecorder recorder(
+        base::StringPrintf("Blocking_%" PRIuS "Bytes", size));
+    for (int i = 0; i < message_count; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      ReceiveSerializedVarReturnValue result;
+      bool was_handled = true;
+      host().host_dispatcher()->Send(
+          new PpapiMsg_PPPMessageHandler_HandleBlockingMessage(
+              pp_instance(),
+              SerializedVarSendInput(host().host_dispatcher(), var.get()),
+              &result, &was_handled));
+      ScopedPPVar reply(ScopedPPVar::PassRef(),
+                        result.Return(host().host_dispatcher()));
+      recorder.AddSample(base::TimeTicks::Now() - start, size);
+      EXPECT_FALSE(was_handled);
+    }
+    recorder.Report();
+  }
+}
+
+// Tests serializing and deserializing array buffers from 1KB to 64MB. They
+// are sent for a real instance, so buffers from 256KB up go in shared memory.
+TEST_F(RawVarDataPerfTest, ArrayBufferPerformance) {
+  int max_size = GetIntSwitch("max_array_buffer_size", 64 * 1024 * 1024);
+  ProxyAutoLock lock;
+  for (size_t size = 1024; size <= static_cast<size_t>(max_size); size *= 4) {
+    ScopedPPVar var(ScopedPPVar::PassRef(),
+                    PpapiGlobals::Get()->GetVarTracker()->MakeArrayBufferPPVar(
+                        static_cast<uint32_t>(size)));
+    // Fewer rounds for the big buffers to keep the run time reasonable.
+    int count = std::max(4, static_cast<int>(64 * 1024 * 1024 / size / 16));
+    count = std::min(count, 1000);
+    LatencyRecorder recorder(
+        base::StringPrintf("ArrayBuffer_%" PRIuS "Bytes", size));
+    RoundTrip(var.get(), pp_instance(), count, size, &recorder);
+    recorder.Report();
+  }
+}
+
+// Tests serializing and deserializing nested dictionaries and arrays.
+TEST_F(RawVarDataPerfTest, NestedVarPerformance) {
+  int count = GetIntSwitch("message_count", 200);
+  ProxyAutoLock lock;
+  ScopedPPVar var(ScopedPPVar::PassRef(), MakeNestedVar(5, 4));
+  LatencyRecorder recorder("RawVarData_Nested_depth5_fanout4");
+  // Instance 0 keeps the graph in the message; reading a graph from shared
+  // memory the host created needs the host's var tracker.
+  RoundTrip(var.get(), 0, count, 0, &recorder);
+  recorder.Report();
+}
+
+// Tests serializing and deserializing arrays of resource vars.
+TEST_F(RawVarDataPerfTest, ResourceVarPerformance) {
+  int count = GetIntSwitch("message_count", 200);
+  ProxyAutoLock lock;
+  std::vector<scoped_refptr<Resource>> resources;
+  scoped_refptr<ArrayVar> array(new ArrayVar);
+  ScopedPPVar release_array(ScopedPPVar::PassRef(), array->GetPPVar());
+  for (uint32_t i = 0; i < 100; ++i) {
+    resources.push_back(new Resource(OBJECT_IS_PROXY, pp_instance()));
+    ScopedPPVar resource_var(
+        ScopedPPVar::PassRef(),
+        PpapiGlobals::Get()->GetVarTracker()->MakeResourcePPVar(
+            resources.back()->pp_resource()));
+    array->Set(i, resource_var.get());
+  }
+  LatencyRecorder recorder("RawVarData_100ResourceVars");
+  RoundTrip(release_array.get(), 0, count, 0, &recorder);
+  recorder.Report();
+  array->elements().clear();
+}
+
 }  // namespace proxy
 }  // namespace ppapi
-
@@ -0,0 +1,130 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/threading/simple_thread.h"
+#include "ppapi/c/ppb_var.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/shared_impl/ppapi_globals.h"
+#include "ppapi/shared_impl/ppb_var_shared.h"
+#include "ppapi/shared_impl/proxy_lock.h"
+#include "ppapi/shared_impl/var.h"
+#include "ppapi/shared_impl/var_tracker.h"
+
+namespace ppapi {
+namespace proxy {
+namespace {
+
+// Simulates a plugin worker thread that does var bookkeeping on a string it
+// shares with other threads: AddRef, read the contents, Release.
+class VarWorker : public base::DelegateSimpleThread::Delegate {
+ public:
+  VarWorker(PP_Var var, int iterations, bool use_global_lock)
+      : var_(var),
+        iterations_(iterations),
+        use_global_lock_(use_global_lock) {}
+
+  void Run() override {
+    const PPB_Var_1_2* ppb_var = PPB_Var_Shared::GetVarInterface1_2();
+    VarTracker* tracker = PpapiGlobals::Get()->GetVarTracker();
+    for (int i = 0; i < iterations_; ++i) {
+      if (use_global_lock_) {
+        // What every PPB_Var call did before the trackers had their own locks.
+        ProxyAutoLock lock;
+        tracker->AddRefVar(var_);
+        StringVar* str = StringVar::FromPPVar(var_);
+        CHECK(str && !str->value().empty());
+        tracker->ReleaseVar(var_);
+      } else {
+        ppb_var->AddRef(var_);
+        uint32_t len = 0;
+        CHECK(ppb_var->VarToUtf8(var_, &len) && len);
+        ppb_var->Release(var_);
+      }
+    }
+  }
+
+ private:
+  PP_Var var_;
+  int iterations_;
+  bool use_global_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(VarWorker);
+};
+
+class ProxyLockPerfTest : public PluginProxyTest {
+ public:
+  ProxyLockPerfTest() {}
+
+  void RunVarWorkers(const char* name, int thread_count, bool global_lock) {
+    PP_Var var;
+    {
+      ProxyAutoLock lock;
+      var = StringVar::StringToPPVar("shared string");
+    }
+
+    std::vector<std::unique_ptr<VarWorker>> workers;
+    std::vector<std::unique_ptr<base::DelegateSimpleThread>> threads;
+    for (int i = 0; i < thread_count; ++i) {
+      workers.push_back(
+          std::make_unique<VarWorker>(var, iterations(), global_lock));
+      threads.push_back(std::make_unique<base::DelegateSimpleThread>(
+          workers.back().get(), "ProxyLockPerfTest"));
+    }
+
+    // Every thread does the same amount of work, so a run time that stays
+    // flat as the thread count grows means throughput scales with cores.
+    base::PerfTimeLogger logger(
+        base::StringPrintf("ProxyLockPerfTest.%s_%dThreads", name,
+                           thread_count)
+            .c_str());
+    for (auto& thread : threads)
+      thread->Start();
+    for (auto& thread : threads)
+      thread->Join();
+    logger.Done();
+
+    ProxyAutoLock lock;
+    EXPECT_EQ(1, var_tracker().GetRefCountForObject(var));
+    var_tracker().ReleaseVar(var);
+  }
+
+  int iterations() const {
+    int iterations = 100000;
+    base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+    if (command_line && command_line->HasSwitch("iterations")) {
+      base::StringToInt(command_line->GetSwitchValueASCII("iterations"),
+                        &iterations);
+    }
+    return iterations;
+  }
+};
+
+const int kThreadCounts[] = {1, 2, 4, 8};
+
+}  // namespace
+
+// Measures PPB_Var refcounting throughput against thread count when all
+// threads serialize on the ProxyLock.
+TEST_F(ProxyLockPerfTest, VarRefCountGlobalLock) {
+  for (int thread_count : kThreadCounts)
+    RunVarWorkers("VarRefCountGlobalLock", thread_count, true);
+}
+
+// Same as above, but through PPB_Var which only takes the VarTracker's lock.
+TEST_F(ProxyLockPerfTest, VarRefCountTrackerLock) {
+  for (int thread_count : kThreadCounts)
+    RunVarWorkers("VarRefCountTrackerLock", thread_count, false);
+}
+
+}  // namespace proxy
+}  // namespace ppapi
@@ -4,10 +4,23 @@
 
 #include "ppapi/proxy/raw_var_data.h"
 
+#include <string.h>
+
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "base/atomicops.h"
 #include "base/containers/hash_tables.h"
 #include "base/containers/stack.h"
+#include "base/lazy_instance.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
 #include "ipc/ipc_message.h"
 #include "ppapi/proxy/ppapi_param_traits.h"
 #include "ppapi/shared_impl/array_var.h"
@@ -32,6 +45,76 @@ static const uint32_t kMinimumArrayBufferSizeForShmem = 256 * 1024;
 static uint32_t g_minimum_array_buffer_size_for_shmem =
     kMinimumArrayBufferSizeForShmem;
 
+// Likewise, if the strings, keys and array buffers copied into the message add
+// up to more than this, the whole graph is sent in a single shared memory
+// buffer. Below this, the extra round trip to create the buffer isn't worth it.
+static const uint32_t kMinimumGraphSizeForShmem = 256 * 1024;
+static uint32_t g_minimum_graph_size_for_shmem = kMinimumGraphSizeForShmem;
+
+static bool g_compact_encoding_enabled = true;
+
+static RawVarDataGraph::HostGraphRegionCreator g_host_graph_region_creator =
+    NULL;
+
+// A graph sent in shared memory is written after this header. The sender sets
+// |in_use| when it writes a graph into the region and the receiver clears it
+// once it has copied the nodes out, which hands the region back to the sender.
+struct GraphRegionHeader {
+  base::subtle::Atomic32 in_use;
+  // The size of the serialized nodes that follow the header. The receiver
+  // loads it once, since the sender can change it at any time.
+  base::subtle::Atomic32 size;
+};
+
+// Each side keeps at most this many regions per instance. If they're all
+// still being read, the graph is sent in the message instead.
+const size_t kMaxGraphRegionsPerInstance = 4;
+
+// Regions are allocated in power-of-two sizes starting here, so that one
+// region can be reused for graphs of similar sizes. Graphs that don't fit in
+// the largest region are sent in the message.
+const uint32_t kMinimumGraphRegionSize = 64 * 1024;
+const uint32_t kMaximumGraphRegionSize = 1024 * 1024 * 1024;
+
+// The regions this process has sent graphs in and received graphs in, indexed
+// by instance and then by the sender's slot. Empty slots are null.
+typedef std::vector<std::unique_ptr<base::SharedMemory>> GraphRegions;
+struct GraphRegionPool {
+  base::Lock lock;
+  std::map<PP_Instance, GraphRegions> sent;
+  std::map<PP_Instance, GraphRegions> received;
+};
+
+base::LazyInstance<GraphRegionPool>::Leaky g_graph_region_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+uint32_t GetGraphRegionSize(size_t needed) {
+  uint32_t size = kMinimumGraphRegionSize;
+  while (size < needed)
+    size *= 2;
+  return size;
+}
+
+GraphRegionHeader* GetGraphRegionHeader(base::SharedMemory* region) {
+  return static_cast<GraphRegionHeader*>(region->memory());
+}
+
+// In the compact encoding, set on a node's type byte when the node's data is
+// pickled after the compact data rather than being part of it.
+const uint8_t kCompactPickledFlag = 0x80;
+
+// The longest varint needed to encode a uint64_t.
+const size_t kMaxVarintLength = 10;
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
 struct StackEntry {
   StackEntry(PP_Var v, size_t i) : var(v), data_index(i) {}
   PP_Var var;
@@ -66,11 +149,186 @@ bool CanHaveChildren(PP_Var var) {
 
 }  // namespace
 
+// Builds the two data blocks of the compact encoding: the table of distinct
+// strings, and the nodes, which refer to strings by their index in the table.
+class CompactGraphWriter {
+ public:
+  CompactGraphWriter() {}
+
+  void WriteByte(uint8_t value) { nodes_.push_back(static_cast<char>(value)); }
+
+  void WriteVarint(uint64_t value) { AppendVarint(value, &nodes_); }
+
+  void WriteSignedVarint(int64_t value) { WriteVarint(ZigZagEncode(value)); }
+
+  void WriteBytes(const void* data, size_t length) {
+    nodes_.append(static_cast<const char*>(data), length);
+  }
+
+  // Writes |value| as a length followed by its bytes.
+  void WriteBlob(const std::string& value) {
+    WriteVarint(value.size());
+    nodes_.append(value);
+  }
+
+  // Writes the index of |value| in the string table, adding it if needed.
+  // |value| must outlive the writer.
+  void WriteString(const std::string& value) {
+    auto result = string_ids_.insert(std::make_pair(
+        base::StringPiece(value), static_cast<uint32_t>(string_ids_.size())));
+    if (result.second) {
+      AppendVarint(value.size(), &strings_);
+      strings_.append(value);
+    }
+    WriteVarint(result.first->second);
+  }
+
+  // Overwrites a byte that was previously written at |offset|.
+  void SetByte(size_t offset, uint8_t value) {
+    DCHECK_LT(offset, nodes_.size());
+    nodes_[offset] = static_cast<char>(value);
+  }
+
+  size_t nodes_size() const { return nodes_.size(); }
+  const std::string& nodes() const { return nodes_; }
+  const std::string& strings() const { return strings_; }
+  uint32_t string_count() const {
+    return static_cast<uint32_t>(string_ids_.size());
+  }
+
+ private:
+  static void AppendVarint(uint64_t value, std::string* out) {
+    while (value >= 0x80) {
+      out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out->push_back(static_cast<char>(value));
+  }
+
+  std::string nodes_;
+  std::string strings_;
+  std::unordered_map<base::StringPiece, uint32_t, base::StringPieceHash>
+      string_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompactGraphWriter);
+};
+
+// Reads the data blocks built by CompactGraphWriter. The reader doesn't copy
+// the blocks, so they must outlive it.
+class CompactGraphReader {
+ public:
+  CompactGraphReader(const char* nodes, size_t nodes_length)
+      : pos_(nodes), end_(nodes + nodes_length) {}
+
+  // Parses the string table. Must be called before ReadString().
+  bool InitStrings(uint32_t count, const char* strings, size_t length) {
+    CompactGraphReader table(strings, length);
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t string_length;
+      const char* data;
+      if (!table.ReadVarint(&string_length) ||
+          !table.ReadBytes(string_length, &data)) {
+        return false;
+      }
+      strings_.push_back(
+          base::StringPiece(data, static_cast<size_t>(string_length)));
+    }
+    return table.AtEnd();
+  }
+
+  bool ReadByte(uint8_t* value) {
+    if (pos_ == end_)
+      return false;
+    *value = static_cast<uint8_t>(*pos_++);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < kMaxVarintLength; ++i) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+      if (!(byte & 0x80)) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t* value) {
+    uint64_t encoded;
+    if (!ReadVarint(&encoded))
+      return false;
+    *value = ZigZagDecode(encoded);
+    return true;
+  }
+
+  bool ReadUInt32(uint32_t* value) {
+    uint64_t result;
+    if (!ReadVarint(&result) || result > UINT32_MAX)
+      return false;
+    *value = static_cast<uint32_t>(result);
+    return true;
+  }
+
+  bool ReadBytes(uint64_t length, const char** data) {
+    if (length > static_cast<uint64_t>(end_ - pos_))
+      return false;
+    *data = pos_;
+    pos_ += length;
+    return true;
+  }
+
+  bool ReadBlob(std::string* value) {
+    uint64_t length;
+    const char* data;
+    if (!ReadVarint(&length) || !ReadBytes(length, &data))
+      return false;
+    value->assign(data, static_cast<size_t>(length));
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    uint32_t index;
+    if (!ReadUInt32(&index) || index >= strings_.size())
+      return false;
+    strings_[index].CopyToString(value);
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == end_; }
+
+ private:
+  const char* pos_;
+  const char* end_;
+  std::vector<base::StringPiece> strings_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompactGraphReader);
+};
+
 // RawVarDataGraph ------------------------------------------------------------
-RawVarDataGraph::RawVarDataGraph() {
+RawVarDataGraph::RawVarDataGraph()
+    : in_shmem_(false),
+      shmem_sender_(false),
+      shmem_written_(false),
+      shmem_slot_(-1),
+      shmem_instance_(0),
+      shmem_is_new_(false),
+      shmem_host_handle_id_(-1) {
 }
 
 RawVarDataGraph::~RawVarDataGraph() {
+  // Don't leave the region marked in use if the graph is dropped before it is
+  // sent or read, or the sender could never reuse it.
+  if (!in_shmem_)
+    return;
+  if (shmem_sender_)
+    ReleaseUnsentShmem();
+  else
+    TakeNodesFromShmem(nullptr);
 }
 
 // This function uses a stack-based DFS search to traverse the var graph. Each
@@ -156,10 +414,16 @@ std::unique_ptr<RawVarDataGraph> RawVarDataGraph::Create(const PP_Var& var,
       }
     }
   }
+  graph->MaybeMoveToShmem(instance);
   return graph;
 }
 
 PP_Var RawVarDataGraph::CreatePPVar(PP_Instance instance) {
+  if (in_shmem_ && !ReadFromShmem(instance))
+    return PP_MakeUndefined();
+  if (data_.empty())
+    return PP_MakeUndefined();
+
   // Create and initialize each node in the graph.
   std::vector<PP_Var> graph;
   for (size_t i = 0; i < data_.size(); ++i)
@@ -175,12 +439,20 @@ PP_Var RawVarDataGraph::CreatePPVar(PP_Instance instance) {
 
 void RawVarDataGraph::Write(base::Pickle* m,
                             const HandleWriter& handle_writer) {
-  // Write the size, followed by each node in the graph.
-  m->WriteUInt32(static_cast<uint32_t>(data_.size()));
-  for (size_t i = 0; i < data_.size(); ++i) {
-    m->WriteInt(data_[i]->Type());
-    data_[i]->Write(m, handle_writer);
+  m->WriteBool(in_shmem_);
+  if (!in_shmem_) {
+    WriteNodes(m, handle_writer);
+    return;
   }
+  shmem_written_ = true;
+  m->WriteInt(shmem_slot_);
+  m->WriteInt(shmem_instance_);
+  m->WriteBool(shmem_is_new_);
+  if (!shmem_is_new_)
+    return;
+  m->WriteInt(shmem_host_handle_id_);
+  if (shmem_host_handle_id_ == -1)
+    handle_writer.Run(m, shmem_plugin_handle_);
 }
 
 // static
@@ -188,25 +460,38 @@ std::unique_ptr<RawVarDataGraph> RawVarDataGraph::Read(
     const base::Pickle* m,
     base::PickleIterator* iter) {
   std::unique_ptr<RawVarDataGraph> result(new RawVarDataGraph);
-  uint32_t size = 0;
-  if (!iter->ReadUInt32(&size))
+  bool in_shmem;
+  if (!iter->ReadBool(&in_shmem))
     return nullptr;
-  for (uint32_t i = 0; i < size; ++i) {
-    int32_t type;
-    if (!iter->ReadInt(&type))
+  if (!in_shmem) {
+    if (!result->ReadNodes(m, iter))
       return nullptr;
-    PP_VarType var_type = static_cast<PP_VarType>(type);
-    result->data_.push_back(base::WrapUnique(RawVarData::Create(var_type)));
-    if (!result->data_.back())
+    return result;
+  }
+  if (!iter->ReadInt(&result->shmem_slot_) ||
+      !iter->ReadInt(&result->shmem_instance_) ||
+      !iter->ReadBool(&result->shmem_is_new_)) {
+    return nullptr;
+  }
+  if (result->shmem_is_new_) {
+    if (!iter->ReadInt(&result->shmem_host_handle_id_))
       return nullptr;
-    if (!result->data_.back()->Read(var_type, m, iter))
+    if (result->shmem_host_handle_id_ == -1 &&
+        !IPC::ReadParam(m, iter, &result->shmem_plugin_handle_)) {
       return nullptr;
+    }
   }
+  result->in_shmem_ = true;
   return result;
 }
 
 std::vector<SerializedHandle*> RawVarDataGraph::GetHandles() {
   std::vector<SerializedHandle*> result;
+  if (in_shmem_) {
+    if (shmem_is_new_ && shmem_host_handle_id_ == -1)
+      result.push_back(&shmem_plugin_handle_);
+    return result;
+  }
   for (size_t i = 0; i < data_.size(); ++i) {
     SerializedHandle* handle = data_[i]->GetHandle();
     if (handle)
@@ -224,6 +509,329 @@ void RawVarDataGraph::SetMinimumArrayBufferSizeForShmemForTest(
     g_minimum_array_buffer_size_for_shmem = threshold;
 }
 
+// static
+void RawVarDataGraph::SetMinimumGraphSizeForShmem(uint32_t threshold) {
+  if (threshold == 0)
+    g_minimum_graph_size_for_shmem = kMinimumGraphSizeForShmem;
+  else
+    g_minimum_graph_size_for_shmem = threshold;
+}
+
+// static
+void RawVarDataGraph::SetHostGraphRegionCreator(
+    HostGraphRegionCreator creator) {
+  g_host_graph_region_creator = creator;
+}
+
+// static
+void RawVarDataGraph::DidDeleteInstance(PP_Instance instance) {
+  GraphRegionPool& pool = g_graph_region_pool.Get();
+  base::AutoLock lock(pool.lock);
+  pool.sent.erase(instance);
+  pool.received.erase(instance);
+}
+
+void RawVarDataGraph::MaybeMoveToShmem(PP_Instance instance) {
+  if (instance == 0)
+    return;
+  size_t inline_size = 0;
+  for (size_t i = 0; i < data_.size(); ++i) {
+    // Handles and resource creation messages must stay in the message itself
+    // so that they can be brokered and scanned.
+    if (data_[i]->GetHandle() || data_[i]->Type() == PP_VARTYPE_RESOURCE)
+      return;
+    inline_size += data_[i]->GetInlineDataSize();
+  }
+  if (inline_size < g_minimum_graph_size_for_shmem)
+    return;
+
+  base::Pickle nodes;
+  WriteNodes(&nodes, HandleWriter());
+  size_t needed = sizeof(GraphRegionHeader) + nodes.size();
+  if (needed > kMaximumGraphRegionSize)
+    return;
+
+  GraphRegionPool& pool = g_graph_region_pool.Get();
+  base::AutoLock lock(pool.lock);
+  GraphRegions& regions = pool.sent[instance];
+  // Use a free region that is big enough. Failing that, replace a free region
+  // that is too small, or take an empty slot.
+  int32_t slot = -1;
+  int32_t replace_slot = -1;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    base::SharedMemory* region = regions[i].get();
+    if (region &&
+        base::subtle::Acquire_Load(&GetGraphRegionHeader(region)->in_use)) {
+      continue;
+    }
+    if (region && region->mapped_size() >= needed) {
+      slot = static_cast<int32_t>(i);
+      break;
+    }
+    if (replace_slot == -1)
+      replace_slot = static_cast<int32_t>(i);
+  }
+  if (slot == -1 && replace_slot == -1 &&
+      regions.size() < kMaxGraphRegionsPerInstance) {
+    replace_slot = static_cast<int32_t>(regions.size());
+    regions.emplace_back();
+  }
+
+  bool is_new = false;
+  int host_handle_id = -1;
+  base::SharedMemoryHandle plugin_handle;
+  if (slot == -1) {
+    if (replace_slot == -1)
+      return;
+    std::unique_ptr<base::SharedMemory> region;
+    uint32_t region_size = GetGraphRegionSize(needed);
+    if (!PpapiGlobals::Get()->GetVarTracker()->CreateSharedMemoryForTransfer(
+            instance, region_size, &region, &host_handle_id,
+            &plugin_handle) &&
+        !(PpapiGlobals::Get()->IsHostGlobals() &&
+          g_host_graph_region_creator &&
+          g_host_graph_region_creator(instance, region_size, &region,
+                                      &plugin_handle))) {
+      return;
+    }
+    regions[replace_slot] = std::move(region);
+    slot = replace_slot;
+    is_new = true;
+  }
+
+  // Copy the nodes into the region once; the receiver copies them back out.
+  GraphRegionHeader* header = GetGraphRegionHeader(regions[slot].get());
+  base::subtle::NoBarrier_Store(&header->size,
+                                static_cast<base::subtle::Atomic32>(
+                                    nodes.size()));
+  memcpy(header + 1, nodes.data(), nodes.size());
+  base::subtle::NoBarrier_Store(&header->in_use, 1);
+
+  in_shmem_ = true;
+  shmem_sender_ = true;
+  shmem_slot_ = slot;
+  shmem_instance_ = instance;
+  shmem_is_new_ = is_new;
+  shmem_host_handle_id_ = host_handle_id;
+  if (is_new && host_handle_id == -1) {
+    shmem_plugin_handle_ = SerializedHandle(
+        plugin_handle, static_cast<uint32_t>(regions[slot]->mapped_size()));
+  }
+  data_.clear();
+}
+
+bool RawVarDataGraph::ReadFromShmem(PP_Instance instance) {
+  DCHECK(data_.empty());
+  std::string nodes_copy;
+  if (!TakeNodesFromShmem(&nodes_copy) || instance != shmem_instance_)
+    return false;
+
+  // The copy can't change under us, so the Pickle checks its header against
+  // the copy and the nodes are parsed from it.
+  base::Pickle nodes(nodes_copy.data(), static_cast<int>(nodes_copy.size()));
+  base::PickleIterator iter(nodes);
+  return ReadNodes(&nodes, &iter);
+}
+
+bool RawVarDataGraph::TakeNodesFromShmem(std::string* nodes) {
+  DCHECK(in_shmem_ && !shmem_sender_);
+  in_shmem_ = false;
+  if (shmem_slot_ < 0 ||
+      static_cast<size_t>(shmem_slot_) >= kMaxGraphRegionsPerInstance) {
+    return false;
+  }
+
+  std::unique_ptr<base::SharedMemory> new_region;
+  if (shmem_is_new_) {
+    base::SharedMemoryHandle handle;
+    uint32_t size_in_bytes;
+    if (shmem_host_handle_id_ != -1) {
+      if (!PpapiGlobals::Get()->GetVarTracker()->
+              StopTrackingSharedMemoryHandle(shmem_host_handle_id_,
+                                             shmem_instance_, &handle,
+                                             &size_in_bytes)) {
+        LOG(ERROR) << "Couldn't find graph region id: "
+                   << shmem_host_handle_id_;
+        return false;
+      }
+    } else {
+      if (!shmem_plugin_handle_.is_shmem())
+        return false;
+      handle = shmem_plugin_handle_.shmem();
+      size_in_bytes = shmem_plugin_handle_.size();
+      shmem_plugin_handle_.set_null_shmem();
+    }
+    new_region.reset(new base::SharedMemory(handle, false));
+    if (size_in_bytes < sizeof(GraphRegionHeader) ||
+        !new_region->Map(size_in_bytes)) {
+      return false;
+    }
+  }
+
+  GraphRegionPool& pool = g_graph_region_pool.Get();
+  base::AutoLock lock(pool.lock);
+  GraphRegions& regions = pool.received[shmem_instance_];
+  if (regions.size() <= static_cast<size_t>(shmem_slot_))
+    regions.resize(shmem_slot_ + 1);
+  if (new_region)
+    regions[shmem_slot_] = std::move(new_region);
+  base::SharedMemory* region = regions[shmem_slot_].get();
+  if (!region)
+    return false;
+
+  // The sender can write to the region at any time, so load the size once,
+  // check it, and copy the nodes out before anything else looks at them.
+  GraphRegionHeader* header = GetGraphRegionHeader(region);
+  uint32_t size =
+      static_cast<uint32_t>(base::subtle::NoBarrier_Load(&header->size));
+  bool result = size <= region->mapped_size() - sizeof(GraphRegionHeader) &&
+                size <= static_cast<uint32_t>(std::numeric_limits<int>::max());
+  if (result && nodes)
+    nodes->assign(reinterpret_cast<const char*>(header + 1), size);
+  base::subtle::Release_Store(&header->in_use, 0);
+  return result;
+}
+
+void RawVarDataGraph::ReleaseUnsentShmem() {
+  DCHECK(in_shmem_ && shmem_sender_);
+  in_shmem_ = false;
+  if (shmem_written_)
+    return;
+  GraphRegionPool& pool = g_graph_region_pool.Get();
+  base::AutoLock lock(pool.lock);
+  std::map<PP_Instance, GraphRegions>::iterator found =
+      pool.sent.find(shmem_instance_);
+  if (found == pool.sent.end() ||
+      found->second.size() <= static_cast<size_t>(shmem_slot_)) {
+    return;
+  }
+  std::unique_ptr<base::SharedMemory>& region = found->second[shmem_slot_];
+  if (!region)
+    return;
+  // The receiver never heard of a new region, so it can't be reused by slot.
+  if (shmem_is_new_)
+    region.reset();
+  else
+    base::subtle::Release_Store(&GetGraphRegionHeader(region.get())->in_use,
+                                0);
+}
+
+// static
+void RawVarDataGraph::SetCompactEncodingEnabled(bool enabled) {
+  g_compact_encoding_enabled = enabled;
+}
+
+void RawVarDataGraph::WriteNodes(base::Pickle* m,
+                                 const HandleWriter& handle_writer) {
+  if (g_compact_encoding_enabled) {
+    m->WriteInt(kEncodingCompact);
+    WriteCompactNodes(m, handle_writer);
+    return;
+  }
+  m->WriteInt(kEncodingLegacy);
+  // Write the size, followed by each node in the graph.
+  m->WriteUInt32(static_cast<uint32_t>(data_.size()));
+  for (size_t i = 0; i < data_.size(); ++i) {
+    m->WriteInt(data_[i]->Type());
+    data_[i]->Write(m, handle_writer);
+  }
+}
+
+bool RawVarDataGraph::ReadNodes(const base::Pickle* m,
+                                base::PickleIterator* iter) {
+  int encoding;
+  if (!iter->ReadInt(&encoding))
+    return false;
+  if (encoding == kEncodingCompact)
+    return ReadCompactNodes(m, iter);
+  if (encoding != kEncodingLegacy)
+    return false;
+
+  uint32_t size = 0;
+  if (!iter->ReadUInt32(&size))
+    return false;
+  for (uint32_t i = 0; i < size; ++i) {
+    int32_t type;
+    if (!iter->ReadInt(&type))
+      return false;
+    PP_VarType var_type = static_cast<PP_VarType>(type);
+    data_.push_back(base::WrapUnique(RawVarData::Create(var_type)));
+    if (!data_.back())
+      return false;
+    if (!data_.back()->Read(var_type, m, iter))
+      return false;
+  }
+  return true;
+}
+
+void RawVarDataGraph::WriteCompactNodes(base::Pickle* m,
+                                        const HandleWriter& handle_writer) {
+  CompactGraphWriter writer;
+  std::vector<size_t> pickled_nodes;
+  writer.WriteVarint(data_.size());
+  for (size_t i = 0; i < data_.size(); ++i) {
+    uint8_t type = static_cast<uint8_t>(data_[i]->Type());
+    DCHECK(!(type & kCompactPickledFlag));
+    size_t type_offset = writer.nodes_size();
+    writer.WriteByte(type);
+    if (!data_[i]->WriteCompact(&writer)) {
+      writer.SetByte(type_offset, type | kCompactPickledFlag);
+      pickled_nodes.push_back(i);
+    }
+  }
+
+  m->WriteUInt32(writer.string_count());
+  m->WriteData(writer.strings().data(),
+               static_cast<int>(writer.strings().size()));
+  m->WriteData(writer.nodes().data(), static_cast<int>(writer.nodes().size()));
+  for (size_t i = 0; i < pickled_nodes.size(); ++i)
+    data_[pickled_nodes[i]]->Write(m, handle_writer);
+}
+
+bool RawVarDataGraph::ReadCompactNodes(const base::Pickle* m,
+                                       base::PickleIterator* iter) {
+  uint32_t string_count;
+  const char* strings;
+  int strings_length;
+  const char* nodes;
+  int nodes_length;
+  if (!iter->ReadUInt32(&string_count) ||
+      !iter->ReadData(&strings, &strings_length) ||
+      !iter->ReadData(&nodes, &nodes_length)) {
+    return false;
+  }
+  CompactGraphReader reader(nodes, static_cast<size_t>(nodes_length));
+  if (!reader.InitStrings(string_count, strings,
+                          static_cast<size_t>(strings_length))) {
+    return false;
+  }
+
+  uint32_t size;
+  if (!reader.ReadUInt32(&size))
+    return false;
+  std::vector<std::pair<RawVarData*, PP_VarType>> pickled_nodes;
+  for (uint32_t i = 0; i < size; ++i) {
+    uint8_t type;
+    if (!reader.ReadByte(&type))
+      return false;
+    PP_VarType var_type = static_cast<PP_VarType>(type & ~kCompactPickledFlag);
+    data_.push_back(base::WrapUnique(RawVarData::Create(var_type)));
+    if (!data_.back())
+      return false;
+    if (type & kCompactPickledFlag)
+      pickled_nodes.push_back(std::make_pair(data_.back().get(), var_type));
+    else if (!data_.back()->ReadCompact(var_type, &reader))
+      return false;
+  }
+  if (!reader.AtEnd())
+    return false;
+  for (size_t i = 0; i < pickled_nodes.size(); ++i) {
+    if (!pickled_nodes[i].first->Read(pickled_nodes[i].second, m, iter))
+      return false;
+  }
+  return true;
+}
+
 // RawVarData ------------------------------------------------------------------
 
 // static
@@ -261,6 +869,18 @@ SerializedHandle* RawVarData::GetHandle() {
   return NULL;
 }
 
+bool RawVarData::WriteCompact(CompactGraphWriter* writer) {
+  return false;
+}
+
+bool RawVarData::ReadCompact(PP_VarType type, CompactGraphReader* reader) {
+  return false;
+}
+
+size_t RawVarData::GetInlineDataSize() {
+  return 0;
+}
+
 // BasicRawVarData -------------------------------------------------------------
 BasicRawVarData::BasicRawVarData() {
 }
@@ -350,6 +970,73 @@ bool BasicRawVarData::Read(PP_VarType type,
   return true;
 }
 
+bool BasicRawVarData::WriteCompact(CompactGraphWriter* writer) {
+  switch (var_.type) {
+    case PP_VARTYPE_UNDEFINED:
+    case PP_VARTYPE_NULL:
+      break;
+    case PP_VARTYPE_BOOL:
+      writer->WriteByte(PP_ToBool(var_.value.as_bool) ? 1 : 0);
+      break;
+    case PP_VARTYPE_INT32:
+      writer->WriteSignedVarint(var_.value.as_int);
+      break;
+    case PP_VARTYPE_DOUBLE:
+      writer->WriteBytes(&var_.value.as_double, sizeof(var_.value.as_double));
+      break;
+    case PP_VARTYPE_OBJECT:
+      writer->WriteSignedVarint(var_.value.as_id);
+      break;
+    default:
+      NOTREACHED();
+      return false;
+  }
+  return true;
+}
+
+bool BasicRawVarData::ReadCompact(PP_VarType type,
+                                  CompactGraphReader* reader) {
+  PP_Var result;
+  result.type = type;
+  switch (type) {
+    case PP_VARTYPE_UNDEFINED:
+    case PP_VARTYPE_NULL:
+      break;
+    case PP_VARTYPE_BOOL: {
+      uint8_t bool_value;
+      if (!reader->ReadByte(&bool_value))
+        return false;
+      result.value.as_bool = PP_FromBool(bool_value != 0);
+      break;
+    }
+    case PP_VARTYPE_INT32: {
+      int64_t int_value;
+      if (!reader->ReadSignedVarint(&int_value) || int_value < INT32_MIN ||
+          int_value > INT32_MAX) {
+        return false;
+      }
+      result.value.as_int = static_cast<int32_t>(int_value);
+      break;
+    }
+    case PP_VARTYPE_DOUBLE: {
+      const char* data;
+      if (!reader->ReadBytes(sizeof(result.value.as_double), &data))
+        return false;
+      memcpy(&result.value.as_double, data, sizeof(result.value.as_double));
+      break;
+    }
+    case PP_VARTYPE_OBJECT:
+      if (!reader->ReadSignedVarint(&result.value.as_id))
+        return false;
+      break;
+    default:
+      NOTREACHED();
+      return false;
+  }
+  var_ = result;
+  return true;
+}
+
 // StringRawVarData ------------------------------------------------------------
 StringRawVarData::StringRawVarData() {
 }
@@ -392,6 +1079,20 @@ bool StringRawVarData::Read(PP_VarType type,
   return true;
 }
 
+bool StringRawVarData::WriteCompact(CompactGraphWriter* writer) {
+  writer->WriteString(data_);
+  return true;
+}
+
+bool StringRawVarData::ReadCompact(PP_VarType type,
+                                   CompactGraphReader* reader) {
+  return reader->ReadString(&data_);
+}
+
+size_t StringRawVarData::GetInlineDataSize() {
+  return data_.size();
+}
+
 // ArrayBufferRawVarData -------------------------------------------------------
 ArrayBufferRawVarData::ArrayBufferRawVarData() {
 }
@@ -529,6 +1230,49 @@ bool ArrayBufferRawVarData::Read(PP_VarType type,
   return true;
 }
 
+bool ArrayBufferRawVarData::WriteCompact(CompactGraphWriter* writer) {
+  switch (type_) {
+    case ARRAY_BUFFER_SHMEM_HOST:
+      writer->WriteByte(type_);
+      writer->WriteSignedVarint(host_shm_handle_id_);
+      return true;
+    case ARRAY_BUFFER_NO_SHMEM:
+      writer->WriteByte(type_);
+      writer->WriteBlob(data_);
+      return true;
+    case ARRAY_BUFFER_SHMEM_PLUGIN:
+      // The handle has to go through the HandleWriter.
+      return false;
+  }
+  NOTREACHED();
+  return false;
+}
+
+bool ArrayBufferRawVarData::ReadCompact(PP_VarType type,
+                                        CompactGraphReader* reader) {
+  uint8_t shmem_type;
+  if (!reader->ReadByte(&shmem_type))
+    return false;
+  type_ = static_cast<ShmemType>(shmem_type);
+  switch (type_) {
+    case ARRAY_BUFFER_SHMEM_HOST: {
+      int64_t id;
+      if (!reader->ReadSignedVarint(&id) || id < INT32_MIN || id > INT32_MAX)
+        return false;
+      host_shm_handle_id_ = static_cast<int>(id);
+      return true;
+    }
+    case ARRAY_BUFFER_NO_SHMEM:
+      return reader->ReadBlob(&data_);
+    default:
+      return false;
+  }
+}
+
+size_t ArrayBufferRawVarData::GetInlineDataSize() {
+  return type_ == ARRAY_BUFFER_NO_SHMEM ? data_.size() : 0;
+}
+
 SerializedHandle* ArrayBufferRawVarData::GetHandle() {
   if (type_ == ARRAY_BUFFER_SHMEM_PLUGIN && plugin_shm_handle_.size() != 0)
     return &plugin_shm_handle_;
@@ -595,6 +1339,27 @@ bool ArrayRawVarData::Read(PP_VarType type,
   return true;
 }
 
+bool ArrayRawVarData::WriteCompact(CompactGraphWriter* writer) {
+  writer->WriteVarint(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i)
+    writer->WriteVarint(children_[i]);
+  return true;
+}
+
+bool ArrayRawVarData::ReadCompact(PP_VarType type,
+                                  CompactGraphReader* reader) {
+  uint32_t size;
+  if (!reader->ReadUInt32(&size))
+    return false;
+  for (uint32_t i = 0; i < size; ++i) {
+    uint32_t index;
+    if (!reader->ReadUInt32(&index))
+      return false;
+    children_.push_back(index);
+  }
+  return true;
+}
+
 // DictionaryRawVarData --------------------------------------------------------
 DictionaryRawVarData::DictionaryRawVarData() {
 }
@@ -663,6 +1428,39 @@ bool DictionaryRawVarData::Read(PP_VarType type,
   return true;
 }
 
+bool DictionaryRawVarData::WriteCompact(CompactGraphWriter* writer) {
+  writer->WriteVarint(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    writer->WriteString(children_[i].first);
+    writer->WriteVarint(children_[i].second);
+  }
+  return true;
+}
+
+bool DictionaryRawVarData::ReadCompact(PP_VarType type,
+                                       CompactGraphReader* reader) {
+  uint32_t size;
+  if (!reader->ReadUInt32(&size))
+    return false;
+  for (uint32_t i = 0; i < size; ++i) {
+    std::string key;
+    uint32_t value;
+    if (!reader->ReadString(&key))
+      return false;
+    if (!reader->ReadUInt32(&value))
+      return false;
+    children_.push_back(make_pair(key, value));
+  }
+  return true;
+}
+
+size_t DictionaryRawVarData::GetInlineDataSize() {
+  size_t size = 0;
+  for (size_t i = 0; i < children_.size(); ++i)
+    size += children_[i].first.size();
+  return size;
+}
+
 // ResourceRawVarData ----------------------------------------------------------
 ResourceRawVarData::ResourceRawVarData()
     : pp_resource_(0),
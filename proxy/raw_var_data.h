@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "base/callback.h"
@@ -22,6 +23,7 @@
 namespace base {
 class Pickle;
 class PickleIterator;
+class SharedMemory;
 }
 
 namespace IPC {
@@ -31,6 +33,8 @@ class Message;
 namespace ppapi {
 namespace proxy {
 
+class CompactGraphReader;
+class CompactGraphWriter;
 class RawVarData;
 
 typedef base::Callback<void(base::Pickle*, const SerializedHandle&)>
@@ -52,8 +56,42 @@ typedef base::Callback<void(base::Pickle*, const SerializedHandle&)>
 //
 // Vars that reference other vars (such as Arrays or Dictionaries) use indices
 // into the message to denote which PP_Var is pointed to.
+//
+// The above is the legacy encoding of the nodes. By default the nodes are
+// written in a compact encoding instead, which is tagged so that the reader
+// can handle either:
+//    encoding | (kEncodingLegacy or kEncodingCompact)
+//    strings  | (data: varint count, then varint length + bytes for each
+//             |  distinct string value and dictionary key)
+//    nodes    | (data: varint count, then for each node a type byte followed
+//             |  by varints; strings and keys are indices into |strings|)
+//    pickled node data | (for nodes that can't be written compactly, such as
+//             |  resources and shmem handles, in node order)
+//
+// If the inline data in the graph (strings, dictionary keys and array buffers
+// that aren't already in shared memory) is large, the nodes are instead
+// serialized into a shared memory region when the graph is created, and the
+// message only names that region:
+//    in shmem | (bool)
+//    slot     | (int32, if in shmem, otherwise the format above)
+//    instance | (PP_Instance)
+//    new      | (bool)
+//    host id  | (int, if new; -1 if the handle follows)
+//    handle   | (SerializedHandle, if new and no host id)
+// Regions are kept per instance on both sides and reused. The sender only
+// passes the region the first time it uses a slot; after that the receiver
+// finds its mapping by slot. The receiver copies the nodes out of the mapping
+// before checking and parsing them, since the sender can still write to it,
+// and marks the region free for the sender to reuse. A graph that is dropped
+// without being read frees its region too.
 class PPAPI_PROXY_EXPORT RawVarDataGraph {
  public:
+  // Tags for the way the nodes of the graph are encoded.
+  enum Encoding {
+    kEncodingLegacy = 0,
+    kEncodingCompact = 1,
+  };
+
   // Construct a RawVarDataGraph from a given root PP_Var. A null pointer
   // is returned upon failure.
   static std::unique_ptr<RawVarDataGraph> Create(const PP_Var& var,
@@ -86,10 +124,70 @@ class PPAPI_PROXY_EXPORT RawVarDataGraph {
   // (in order to have fast tests).
   static void SetMinimumArrayBufferSizeForShmemForTest(uint32_t threshold);
 
+  // Sets the amount of inline data in a graph at which point the whole graph
+  // is sent in shared memory rather than in the message. Passing 0 restores
+  // the default.
+  static void SetMinimumGraphSizeForShmem(uint32_t threshold);
+
+  // Creates a shared memory region of |size| bytes for graphs the host sends
+  // to the plugin, along with a handle to it for the plugin, when the host var
+  // tracker doesn't implement CreateSharedMemoryForTransfer().
+  typedef bool (*HostGraphRegionCreator)(
+      PP_Instance instance,
+      uint32_t size,
+      std::unique_ptr<base::SharedMemory>* region,
+      base::SharedMemoryHandle* plugin_handle);
+  static void SetHostGraphRegionCreator(HostGraphRegionCreator creator);
+
+  // Drops the shared memory regions that graphs for |instance| were sent or
+  // received in.
+  static void DidDeleteInstance(PP_Instance instance);
+
+  // Selects whether graphs are written using the compact encoding (the
+  // default) or the legacy one. Reading always accepts both.
+  static void SetCompactEncodingEnabled(bool enabled);
+
  private:
+  // Serializes the nodes into a pooled shared memory region if the graph has
+  // enough inline data and none of the nodes carry handles of their own.
+  // |data_| is cleared on success.
+  void MaybeMoveToShmem(PP_Instance instance);
+  // Parses |data_| out of the region named by |shmem_slot_|. Returns false on
+  // failure.
+  bool ReadFromShmem(PP_Instance instance);
+  // Copies the serialized nodes out of the region named by |shmem_slot_|, or
+  // just drops them if |nodes| is null, and frees the region for the sender.
+  // Returns false if the region or its contents aren't valid.
+  bool TakeNodesFromShmem(std::string* nodes);
+  // Frees the region a graph was written into if the graph was never sent.
+  void ReleaseUnsentShmem();
+
+  // Writes/reads the encoding tag, followed by the nodes in the graph.
+  void WriteNodes(base::Pickle* m, const HandleWriter& handle_writer);
+  bool ReadNodes(const base::Pickle* m, base::PickleIterator* iter);
+  void WriteCompactNodes(base::Pickle* m, const HandleWriter& handle_writer);
+  bool ReadCompactNodes(const base::Pickle* m, base::PickleIterator* iter);
+
   // A list of the nodes in the graph.
   std::vector<std::unique_ptr<RawVarData>> data_;
 
+  // Set if the serialized nodes live in a shared memory region, in which case
+  // |data_| is empty until ReadFromShmem().
+  bool in_shmem_;
+  // Set on the sending side, where |shmem_written_| is set once the graph has
+  // been written to a message.
+  bool shmem_sender_;
+  bool shmem_written_;
+  // The sender's slot for the region, and the instance its pool belongs to.
+  int32_t shmem_slot_;
+  PP_Instance shmem_instance_;
+  // Set if the region is new to the receiver. It is then passed either as
+  // |shmem_host_handle_id_| (from the plugin) or as |shmem_plugin_handle_|
+  // (from the host).
+  bool shmem_is_new_;
+  int shmem_host_handle_id_;
+  SerializedHandle shmem_plugin_handle_;
+
   DISALLOW_COPY_AND_ASSIGN(RawVarDataGraph);
 };
 
@@ -123,10 +221,20 @@ class RawVarData {
                     const base::Pickle* m,
                     base::PickleIterator* iter) = 0;
 
+  // Writes the RawVarData using the compact encoding. Returns false if the
+  // data can't be written compactly, in which case Write() is used instead.
+  virtual bool WriteCompact(CompactGraphWriter* writer);
+  // Reads data written by WriteCompact(). Returns true on success.
+  virtual bool ReadCompact(PP_VarType type, CompactGraphReader* reader);
+
   // Returns a SerializedHandle associated with this RawVarData or NULL if none
   // exists. Ownership of the pointer remains with the RawVarData.
   virtual SerializedHandle* GetHandle();
 
+  // Returns the number of bytes of variable-length data (e.g., string
+  // contents) that Write() copies into the message.
+  virtual size_t GetInlineDataSize();
+
   bool initialized() { return initialized_; }
 
  protected:
@@ -149,6 +257,8 @@ class BasicRawVarData : public RawVarData {
   bool Read(PP_VarType type,
             const base::Pickle* m,
             base::PickleIterator* iter) override;
+  bool WriteCompact(CompactGraphWriter* writer) override;
+  bool ReadCompact(PP_VarType type, CompactGraphReader* reader) override;
 
  private:
   PP_Var var_;
@@ -170,6 +280,9 @@ class StringRawVarData : public RawVarData {
   bool Read(PP_VarType type,
             const base::Pickle* m,
             base::PickleIterator* iter) override;
+  bool WriteCompact(CompactGraphWriter* writer) override;
+  bool ReadCompact(PP_VarType type, CompactGraphReader* reader) override;
+  size_t GetInlineDataSize() override;
 
  private:
   // The data in the string.
@@ -199,6 +312,9 @@ class ArrayBufferRawVarData : public RawVarData {
   bool Read(PP_VarType type,
             const base::Pickle* m,
             base::PickleIterator* iter) override;
+  bool WriteCompact(CompactGraphWriter* writer) override;
+  bool ReadCompact(PP_VarType type, CompactGraphReader* reader) override;
+  size_t GetInlineDataSize() override;
   SerializedHandle* GetHandle() override;
 
  private:
@@ -230,6 +346,8 @@ class ArrayRawVarData : public RawVarData {
   bool Read(PP_VarType type,
             const base::Pickle* m,
             base::PickleIterator* iter) override;
+  bool WriteCompact(CompactGraphWriter* writer) override;
+  bool ReadCompact(PP_VarType type, CompactGraphReader* reader) override;
 
  private:
   std::vector<size_t> children_;
@@ -253,6 +371,9 @@ class DictionaryRawVarData : public RawVarData {
   bool Read(PP_VarType type,
             const base::Pickle* m,
             base::PickleIterator* iter) override;
+  bool WriteCompact(CompactGraphWriter* writer) override;
+  bool ReadCompact(PP_VarType type, CompactGraphReader* reader) override;
+  size_t GetInlineDataSize() override;
 
  private:
   std::vector<std::pair<std::string, size_t> > children_;
@@ -193,6 +193,131 @@ TEST_F(RawVarDataTest, DictionaryArrayTest) {
   array->Set(static_cast<uint32_t>(index), PP_MakeUndefined());
 }
 
+TEST_F(RawVarDataTest, LargeGraphTest) {
+  // Graphs whose inline data crosses the threshold are sent in a shared
+  // memory region rather than in the message.
+  const PP_Instance kInstance = 1234;
+  TestVarTracker* var_tracker =
+      static_cast<TestVarTracker*>(PpapiGlobals::Get()->GetVarTracker());
+  RawVarDataGraph::SetMinimumGraphSizeForShmem(1024);
+  scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+  ScopedPPVar release_dictionary(ScopedPPVar::PassRef(),
+                                 dictionary->GetPPVar());
+  ScopedPPVar release_string(ScopedPPVar::PassRef(),
+                             StringVar::StringToPPVar(std::string(4096, 'x')));
+  dictionary->SetWithStringKey("a long enough key", release_string.get());
+  dictionary->SetWithStringKey("b", PP_MakeInt32(7));
+
+  for (int i = 0; i < 2; ++i) {
+    std::unique_ptr<RawVarDataGraph> expected_data(
+        RawVarDataGraph::Create(dictionary->GetPPVar(), kInstance));
+    ASSERT_TRUE(expected_data);
+    IPC::Message m;
+    expected_data->Write(&m, base::Bind(&DefaultHandleWriter));
+    EXPECT_LT(m.payload_size(), 1024u);
+
+    base::PickleIterator iter(m);
+    std::unique_ptr<RawVarDataGraph> actual_data(
+        RawVarDataGraph::Read(&m, &iter));
+    ASSERT_TRUE(actual_data);
+    ScopedPPVar actual(ScopedPPVar::PassRef(),
+                       actual_data->CreatePPVar(kInstance));
+    EXPECT_TRUE(TestEqual(dictionary->GetPPVar(), actual.get(), true));
+
+    // Once the first graph has been read, its region is reused.
+    EXPECT_EQ(1, var_tracker->shared_memory_created());
+  }
+
+  // A graph that is received but never read, or never sent, doesn't keep
+  // the region from being reused.
+  {
+    std::unique_ptr<RawVarDataGraph> unread_data(
+        RawVarDataGraph::Create(dictionary->GetPPVar(), kInstance));
+    ASSERT_TRUE(unread_data);
+    IPC::Message m;
+    unread_data->Write(&m, base::Bind(&DefaultHandleWriter));
+    base::PickleIterator iter(m);
+    ASSERT_TRUE(RawVarDataGraph::Read(&m, &iter));
+  }
+  {
+    std::unique_ptr<RawVarDataGraph> unsent_data(
+        RawVarDataGraph::Create(dictionary->GetPPVar(), kInstance));
+    ASSERT_TRUE(unsent_data);
+  }
+  {
+    std::unique_ptr<RawVarDataGraph> expected_data(
+        RawVarDataGraph::Create(dictionary->GetPPVar(), kInstance));
+    ASSERT_TRUE(expected_data);
+    IPC::Message m;
+    expected_data->Write(&m, base::Bind(&DefaultHandleWriter));
+    base::PickleIterator iter(m);
+    std::unique_ptr<RawVarDataGraph> actual_data(
+        RawVarDataGraph::Read(&m, &iter));
+    ASSERT_TRUE(actual_data);
+    ScopedPPVar actual(ScopedPPVar::PassRef(),
+                       actual_data->CreatePPVar(kInstance));
+    EXPECT_TRUE(TestEqual(dictionary->GetPPVar(), actual.get(), true));
+    EXPECT_EQ(1, var_tracker->shared_memory_created());
+  }
+
+  // A graph can only be read for the instance it was sent for.
+  {
+    std::unique_ptr<RawVarDataGraph> expected_data(
+        RawVarDataGraph::Create(dictionary->GetPPVar(), kInstance));
+    ASSERT_TRUE(expected_data);
+    IPC::Message m;
+    expected_data->Write(&m, base::Bind(&DefaultHandleWriter));
+    base::PickleIterator iter(m);
+    std::unique_ptr<RawVarDataGraph> actual_data(
+        RawVarDataGraph::Read(&m, &iter));
+    ASSERT_TRUE(actual_data);
+    PP_Var actual = actual_data->CreatePPVar(kInstance + 1);
+    EXPECT_EQ(PP_VARTYPE_UNDEFINED, actual.type);
+  }
+
+  // Small graphs are still sent inline.
+  EXPECT_TRUE(WriteReadAndCompare(StringVar::StringToPPVar("small")));
+  EXPECT_EQ(1, var_tracker->shared_memory_created());
+
+  RawVarDataGraph::DidDeleteInstance(kInstance);
+  RawVarDataGraph::SetMinimumGraphSizeForShmem(0);
+}
+
+TEST_F(RawVarDataTest, CompactEncodingTest) {
+  // An array of dictionaries which all have the same keys.
+  scoped_refptr<ArrayVar> array(new ArrayVar);
+  ScopedPPVar release_array(ScopedPPVar::PassRef(), array->GetPPVar());
+  for (uint32_t i = 0; i < 100; ++i) {
+    scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+    ScopedPPVar release_dictionary(ScopedPPVar::PassRef(),
+                                   dictionary->GetPPVar());
+    dictionary->SetWithStringKey("timestamp", PP_MakeDouble(i * 0.5));
+    dictionary->SetWithStringKey("sequence_number", PP_MakeInt32(i));
+    dictionary->SetWithStringKey("negative", PP_MakeInt32(-1));
+    dictionary->SetWithStringKey("flag", PP_MakeBool(PP_FromBool(i % 2)));
+    ScopedPPVar release_string(ScopedPPVar::PassRef(),
+                               StringVar::StringToPPVar("status: ok"));
+    dictionary->SetWithStringKey("status", release_string.get());
+    array->Set(i, release_dictionary.get());
+  }
+
+  std::unique_ptr<RawVarDataGraph> graph(
+      RawVarDataGraph::Create(array->GetPPVar(), 0));
+  ASSERT_TRUE(graph);
+  IPC::Message legacy_message;
+  RawVarDataGraph::SetCompactEncodingEnabled(false);
+  graph->Write(&legacy_message, base::Bind(&DefaultHandleWriter));
+  EXPECT_TRUE(WriteReadAndCompare(array->GetPPVar()));
+  IPC::Message compact_message;
+  RawVarDataGraph::SetCompactEncodingEnabled(true);
+  graph->Write(&compact_message, base::Bind(&DefaultHandleWriter));
+  EXPECT_TRUE(WriteReadAndCompare(array->GetPPVar()));
+
+  // Keys and equal strings are only sent once.
+  EXPECT_LT(compact_message.payload_size() * 3,
+            legacy_message.payload_size());
+}
+
 TEST_F(RawVarDataTest, ResourceTest) {
   // TODO(mgiuca): This test passes trivially, since GetVarTracker() returns a
   // TestVarTracker which returns a null PP_Var.
@@ -67,6 +67,20 @@ using ppapi::thunk::ResourceCreationAPI;
 namespace ppapi {
 namespace proxy {
 
+namespace {
+
+// On the plugin side, we create PlatformImageData resources for trusted
+// plugins and SimpleImageData resources for untrusted ones.
+PPB_ImageData_Shared::ImageDataType GetImageDataType() {
+#if !defined(OS_NACL)
+  return PPB_ImageData_Shared::PLATFORM;
+#else
+  return PPB_ImageData_Shared::SIMPLE;
+#endif
+}
+
+}  // namespace
+
 ResourceCreationProxy::ResourceCreationProxy(Dispatcher* dispatcher)
     : InterfaceProxy(dispatcher) {
 }
@@ -225,6 +239,15 @@ PP_Resource ResourceCreationProxy::CreateAudioConfig(
       OBJECT_IS_PROXY, instance, sample_rate, sample_frame_count);
 }
 
+PP_Resource ResourceCreationProxy::CreateAudioConfigFloat32(
+    PP_Instance instance,
+    PP_AudioSampleRate sample_rate,
+    uint32_t sample_frame_count) {
+  return PPB_AudioConfig_Shared::Create(OBJECT_IS_PROXY, instance, sample_rate,
+                                        sample_frame_count,
+                                        PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32);
+}
+
 PP_Resource ResourceCreationProxy::CreateCameraDevicePrivate(
     PP_Instance instance) {
   return (new CameraDeviceResource(GetConnection(), instance))->GetReference();
@@ -286,16 +309,8 @@ PP_Resource ResourceCreationProxy::CreateImageData(
     PP_ImageDataFormat format,
     const PP_Size* size,
     PP_Bool init_to_zero) {
-  // On the plugin side, we create PlatformImageData resources for trusted
-  // plugins and SimpleImageData resources for untrusted ones.
-  PPB_ImageData_Shared::ImageDataType type =
-#if !defined(OS_NACL)
-      PPB_ImageData_Shared::PLATFORM;
-#else
-      PPB_ImageData_Shared::SIMPLE;
-#endif
   return PPB_ImageData_Proxy::CreateProxyResource(
-      instance, type,
+      instance, GetImageDataType(),
       format, *size, init_to_zero);
 }
 
@@ -310,6 +325,26 @@ PP_Resource ResourceCreationProxy::CreateImageDataSimple(
       format, *size, init_to_zero);
 }
 
+void ResourceCreationProxy::PrewarmImageDataCache(PP_Instance instance,
+                                                  PP_ImageDataFormat format,
+                                                  const PP_Size* size,
+                                                  uint32_t count) {
+  PPB_ImageData_Proxy::PrewarmCache(instance, GetImageDataType(), format,
+                                    *size, count);
+}
+
+void ResourceCreationProxy::SetImageDataCacheBudget(PP_Instance instance,
+                                                    uint32_t budget_bytes) {
+  PPB_ImageData_Proxy::SetCacheBudget(instance, budget_bytes);
+}
+
+PP_Bool ResourceCreationProxy::GetImageDataCacheStats(
+    PP_Instance instance,
+    PP_ImageDataCacheStats_Dev* stats) {
+  *stats = PPB_ImageData_Proxy::GetCacheStats(instance);
+  return PP_TRUE;
+}
+
 PP_Resource ResourceCreationProxy::CreateMediaStreamVideoTrack(
     PP_Instance instance) {
   return (new MediaStreamVideoTrackResource(GetConnection(),
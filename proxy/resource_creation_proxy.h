@@ -107,6 +107,9 @@ class ResourceCreationProxy : public InterfaceProxy,
   PP_Resource CreateAudioConfig(PP_Instance instance,
                                 PP_AudioSampleRate sample_rate,
                                 uint32_t sample_frame_count) override;
+  PP_Resource CreateAudioConfigFloat32(PP_Instance instance,
+                                       PP_AudioSampleRate sample_rate,
+                                       uint32_t sample_frame_count) override;
   PP_Resource CreateCameraDevicePrivate(PP_Instance instance) override;
   PP_Resource CreateCompositor(PP_Instance instance) override;
   PP_Resource CreateFileChooser(PP_Instance instance,
@@ -135,6 +138,14 @@ class ResourceCreationProxy : public InterfaceProxy,
                                     PP_ImageDataFormat format,
                                     const PP_Size* size,
                                     PP_Bool init_to_zero) override;
+  void PrewarmImageDataCache(PP_Instance instance,
+                             PP_ImageDataFormat format,
+                             const PP_Size* size,
+                             uint32_t count) override;
+  void SetImageDataCacheBudget(PP_Instance instance,
+                               uint32_t budget_bytes) override;
+  PP_Bool GetImageDataCacheStats(PP_Instance instance,
+                                 PP_ImageDataCacheStats_Dev* stats) override;
   PP_Resource CreateMediaStreamVideoTrack(PP_Instance instance) override;
   PP_Resource CreateNetAddressFromIPv4Address(
       PP_Instance instance,
@@ -110,5 +110,15 @@ PPBFlash_DrawGlyphs_Params::PPBFlash_DrawGlyphs_Params()
 
 PPBFlash_DrawGlyphs_Params::~PPBFlash_DrawGlyphs_Params() {}
 
+PPB_Graphics2D_Operation::PPB_Graphics2D_Operation() : type(TYPE_PAINT) {
+  point.x = 0;
+  point.y = 0;
+}
+
+PPB_Graphics2D_Operation::PPB_Graphics2D_Operation(
+    const PPB_Graphics2D_Operation& other) = default;
+
+PPB_Graphics2D_Operation::~PPB_Graphics2D_Operation() {}
+
 }  // namespace proxy
 }  // namespace ppapi
@@ -109,6 +109,30 @@ struct PPAPI_PROXY_EXPORT PPBFlash_DrawGlyphs_Params {
   std::vector<PP_Point> glyph_advances;
 };
 
+// A PaintImageData() or Scroll() call queued by Graphics2DResource until the
+// next Flush(), when the queued calls are sent to the host in one message.
+struct PPAPI_PROXY_EXPORT PPB_Graphics2D_Operation {
+  enum Type {
+    TYPE_PAINT,
+    TYPE_SCROLL,
+    TYPE_LAST = TYPE_SCROLL
+  };
+
+  PPB_Graphics2D_Operation();
+  PPB_Graphics2D_Operation(const PPB_Graphics2D_Operation& other);
+  ~PPB_Graphics2D_Operation();
+
+  Type type;
+  // The image to paint for TYPE_PAINT.
+  ppapi::HostResource image_data;
+  // The top left of the image for TYPE_PAINT, or the scroll amount for
+  // TYPE_SCROLL.
+  PP_Point point;
+  // The parts of the image to paint for TYPE_PAINT, or the clip rect for
+  // TYPE_SCROLL. Empty means the whole image or the whole context.
+  std::vector<PP_Rect> rects;
+};
+
 struct PPBURLLoader_UpdateProgress_Params {
   PP_Instance instance;
   ppapi::HostResource resource;
@@ -7,7 +7,6 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
-#include <utility>
 
 #include "base/logging.h"
 #include "ppapi/c/pp_errors.h"
@@ -23,32 +22,10 @@ namespace proxy {
 
 namespace {
 
-int32_t SetRecvFromOutput(PP_Instance pp_instance,
-                          const std::unique_ptr<std::string>& data,
-                          const PP_NetAddress_Private& addr,
-                          char* output_buffer,
-                          int32_t num_bytes,
-                          PP_Resource* output_addr,
-                          int32_t browser_result) {
-  ProxyLock::AssertAcquired();
-  DCHECK_GE(num_bytes, static_cast<int32_t>(data->size()));
-
-  int32_t result = browser_result;
-  if (result == PP_OK && output_addr) {
-    thunk::EnterResourceCreationNoLock enter(pp_instance);
-    if (enter.succeeded()) {
-      *output_addr = enter.functions()->CreateNetAddressFromNetAddressPrivate(
-          pp_instance, addr);
-    } else {
-      result = PP_ERROR_FAILED;
-    }
-  }
-
-  if (result == PP_OK && !data->empty())
-    memcpy(output_buffer, data->c_str(), data->size());
-
-  return result == PP_OK ? static_cast<int32_t>(data->size()) : result;
-}
+// Enough for a full queue of Ethernet-MTU-sized packets, which is what most
+// sockets see, so that their receive slab never needs to grow.
+const size_t kInitialSlabSize =
+    UDPSocketResourceConstants::kPluginReceiveBufferSlots * 1500;
 
 }  // namespace
 
@@ -66,8 +43,8 @@ void UDPSocketFilter::AddUDPResource(
   ProxyLock::AssertAcquired();
   base::AutoLock acquire(lock_);
   DCHECK(queues_.find(resource) == queues_.end());
-  queues_[resource] = std::make_unique<RecvQueue>(instance, private_api,
-                                                  slot_available_callback);
+  queues_[resource] = std::make_unique<RecvQueue>(
+      this, instance, resource, private_api, slot_available_callback);
 }
 
 void UDPSocketFilter::RemoveUDPResource(PP_Resource resource) {
@@ -93,6 +70,24 @@ int32_t UDPSocketFilter::RequestData(
   return it->second->RequestData(num_bytes, buffer, addr, callback);
 }
 
+int32_t UDPSocketFilter::RequestDataBatch(
+    PP_Resource resource,
+    int32_t num_bytes,
+    char* buffer,
+    PP_UDPSocket_Datagram_Dev* datagrams,
+    uint32_t max_datagrams,
+    const scoped_refptr<TrackedCallback>& callback) {
+  ProxyLock::AssertAcquired();
+  base::AutoLock acquire(lock_);
+  auto it = queues_.find(resource);
+  if (it == queues_.end()) {
+    NOTREACHED();
+    return PP_ERROR_FAILED;
+  }
+  return it->second->RequestDataBatch(num_bytes, buffer, datagrams,
+                                      max_datagrams, callback);
+}
+
 bool UDPSocketFilter::OnResourceReplyReceived(
     const ResourceMessageReplyParams& params,
     const IPC::Message& nested_msg) {
@@ -112,6 +107,39 @@ PP_NetAddress_Private UDPSocketFilter::GetLastAddrPrivate(
   return it->second->GetLastAddrPrivate();
 }
 
+int32_t UDPSocketFilter::CompleteRequestData(PP_Resource resource,
+                                             int32_t num_bytes,
+                                             char* buffer,
+                                             PP_Resource* addr,
+                                             int32_t result) {
+  ProxyLock::AssertAcquired();
+  if (result == PP_ERROR_ABORTED)
+    return result;
+  base::AutoLock acquire(lock_);
+  auto it = queues_.find(resource);
+  if (it == queues_.end())
+    return PP_ERROR_ABORTED;
+  return it->second->ReadData(num_bytes, buffer, addr);
+}
+
+int32_t UDPSocketFilter::CompleteRequestDataBatch(
+    PP_Resource resource,
+    int32_t num_bytes,
+    char* buffer,
+    PP_UDPSocket_Datagram_Dev* datagrams,
+    uint32_t max_datagrams,
+    int32_t result) {
+  ProxyLock::AssertAcquired();
+  if (result == PP_ERROR_ABORTED)
+    return result;
+  base::AutoLock acquire(lock_);
+  auto it = queues_.find(resource);
+  if (it == queues_.end())
+    return PP_ERROR_ABORTED;
+  return it->second->ReadDataBatch(num_bytes, buffer, datagrams,
+                                   max_datagrams);
+}
+
 void UDPSocketFilter::OnPluginMsgPushRecvResult(
     const ResourceMessageReplyParams& params,
     int32_t result,
@@ -130,16 +158,23 @@ void UDPSocketFilter::OnPluginMsgPushRecvResult(
 }
 
 UDPSocketFilter::RecvQueue::RecvQueue(
+    UDPSocketFilter* filter,
     PP_Instance pp_instance,
+    PP_Resource pp_resource,
     bool private_api,
     const base::Closure& slot_available_callback)
-    : pp_instance_(pp_instance),
+    : filter_(filter),
+      pp_instance_(pp_instance),
+      pp_resource_(pp_resource),
       read_buffer_(nullptr),
       bytes_to_read_(0),
       recvfrom_addr_resource_(nullptr),
+      recvfrom_datagrams_(nullptr),
+      max_datagrams_(0),
       last_recvfrom_addr_(),
       private_api_(private_api),
       slot_available_callback_(slot_available_callback) {
+  slab_.reserve(kInitialSlabSize);
 }
 
 UDPSocketFilter::RecvQueue::~RecvQueue() {
@@ -156,46 +191,42 @@ void UDPSocketFilter::RecvQueue::DataReceivedOnIOThread(
             static_cast<size_t>(
                 UDPSocketResourceConstants::kPluginReceiveBufferSlots));
 
-  if (!TrackedCallback::IsPending(recvfrom_callback_) || !read_buffer_) {
-    recv_buffers_.push(RecvBuffer());
-    RecvBuffer& back = recv_buffers_.back();
-    back.result = result;
-    back.data = data;
-    back.addr = addr;
+  PushBuffer(result, data, addr);
+  if (!TrackedCallback::IsPending(recvfrom_callback_) || !read_buffer_)
     return;
-  }
-  DCHECK_EQ(recv_buffers_.size(), 0u);
+  DCHECK_EQ(recv_buffers_.size(), 1u);
 
   if (bytes_to_read_ < static_cast<int32_t>(data.size())) {
-    recv_buffers_.push(RecvBuffer());
-    RecvBuffer& back = recv_buffers_.back();
-    back.result = result;
-    back.data = data;
-    back.addr = addr;
-
+    // Leave the data queued for a request with a bigger buffer.
     result = PP_ERROR_MESSAGE_TOO_BIG;
   } else {
-    // Instead of calling SetRecvFromOutput directly, post it as a completion
-    // task, so that:
+    // Don't read the data here, but in a completion task, so that:
     // 1) It can run with the ProxyLock (we can't lock it on the IO thread.)
     // 2) So that we only write to the output params in the case of success.
     //    (Since the callback will complete on another thread, it's possible
     //     that the resource will be deleted and abort the callback before it
     //     is actually run.)
-    std::unique_ptr<std::string> data_to_pass(new std::string(data));
-    recvfrom_callback_->set_completion_task(base::Bind(
-        &SetRecvFromOutput, pp_instance_, base::Passed(std::move(data_to_pass)),
-        addr, base::Unretained(read_buffer_), bytes_to_read_,
-        base::Unretained(recvfrom_addr_resource_)));
-    last_recvfrom_addr_ = addr;
-    PpapiGlobals::Get()->GetMainThreadMessageLoop()->PostTask(
-        FROM_HERE,
-        RunWhileLocked(slot_available_callback_));
+    // 3) A batch request also gets what arrives before the task runs.
+    if (recvfrom_datagrams_) {
+      recvfrom_callback_->set_completion_task(base::Bind(
+          &UDPSocketFilter::CompleteRequestDataBatch,
+          scoped_refptr<UDPSocketFilter>(filter_), pp_resource_,
+          bytes_to_read_, base::Unretained(read_buffer_),
+          base::Unretained(recvfrom_datagrams_), max_datagrams_));
+    } else {
+      recvfrom_callback_->set_completion_task(base::Bind(
+          &UDPSocketFilter::CompleteRequestData,
+          scoped_refptr<UDPSocketFilter>(filter_), pp_resource_,
+          bytes_to_read_, base::Unretained(read_buffer_),
+          base::Unretained(recvfrom_addr_resource_)));
+    }
   }
 
   read_buffer_ = NULL;
   bytes_to_read_ = -1;
   recvfrom_addr_resource_ = NULL;
+  recvfrom_datagrams_ = NULL;
+  max_datagrams_ = 0;
 
   recvfrom_callback_->Run(
       ConvertNetworkAPIErrorForCompatibility(result, private_api_));
@@ -220,25 +251,153 @@ int32_t UDPSocketFilter::RecvQueue::RequestData(
     recvfrom_addr_resource_ = addr_out;
     recvfrom_callback_ = callback;
     return PP_OK_COMPLETIONPENDING;
-  } else {
-    RecvBuffer& front = recv_buffers_.front();
+  }
+  return ReadData(num_bytes, buffer_out, addr_out);
+}
+
+int32_t UDPSocketFilter::RecvQueue::RequestDataBatch(
+    int32_t num_bytes,
+    char* buffer_out,
+    PP_UDPSocket_Datagram_Dev* datagrams_out,
+    uint32_t max_datagrams,
+    const scoped_refptr<TrackedCallback>& callback) {
+  ProxyLock::AssertAcquired();
+  if (!buffer_out || num_bytes <= 0 || !datagrams_out || !max_datagrams)
+    return PP_ERROR_BADARGUMENT;
+  if (TrackedCallback::IsPending(recvfrom_callback_))
+    return PP_ERROR_INPROGRESS;
+
+  if (recv_buffers_.empty()) {
+    read_buffer_ = buffer_out;
+    bytes_to_read_ = num_bytes;
+    recvfrom_datagrams_ = datagrams_out;
+    max_datagrams_ = max_datagrams;
+    recvfrom_callback_ = callback;
+    return PP_OK_COMPLETIONPENDING;
+  }
+  return ReadDataBatch(num_bytes, buffer_out, datagrams_out, max_datagrams);
+}
+
+int32_t UDPSocketFilter::RecvQueue::ReadData(int32_t num_bytes,
+                                             char* buffer_out,
+                                             PP_Resource* addr_out) {
+  ProxyLock::AssertAcquired();
+  if (recv_buffers_.empty()) {
+    NOTREACHED();
+    return PP_ERROR_FAILED;
+  }
+  const RecvBuffer& front = recv_buffers_.front();
+  if (static_cast<size_t>(num_bytes) < front.size)
+    return PP_ERROR_MESSAGE_TOO_BIG;
+
+  int32_t result = front.result;
+  if (result == PP_OK && addr_out && !CreateNetAddress(front.addr, addr_out))
+    result = PP_ERROR_FAILED;
+  if (result == PP_OK) {
+    if (front.size)
+      memcpy(buffer_out, &slab_[front.offset], front.size);
+    result = static_cast<int32_t>(front.size);
+  }
+  last_recvfrom_addr_ = front.addr;
+  PopBuffer();
+  slot_available_callback_.Run();
+
+  return result;
+}
 
-    if (static_cast<size_t>(num_bytes) < front.data.size())
-      return PP_ERROR_MESSAGE_TOO_BIG;
+int32_t UDPSocketFilter::RecvQueue::ReadDataBatch(
+    int32_t num_bytes,
+    char* buffer_out,
+    PP_UDPSocket_Datagram_Dev* datagrams_out,
+    uint32_t max_datagrams) {
+  ProxyLock::AssertAcquired();
+  if (recv_buffers_.empty()) {
+    NOTREACHED();
+    return PP_ERROR_FAILED;
+  }
+
+  size_t offset = 0;
+  uint32_t count = 0;
+  while (count < max_datagrams && !recv_buffers_.empty()) {
+    const RecvBuffer& front = recv_buffers_.front();
+    // A failed receive is reported on its own, after the packets before it.
+    if (front.result != PP_OK) {
+      if (count)
+        break;
+      int32_t result = front.result;
+      PopBuffer();
+      slot_available_callback_.Run();
+      return result;
+    }
+    if (front.size > static_cast<size_t>(num_bytes) - offset) {
+      if (!count)
+        return PP_ERROR_MESSAGE_TOO_BIG;
+      break;
+    }
+    PP_Resource addr = 0;
+    if (!CreateNetAddress(front.addr, &addr)) {
+      if (!count)
+        return PP_ERROR_FAILED;
+      break;
+    }
+
+    if (front.size)
+      memcpy(buffer_out + offset, &slab_[front.offset], front.size);
+    PP_UDPSocket_Datagram_Dev& datagram = datagrams_out[count];
+    datagram.offset = static_cast<int32_t>(offset);
+    datagram.size = static_cast<int32_t>(front.size);
+    datagram.addr = addr;
+    offset += front.size;
+    ++count;
 
-    std::unique_ptr<std::string> data_to_pass(new std::string);
-    data_to_pass->swap(front.data);
-    int32_t result =
-        SetRecvFromOutput(pp_instance_, std::move(data_to_pass), front.addr,
-                          buffer_out, num_bytes, addr_out, front.result);
     last_recvfrom_addr_ = front.addr;
-    recv_buffers_.pop();
+    PopBuffer();
     slot_available_callback_.Run();
+  }
+  return static_cast<int32_t>(count);
+}
 
-    return result;
+void UDPSocketFilter::RecvQueue::PushBuffer(int32_t result,
+                                            const std::string& data,
+                                            const PP_NetAddress_Private& addr) {
+  RecvBuffer buffer;
+  // Store the result as the plugin sees it, so that reads from the queue
+  // return the same errors as reads that complete a pending callback.
+  buffer.result = ConvertNetworkAPIErrorForCompatibility(result, private_api_);
+  buffer.offset = slab_.size();
+  buffer.size = data.size();
+  buffer.addr = addr;
+  slab_.insert(slab_.end(), data.begin(), data.end());
+  recv_buffers_.push_back(buffer);
+}
+
+void UDPSocketFilter::RecvQueue::PopBuffer() {
+  recv_buffers_.pop_front();
+  if (recv_buffers_.empty()) {
+    slab_.clear();
+    return;
+  }
+  // If the queue never drains, move what's left to the front once more than
+  // half the slab has been read, so the slab stays bounded.
+  size_t read_offset = recv_buffers_.front().offset;
+  if (read_offset > slab_.size() / 2) {
+    slab_.erase(slab_.begin(), slab_.begin() + read_offset);
+    for (RecvBuffer& buffer : recv_buffers_)
+      buffer.offset -= read_offset;
   }
 }
 
+bool UDPSocketFilter::RecvQueue::CreateNetAddress(
+    const PP_NetAddress_Private& addr,
+    PP_Resource* addr_out) {
+  thunk::EnterResourceCreationNoLock enter(pp_instance_);
+  if (enter.failed())
+    return false;
+  *addr_out = enter.functions()->CreateNetAddressFromNetAddressPrivate(
+      pp_instance_, addr);
+  return true;
+}
+
 PP_NetAddress_Private UDPSocketFilter::RecvQueue::GetLastAddrPrivate() const {
   CHECK(private_api_);
   return last_recvfrom_addr_;
@@ -11,10 +11,12 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base/compiler_specific.h"
-#include "base/containers/queue.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/ref_counted.h"
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
 #include "ppapi/c/ppb_udp_socket.h"
 #include "ppapi/c/private/ppb_net_address_private.h"
 #include "ppapi/proxy/plugin_resource.h"
@@ -51,6 +53,14 @@ class PPAPI_PROXY_EXPORT UDPSocketFilter : public ResourceMessageFilter {
                       char* buffer,
                       PP_Resource* addr,
                       const scoped_refptr<TrackedCallback>& callback);
+  // Like RequestData, but takes every queued datagram (up to |max_datagrams|)
+  // that fits in |buffer|. See PPB_UDPSocket_Dev::RecvFromBatch.
+  int32_t RequestDataBatch(PP_Resource resource,
+                           int32_t num_bytes,
+                           char* buffer,
+                           PP_UDPSocket_Datagram_Dev* datagrams,
+                           uint32_t max_datagrams,
+                           const scoped_refptr<TrackedCallback>& callback);
 
   // ResourceMessageFilter implementation.
   bool OnResourceReplyReceived(const ResourceMessageReplyParams& reply_params,
@@ -75,13 +85,16 @@ class PPAPI_PROXY_EXPORT UDPSocketFilter : public ResourceMessageFilter {
   // must be protected by UDPSocketFilter::lock_.
   class RecvQueue {
    public:
-    explicit RecvQueue(PP_Instance instance,
-                       bool private_api,
-                       const base::Closure& slot_available_callback);
+    RecvQueue(UDPSocketFilter* filter,
+              PP_Instance instance,
+              PP_Resource resource,
+              bool private_api,
+              const base::Closure& slot_available_callback);
     ~RecvQueue();
 
-    // Called on the IO thread when data is received. It will post |callback_|
-    // if it's valid, otherwise push the data on buffers_.
+    // Called on the IO thread when data is received. It pushes the data on
+    // recv_buffers_, and if a request is pending, runs |recvfrom_callback_|
+    // with a completion task that reads it out.
     // The ppapi::ProxyLock should *not* be held, and won't be acquired.
     void DataReceivedOnIOThread(int32_t result,
                                 const std::string& d,
@@ -96,21 +109,58 @@ class PPAPI_PROXY_EXPORT UDPSocketFilter : public ResourceMessageFilter {
                         char* buffer_out,
                         PP_Resource* addr_out,
                         const scoped_refptr<TrackedCallback>& callback);
+    int32_t RequestDataBatch(int32_t num_bytes,
+                             char* buffer_out,
+                             PP_UDPSocket_Datagram_Dev* datagrams_out,
+                             uint32_t max_datagrams,
+                             const scoped_refptr<TrackedCallback>& callback);
+
+    // Copy queued data to the plugin's out-params, and tell the host about
+    // the slots that were freed. Must hold the ProxyLock.
+    int32_t ReadData(int32_t num_bytes,
+                     char* buffer_out,
+                     PP_Resource* addr_out);
+    int32_t ReadDataBatch(int32_t num_bytes,
+                          char* buffer_out,
+                          PP_UDPSocket_Datagram_Dev* datagrams_out,
+                          uint32_t max_datagrams);
+
     PP_NetAddress_Private GetLastAddrPrivate() const;
 
    private:
+    // A received packet. Its payload is |size| bytes at |offset| in |slab_|.
     struct RecvBuffer {
+      // Already converted with ConvertNetworkAPIErrorForCompatibility().
       int32_t result;
-      std::string data;
+      size_t offset;
+      size_t size;
       PP_NetAddress_Private addr;
     };
-    base::queue<RecvBuffer> recv_buffers_;
 
+    void PushBuffer(int32_t result,
+                    const std::string& data,
+                    const PP_NetAddress_Private& addr);
+    void PopBuffer();
+    bool CreateNetAddress(const PP_NetAddress_Private& addr,
+                          PP_Resource* addr_out);
+
+    base::circular_deque<RecvBuffer> recv_buffers_;
+    // Payloads of |recv_buffers_|, back to back. It's reset when the queue
+    // drains and compacted when the read position passes its middle, so it
+    // keeps its capacity instead of allocating for every packet.
+    std::vector<char> slab_;
+
+    UDPSocketFilter* filter_;
     PP_Instance pp_instance_;
+    PP_Resource pp_resource_;
     scoped_refptr<ppapi::TrackedCallback> recvfrom_callback_;
+    // The out-params of the pending request, if any. |recvfrom_datagrams_| is
+    // non-NULL for a RequestDataBatch.
     char* read_buffer_;
     int32_t bytes_to_read_;
     PP_Resource* recvfrom_addr_resource_;
+    PP_UDPSocket_Datagram_Dev* recvfrom_datagrams_;
+    uint32_t max_datagrams_;
     PP_NetAddress_Private last_recvfrom_addr_;
     bool private_api_;
     // Callback to invoke when a UDP receive slot is available.
@@ -120,6 +170,19 @@ class PPAPI_PROXY_EXPORT UDPSocketFilter : public ResourceMessageFilter {
  private:
   // This is deleted via RefCountedThreadSafe (see ResourceMessageFilter).
   ~UDPSocketFilter();
+  // Completion tasks for requests that couldn't be satisfied immediately.
+  // They run with the ProxyLock and read out whatever has been queued by then.
+  int32_t CompleteRequestData(PP_Resource resource,
+                              int32_t num_bytes,
+                              char* buffer,
+                              PP_Resource* addr,
+                              int32_t result);
+  int32_t CompleteRequestDataBatch(PP_Resource resource,
+                                   int32_t num_bytes,
+                                   char* buffer,
+                                   PP_UDPSocket_Datagram_Dev* datagrams,
+                                   uint32_t max_datagrams,
+                                   int32_t result);
   void OnPluginMsgPushRecvResult(const ResourceMessageReplyParams& params,
                                  int32_t result,
                                  const std::string& data,
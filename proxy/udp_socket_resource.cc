@@ -4,6 +4,10 @@
 
 #include "ppapi/proxy/udp_socket_resource.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "ppapi/proxy/udp_socket_resource_constants.h"
 #include "ppapi/shared_impl/tracked_callback.h"
 #include "ppapi/thunk/enter.h"
 #include "ppapi/thunk/ppb_net_address_api.h"
@@ -130,5 +134,39 @@ int32_t UDPSocketResource::LeaveGroup(
                         callback);
 }
 
+int32_t UDPSocketResource::RecvFromBatch(
+    char* buffer,
+    int32_t num_bytes,
+    PP_UDPSocket_Datagram_Dev datagrams[],
+    uint32_t max_datagrams,
+    scoped_refptr<TrackedCallback> callback) {
+  return RecvFromBatchImpl(buffer, num_bytes, datagrams, max_datagrams,
+                           callback);
+}
+
+int32_t UDPSocketResource::SendToBatch(
+    const char* buffer,
+    int32_t num_bytes,
+    const PP_UDPSocket_Datagram_Dev datagrams[],
+    uint32_t num_datagrams,
+    scoped_refptr<TrackedCallback> callback) {
+  if (!datagrams || !num_datagrams)
+    return PP_ERROR_BADARGUMENT;
+  // The result counts the datagrams sent, so a batch can be cut short here
+  // and the caller sends the rest.
+  num_datagrams = std::min(
+      num_datagrams,
+      static_cast<uint32_t>(UDPSocketResourceConstants::kMaxSendBatchDatagrams));
+
+  std::vector<PP_NetAddress_Private> addrs(num_datagrams);
+  for (uint32_t i = 0; i < num_datagrams; ++i) {
+    EnterNetAddressNoLock enter(datagrams[i].addr, true);
+    if (enter.failed())
+      return PP_ERROR_BADARGUMENT;
+    addrs[i] = enter.object()->GetNetAddressPrivate();
+  }
+  return SendToBatchImpl(buffer, num_bytes, datagrams, addrs, callback);
+}
+
 }  // namespace proxy
 }  // namespace ppapi
@@ -53,6 +53,16 @@ class PPAPI_PROXY_EXPORT UDPSocketResource : public UDPSocketResourceBase,
                     scoped_refptr<TrackedCallback> callback) override;
   int32_t LeaveGroup(PP_Resource group,
                      scoped_refptr<TrackedCallback> callback) override;
+  int32_t RecvFromBatch(char* buffer,
+                        int32_t num_bytes,
+                        PP_UDPSocket_Datagram_Dev datagrams[],
+                        uint32_t max_datagrams,
+                        scoped_refptr<TrackedCallback> callback) override;
+  int32_t SendToBatch(const char* buffer,
+                      int32_t num_bytes,
+                      const PP_UDPSocket_Datagram_Dev datagrams[],
+                      uint32_t num_datagrams,
+                      scoped_refptr<TrackedCallback> callback) override;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(UDPSocketResource);
@@ -4,11 +4,13 @@
 
 #include "ppapi/proxy/udp_socket_resource_base.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "base/logging.h"
 #include "ppapi/c/pp_bool.h"
 #include "ppapi/c/pp_errors.h"
+#include "ppapi/proxy/dispatch_reply_message.h"
 #include "ppapi/proxy/error_conversion.h"
 #include "ppapi/proxy/plugin_globals.h"
 #include "ppapi/proxy/ppapi_messages.h"
@@ -34,6 +36,11 @@ void PostAbortIfNecessary(const scoped_refptr<TrackedCallback>& callback) {
 
 }  // namespace
 
+UDPSocketResourceBase::SendBatch::SendBatch()
+    : num_sent(0), num_replied(0), num_succeeded(0), error(PP_OK) {}
+
+UDPSocketResourceBase::SendBatch::~SendBatch() {}
+
 UDPSocketResourceBase::UDPSocketResourceBase(Connection connection,
                                              PP_Instance instance,
                                              bool private_api)
@@ -42,6 +49,7 @@ UDPSocketResourceBase::UDPSocketResourceBase(Connection connection,
       bind_called_(false),
       bound_(false),
       closed_(false),
+      send_to_batch_enabled_(false),
       recv_filter_(PluginGlobals::Get()->udp_socket_filter()),
       bound_addr_() {
   recv_filter_->AddUDPResource(
@@ -172,6 +180,18 @@ int32_t UDPSocketResourceBase::RecvFromImpl(
                                    callback);
 }
 
+int32_t UDPSocketResourceBase::RecvFromBatchImpl(
+    char* buffer_out,
+    int32_t num_bytes,
+    PP_UDPSocket_Datagram_Dev* datagrams,
+    uint32_t max_datagrams,
+    scoped_refptr<TrackedCallback> callback) {
+  if (!bound_)
+    return PP_ERROR_FAILED;
+  return recv_filter_->RequestDataBatch(pp_resource(), num_bytes, buffer_out,
+                                        datagrams, max_datagrams, callback);
+}
+
 PP_Bool UDPSocketResourceBase::GetRecvFromAddressImpl(
     PP_NetAddress_Private* addr) {
   if (!addr)
@@ -189,8 +209,7 @@ int32_t UDPSocketResourceBase::SendToImpl(
     return PP_ERROR_BADARGUMENT;
   if (!bound_)
     return PP_ERROR_FAILED;
-  if (sendto_callbacks_.size() ==
-      UDPSocketResourceConstants::kPluginSendBufferSlots)
+  if (SendSlotsInUse() == UDPSocketResourceConstants::kPluginSendBufferSlots)
     return PP_ERROR_INPROGRESS;
 
   if (num_bytes > UDPSocketResourceConstants::kMaxWriteSize)
@@ -208,6 +227,80 @@ int32_t UDPSocketResourceBase::SendToImpl(
   return PP_OK_COMPLETIONPENDING;
 }
 
+int32_t UDPSocketResourceBase::SendToBatchImpl(
+    const char* buffer,
+    int32_t num_bytes,
+    const PP_UDPSocket_Datagram_Dev* datagrams,
+    const std::vector<PP_NetAddress_Private>& addrs,
+    scoped_refptr<TrackedCallback> callback) {
+  if (!buffer || num_bytes <= 0 || !datagrams || addrs.empty())
+    return PP_ERROR_BADARGUMENT;
+  if (!bound_)
+    return PP_ERROR_FAILED;
+  if (send_batch_)
+    return PP_ERROR_INPROGRESS;
+
+  DCHECK_LE(addrs.size(),
+            static_cast<size_t>(
+                UDPSocketResourceConstants::kMaxSendBatchDatagrams));
+
+  // Like SendToImpl, quietly truncate datagrams that are too big. The batch
+  // stops at the first datagram that would take it past kMaxSendBatchSize;
+  // since each datagram is at most kMaxWriteSize, at least one always fits.
+  std::vector<uint32_t> sizes;
+  sizes.reserve(addrs.size());
+  size_t total_size = 0;
+  for (size_t i = 0; i < addrs.size(); ++i) {
+    const PP_UDPSocket_Datagram_Dev& datagram = datagrams[i];
+    if (datagram.offset < 0 || datagram.size <= 0 ||
+        datagram.size > num_bytes - datagram.offset) {
+      return PP_ERROR_BADARGUMENT;
+    }
+    uint32_t size = std::min(
+        datagram.size,
+        static_cast<int32_t>(UDPSocketResourceConstants::kMaxWriteSize));
+    if (total_size + size > UDPSocketResourceConstants::kMaxSendBatchSize)
+      break;
+    sizes.push_back(size);
+    total_size += size;
+  }
+  std::vector<PP_NetAddress_Private> batch_addrs(
+      addrs.begin(), addrs.begin() + sizes.size());
+
+  send_batch_.reset(new SendBatch);
+  send_batch_->callback = callback;
+
+  if (send_to_batch_enabled_) {
+    // The payloads go straight from |buffer| into the one message. They are
+    // sent inline, as SendTo sends its data: the batch is bounded by
+    // kMaxSendBatchSize, and a shared memory region would cost a handle
+    // transfer and a mapping on both sides for every batch.
+    std::string data;
+    data.reserve(total_size);
+    for (size_t i = 0; i < sizes.size(); ++i)
+      data.append(buffer + datagrams[i].offset, sizes[i]);
+    Call<PpapiPluginMsg_UDPSocket_SendToBatchReply>(
+        BROWSER,
+        PpapiHostMsg_UDPSocket_SendToBatch(data, sizes, batch_addrs),
+        base::Bind(&UDPSocketResourceBase::OnPluginMsgSendToBatchReply,
+                   base::Unretained(this)),
+        callback);
+    return PP_OK_COMPLETIONPENDING;
+  }
+
+  // Otherwise each datagram is sent as its own SendTo message, as send slots
+  // become available. |buffer| may be reused once this returns, so each
+  // payload is copied once, into the string its message is built from.
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    send_batch_->datagrams.push(SendBatch::Datagram());
+    SendBatch::Datagram& datagram = send_batch_->datagrams.back();
+    datagram.data.assign(buffer + datagrams[i].offset, sizes[i]);
+    datagram.addr = batch_addrs[i];
+  }
+  ContinueSendBatch();
+  return PP_OK_COMPLETIONPENDING;
+}
+
 void UDPSocketResourceBase::CloseImpl() {
   if(closed_)
     return;
@@ -223,6 +316,10 @@ void UDPSocketResourceBase::CloseImpl() {
     sendto_callbacks_.pop();
     PostAbortIfNecessary(callback);
   }
+  if (send_batch_) {
+    PostAbortIfNecessary(send_batch_->callback);
+    send_batch_.reset();
+  }
   recv_filter_->RemoveUDPResource(pp_resource());
 }
 
@@ -256,6 +353,43 @@ int32_t UDPSocketResourceBase::LeaveGroupImpl(
   return PP_OK_COMPLETIONPENDING;
 }
 
+size_t UDPSocketResourceBase::SendSlotsInUse() const {
+  size_t slots = sendto_callbacks_.size();
+  if (send_batch_)
+    slots += send_batch_->num_sent - send_batch_->num_replied;
+  return slots;
+}
+
+void UDPSocketResourceBase::ContinueSendBatch() {
+  SendBatch* batch = send_batch_.get();
+  // Stop at the first failure; the result only counts datagrams up to it.
+  while (batch->error == PP_OK && !batch->datagrams.empty() &&
+         SendSlotsInUse() <
+             UDPSocketResourceConstants::kPluginSendBufferSlots) {
+    const SendBatch::Datagram& datagram = batch->datagrams.front();
+    Call<PpapiPluginMsg_UDPSocket_SendToReply>(
+        BROWSER,
+        PpapiHostMsg_UDPSocket_SendTo(datagram.data, datagram.addr),
+        base::Bind(&UDPSocketResourceBase::OnPluginMsgSendToReplyForBatch,
+                   base::Unretained(this)),
+        batch->callback);
+    batch->datagrams.pop();
+    ++batch->num_sent;
+  }
+}
+
+void UDPSocketResourceBase::OnReplyReceived(
+    const ResourceMessageReplyParams& params,
+    const IPC::Message& msg) {
+  PPAPI_BEGIN_MESSAGE_MAP(UDPSocketResourceBase, msg)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_0(
+        PpapiPluginMsg_UDPSocket_EnableSendToBatch,
+        OnPluginMsgEnableSendToBatch)
+    PPAPI_DISPATCH_PLUGIN_RESOURCE_CALL_UNHANDLED(
+        PluginResource::OnReplyReceived(params, msg))
+  PPAPI_END_MESSAGE_MAP()
+}
+
 void UDPSocketResourceBase::OnPluginMsgGeneralReply(
     scoped_refptr<TrackedCallback> callback,
     const ResourceMessageReplyParams& params) {
@@ -289,6 +423,11 @@ void UDPSocketResourceBase::OnPluginMsgSendToReply(
 
   scoped_refptr<TrackedCallback> callback = sendto_callbacks_.front();
   sendto_callbacks_.pop();
+
+  // The slot this freed may let a batch continue.
+  if (send_batch_)
+    ContinueSendBatch();
+
   if (!TrackedCallback::IsPending(callback))
     return;
 
@@ -298,6 +437,61 @@ void UDPSocketResourceBase::OnPluginMsgSendToReply(
     RunCallback(callback, params.result(), private_api_);
 }
 
+void UDPSocketResourceBase::OnPluginMsgEnableSendToBatch(
+    const ResourceMessageReplyParams& params) {
+  send_to_batch_enabled_ = true;
+}
+
+void UDPSocketResourceBase::OnPluginMsgSendToBatchReply(
+    const ResourceMessageReplyParams& params,
+    uint32_t datagrams_sent) {
+  // This can be empty if the socket was closed, but the reply was already on
+  // its way.
+  if (!send_batch_)
+    return;
+
+  scoped_refptr<TrackedCallback> callback = send_batch_->callback;
+  send_batch_.reset();
+  if (!TrackedCallback::IsPending(callback))
+    return;
+
+  if (datagrams_sent)
+    RunCallback(callback, static_cast<int32_t>(datagrams_sent), private_api_);
+  else
+    RunCallback(callback, params.result(), private_api_);
+}
+
+void UDPSocketResourceBase::OnPluginMsgSendToReplyForBatch(
+    const ResourceMessageReplyParams& params,
+    int32_t bytes_written) {
+  // This can be empty if the socket was closed, but there are still replies
+  // on their way.
+  if (!send_batch_)
+    return;
+
+  SendBatch* batch = send_batch_.get();
+  ++batch->num_replied;
+  if (batch->error == PP_OK) {
+    if (params.result() == PP_OK)
+      ++batch->num_succeeded;
+    else
+      batch->error = params.result();
+  }
+
+  ContinueSendBatch();
+  bool done = batch->error != PP_OK || batch->datagrams.empty();
+  if (!done || batch->num_replied < batch->num_sent)
+    return;
+
+  scoped_refptr<TrackedCallback> callback = batch->callback;
+  int32_t result = batch->num_succeeded
+                       ? static_cast<int32_t>(batch->num_succeeded)
+                       : batch->error;
+  send_batch_.reset();
+  if (TrackedCallback::IsPending(callback))
+    RunCallback(callback, result, private_api_);
+}
+
 // static
 void UDPSocketResourceBase::SlotBecameAvailable(PP_Resource resource) {
   ProxyLock::AssertAcquired();
@@ -8,10 +8,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "base/containers/queue.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
 #include "ppapi/c/ppb_udp_socket.h"
 #include "ppapi/c/private/ppb_net_address_private.h"
 #include "ppapi/proxy/plugin_resource.h"
@@ -43,11 +48,22 @@ class PPAPI_PROXY_EXPORT UDPSocketResourceBase : public PluginResource {
                        int32_t num_bytes,
                        PP_Resource* addr,
                        scoped_refptr<TrackedCallback> callback);
+  int32_t RecvFromBatchImpl(char* buffer,
+                            int32_t num_bytes,
+                            PP_UDPSocket_Datagram_Dev* datagrams,
+                            uint32_t max_datagrams,
+                            scoped_refptr<TrackedCallback> callback);
   PP_Bool GetRecvFromAddressImpl(PP_NetAddress_Private* addr);
   int32_t SendToImpl(const char* buffer,
                      int32_t num_bytes,
                      const PP_NetAddress_Private* addr,
                      scoped_refptr<TrackedCallback> callback);
+  // |addrs| holds the destination of each of |datagrams|.
+  int32_t SendToBatchImpl(const char* buffer,
+                          int32_t num_bytes,
+                          const PP_UDPSocket_Datagram_Dev* datagrams,
+                          const std::vector<PP_NetAddress_Private>& addrs,
+                          scoped_refptr<TrackedCallback> callback);
   void CloseImpl();
   int32_t JoinGroupImpl(const PP_NetAddress_Private *group,
                         scoped_refptr<TrackedCallback> callback);
@@ -55,6 +71,39 @@ class PPAPI_PROXY_EXPORT UDPSocketResourceBase : public PluginResource {
                          scoped_refptr<TrackedCallback> callback);
 
  private:
+  // A SendToBatchImpl call in progress. When the host takes whole batches,
+  // only |callback| is used. Otherwise the datagrams are sent one SendTo
+  // message at a time, as send slots become available.
+  struct SendBatch {
+    struct Datagram {
+      std::string data;
+      PP_NetAddress_Private addr;
+    };
+
+    SendBatch();
+    ~SendBatch();
+
+    scoped_refptr<TrackedCallback> callback;
+    // The datagrams that haven't been sent yet.
+    base::queue<Datagram> datagrams;
+    // Number of datagrams sent to the browser, and replied to, so far.
+    size_t num_sent;
+    size_t num_replied;
+    // Number of datagrams that succeeded before the first failure, and the
+    // result of that failure, if any.
+    size_t num_succeeded;
+    int32_t error;
+  };
+
+  // The number of SendTo messages that are awaiting a reply.
+  size_t SendSlotsInUse() const;
+  // Sends as much of |send_batch_| as the free send slots allow.
+  void ContinueSendBatch();
+
+  // PluginResource override.
+  void OnReplyReceived(const ResourceMessageReplyParams& params,
+                       const IPC::Message& msg) override;
+
   // IPC message handlers.
   void OnPluginMsgGeneralReply(scoped_refptr<TrackedCallback> callback,
                                const ResourceMessageReplyParams& params);
@@ -62,6 +111,11 @@ class PPAPI_PROXY_EXPORT UDPSocketResourceBase : public PluginResource {
                             const PP_NetAddress_Private& bound_addr);
   void OnPluginMsgSendToReply(const ResourceMessageReplyParams& params,
                               int32_t bytes_written);
+  void OnPluginMsgEnableSendToBatch(const ResourceMessageReplyParams& params);
+  void OnPluginMsgSendToBatchReply(const ResourceMessageReplyParams& params,
+                                   uint32_t datagrams_sent);
+  void OnPluginMsgSendToReplyForBatch(const ResourceMessageReplyParams& params,
+                                      int32_t bytes_written);
 
   static void SlotBecameAvailable(PP_Resource resource);
   static void SlotBecameAvailableWithLock(PP_Resource resource);
@@ -75,12 +129,16 @@ class PPAPI_PROXY_EXPORT UDPSocketResourceBase : public PluginResource {
   bool bound_;
   bool closed_;
 
+  // Set once the host says it takes PpapiHostMsg_UDPSocket_SendToBatch.
+  bool send_to_batch_enabled_;
+
   scoped_refptr<TrackedCallback> bind_callback_;
   scoped_refptr<UDPSocketFilter> recv_filter_;
 
   PP_NetAddress_Private bound_addr_;
 
   base::queue<scoped_refptr<TrackedCallback>> sendto_callbacks_;
+  std::unique_ptr<SendBatch> send_batch_;
 
   DISALLOW_COPY_AND_ASSIGN(UDPSocketResourceBase);
 };
@@ -39,6 +39,14 @@ class UDPSocketResourceConstants {
   // sending before we block the plugin.
   enum { kPluginSendBufferSlots = 8u };
 
+  // The maximum number of datagrams, and of payload bytes, that one
+  // SendToBatch call sends. Larger batches are cut short and the caller sends
+  // the rest with another call. The byte limit matches what the send slots
+  // can have in flight, and keeps PpapiHostMsg_UDPSocket_SendToBatch well
+  // under the IPC message size limit.
+  enum { kMaxSendBatchDatagrams = 64u };
+  enum { kMaxSendBatchSize = kPluginSendBufferSlots * kMaxWriteSize };
+
  private:
   DISALLOW_COPY_AND_ASSIGN(UDPSocketResourceConstants);
 };
@@ -4,8 +4,6 @@
 
 #include "ppapi/proxy/url_loader_resource.h"
 
-#include <algorithm>
-
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "ppapi/c/pp_completion_callback.h"
@@ -245,7 +243,7 @@ void URLLoaderResource::OnPluginMsgSendData(
   }
 
   mode_ = MODE_STREAMING_DATA;
-  buffer_.insert(buffer_.end(), data, data + data_length);
+  buffer_.Append(data, static_cast<size_t>(data_length));
 
   // To avoid letting the network stack download an entire stream all at once,
   // defer loading when we have enough buffer.
@@ -345,9 +343,7 @@ int32_t URLLoaderResource::FillUserBuffer() {
   DCHECK(user_buffer_);
   DCHECK(user_buffer_size_);
 
-  size_t bytes_to_copy = std::min(buffer_.size(), user_buffer_size_);
-  std::copy(buffer_.begin(), buffer_.begin() + bytes_to_copy, user_buffer_);
-  buffer_.erase(buffer_.begin(), buffer_.begin() + bytes_to_copy);
+  size_t bytes_to_copy = buffer_.Read(user_buffer_, user_buffer_size_);
 
   // If the buffer is getting too empty, resume asynchronous loading.
   if (is_asynchronous_load_suspended_ &&
@@ -9,9 +9,9 @@
 #include <stdint.h>
 
 #include "base/compiler_specific.h"
-#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "ppapi/c/trusted/ppb_url_loader_trusted.h"
+#include "ppapi/proxy/byte_chunk_queue.h"
 #include "ppapi/proxy/plugin_resource.h"
 #include "ppapi/proxy/ppapi_proxy_export.h"
 #include "ppapi/shared_impl/url_request_info_data.h"
@@ -126,7 +126,7 @@ class PPAPI_PROXY_EXPORT URLLoaderResource : public PluginResource,
 
   PP_URLLoaderTrusted_StatusCallback status_callback_;
 
-  base::circular_deque<char> buffer_;
+  ByteChunkQueue buffer_;
   int64_t bytes_sent_;
   int64_t total_bytes_to_be_sent_;
   int64_t bytes_received_;
@@ -10,9 +10,13 @@ namespace proxy {
 
 // These constants are shared by the video decoder resource and host.
 enum {
-  // Maximum number of concurrent decodes which can be pending.
+  // Maximum number of concurrent decodes which can be pending, unless the
+  // plugin sets another with PPB_VideoDecoderPipeline_Dev.
   kMaximumPendingDecodes = 8,
 
+  // Upper limit on the number of pending decodes a plugin can ask for.
+  kMaximumPendingDecodesLimit = 32,
+
   // Minimum size of shared-memory buffers (100 KB). Make them large since we
   // try to reuse them.
   kMinimumBitstreamBufferSize = 100 << 10,
@@ -21,6 +25,10 @@ enum {
   // for 4K video at reasonable compression levels.
   kMaximumBitstreamBufferSize = 4 << 20,
 
+  // Upper limit on the buffer size a plugin can ask for (16 MB), for high
+  // bitrate streams.
+  kMaximumBitstreamBufferSizeLimit = 16 << 20,
+
   // The maximum number of pictures that the client can pass in for
   // min_picture_count, just as a sanity check on the argument.
   // This should match the constant of the same name in test_video_decoder.cc.
@@ -4,6 +4,7 @@
 
 #include "ppapi/proxy/video_decoder_resource.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -35,7 +36,7 @@ VideoDecoderResource::ShmBuffer::ShmBuffer(
     std::unique_ptr<base::SharedMemory> shm_ptr,
     uint32_t size,
     uint32_t shm_id)
-    : shm(std::move(shm_ptr)), addr(NULL), shm_id(shm_id) {
+    : shm(std::move(shm_ptr)), addr(NULL), shm_id(shm_id), acquired(false) {
   if (shm->Map(size))
     addr = shm->memory();
 }
@@ -63,8 +64,19 @@ VideoDecoderResource::Picture::~Picture() {
 VideoDecoderResource::VideoDecoderResource(Connection connection,
                                            PP_Instance instance)
     : PluginResource(connection, instance),
+      num_acquired_shm_buffers_(0),
+      max_pending_decodes_(kMaximumPendingDecodes),
+      max_bitstream_buffer_size_(kMaximumBitstreamBufferSize),
+      preallocate_shm_buffers_(false),
+      decode_count_(0),
+      pending_decodes_sum_(0),
+      peak_pending_decodes_(0),
+      buffer_wait_count_(0),
       num_decodes_(0),
       min_picture_count_(0),
+      acquire_size_(0),
+      acquire_buffer_id_(NULL),
+      acquire_buffer_(NULL),
       get_picture_(NULL),
       get_picture_0_1_(NULL),
       gles2_impl_(NULL),
@@ -179,93 +191,27 @@ int32_t VideoDecoderResource::Decode(uint32_t decode_id,
     return decoder_last_error_;
   if (flush_callback_.get() || reset_callback_.get())
     return PP_ERROR_FAILED;
-  if (decode_callback_.get())
+  if (decode_callback_.get() || acquire_callback_.get())
     return PP_ERROR_INPROGRESS;
-  if (size > kMaximumBitstreamBufferSize)
+  if (size > max_bitstream_buffer_size_)
     return PP_ERROR_NOMEMORY;
 
-  // If we allow the plugin to call Decode again, we must have somewhere to
-  // copy their buffer.
-  DCHECK(!available_shm_buffers_.empty() ||
-         shm_buffers_.size() < kMaximumPendingDecodes);
-
-  // Count up, wrapping back to 0 before overflowing.
-  int32_t uid = ++num_decodes_;
-  if (uid == std::numeric_limits<int32_t>::max())
-    num_decodes_ = 0;
-
-  // Save decode_id in a ring buffer. The ring buffer is sized to store
-  // decode_id for the maximum picture delay.
-  decode_ids_[uid % kMaximumPictureDelay] = decode_id;
-
-  if (available_shm_buffers_.empty() ||
-      available_shm_buffers_.back()->shm->mapped_size() < size) {
-    uint32_t shm_id;
-    if (shm_buffers_.size() < kMaximumPendingDecodes) {
-      // Signal the host to create a new shm buffer by passing an index outside
-      // the legal range.
-      shm_id = static_cast<uint32_t>(shm_buffers_.size());
-    } else {
-      // Signal the host to grow a buffer by passing a legal index. Choose the
-      // last available shm buffer for simplicity.
-      shm_id = available_shm_buffers_.back()->shm_id;
-      available_shm_buffers_.pop_back();
-    }
-
-    // Synchronously get shared memory. Use GenericSyncCall so we can get the
-    // reply params, which contain the handle.
-    uint32_t shm_size = 0;
-    IPC::Message reply;
-    ResourceMessageReplyParams reply_params;
-    int32_t result =
-        GenericSyncCall(RENDERER,
-                        PpapiHostMsg_VideoDecoder_GetShm(shm_id, size),
-                        &reply,
-                        &reply_params);
-    if (result != PP_OK)
-      return PP_ERROR_FAILED;
-    if (!UnpackMessage<PpapiPluginMsg_VideoDecoder_GetShmReply>(reply,
-                                                                &shm_size))
-      return PP_ERROR_FAILED;
-    base::SharedMemoryHandle shm_handle;
-    if (!reply_params.TakeSharedMemoryHandleAtIndex(0, &shm_handle))
-      return PP_ERROR_NOMEMORY;
-    std::unique_ptr<base::SharedMemory> shm(
-        new base::SharedMemory(shm_handle, false /* read_only */));
-    std::unique_ptr<ShmBuffer> shm_buffer(
-        new ShmBuffer(std::move(shm), shm_size, shm_id));
-    if (!shm_buffer->addr)
-      return PP_ERROR_NOMEMORY;
-
-    available_shm_buffers_.push_back(shm_buffer.get());
-    if (shm_buffers_.size() < kMaximumPendingDecodes)
-      shm_buffers_.push_back(std::move(shm_buffer));
-    else
-      shm_buffers_[shm_id] = std::move(shm_buffer);
-  }
-
-  // At this point we should have shared memory to hold the plugin's buffer.
-  DCHECK(!available_shm_buffers_.empty() &&
-         available_shm_buffers_.back()->shm->mapped_size() >= size);
-
-  ShmBuffer* shm_buffer = available_shm_buffers_.back();
-  available_shm_buffers_.pop_back();
+  ShmBuffer* shm_buffer = NULL;
+  int32_t result = TakeShmBuffer(size, &shm_buffer);
+  if (result != PP_OK)
+    return result;
   memcpy(shm_buffer->addr, buffer, size);
-
-  Call<PpapiPluginMsg_VideoDecoder_DecodeReply>(
-      RENDERER,
-      PpapiHostMsg_VideoDecoder_Decode(shm_buffer->shm_id, size, uid),
-      base::Bind(&VideoDecoderResource::OnPluginMsgDecodeComplete, this));
+  SendDecode(shm_buffer, decode_id, size);
 
   // If we have another free buffer, or we can still create new buffers, let
   // the plugin call Decode again.
-  if (!available_shm_buffers_.empty() ||
-      shm_buffers_.size() < kMaximumPendingDecodes)
+  if (CanTakeShmBuffer())
     return PP_OK;
 
   // All buffers are busy and we can't create more. Delay completion until a
   // buffer is available.
   decode_callback_ = callback;
+  StartBufferWait();
   return PP_OK_COMPLETIONPENDING;
 }
 
@@ -332,11 +278,16 @@ int32_t VideoDecoderResource::Reset(scoped_refptr<TrackedCallback> callback) {
     return PP_ERROR_INPROGRESS;
   reset_callback_ = callback;
 
-  // Cause any pending Decode or GetPicture callbacks to abort after we return,
-  // to avoid reentering the plugin.
+  // Cause any pending Decode, AcquireBitstreamBuffer or GetPicture callbacks
+  // to abort after we return, to avoid reentering the plugin.
+  if (decode_callback_.get() || acquire_callback_.get())
+    EndBufferWait();
   if (TrackedCallback::IsPending(decode_callback_))
     decode_callback_->PostAbort();
   decode_callback_ = NULL;
+  if (TrackedCallback::IsPending(acquire_callback_))
+    acquire_callback_->PostAbort();
+  acquire_callback_ = NULL;
   if (TrackedCallback::IsPending(get_picture_callback_))
     get_picture_callback_->PostAbort();
   get_picture_callback_ = NULL;
@@ -348,6 +299,121 @@ int32_t VideoDecoderResource::Reset(scoped_refptr<TrackedCallback> callback) {
   return PP_OK_COMPLETIONPENDING;
 }
 
+int32_t VideoDecoderResource::SetPipelineOptions(
+    const PP_VideoDecoderPipelineOptions_Dev* options) {
+  if (initialized_ || initialize_callback_.get())
+    return PP_ERROR_FAILED;
+  if (!options)
+    return PP_ERROR_BADARGUMENT;
+  uint32_t max_pending_decodes = options->max_pending_decodes
+                                     ? options->max_pending_decodes
+                                     : kMaximumPendingDecodes;
+  uint32_t max_bitstream_buffer_size = options->bitstream_buffer_size
+                                           ? options->bitstream_buffer_size
+                                           : kMaximumBitstreamBufferSize;
+  if (max_pending_decodes > kMaximumPendingDecodesLimit ||
+      max_bitstream_buffer_size > kMaximumBitstreamBufferSizeLimit)
+    return PP_ERROR_BADARGUMENT;
+
+  // The host checks shm ids and sizes against the same limits, so it has to
+  // agree to them before we rely on them.
+  int32_t result =
+      SyncCall<PpapiPluginMsg_VideoDecoder_SetPipelineOptionsReply>(
+          RENDERER, PpapiHostMsg_VideoDecoder_SetPipelineOptions(
+                        max_pending_decodes, max_bitstream_buffer_size));
+  if (result != PP_OK)
+    return PP_ERROR_NOTSUPPORTED;
+
+  max_pending_decodes_ = max_pending_decodes;
+  max_bitstream_buffer_size_ = max_bitstream_buffer_size;
+  preallocate_shm_buffers_ = PP_ToBool(options->preallocate_buffers);
+  return PP_OK;
+}
+
+int32_t VideoDecoderResource::GetPipelineStats(
+    PP_VideoDecoderPipelineStats_Dev* stats) {
+  if (!stats)
+    return PP_ERROR_BADARGUMENT;
+  base::TimeDelta buffer_wait_time = buffer_wait_time_;
+  if (decode_callback_.get() || acquire_callback_.get())
+    buffer_wait_time += base::TimeTicks::Now() - buffer_wait_start_;
+  stats->buffer_wait_time = buffer_wait_time.InSecondsF();
+  stats->average_pending_decodes =
+      decode_count_ ? static_cast<double>(pending_decodes_sum_) / decode_count_
+                    : 0.0;
+  stats->decode_count = decode_count_;
+  stats->pending_decodes = GetPendingDecodes();
+  stats->peak_pending_decodes = peak_pending_decodes_;
+  stats->buffer_wait_count = buffer_wait_count_;
+  stats->shm_buffer_count = static_cast<uint32_t>(shm_buffers_.size());
+  stats->shm_buffer_size = 0;
+  for (const auto& shm_buffer : shm_buffers_) {
+    stats->shm_buffer_size +=
+        static_cast<uint32_t>(shm_buffer->shm->mapped_size());
+  }
+  return PP_OK;
+}
+
+int32_t VideoDecoderResource::AcquireBitstreamBuffer(
+    uint32_t size,
+    uint32_t* buffer_id,
+    void** buffer,
+    scoped_refptr<TrackedCallback> callback) {
+  if (decoder_last_error_)
+    return decoder_last_error_;
+  if (flush_callback_.get() || reset_callback_.get())
+    return PP_ERROR_FAILED;
+  if (decode_callback_.get() || acquire_callback_.get())
+    return PP_ERROR_INPROGRESS;
+  if (!buffer_id || !buffer)
+    return PP_ERROR_BADARGUMENT;
+  if (size > max_bitstream_buffer_size_)
+    return PP_ERROR_NOMEMORY;
+
+  if (CanTakeShmBuffer())
+    return AcquireShmBuffer(size, buffer_id, buffer);
+
+  // All buffers are busy. Complete when one is returned, as for Decode.
+  acquire_callback_ = callback;
+  acquire_size_ = size;
+  acquire_buffer_id_ = buffer_id;
+  acquire_buffer_ = buffer;
+  StartBufferWait();
+  return PP_OK_COMPLETIONPENDING;
+}
+
+int32_t VideoDecoderResource::SubmitBitstreamBuffer(uint32_t buffer_id,
+                                                    uint32_t decode_id,
+                                                    uint32_t size) {
+  if (decoder_last_error_)
+    return decoder_last_error_;
+  if (flush_callback_.get() || reset_callback_.get())
+    return PP_ERROR_FAILED;
+  if (buffer_id >= shm_buffers_.size() || !shm_buffers_[buffer_id]->acquired)
+    return PP_ERROR_BADARGUMENT;
+  ShmBuffer* shm_buffer = shm_buffers_[buffer_id].get();
+  if (size > shm_buffer->shm->mapped_size())
+    return PP_ERROR_BADARGUMENT;
+
+  shm_buffer->acquired = false;
+  num_acquired_shm_buffers_--;
+  SendDecode(shm_buffer, decode_id, size);
+  return PP_OK;
+}
+
+int32_t VideoDecoderResource::ReleaseBitstreamBuffer(uint32_t buffer_id) {
+  if (buffer_id >= shm_buffers_.size() || !shm_buffers_[buffer_id]->acquired)
+    return PP_ERROR_BADARGUMENT;
+  ShmBuffer* shm_buffer = shm_buffers_[buffer_id].get();
+  shm_buffer->acquired = false;
+  num_acquired_shm_buffers_--;
+  available_shm_buffers_.push_back(shm_buffer);
+  // The plugin is calling us, so any callback waiting for this buffer has to
+  // run later.
+  OnShmBufferAvailable(true /* post_callback */);
+  return PP_OK;
+}
+
 void VideoDecoderResource::OnReplyReceived(
     const ResourceMessageReplyParams& params,
     const IPC::Message& msg) {
@@ -451,10 +517,13 @@ void VideoDecoderResource::OnPluginMsgNotifyError(
     const ResourceMessageReplyParams& params,
     int32_t error) {
   decoder_last_error_ = error;
+  if (decode_callback_.get() || acquire_callback_.get())
+    EndBufferWait();
   // Cause any pending callbacks to run immediately. Reentrancy isn't a problem,
   // since the plugin wasn't calling us.
   RunCallbackWithError(&initialize_callback_);
   RunCallbackWithError(&decode_callback_);
+  RunCallbackWithError(&acquire_callback_);
   RunCallbackWithError(&get_picture_callback_);
   RunCallbackWithError(&flush_callback_);
   RunCallbackWithError(&reset_callback_);
@@ -463,8 +532,18 @@ void VideoDecoderResource::OnPluginMsgNotifyError(
 void VideoDecoderResource::OnPluginMsgInitializeComplete(
     const ResourceMessageReplyParams& params) {
   decoder_last_error_ = params.result();
-  if (decoder_last_error_ == PP_OK)
+  if (decoder_last_error_ == PP_OK) {
     initialized_ = true;
+    // Fill the pool before the plugin starts decoding. If the host runs out
+    // of memory, the rest of the buffers are allocated on demand as usual.
+    if (preallocate_shm_buffers_) {
+      while (shm_buffers_.size() < max_pending_decodes_) {
+        if (GetShmBuffer(static_cast<uint32_t>(shm_buffers_.size()),
+                         max_bitstream_buffer_size_) != PP_OK)
+          break;
+      }
+    }
+  }
 
   // Let the plugin call Initialize again from its callback in case of failure.
   scoped_refptr<TrackedCallback> callback;
@@ -481,18 +560,15 @@ void VideoDecoderResource::OnPluginMsgDecodeComplete(
   }
   // Make the shm buffer available.
   available_shm_buffers_.push_back(shm_buffers_[shm_id].get());
-  // If the plugin is waiting, let it call Decode again.
-  if (decode_callback_.get()) {
-    scoped_refptr<TrackedCallback> callback;
-    callback.swap(decode_callback_);
-    callback->Run(PP_OK);
-  }
+  OnShmBufferAvailable(false /* post_callback */);
 }
 
 void VideoDecoderResource::OnPluginMsgFlushComplete(
     const ResourceMessageReplyParams& params) {
-  // All shm buffers should have been made available by now.
-  DCHECK_EQ(shm_buffers_.size(), available_shm_buffers_.size());
+  // All shm buffers should have been made available by now, apart from those
+  // the plugin has acquired.
+  DCHECK_EQ(shm_buffers_.size(),
+            available_shm_buffers_.size() + num_acquired_shm_buffers_);
 
   if (get_picture_callback_.get()) {
     scoped_refptr<TrackedCallback> callback;
@@ -507,8 +583,10 @@ void VideoDecoderResource::OnPluginMsgFlushComplete(
 
 void VideoDecoderResource::OnPluginMsgResetComplete(
     const ResourceMessageReplyParams& params) {
-  // All shm buffers should have been made available by now.
-  DCHECK_EQ(shm_buffers_.size(), available_shm_buffers_.size());
+  // All shm buffers should have been made available by now, apart from those
+  // the plugin has acquired.
+  DCHECK_EQ(shm_buffers_.size(),
+            available_shm_buffers_.size() + num_acquired_shm_buffers_);
   // Recycle any pictures which haven't been passed to the plugin.
   while (!received_pictures_.empty()) {
     Post(RENDERER, PpapiHostMsg_VideoDecoder_RecyclePicture(
@@ -521,6 +599,152 @@ void VideoDecoderResource::OnPluginMsgResetComplete(
   callback->Run(params.result());
 }
 
+int32_t VideoDecoderResource::GetShmBuffer(uint32_t shm_id, uint32_t size) {
+  // Synchronously get shared memory. Use GenericSyncCall so we can get the
+  // reply params, which contain the handle.
+  uint32_t shm_size = 0;
+  IPC::Message reply;
+  ResourceMessageReplyParams reply_params;
+  int32_t result =
+      GenericSyncCall(RENDERER,
+                      PpapiHostMsg_VideoDecoder_GetShm(shm_id, size),
+                      &reply,
+                      &reply_params);
+  if (result != PP_OK)
+    return PP_ERROR_FAILED;
+  if (!UnpackMessage<PpapiPluginMsg_VideoDecoder_GetShmReply>(reply,
+                                                              &shm_size))
+    return PP_ERROR_FAILED;
+  base::SharedMemoryHandle shm_handle;
+  if (!reply_params.TakeSharedMemoryHandleAtIndex(0, &shm_handle))
+    return PP_ERROR_NOMEMORY;
+  std::unique_ptr<base::SharedMemory> shm(
+      new base::SharedMemory(shm_handle, false /* read_only */));
+  std::unique_ptr<ShmBuffer> shm_buffer(
+      new ShmBuffer(std::move(shm), shm_size, shm_id));
+  if (!shm_buffer->addr)
+    return PP_ERROR_NOMEMORY;
+
+  available_shm_buffers_.push_back(shm_buffer.get());
+  if (shm_id == shm_buffers_.size())
+    shm_buffers_.push_back(std::move(shm_buffer));
+  else
+    shm_buffers_[shm_id] = std::move(shm_buffer);
+  return PP_OK;
+}
+
+bool VideoDecoderResource::CanTakeShmBuffer() const {
+  return !available_shm_buffers_.empty() ||
+         shm_buffers_.size() < max_pending_decodes_;
+}
+
+int32_t VideoDecoderResource::TakeShmBuffer(uint32_t size,
+                                            ShmBuffer** shm_buffer) {
+  // Decode and AcquireBitstreamBuffer don't complete until another buffer can
+  // be taken, but the plugin may have acquired it since.
+  if (!CanTakeShmBuffer())
+    return PP_ERROR_NOMEMORY;
+
+  if (available_shm_buffers_.empty() ||
+      available_shm_buffers_.back()->shm->mapped_size() < size) {
+    uint32_t shm_id;
+    if (shm_buffers_.size() < max_pending_decodes_) {
+      // Signal the host to create a new shm buffer by passing an index outside
+      // the legal range.
+      shm_id = static_cast<uint32_t>(shm_buffers_.size());
+    } else {
+      // Signal the host to grow a buffer by passing a legal index. Choose the
+      // last available shm buffer for simplicity.
+      shm_id = available_shm_buffers_.back()->shm_id;
+      available_shm_buffers_.pop_back();
+    }
+    int32_t result = GetShmBuffer(shm_id, size);
+    if (result != PP_OK)
+      return result;
+  }
+
+  // At this point we should have shared memory to hold the plugin's buffer.
+  DCHECK(!available_shm_buffers_.empty() &&
+         available_shm_buffers_.back()->shm->mapped_size() >= size);
+
+  *shm_buffer = available_shm_buffers_.back();
+  available_shm_buffers_.pop_back();
+  return PP_OK;
+}
+
+int32_t VideoDecoderResource::AcquireShmBuffer(uint32_t size,
+                                               uint32_t* buffer_id,
+                                               void** buffer) {
+  ShmBuffer* shm_buffer = NULL;
+  int32_t result = TakeShmBuffer(size, &shm_buffer);
+  if (result != PP_OK)
+    return result;
+  shm_buffer->acquired = true;
+  num_acquired_shm_buffers_++;
+  *buffer_id = shm_buffer->shm_id;
+  *buffer = shm_buffer->addr;
+  return PP_OK;
+}
+
+void VideoDecoderResource::SendDecode(ShmBuffer* shm_buffer,
+                                      uint32_t decode_id,
+                                      uint32_t size) {
+  // Count up, wrapping back to 0 before overflowing.
+  int32_t uid = ++num_decodes_;
+  if (uid == std::numeric_limits<int32_t>::max())
+    num_decodes_ = 0;
+
+  // Save decode_id in a ring buffer. The ring buffer is sized to store
+  // decode_id for the maximum picture delay.
+  decode_ids_[uid % kMaximumPictureDelay] = decode_id;
+
+  Call<PpapiPluginMsg_VideoDecoder_DecodeReply>(
+      RENDERER,
+      PpapiHostMsg_VideoDecoder_Decode(shm_buffer->shm_id, size, uid),
+      base::Bind(&VideoDecoderResource::OnPluginMsgDecodeComplete, this));
+
+  uint32_t pending_decodes = GetPendingDecodes();
+  decode_count_++;
+  pending_decodes_sum_ += pending_decodes;
+  peak_pending_decodes_ = std::max(peak_pending_decodes_, pending_decodes);
+}
+
+uint32_t VideoDecoderResource::GetPendingDecodes() const {
+  return static_cast<uint32_t>(shm_buffers_.size() -
+                               available_shm_buffers_.size() -
+                               num_acquired_shm_buffers_);
+}
+
+void VideoDecoderResource::OnShmBufferAvailable(bool post_callback) {
+  // If the plugin is waiting, let it call Decode again, or give it the
+  // buffer it asked for.
+  scoped_refptr<TrackedCallback> callback;
+  int32_t result = PP_OK;
+  if (decode_callback_.get()) {
+    callback.swap(decode_callback_);
+  } else if (acquire_callback_.get()) {
+    callback.swap(acquire_callback_);
+    result =
+        AcquireShmBuffer(acquire_size_, acquire_buffer_id_, acquire_buffer_);
+  } else {
+    return;
+  }
+  EndBufferWait();
+  if (post_callback)
+    callback->PostRun(result);
+  else
+    callback->Run(result);
+}
+
+void VideoDecoderResource::StartBufferWait() {
+  buffer_wait_count_++;
+  buffer_wait_start_ = base::TimeTicks::Now();
+}
+
+void VideoDecoderResource::EndBufferWait() {
+  buffer_wait_time_ += base::TimeTicks::Now() - buffer_wait_start_;
+}
+
 void VideoDecoderResource::RunCallbackWithError(
     scoped_refptr<TrackedCallback>* callback) {
   SafeRunCallback(callback, decoder_last_error_);
@@ -14,6 +14,7 @@
 #include "base/containers/queue.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "ppapi/proxy/connection.h"
 #include "ppapi/proxy/plugin_resource.h"
 #include "ppapi/proxy/ppapi_proxy_export.h"
@@ -71,6 +72,18 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
   void RecyclePicture(const PP_VideoPicture* picture) override;
   int32_t Flush(scoped_refptr<TrackedCallback> callback) override;
   int32_t Reset(scoped_refptr<TrackedCallback> callback) override;
+  int32_t SetPipelineOptions(
+      const PP_VideoDecoderPipelineOptions_Dev* options) override;
+  int32_t GetPipelineStats(PP_VideoDecoderPipelineStats_Dev* stats) override;
+  int32_t AcquireBitstreamBuffer(
+      uint32_t size,
+      uint32_t* buffer_id,
+      void** buffer,
+      scoped_refptr<TrackedCallback> callback) override;
+  int32_t SubmitBitstreamBuffer(uint32_t buffer_id,
+                                uint32_t decode_id,
+                                uint32_t size) override;
+  int32_t ReleaseBitstreamBuffer(uint32_t buffer_id) override;
 
   // PluginResource implementation.
   void OnReplyReceived(const ResourceMessageReplyParams& params,
@@ -93,6 +106,8 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
     // Index into shm_buffers_ vector, used as an id. This should map 1:1 to
     // the index on the host side of the proxy.
     const uint32_t shm_id;
+    // True while the plugin holds the buffer after AcquireBitstreamBuffer.
+    bool acquired;
   };
 
   // Struct to hold texture information.
@@ -137,6 +152,28 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
   void OnPluginMsgFlushComplete(const ResourceMessageReplyParams& params);
   void OnPluginMsgResetComplete(const ResourceMessageReplyParams& params);
 
+  // Gets a shm buffer of at least |size| bytes from the host and makes it
+  // available. |shm_id| is either a new id, shm_buffers_.size(), to create a
+  // buffer, or the id of a buffer to replace with a larger one.
+  int32_t GetShmBuffer(uint32_t shm_id, uint32_t size);
+  // Returns true if a buffer is available, or another can be created.
+  bool CanTakeShmBuffer() const;
+  // Removes a buffer of at least |size| bytes from the available list,
+  // creating or growing one if needed.
+  int32_t TakeShmBuffer(uint32_t size, ShmBuffer** shm_buffer);
+  // Takes a buffer and hands it to the plugin.
+  int32_t AcquireShmBuffer(uint32_t size, uint32_t* buffer_id, void** buffer);
+  // Sends |size| bytes of |shm_buffer| to the host to be decoded.
+  void SendDecode(ShmBuffer* shm_buffer, uint32_t decode_id, uint32_t size);
+  // Returns the number of buffers the host has yet to return.
+  uint32_t GetPendingDecodes() const;
+  // Completes a pending Decode or AcquireBitstreamBuffer call, now that a
+  // buffer has been made available.
+  void OnShmBufferAvailable(bool post_callback);
+  // Account for the time the plugin waits for a buffer.
+  void StartBufferWait();
+  void EndBufferWait();
+
   void RunCallbackWithError(scoped_refptr<TrackedCallback>* callback);
   void DeleteGLTexture(uint32_t texture_id);
   void WriteNextPicture();
@@ -147,6 +184,23 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
   // List of available shared memory buffers.
   using ShmBufferList = std::vector<ShmBuffer*>;
   ShmBufferList available_shm_buffers_;
+  // Number of buffers held by the plugin between AcquireBitstreamBuffer and
+  // SubmitBitstreamBuffer or ReleaseBitstreamBuffer.
+  uint32_t num_acquired_shm_buffers_;
+
+  // Pipeline options. These default to kMaximumPendingDecodes and
+  // kMaximumBitstreamBufferSize, and can only be changed before Initialize.
+  uint32_t max_pending_decodes_;
+  uint32_t max_bitstream_buffer_size_;
+  bool preallocate_shm_buffers_;
+
+  // Pipeline statistics.
+  uint32_t decode_count_;
+  uint64_t pending_decodes_sum_;
+  uint32_t peak_pending_decodes_;
+  uint32_t buffer_wait_count_;
+  base::TimeTicks buffer_wait_start_;
+  base::TimeDelta buffer_wait_time_;
 
   // Map of GL texture id to texture info.
   using TextureMap = base::hash_map<uint32_t, Texture>;
@@ -159,6 +213,7 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
   // Pending callbacks.
   scoped_refptr<TrackedCallback> initialize_callback_;
   scoped_refptr<TrackedCallback> decode_callback_;
+  scoped_refptr<TrackedCallback> acquire_callback_;
   scoped_refptr<TrackedCallback> get_picture_callback_;
   scoped_refptr<TrackedCallback> flush_callback_;
   scoped_refptr<TrackedCallback> reset_callback_;
@@ -176,6 +231,11 @@ class PPAPI_PROXY_EXPORT VideoDecoderResource
 
   uint32_t min_picture_count_;
 
+  // State for pending acquire_callback_.
+  uint32_t acquire_size_;
+  uint32_t* acquire_buffer_id_;
+  void** acquire_buffer_;
+
   // State for pending get_picture_callback_.
   PP_VideoPicture* get_picture_;
   PP_VideoPicture_0_1* get_picture_0_1_;
@@ -4,6 +4,8 @@
 
 #include "ppapi/proxy/video_encoder_resource.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -53,7 +55,7 @@ std::vector<PP_VideoProfileDescription_0_1> PP_VideoProfileDescriptionTo_0_1(
 VideoEncoderResource::ShmBuffer::ShmBuffer(
     uint32_t id,
     std::unique_ptr<base::SharedMemory> shm)
-    : id(id), shm(std::move(shm)) {}
+    : id(id), shm(std::move(shm)), held(false) {}
 
 VideoEncoderResource::ShmBuffer::~ShmBuffer() {
 }
@@ -67,6 +69,12 @@ VideoEncoderResource::BitstreamBuffer::BitstreamBuffer(uint32_t id,
 VideoEncoderResource::BitstreamBuffer::~BitstreamBuffer() {
 }
 
+VideoEncoderResource::PendingEncode::PendingEncode() {
+}
+
+VideoEncoderResource::PendingEncode::~PendingEncode() {
+}
+
 VideoEncoderResource::VideoEncoderResource(Connection connection,
                                            PP_Instance instance)
     : PluginResource(connection, instance),
@@ -80,8 +88,14 @@ VideoEncoderResource::VideoEncoderResource(Connection connection,
       input_frame_count_(0),
       input_coded_size_(PP_MakeSize(0, 0)),
       buffer_manager_(this),
+      num_held_bitstream_buffers_(0),
       get_video_frame_data_(nullptr),
-      get_bitstream_buffer_data_(nullptr) {
+      num_pending_encodes_(0),
+      get_bitstream_buffer_data_(nullptr),
+      get_bitstream_buffers_data_(nullptr),
+      get_bitstream_buffers_max_(0),
+      encode_count_(0),
+      peak_pending_encodes_(0) {
   SendCreate(RENDERER, PpapiHostMsg_VideoEncoder_Create());
 }
 
@@ -193,15 +207,21 @@ int32_t VideoEncoderResource::Encode(
     return PP_ERROR_BADRESOURCE;
 
   scoped_refptr<VideoFrameResource> frame_resource = it->second;
+  uint32_t frame_index = frame_resource->GetBufferIndex();
+  DCHECK_LT(frame_index, pending_encodes_.size());
 
-  encode_callbacks_.insert(std::make_pair(video_frame, callback));
+  PendingEncode& encode = pending_encodes_[frame_index];
+  DCHECK(!encode.callback);
+  encode.callback = callback;
+  encode.start_time = base::TimeTicks::Now();
+  num_pending_encodes_++;
+  peak_pending_encodes_ = std::max(peak_pending_encodes_, num_pending_encodes_);
 
   Call<PpapiPluginMsg_VideoEncoder_EncodeReply>(
       RENDERER,
-      PpapiHostMsg_VideoEncoder_Encode(frame_resource->GetBufferIndex(),
-                                       PP_ToBool(force_keyframe)),
+      PpapiHostMsg_VideoEncoder_Encode(frame_index, PP_ToBool(force_keyframe)),
       base::Bind(&VideoEncoderResource::OnPluginMsgEncodeReply, this,
-                 video_frame));
+                 frame_index));
 
   // Invalidate the frame to prevent the plugin from modifying it.
   it->second->Invalidate();
@@ -215,17 +235,12 @@ int32_t VideoEncoderResource::GetBitstreamBuffer(
     const scoped_refptr<TrackedCallback>& callback) {
   if (encoder_last_error_)
     return encoder_last_error_;
-  if (TrackedCallback::IsPending(get_bitstream_buffer_callback_))
+  if (HasPendingGetBitstreamBuffer())
     return PP_ERROR_INPROGRESS;
 
   get_bitstream_buffer_callback_ = callback;
   get_bitstream_buffer_data_ = bitstream_buffer;
-
-  if (!available_bitstream_buffers_.empty()) {
-    BitstreamBuffer buffer(available_bitstream_buffers_.front());
-    available_bitstream_buffers_.pop_front();
-    WriteBitstreamBuffer(buffer);
-  }
+  TryWriteBitstreamBuffers();
 
   return PP_OK_COMPLETIONPENDING;
 }
@@ -236,10 +251,17 @@ void VideoEncoderResource::RecycleBitstreamBuffer(
     return;
   BitstreamBufferMap::const_iterator iter =
       bitstream_buffer_map_.find(bitstream_buffer->buffer);
-  if (iter != bitstream_buffer_map_.end()) {
-    Post(RENDERER,
-         PpapiHostMsg_VideoEncoder_RecycleBitstreamBuffer(iter->second));
-  }
+  if (iter == bitstream_buffer_map_.end())
+    return;
+  // Ignore buffers that are recycled twice, rather than handing the encoder a
+  // buffer it is already using.
+  ShmBuffer* shm_buffer = shm_buffers_[iter->second].get();
+  if (!shm_buffer->held)
+    return;
+  shm_buffer->held = false;
+  num_held_bitstream_buffers_--;
+  Post(RENDERER,
+       PpapiHostMsg_VideoEncoder_RecycleBitstreamBuffer(iter->second));
 }
 
 void VideoEncoderResource::RequestEncodingParametersChange(uint32_t bitrate,
@@ -260,6 +282,45 @@ void VideoEncoderResource::Close() {
   ReleaseFrames();
 }
 
+int32_t VideoEncoderResource::GetBitstreamBuffers(
+    PP_BitstreamBuffer buffers[],
+    uint32_t max_buffers,
+    const scoped_refptr<TrackedCallback>& callback) {
+  if (encoder_last_error_)
+    return encoder_last_error_;
+  if (!buffers || max_buffers == 0 ||
+      max_buffers > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()))
+    return PP_ERROR_BADARGUMENT;
+  if (HasPendingGetBitstreamBuffer())
+    return PP_ERROR_INPROGRESS;
+
+  uint32_t count = WriteBitstreamBuffers(buffers, max_buffers);
+  if (count > 0)
+    return static_cast<int32_t>(count);
+
+  get_bitstream_buffers_callback_ = callback;
+  get_bitstream_buffers_data_ = buffers;
+  get_bitstream_buffers_max_ = max_buffers;
+  return PP_OK_COMPLETIONPENDING;
+}
+
+int32_t VideoEncoderResource::GetStats(PP_VideoEncoderStats_Dev* stats) {
+  if (!stats)
+    return PP_ERROR_BADARGUMENT;
+  stats->total_encode_time = total_encode_time_.InSecondsF();
+  stats->max_encode_time = max_encode_time_.InSecondsF();
+  stats->last_encode_time = last_encode_time_.InSecondsF();
+  stats->encode_count = encode_count_;
+  stats->pending_encodes = num_pending_encodes_;
+  stats->peak_pending_encodes = peak_pending_encodes_;
+  stats->ready_bitstream_buffers =
+      base::checked_cast<uint32_t>(available_bitstream_buffers_.size());
+  stats->held_bitstream_buffers = num_held_bitstream_buffers_;
+  stats->bitstream_buffer_count =
+      base::checked_cast<uint32_t>(shm_buffers_.size());
+  return PP_OK;
+}
+
 void VideoEncoderResource::OnReplyReceived(
     const ResourceMessageReplyParams& params,
     const IPC::Message& msg) {
@@ -346,28 +407,35 @@ void VideoEncoderResource::OnPluginMsgGetVideoFramesReply(
     NotifyError(PP_ERROR_FAILED);
     return;
   }
+  pending_encodes_.resize(frame_count);
 
   if (TrackedCallback::IsPending(get_video_frame_callback_))
     TryWriteVideoFrame();
 }
 
 void VideoEncoderResource::OnPluginMsgEncodeReply(
-    PP_Resource video_frame,
+    uint32_t frame_index,
     const ResourceMessageReplyParams& params,
     uint32_t frame_id) {
-  // We need to ensure there are still callbacks to be called before
+  // We need to ensure the encode still has a callback to be called before
   // processing this message. We might receive a EncodeReply message
   // after having sent a Close message to the renderer. In this case,
-  // we don't have any callback left to call.
-  if (encode_callbacks_.empty())
+  // the callback has already been aborted.
+  if (frame_index >= pending_encodes_.size() ||
+      !pending_encodes_[frame_index].callback)
     return;
+  DCHECK_EQ(frame_index, frame_id);
   encoder_last_error_ = params.result();
 
-  EncodeMap::iterator it = encode_callbacks_.find(video_frame);
-  DCHECK(encode_callbacks_.end() != it);
+  PendingEncode& encode = pending_encodes_[frame_index];
+  last_encode_time_ = base::TimeTicks::Now() - encode.start_time;
+  total_encode_time_ += last_encode_time_;
+  max_encode_time_ = std::max(max_encode_time_, last_encode_time_);
+  encode_count_++;
+  num_pending_encodes_--;
 
-  scoped_refptr<TrackedCallback> callback = it->second;
-  encode_callbacks_.erase(it);
+  scoped_refptr<TrackedCallback> callback;
+  callback.swap(encode.callback);
   SafeRunCallback(&callback, encoder_last_error_);
 
   buffer_manager_.EnqueueBuffer(frame_id);
@@ -406,12 +474,7 @@ void VideoEncoderResource::OnPluginMsgBitstreamBufferReady(
     bool key_frame) {
   available_bitstream_buffers_.push_back(
       BitstreamBuffer(buffer_id, buffer_size, key_frame));
-
-  if (TrackedCallback::IsPending(get_bitstream_buffer_callback_)) {
-    BitstreamBuffer buffer(available_bitstream_buffers_.front());
-    available_bitstream_buffers_.pop_front();
-    WriteBitstreamBuffer(buffer);
-  }
+  TryWriteBitstreamBuffers();
 }
 
 void VideoEncoderResource::OnPluginMsgNotifyError(
@@ -428,12 +491,14 @@ void VideoEncoderResource::NotifyError(int32_t error) {
   get_video_frame_data_ = nullptr;
   SafeRunCallback(&get_bitstream_buffer_callback_, error);
   get_bitstream_buffer_data_ = nullptr;
-  for (EncodeMap::iterator it = encode_callbacks_.begin();
-       it != encode_callbacks_.end(); ++it) {
-    scoped_refptr<TrackedCallback> callback = it->second;
+  SafeRunCallback(&get_bitstream_buffers_callback_, error);
+  get_bitstream_buffers_data_ = nullptr;
+  for (PendingEncode& encode : pending_encodes_) {
+    scoped_refptr<TrackedCallback> callback;
+    callback.swap(encode.callback);
     SafeRunCallback(&callback, error);
   }
-  encode_callbacks_.clear();
+  num_pending_encodes_ = 0;
 }
 
 void VideoEncoderResource::TryWriteVideoFrame() {
@@ -453,14 +518,47 @@ void VideoEncoderResource::TryWriteVideoFrame() {
   SafeRunCallback(&get_video_frame_callback_, PP_OK);
 }
 
-void VideoEncoderResource::WriteBitstreamBuffer(const BitstreamBuffer& buffer) {
-  DCHECK_LT(buffer.id, shm_buffers_.size());
+bool VideoEncoderResource::HasPendingGetBitstreamBuffer() const {
+  return TrackedCallback::IsPending(get_bitstream_buffer_callback_) ||
+         TrackedCallback::IsPending(get_bitstream_buffers_callback_);
+}
+
+void VideoEncoderResource::TryWriteBitstreamBuffers() {
+  if (available_bitstream_buffers_.empty())
+    return;
 
-  get_bitstream_buffer_data_->size = buffer.size;
-  get_bitstream_buffer_data_->buffer = shm_buffers_[buffer.id]->shm->memory();
-  get_bitstream_buffer_data_->key_frame = PP_FromBool(buffer.key_frame);
-  get_bitstream_buffer_data_ = nullptr;
-  SafeRunCallback(&get_bitstream_buffer_callback_, PP_OK);
+  if (TrackedCallback::IsPending(get_bitstream_buffer_callback_)) {
+    WriteBitstreamBuffers(get_bitstream_buffer_data_, 1);
+    get_bitstream_buffer_data_ = nullptr;
+    SafeRunCallback(&get_bitstream_buffer_callback_, PP_OK);
+  } else if (TrackedCallback::IsPending(get_bitstream_buffers_callback_)) {
+    uint32_t count = WriteBitstreamBuffers(get_bitstream_buffers_data_,
+                                           get_bitstream_buffers_max_);
+    get_bitstream_buffers_data_ = nullptr;
+    SafeRunCallback(&get_bitstream_buffers_callback_,
+                    static_cast<int32_t>(count));
+  }
+}
+
+uint32_t VideoEncoderResource::WriteBitstreamBuffers(
+    PP_BitstreamBuffer buffers[],
+    uint32_t max_buffers) {
+  uint32_t count = 0;
+  while (count < max_buffers && !available_bitstream_buffers_.empty()) {
+    const BitstreamBuffer& buffer = available_bitstream_buffers_.front();
+    DCHECK_LT(buffer.id, shm_buffers_.size());
+    ShmBuffer* shm_buffer = shm_buffers_[buffer.id].get();
+    DCHECK(!shm_buffer->held);
+    shm_buffer->held = true;
+    num_held_bitstream_buffers_++;
+
+    PP_BitstreamBuffer* output = &buffers[count++];
+    output->size = buffer.size;
+    output->buffer = shm_buffer->shm->memory();
+    output->key_frame = PP_FromBool(buffer.key_frame);
+    available_bitstream_buffers_.pop_front();
+  }
+  return count;
 }
 
 void VideoEncoderResource::ReleaseFrames() {
@@ -11,8 +11,10 @@
 #include <vector>
 
 #include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "ppapi/proxy/connection.h"
 #include "ppapi/proxy/plugin_resource.h"
 #include "ppapi/shared_impl/media_stream_buffer_manager.h"
@@ -50,6 +52,9 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
     // the plugin and the host.
     uint32_t id;
     std::unique_ptr<base::SharedMemory> shm;
+    // True while the plugin holds the buffer, from the time it is returned by
+    // GetBitstreamBuffer(s) until it is recycled.
+    bool held;
   };
 
   struct BitstreamBuffer {
@@ -62,6 +67,14 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
     bool key_frame;
   };
 
+  struct PendingEncode {
+    PendingEncode();
+    ~PendingEncode();
+
+    scoped_refptr<TrackedCallback> callback;
+    base::TimeTicks start_time;
+  };
+
   // PPB_VideoEncoder_API implementation.
   int32_t GetSupportedProfiles(
       const PP_ArrayOutput& output,
@@ -90,6 +103,11 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
   void RequestEncodingParametersChange(uint32_t bitrate,
                                        uint32_t framerate) override;
   void Close() override;
+  int32_t GetBitstreamBuffers(
+      PP_BitstreamBuffer buffers[],
+      uint32_t max_buffers,
+      const scoped_refptr<TrackedCallback>& callback) override;
+  int32_t GetStats(PP_VideoEncoderStats_Dev* stats) override;
 
   // PluginResource implementation.
   void OnReplyReceived(const ResourceMessageReplyParams& params,
@@ -108,7 +126,7 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
                                       uint32_t frame_count,
                                       uint32_t frame_length,
                                       const PP_Size& frame_size);
-  void OnPluginMsgEncodeReply(PP_Resource video_frame,
+  void OnPluginMsgEncodeReply(uint32_t frame_index,
                               const ResourceMessageReplyParams& params,
                               uint32_t frame_id);
 
@@ -125,7 +143,12 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
   // Internal utility functions.
   void NotifyError(int32_t error);
   void TryWriteVideoFrame();
-  void WriteBitstreamBuffer(const BitstreamBuffer& buffer);
+  bool HasPendingGetBitstreamBuffer() const;
+  // Completes a pending GetBitstreamBuffer(s) call if any buffer is ready.
+  void TryWriteBitstreamBuffers();
+  // Hands up to |max_buffers| ready buffers to the plugin, returning how many.
+  uint32_t WriteBitstreamBuffers(PP_BitstreamBuffer buffers[],
+                                 uint32_t max_buffers);
   void ReleaseFrames();
 
   bool initialized_;
@@ -141,10 +164,15 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
       VideoFrameMap;
   VideoFrameMap video_frames_;
 
+  // Indexed by buffer id.
   std::vector<std::unique_ptr<ShmBuffer>> shm_buffers_;
+  uint32_t num_held_bitstream_buffers_;
 
   base::circular_deque<BitstreamBuffer> available_bitstream_buffers_;
-  using BitstreamBufferMap = std::map<void*, uint32_t>;
+  // Maps the address of each buffer back to its id for
+  // RecycleBitstreamBuffer(). There are only a handful of buffers, so a sorted
+  // vector beats a tree of nodes.
+  using BitstreamBufferMap = base::flat_map<void*, uint32_t>;
   BitstreamBufferMap bitstream_buffer_map_;
 
   scoped_refptr<TrackedCallback> get_supported_profiles_callback_;
@@ -152,12 +180,25 @@ class PPAPI_PROXY_EXPORT VideoEncoderResource
   scoped_refptr<TrackedCallback> get_video_frame_callback_;
   PP_Resource* get_video_frame_data_;
 
-  using EncodeMap = std::map<PP_Resource, scoped_refptr<TrackedCallback>>;
-  EncodeMap encode_callbacks_;
+  // Indexed by the video frame's buffer index, which the host echoes back in
+  // the EncodeReply.
+  std::vector<PendingEncode> pending_encodes_;
+  uint32_t num_pending_encodes_;
 
   scoped_refptr<TrackedCallback> get_bitstream_buffer_callback_;
   PP_BitstreamBuffer* get_bitstream_buffer_data_;
 
+  scoped_refptr<TrackedCallback> get_bitstream_buffers_callback_;
+  PP_BitstreamBuffer* get_bitstream_buffers_data_;
+  uint32_t get_bitstream_buffers_max_;
+
+  // Statistics for GetStats().
+  uint32_t encode_count_;
+  uint32_t peak_pending_encodes_;
+  base::TimeDelta total_encode_time_;
+  base::TimeDelta max_encode_time_;
+  base::TimeDelta last_encode_time_;
+
   DISALLOW_COPY_AND_ASSIGN(VideoEncoderResource);
 };
 
@@ -13,6 +13,7 @@
 #include "base/memory/shared_memory.h"
 #include "base/process/process.h"
 #include "base/synchronization/waitable_event.h"
+#include "ppapi/c/dev/ppb_video_encoder_stream_dev.h"
 #include "ppapi/c/pp_codecs.h"
 #include "ppapi/c/pp_errors.h"
 #include "ppapi/c/ppb_video_encoder.h"
@@ -70,6 +71,7 @@ class VideoEncoderResourceTest : public PluginProxyTest,
   VideoEncoderResourceTest()
       : encoder_iface_(thunk::GetPPB_VideoEncoder_0_2_Thunk()),
         encoder_iface_0_1_(thunk::GetPPB_VideoEncoder_0_1_Thunk()),
+        stream_iface_(thunk::GetPPB_VideoEncoderStream_Dev_0_1_Thunk()),
         video_frames_manager_(this) {}
   ~VideoEncoderResourceTest() override {}
 
@@ -77,6 +79,9 @@ class VideoEncoderResourceTest : public PluginProxyTest,
   const PPB_VideoEncoder_0_1* encoder_iface_0_1() const {
     return encoder_iface_0_1_;
   }
+  const PPB_VideoEncoderStream_Dev_0_1* stream_iface() const {
+    return stream_iface_;
+  }
 
   const uint32_t kBitstreamBufferSize = 4000;
   const uint32_t kBitstreamBufferCount = 5;
@@ -258,6 +263,21 @@ class VideoEncoderResourceTest : public PluginProxyTest,
                                           cb));
   }
 
+  int32_t CallGetBitstreamBuffers(PP_Resource pp_encoder,
+                                  PP_BitstreamBuffer buffers[],
+                                  uint32_t max_buffers,
+                                  MockCompletionCallback* cb) {
+    return stream_iface()->GetBitstreamBuffers(
+        pp_encoder, buffers, max_buffers,
+        PP_MakeOptionalCompletionCallback(&MockCompletionCallback::Callback,
+                                          cb));
+  }
+
+  int32_t CallGetStats(PP_Resource pp_encoder,
+                       PP_VideoEncoderStats_Dev* stats) {
+    return stream_iface()->GetStats(pp_encoder, stats);
+  }
+
   void CallRecycleBitstreamBuffer(PP_Resource pp_encoder,
                                   const PP_BitstreamBuffer& buffer) {
     encoder_iface()->RecycleBitstreamBuffer(pp_encoder, &buffer);
@@ -425,6 +445,7 @@ class VideoEncoderResourceTest : public PluginProxyTest,
 
   const PPB_VideoEncoder_0_2* encoder_iface_;
   const PPB_VideoEncoder_0_1* encoder_iface_0_1_;
+  const PPB_VideoEncoderStream_Dev_0_1* stream_iface_;
 
   std::vector<std::unique_ptr<base::SharedMemory>> shared_memory_bitstreams_;
 
@@ -992,6 +1013,113 @@ TEST_F(VideoEncoderResourceTest, RecycleBitstreamBuffer) {
   ASSERT_EQ(kBitstreamBufferCount - 1, buffer_id);
 }
 
+TEST_F(VideoEncoderResourceTest, GetBitstreamBuffers) {
+  // Check GetBitstreamBuffers() returns every buffer that is ready at once,
+  // and otherwise completes when the next one arrives.
+  LockingResourceReleaser encoder(CreateAndInitializeEncoder());
+
+  ResourceMessageCallParams buffer_params(encoder.get(), 0);
+  SendBitstreamBufferReady(buffer_params, 0, 10, true);
+  SendBitstreamBufferReady(buffer_params, 1, 20, false);
+
+  PP_BitstreamBuffer buffers[4];
+  MockCompletionCallback get_buffers_cb;
+  ASSERT_EQ(2, CallGetBitstreamBuffers(encoder.get(), buffers,
+                                       arraysize(buffers), &get_buffers_cb));
+  ASSERT_FALSE(get_buffers_cb.called());
+  ASSERT_EQ(10U, buffers[0].size);
+  ASSERT_EQ(PP_TRUE, buffers[0].key_frame);
+  ASSERT_EQ(20U, buffers[1].size);
+  ASSERT_EQ(PP_FALSE, buffers[1].key_frame);
+
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING,
+            CallGetBitstreamBuffers(encoder.get(), buffers, arraysize(buffers),
+                                    &get_buffers_cb));
+  PP_BitstreamBuffer bitstream_buffer;
+  MockCompletionCallback get_bitstream_buffer_cb;
+  ASSERT_EQ(PP_ERROR_INPROGRESS,
+            CallGetBitstreamBuffer(encoder.get(), &bitstream_buffer,
+                                   &get_bitstream_buffer_cb));
+
+  SendBitstreamBufferReady(buffer_params, 2, 30, false);
+  ASSERT_TRUE(get_buffers_cb.called());
+  ASSERT_EQ(1, get_buffers_cb.result());
+  ASSERT_EQ(30U, buffers[0].size);
+
+  PP_VideoEncoderStats_Dev stats;
+  ASSERT_EQ(PP_OK, CallGetStats(encoder.get(), &stats));
+  ASSERT_EQ(3U, stats.held_bitstream_buffers);
+  ASSERT_EQ(0U, stats.ready_bitstream_buffers);
+  ASSERT_EQ(kBitstreamBufferCount, stats.bitstream_buffer_count);
+
+  // Buffers recycled twice are only sent back to the renderer once.
+  CallRecycleBitstreamBuffer(encoder.get(), buffers[0]);
+  ResourceMessageCallParams recycle_params;
+  uint32_t buffer_id;
+  ASSERT_TRUE(CheckRecycleBitstreamBufferMsg(&recycle_params, &buffer_id));
+  ASSERT_EQ(2U, buffer_id);
+  CallRecycleBitstreamBuffer(encoder.get(), buffers[0]);
+  ASSERT_FALSE(CheckRecycleBitstreamBufferMsg(&recycle_params, &buffer_id));
+
+  ASSERT_EQ(PP_OK, CallGetStats(encoder.get(), &stats));
+  ASSERT_EQ(2U, stats.held_bitstream_buffers);
+}
+
+TEST_F(VideoEncoderResourceTest, EncodeStats) {
+  // Check the queue depth and latency counters follow Encode() calls.
+  LockingResourceReleaser encoder(CreateAndInitializeEncoder());
+
+  MockCompletionCallback get_frame_cb, encode_cb1, encode_cb2;
+  PP_Resource video_frame1, video_frame2;
+  ASSERT_EQ(
+      PP_OK_COMPLETIONPENDING,
+      CallFirstGetVideoFrame(encoder.get(), &video_frame1, &get_frame_cb));
+  ASSERT_TRUE(get_frame_cb.called());
+  get_frame_cb.Reset();
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING,
+            CallGetVideoFrame(encoder.get(), &video_frame2, &get_frame_cb));
+  ASSERT_TRUE(get_frame_cb.called());
+
+  ResourceMessageCallParams params1, params2;
+  uint32_t frame_id1, frame_id2;
+  bool force_frame;
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING,
+            CallEncode(encoder.get(), video_frame1, PP_FALSE, &encode_cb1));
+  ASSERT_TRUE(CheckEncodeMsg(&params1, &frame_id1, &force_frame));
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING,
+            CallEncode(encoder.get(), video_frame2, PP_FALSE, &encode_cb2));
+  ASSERT_TRUE(CheckEncodeMsg(&params2, &frame_id2, &force_frame));
+  ASSERT_NE(frame_id1, frame_id2);
+
+  PP_VideoEncoderStats_Dev stats;
+  ASSERT_EQ(PP_OK, CallGetStats(encoder.get(), &stats));
+  ASSERT_EQ(0U, stats.encode_count);
+  ASSERT_EQ(2U, stats.pending_encodes);
+  ASSERT_EQ(2U, stats.peak_pending_encodes);
+
+  // Replies may come back out of order.
+  SendEncodeReply(params2, frame_id2);
+  ASSERT_TRUE(encode_cb2.called());
+  ASSERT_FALSE(encode_cb1.called());
+
+  ASSERT_EQ(PP_OK, CallGetStats(encoder.get(), &stats));
+  ASSERT_EQ(1U, stats.encode_count);
+  ASSERT_EQ(1U, stats.pending_encodes);
+  ASSERT_GE(stats.last_encode_time, 0.0);
+  ASSERT_EQ(stats.last_encode_time, stats.total_encode_time);
+  ASSERT_EQ(stats.last_encode_time, stats.max_encode_time);
+
+  SendEncodeReply(params1, frame_id1);
+  ASSERT_TRUE(encode_cb1.called());
+  ASSERT_EQ(PP_OK, encode_cb1.result());
+
+  ASSERT_EQ(PP_OK, CallGetStats(encoder.get(), &stats));
+  ASSERT_EQ(2U, stats.encode_count);
+  ASSERT_EQ(0U, stats.pending_encodes);
+  ASSERT_EQ(2U, stats.peak_pending_encodes);
+  ASSERT_GE(stats.total_encode_time, stats.max_encode_time);
+}
+
 TEST_F(VideoEncoderResourceTest, RequestEncodingParametersChange) {
   // Check encoding parameter changes are correctly sent to the
   // renderer.
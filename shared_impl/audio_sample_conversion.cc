@@ -0,0 +1,268 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/shared_impl/audio_sample_conversion.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "build/build_config.h"
+#include "media/base/audio_bus.h"
+#include "media/base/limits.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#define USE_AUDIO_SIMD 1
+#include <immintrin.h>
+
+#include "base/cpu.h"
+
+// Lets the AVX2 kernels be built without enabling AVX2 for the whole file.
+// They are only called after checking for AVX2 at runtime. clang-cl needs the
+// attribute as well, while MSVC allows AVX2 intrinsics anywhere.
+#if defined(__clang__) || defined(COMPILER_GCC)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+#endif
+
+namespace ppapi {
+
+namespace {
+
+// Same scale factors as media::SignedInt16SampleTypeTraits, which treat the
+// negative and positive halves of the range separately.
+const float kInt16NegativeScale = 1.0f / 32768.0f;
+const float kInt16PositiveScale = 1.0f / 32767.0f;
+
+float Int16ToFloat(int16_t sample) {
+  return sample < 0 ? sample * kInt16NegativeScale
+                    : sample * kInt16PositiveScale;
+}
+
+float ClampFloat(float sample) {
+  // Written so that NaN ends up as 1, like the _mm_min_ps/_mm_max_ps pair
+  // below, which keeps the SIMD and scalar paths bit exact.
+  return std::max(-1.0f, std::min(1.0f, sample));
+}
+
+// Converts frames [start_frame, frames) one sample at a time. Used by the
+// SIMD kernels for their tails and as the fallback for other architectures.
+template <typename T, float (*Convert)(T)>
+void DeinterleaveScalar(const T* source,
+                        int channels,
+                        int start_frame,
+                        int frames,
+                        float* const* dest) {
+  for (int ch = 0; ch < channels; ++ch) {
+    float* channel = dest[ch];
+    const T* sample = source + start_frame * channels + ch;
+    for (int i = start_frame; i < frames; ++i, sample += channels)
+      channel[i] = Convert(*sample);
+  }
+}
+
+#if defined(USE_AUDIO_SIMD)
+
+bool HasAVX2() {
+  static const bool has_avx2 = base::CPU().has_avx2();
+  return has_avx2;
+}
+
+// SSE2 -----------------------------------------------------------------------
+
+// Converts the 4 int16 samples in the low half of |packed| to float.
+inline __m128 Int16x4ToFloatSSE2(__m128i packed) {
+  // Sign extend by moving each sample to the top of a 32-bit lane and
+  // shifting it back down arithmetically.
+  __m128 samples =
+      _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+  __m128 negative = _mm_cmplt_ps(samples, _mm_setzero_ps());
+  __m128 scale =
+      _mm_or_ps(_mm_and_ps(negative, _mm_set1_ps(kInt16NegativeScale)),
+                _mm_andnot_ps(negative, _mm_set1_ps(kInt16PositiveScale)));
+  return _mm_mul_ps(samples, scale);
+}
+
+// Loads 4 samples of |source| as float, converting or clamping as needed.
+inline __m128 Loadx4SSE2(const int16_t* source) {
+  return Int16x4ToFloatSSE2(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+}
+
+inline __m128 Loadx4SSE2(const float* source) {
+  return _mm_max_ps(_mm_min_ps(_mm_loadu_ps(source), _mm_set1_ps(1.0f)),
+                    _mm_set1_ps(-1.0f));
+}
+
+// Returns the number of frames converted.
+template <typename T>
+int DeinterleaveMonoSSE2(const T* source, int frames, float* dest) {
+  int i = 0;
+  for (; i + 4 <= frames; i += 4)
+    _mm_storeu_ps(dest + i, Loadx4SSE2(source + i));
+  return i;
+}
+
+template <typename T>
+int DeinterleaveStereoSSE2(const T* source, int frames, float* const* dest) {
+  float* left = dest[0];
+  float* right = dest[1];
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    // L0 R0 L1 R1 and L2 R2 L3 R3.
+    __m128 a = Loadx4SSE2(source + 2 * i);
+    __m128 b = Loadx4SSE2(source + 2 * i + 4);
+    _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  return i;
+}
+
+// For layouts with a multiple of 4 channels: converts 4x4 blocks of frames
+// by channels with a transpose.
+template <typename T>
+int DeinterleaveQuadsSSE2(const T* source,
+                          int channels,
+                          int frames,
+                          float* const* dest) {
+  DCHECK_EQ(0, channels % 4);
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    const T* block = source + i * channels;
+    for (int ch = 0; ch < channels; ch += 4) {
+      __m128 row0 = Loadx4SSE2(block + ch);
+      __m128 row1 = Loadx4SSE2(block + channels + ch);
+      __m128 row2 = Loadx4SSE2(block + 2 * channels + ch);
+      __m128 row3 = Loadx4SSE2(block + 3 * channels + ch);
+      _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+      _mm_storeu_ps(dest[ch] + i, row0);
+      _mm_storeu_ps(dest[ch + 1] + i, row1);
+      _mm_storeu_ps(dest[ch + 2] + i, row2);
+      _mm_storeu_ps(dest[ch + 3] + i, row3);
+    }
+  }
+  return i;
+}
+
+// AVX2 -----------------------------------------------------------------------
+
+TARGET_AVX2 inline __m256 Loadx8AVX2(const int16_t* source) {
+  __m256 samples = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source))));
+  // Integer samples never convert to -0, so the sign bit alone picks the
+  // scale.
+  __m256 scale = _mm256_blendv_ps(_mm256_set1_ps(kInt16PositiveScale),
+                                  _mm256_set1_ps(kInt16NegativeScale),
+                                  samples);
+  return _mm256_mul_ps(samples, scale);
+}
+
+TARGET_AVX2 inline __m256 Loadx8AVX2(const float* source) {
+  return _mm256_max_ps(
+      _mm256_min_ps(_mm256_loadu_ps(source), _mm256_set1_ps(1.0f)),
+      _mm256_set1_ps(-1.0f));
+}
+
+template <typename T>
+TARGET_AVX2 int DeinterleaveMonoAVX2(const T* source, int frames, float* dest) {
+  int i = 0;
+  for (; i + 8 <= frames; i += 8)
+    _mm256_storeu_ps(dest + i, Loadx8AVX2(source + i));
+  return i;
+}
+
+template <typename T>
+TARGET_AVX2 int DeinterleaveStereoAVX2(const T* source,
+                                       int frames,
+                                       float* const* dest) {
+  float* left = dest[0];
+  float* right = dest[1];
+  int i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    // L0 R0 L1 R1 L2 R2 L3 R3 and L4 R4 L5 R5 L6 R6 L7 R7.
+    __m256 a = Loadx8AVX2(source + 2 * i);
+    __m256 b = Loadx8AVX2(source + 2 * i + 8);
+    // Shuffles work within 128-bit lanes, which gives L0 L1 L4 L5 L2 L3 L6 L7;
+    // swapping the middle 64-bit pairs puts the frames back in order.
+    __m256 l = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    l = _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(l), _MM_SHUFFLE(3, 1, 2, 0)));
+    r = _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(left + i, l);
+    _mm256_storeu_ps(right + i, r);
+  }
+  return i;
+}
+
+#endif  // defined(USE_AUDIO_SIMD)
+
+template <typename T, float (*Convert)(T)>
+void Deinterleave(const T* source,
+                  int channels,
+                  int frames,
+                  float* const* dest) {
+  DCHECK_GT(channels, 0);
+  DCHECK_GE(frames, 0);
+  int done = 0;
+#if defined(USE_AUDIO_SIMD)
+  if (channels == 1) {
+    if (HasAVX2())
+      done = DeinterleaveMonoAVX2(source, frames, dest[0]);
+    done += DeinterleaveMonoSSE2(source + done, frames - done, dest[0] + done);
+  } else if (channels == 2) {
+    if (HasAVX2())
+      done = DeinterleaveStereoAVX2(source, frames, dest);
+    if (done < frames) {
+      float* tail[] = {dest[0] + done, dest[1] + done};
+      done +=
+          DeinterleaveStereoSSE2(source + 2 * done, frames - done, tail);
+    }
+  } else if (channels % 4 == 0) {
+    done = DeinterleaveQuadsSSE2(source, channels, frames, dest);
+  }
+#endif
+  DeinterleaveScalar<T, Convert>(source, channels, done, frames, dest);
+}
+
+}  // namespace
+
+int BytesPerAudioSample(PP_AudioSampleFormat_Dev format) {
+  return format == PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32 ? sizeof(float)
+                                                   : sizeof(int16_t);
+}
+
+void DeinterleaveInt16(const int16_t* source,
+                       int channels,
+                       int frames,
+                       float* const* dest) {
+  Deinterleave<int16_t, &Int16ToFloat>(source, channels, frames, dest);
+}
+
+void DeinterleaveFloat(const float* source,
+                       int channels,
+                       int frames,
+                       float* const* dest) {
+  Deinterleave<float, &ClampFloat>(source, channels, frames, dest);
+}
+
+void DeinterleaveToAudioBus(const void* source,
+                            PP_AudioSampleFormat_Dev format,
+                            media::AudioBus* dest) {
+  DCHECK_LE(dest->channels(), media::limits::kMaxChannels);
+  float* channels[media::limits::kMaxChannels];
+  for (int ch = 0; ch < dest->channels(); ++ch)
+    channels[ch] = dest->channel(ch);
+  if (format == PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32) {
+    DeinterleaveFloat(static_cast<const float*>(source), dest->channels(),
+                      dest->frames(), channels);
+  } else {
+    DeinterleaveInt16(static_cast<const int16_t*>(source), dest->channels(),
+                      dest->frames(), channels);
+  }
+}
+
+}  // namespace ppapi
@@ -0,0 +1,50 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_SHARED_IMPL_AUDIO_SAMPLE_CONVERSION_H_
+#define PPAPI_SHARED_IMPL_AUDIO_SAMPLE_CONVERSION_H_
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
+#include "ppapi/shared_impl/ppapi_shared_export.h"
+
+namespace media {
+class AudioBus;
+}
+
+namespace ppapi {
+
+// Returns the size in bytes of one sample of |format|.
+PPAPI_SHARED_EXPORT int BytesPerAudioSample(PP_AudioSampleFormat_Dev format);
+
+// Converts |frames| frames of interleaved samples with |channels| channels to
+// planar float in [-1, 1]. |dest| points at |channels| arrays of at least
+// |frames| floats. This is what media::AudioBus::FromInterleaved() does, but
+// uses SSE2 or AVX2 where available; both run on the audio thread once per
+// period, so they must not allocate or lock.
+//
+// Int16 samples are scaled the same way as media::AudioBus does, so that
+// -32768 and 32767 map to exactly -1 and 1.
+PPAPI_SHARED_EXPORT void DeinterleaveInt16(const int16_t* source,
+                                           int channels,
+                                           int frames,
+                                           float* const* dest);
+
+// Float samples are copied as is, except that values outside [-1, 1] (and
+// NaNs) are clamped, as the host's mixer expects.
+PPAPI_SHARED_EXPORT void DeinterleaveFloat(const float* source,
+                                           int channels,
+                                           int frames,
+                                           float* const* dest);
+
+// Fills all of |dest| from |source|, which holds |dest->frames()| frames
+// interleaved with |dest->channels()| channels in |format|.
+PPAPI_SHARED_EXPORT void DeinterleaveToAudioBus(const void* source,
+                                                PP_AudioSampleFormat_Dev format,
+                                                media::AudioBus* dest);
+
+}  // namespace ppapi
+
+#endif  // PPAPI_SHARED_IMPL_AUDIO_SAMPLE_CONVERSION_H_
@@ -0,0 +1,111 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "media/base/audio_bus.h"
+#include "ppapi/shared_impl/audio_sample_conversion.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ppapi {
+namespace {
+
+// A typical PPB_Audio period at 48kHz.
+const int kFrames = 480;
+
+int Iterations() {
+  int iterations = 100000;
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line && command_line->HasSwitch("iterations")) {
+    base::StringToInt(command_line->GetSwitchValueASCII("iterations"),
+                      &iterations);
+  }
+  return iterations;
+}
+
+// Converts one period of |channels| interleaved channels per iteration, the
+// way PPB_Audio_Shared::Run() does, with both the media::AudioBus conversion
+// it used to call and the kernels it calls now.
+void RunInt16(int channels) {
+  std::vector<int16_t> source(channels * kFrames);
+  for (size_t i = 0; i < source.size(); ++i)
+    source[i] = static_cast<int16_t>(i * 7919);
+  std::unique_ptr<media::AudioBus> bus =
+      media::AudioBus::Create(channels, kFrames);
+  int iterations = Iterations();
+
+  base::PerfTimeLogger audio_bus_logger(
+      base::StringPrintf("AudioSampleConversionPerfTest.Int16_AudioBus_%dCh",
+                         channels)
+          .c_str());
+  for (int i = 0; i < iterations; ++i)
+    bus->FromInterleaved(source.data(), kFrames, sizeof(int16_t));
+  audio_bus_logger.Done();
+
+  base::PerfTimeLogger kernel_logger(
+      base::StringPrintf("AudioSampleConversionPerfTest.Int16_Kernel_%dCh",
+                         channels)
+          .c_str());
+  for (int i = 0; i < iterations; ++i) {
+    DeinterleaveToAudioBus(source.data(), PP_AUDIOSAMPLEFORMAT_DEV_INT16,
+                           bus.get());
+  }
+  kernel_logger.Done();
+}
+
+// media::AudioBus has no float interleaved input, so the baseline is the
+// obvious loop over frames and channels.
+void RunFloat(int channels) {
+  std::vector<float> source(channels * kFrames);
+  for (size_t i = 0; i < source.size(); ++i)
+    source[i] = (static_cast<int>(i % 201) - 100) / 100.0f;
+  std::unique_ptr<media::AudioBus> bus =
+      media::AudioBus::Create(channels, kFrames);
+  int iterations = Iterations();
+
+  base::PerfTimeLogger loop_logger(
+      base::StringPrintf("AudioSampleConversionPerfTest.Float_Loop_%dCh",
+                         channels)
+          .c_str());
+  for (int i = 0; i < iterations; ++i) {
+    for (int frame = 0; frame < kFrames; ++frame) {
+      for (int ch = 0; ch < channels; ++ch)
+        bus->channel(ch)[frame] = source[frame * channels + ch];
+    }
+  }
+  loop_logger.Done();
+
+  base::PerfTimeLogger kernel_logger(
+      base::StringPrintf("AudioSampleConversionPerfTest.Float_Kernel_%dCh",
+                         channels)
+          .c_str());
+  for (int i = 0; i < iterations; ++i) {
+    DeinterleaveToAudioBus(source.data(), PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32,
+                           bus.get());
+  }
+  kernel_logger.Done();
+}
+
+const int kChannelCounts[] = {1, 2, 8, 32};
+
+}  // namespace
+
+TEST(AudioSampleConversionPerfTest, Int16) {
+  for (int channels : kChannelCounts)
+    RunInt16(channels);
+}
+
+TEST(AudioSampleConversionPerfTest, Float) {
+  for (int channels : kChannelCounts)
+    RunFloat(channels);
+}
+
+}  // namespace ppapi
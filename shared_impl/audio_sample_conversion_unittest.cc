@@ -0,0 +1,168 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/shared_impl/audio_sample_conversion.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "media/base/audio_bus.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ppapi {
+
+namespace {
+
+// Covers the mono, stereo and multiple-of-4 SIMD kernels as well as the
+// scalar path, with frame counts that leave tails of every length.
+const int kChannelCounts[] = {1, 2, 3, 4, 6, 8, 32};
+const int kFrameCounts[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 480, 511};
+
+std::vector<int16_t> MakeInt16Samples(int count) {
+  std::vector<int16_t> samples(count);
+  for (int i = 0; i < count; ++i)
+    samples[i] = static_cast<int16_t>(i * 7919 - 32768);
+  // Make sure the extremes show up in every run that has room for them.
+  if (count > 1) {
+    samples[0] = std::numeric_limits<int16_t>::min();
+    samples[1] = std::numeric_limits<int16_t>::max();
+  }
+  return samples;
+}
+
+class Planar {
+ public:
+  Planar(int channels, int frames)
+      : data_(channels, std::vector<float>(frames)) {
+    for (auto& channel : data_)
+      pointers_.push_back(channel.data());
+  }
+
+  float* const* pointers() const { return pointers_.data(); }
+  float at(int channel, int frame) const { return data_[channel][frame]; }
+
+ private:
+  std::vector<std::vector<float>> data_;
+  std::vector<float*> pointers_;
+};
+
+}  // namespace
+
+// The int16 kernels must produce exactly what media::AudioBus produced before
+// PPB_Audio switched to them.
+TEST(AudioSampleConversionTest, Int16MatchesAudioBus) {
+  for (int channels : kChannelCounts) {
+    for (int frames : kFrameCounts) {
+      SCOPED_TRACE(testing::Message() << channels << " channels, " << frames
+                                      << " frames");
+      std::vector<int16_t> source = MakeInt16Samples(channels * frames);
+      std::unique_ptr<media::AudioBus> expected =
+          media::AudioBus::Create(channels, frames);
+      expected->FromInterleaved(source.data(), frames, sizeof(int16_t));
+
+      Planar actual(channels, frames);
+      DeinterleaveInt16(source.data(), channels, frames, actual.pointers());
+      for (int ch = 0; ch < channels; ++ch) {
+        for (int i = 0; i < frames; ++i)
+          ASSERT_EQ(expected->channel(ch)[i], actual.at(ch, i));
+      }
+    }
+  }
+}
+
+TEST(AudioSampleConversionTest, Int16Range) {
+  const int16_t source[] = {std::numeric_limits<int16_t>::min(), 0,
+                            std::numeric_limits<int16_t>::max(), -1};
+  Planar dest(2, 2);
+  DeinterleaveInt16(source, 2, 2, dest.pointers());
+  EXPECT_EQ(-1.0f, dest.at(0, 0));
+  EXPECT_EQ(0.0f, dest.at(1, 0));
+  EXPECT_EQ(1.0f, dest.at(0, 1));
+  EXPECT_GT(0.0f, dest.at(1, 1));
+}
+
+TEST(AudioSampleConversionTest, Float) {
+  for (int channels : kChannelCounts) {
+    for (int frames : kFrameCounts) {
+      SCOPED_TRACE(testing::Message() << channels << " channels, " << frames
+                                      << " frames");
+      std::vector<float> source(channels * frames);
+      for (size_t i = 0; i < source.size(); ++i)
+        source[i] = (static_cast<int>(i % 101) - 50) / 40.0f;
+
+      Planar actual(channels, frames);
+      DeinterleaveFloat(source.data(), channels, frames, actual.pointers());
+      for (int ch = 0; ch < channels; ++ch) {
+        for (int i = 0; i < frames; ++i) {
+          float expected = source[i * channels + ch];
+          expected = std::max(-1.0f, std::min(1.0f, expected));
+          ASSERT_EQ(expected, actual.at(ch, i));
+        }
+      }
+    }
+  }
+}
+
+// Samples outside [-1, 1] must not reach the host, including NaNs, on every
+// code path.
+TEST(AudioSampleConversionTest, FloatClamping) {
+  const float kSpecial[] = {2.0f, -2.0f, std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN()};
+  for (int channels : kChannelCounts) {
+    const int frames = 17;
+    std::vector<float> source(channels * frames);
+    for (size_t i = 0; i < source.size(); ++i)
+      source[i] = kSpecial[i % arraysize(kSpecial)];
+
+    Planar actual(channels, frames);
+    DeinterleaveFloat(source.data(), channels, frames, actual.pointers());
+    for (int ch = 0; ch < channels; ++ch) {
+      for (int i = 0; i < frames; ++i) {
+        EXPECT_LE(-1.0f, actual.at(ch, i));
+        EXPECT_GE(1.0f, actual.at(ch, i));
+      }
+    }
+  }
+}
+
+TEST(AudioSampleConversionTest, DeinterleaveToAudioBus) {
+  const int kFrames = 480;
+  std::unique_ptr<media::AudioBus> bus = media::AudioBus::Create(2, kFrames);
+
+  std::vector<float> float_source(2 * kFrames);
+  for (int i = 0; i < kFrames; ++i) {
+    float_source[2 * i] = i / static_cast<float>(kFrames);
+    float_source[2 * i + 1] = -i / static_cast<float>(kFrames);
+  }
+  DeinterleaveToAudioBus(float_source.data(), PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32,
+                         bus.get());
+  for (int i = 0; i < kFrames; ++i) {
+    ASSERT_EQ(float_source[2 * i], bus->channel(0)[i]);
+    ASSERT_EQ(float_source[2 * i + 1], bus->channel(1)[i]);
+  }
+
+  std::vector<int16_t> int16_source = MakeInt16Samples(2 * kFrames);
+  std::unique_ptr<media::AudioBus> expected =
+      media::AudioBus::Create(2, kFrames);
+  expected->FromInterleaved(int16_source.data(), kFrames, sizeof(int16_t));
+  DeinterleaveToAudioBus(int16_source.data(), PP_AUDIOSAMPLEFORMAT_DEV_INT16,
+                         bus.get());
+  for (int ch = 0; ch < 2; ++ch) {
+    for (int i = 0; i < kFrames; ++i)
+      ASSERT_EQ(expected->channel(ch)[i], bus->channel(ch)[i]);
+  }
+}
+
+TEST(AudioSampleConversionTest, BytesPerAudioSample) {
+  EXPECT_EQ(2, BytesPerAudioSample(PP_AUDIOSAMPLEFORMAT_DEV_INT16));
+  EXPECT_EQ(4, BytesPerAudioSample(PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32));
+}
+
+}  // namespace ppapi
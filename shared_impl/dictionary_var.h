@@ -5,10 +5,10 @@
 #ifndef PPAPI_SHARED_IMPL_DICTIONARY_VAR_H_
 #define PPAPI_SHARED_IMPL_DICTIONARY_VAR_H_
 
-#include <map>
 #include <string>
 
 #include "base/compiler_specific.h"
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "ppapi/c/pp_var.h"
 #include "ppapi/shared_impl/ppapi_shared_export.h"
@@ -19,7 +19,11 @@ namespace ppapi {
 
 class PPAPI_SHARED_EXPORT DictionaryVar : public Var {
  public:
-  typedef std::map<std::string, ScopedPPVar> KeyValueMap;
+  // Dictionaries are usually small and read far more often than they are
+  // modified, so the entries are kept in a sorted vector rather than a tree:
+  // lookups are a binary search over contiguous memory and iteration order
+  // (and thus GetKeys()) stays sorted by key. Short keys don't allocate.
+  typedef base::flat_map<std::string, ScopedPPVar> KeyValueMap;
 
   DictionaryVar();
 
@@ -0,0 +1,247 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/format_macros.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "ppapi/shared_impl/array_var.h"
+#include "ppapi/shared_impl/dictionary_var.h"
+#include "ppapi/shared_impl/ppapi_globals.h"
+#include "ppapi/shared_impl/proxy_lock.h"
+#include "ppapi/shared_impl/scoped_pp_var.h"
+#include "ppapi/shared_impl/test_globals.h"
+#include "ppapi/shared_impl/var.h"
+#include "ppapi/shared_impl/var_tracker.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ppapi {
+namespace {
+
+// The std::map based storage DictionaryVar used before it switched to a flat
+// map, kept here as the baseline. Mirrors DictionaryVar's Get/Set/GetKeys.
+class MapDictionary {
+ public:
+  MapDictionary() {}
+
+  PP_Var Get(const PP_Var& key) const {
+    StringVar* string_var = StringVar::FromPPVar(key);
+    if (!string_var)
+      return PP_MakeUndefined();
+    auto iter = map_.find(string_var->value());
+    if (iter == map_.end())
+      return PP_MakeUndefined();
+    PpapiGlobals::Get()->GetVarTracker()->AddRefVar(iter->second.get());
+    return iter->second.get();
+  }
+
+  void Set(const PP_Var& key, const PP_Var& value) {
+    StringVar* string_var = StringVar::FromPPVar(key);
+    if (string_var)
+      map_[string_var->value()] = value;
+  }
+
+  void Delete(const PP_Var& key) {
+    StringVar* string_var = StringVar::FromPPVar(key);
+    if (string_var)
+      map_.erase(string_var->value());
+  }
+
+  PP_Var GetKeys() const {
+    scoped_refptr<ArrayVar> array_var(new ArrayVar());
+    array_var->elements().reserve(map_.size());
+    for (auto iter = map_.begin(); iter != map_.end(); ++iter) {
+      array_var->elements().push_back(ScopedPPVar(
+          ScopedPPVar::PassRef(), StringVar::StringToPPVar(iter->first)));
+    }
+    return array_var->GetPPVar();
+  }
+
+ private:
+  std::map<std::string, ScopedPPVar> map_;
+
+  DISALLOW_COPY_AND_ASSIGN(MapDictionary);
+};
+
+class DictionaryVarPerfTest : public testing::Test {
+ public:
+  DictionaryVarPerfTest() {}
+
+  void SetUp() override { ProxyLock::Acquire(); }
+  void TearDown() override { ProxyLock::Release(); }
+
+  int iterations() const {
+    int iterations = 10000;
+    base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+    if (command_line && command_line->HasSwitch("iterations")) {
+      base::StringToInt(command_line->GetSwitchValueASCII("iterations"),
+                        &iterations);
+    }
+    return iterations;
+  }
+
+  // Runs Set, Get and GetKeys on |dictionary| with |key_count| keys of the
+  // kind seen in typical messages (short, with a shared prefix), mapped to
+  // |values|, which are alternated between. Refcounted values show the cost
+  // of moving entries around inside the dictionary.
+  template <typename DictionaryT>
+  void Run(const char* name,
+           DictionaryT* dictionary,
+           size_t key_count,
+           const std::vector<ScopedPPVar>& values) {
+    std::vector<ScopedPPVar> keys;
+    for (size_t i = 0; i < key_count; ++i) {
+      // Insert in a scrambled order, as plugins don't insert sorted keys.
+      size_t index = (i * 7919) % key_count;
+      keys.push_back(ScopedPPVar(
+          ScopedPPVar::PassRef(),
+          StringVar::StringToPPVar(
+              base::StringPrintf("key_%" PRIuS, index))));
+    }
+    int iterations = this->iterations();
+
+    // Filling and emptying the dictionary out of order inserts and erases in
+    // the middle of it.
+    base::PerfTimeLogger build_logger(
+        base::StringPrintf("DictionaryVarPerfTest.%s_SetDelete_%" PRIuS "Keys",
+                           name, key_count)
+            .c_str());
+    for (int i = 0; i < iterations / 10; ++i) {
+      for (size_t j = 0; j < keys.size(); ++j)
+        dictionary->Set(keys[j].get(), values[j % values.size()].get());
+      for (size_t j = 0; j < keys.size(); ++j)
+        dictionary->Delete(keys[j].get());
+    }
+    build_logger.Done();
+
+    base::PerfTimeLogger set_logger(
+        base::StringPrintf("DictionaryVarPerfTest.%s_Set_%" PRIuS "Keys",
+                           name, key_count)
+            .c_str());
+    for (int i = 0; i < iterations; ++i) {
+      for (size_t j = 0; j < keys.size(); ++j)
+        dictionary->Set(keys[j].get(), values[i % values.size()].get());
+    }
+    set_logger.Done();
+
+    base::PerfTimeLogger get_logger(
+        base::StringPrintf("DictionaryVarPerfTest.%s_Get_%" PRIuS "Keys",
+                           name, key_count)
+            .c_str());
+    const PP_Var& expected = values[(iterations - 1) % values.size()].get();
+    size_t matches = 0;
+    for (int i = 0; i < iterations; ++i) {
+      for (size_t j = 0; j < keys.size(); ++j) {
+        ScopedPPVar value(ScopedPPVar::PassRef(),
+                          dictionary->Get(keys[j].get()));
+        if (value.get().type == expected.type &&
+            (expected.type == PP_VARTYPE_INT32
+                 ? value.get().value.as_int == expected.value.as_int
+                 : value.get().value.as_id == expected.value.as_id)) {
+          ++matches;
+        }
+      }
+    }
+    get_logger.Done();
+    EXPECT_EQ(key_count * iterations, matches);
+
+    base::PerfTimeLogger keys_logger(
+        base::StringPrintf("DictionaryVarPerfTest.%s_GetKeys_%" PRIuS "Keys",
+                           name, key_count)
+            .c_str());
+    for (int i = 0; i < iterations / 10; ++i)
+      ScopedPPVar(ScopedPPVar::PassRef(), dictionary->GetKeys());
+    keys_logger.Done();
+  }
+
+  // Values of each kind to store: plain ints, and refcounted strings and
+  // arrays.
+  std::vector<ScopedPPVar> IntValues() {
+    std::vector<ScopedPPVar> values;
+    values.push_back(ScopedPPVar(PP_MakeInt32(1)));
+    values.push_back(ScopedPPVar(PP_MakeInt32(2)));
+    return values;
+  }
+  std::vector<ScopedPPVar> StringValues() {
+    std::vector<ScopedPPVar> values;
+    values.push_back(ScopedPPVar(ScopedPPVar::PassRef(),
+                                 StringVar::StringToPPVar("value_1")));
+    values.push_back(ScopedPPVar(ScopedPPVar::PassRef(),
+                                 StringVar::StringToPPVar("value_2")));
+    return values;
+  }
+  std::vector<ScopedPPVar> ArrayValues() {
+    std::vector<ScopedPPVar> values;
+    for (int i = 0; i < 2; ++i) {
+      scoped_refptr<ArrayVar> array_var(new ArrayVar());
+      values.push_back(
+          ScopedPPVar(ScopedPPVar::PassRef(), array_var->GetPPVar()));
+    }
+    return values;
+  }
+
+ private:
+  TestGlobals globals_;
+};
+
+const size_t kKeyCounts[] = {4, 16, 64, 1024};
+
+}  // namespace
+
+TEST_F(DictionaryVarPerfTest, FlatMapInt) {
+  std::vector<ScopedPPVar> values = IntValues();
+  for (size_t key_count : kKeyCounts) {
+    scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+    Run("FlatMapInt", dictionary.get(), key_count, values);
+  }
+}
+
+TEST_F(DictionaryVarPerfTest, StdMapInt) {
+  std::vector<ScopedPPVar> values = IntValues();
+  for (size_t key_count : kKeyCounts) {
+    MapDictionary dictionary;
+    Run("StdMapInt", &dictionary, key_count, values);
+  }
+}
+
+TEST_F(DictionaryVarPerfTest, FlatMapString) {
+  std::vector<ScopedPPVar> values = StringValues();
+  for (size_t key_count : kKeyCounts) {
+    scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+    Run("FlatMapString", dictionary.get(), key_count, values);
+  }
+}
+
+TEST_F(DictionaryVarPerfTest, StdMapString) {
+  std::vector<ScopedPPVar> values = StringValues();
+  for (size_t key_count : kKeyCounts) {
+    MapDictionary dictionary;
+    Run("StdMapString", &dictionary, key_count, values);
+  }
+}
+
+TEST_F(DictionaryVarPerfTest, FlatMapArray) {
+  std::vector<ScopedPPVar> values = ArrayValues();
+  for (size_t key_count : kKeyCounts) {
+    scoped_refptr<DictionaryVar> dictionary(new DictionaryVar);
+    Run("FlatMapArray", dictionary.get(), key_count, values);
+  }
+}
+
+TEST_F(DictionaryVarPerfTest, StdMapArray) {
+  std::vector<ScopedPPVar> values = ArrayValues();
+  for (size_t key_count : kKeyCounts) {
+    MapDictionary dictionary;
+    Run("StdMapArray", &dictionary, key_count, values);
+  }
+}
+
+}  // namespace ppapi
@@ -10,12 +10,21 @@
 namespace ppapi {
 
 FileIOStateManager::FileIOStateManager()
-    : num_pending_ops_(0), pending_op_(OPERATION_NONE), file_open_(false) {}
+    : num_pending_ops_(0),
+      max_pending_ops_(0),
+      pending_op_(OPERATION_NONE),
+      file_open_(false) {}
 
 FileIOStateManager::~FileIOStateManager() {}
 
 void FileIOStateManager::SetOpenSucceed() { file_open_ = true; }
 
+void FileIOStateManager::SetConcurrentReadWrite(int max_pending_ops) {
+  DCHECK_EQ(OPERATION_NONE, pending_op_);
+  DCHECK_GE(max_pending_ops, 0);
+  max_pending_ops_ = max_pending_ops;
+}
+
 int32_t FileIOStateManager::CheckOperationState(OperationType new_op,
                                                 bool should_be_open) {
   if (should_be_open) {
@@ -26,6 +35,10 @@ int32_t FileIOStateManager::CheckOperationState(OperationType new_op,
       return PP_ERROR_FAILED;
   }
 
+  new_op = GetEffectiveOperation(new_op);
+  if (new_op == OPERATION_READ_WRITE && num_pending_ops_ >= max_pending_ops_)
+    return PP_ERROR_INPROGRESS;
+
   if (pending_op_ != OPERATION_NONE &&
       (pending_op_ != new_op || pending_op_ == OPERATION_EXCLUSIVE))
     return PP_ERROR_INPROGRESS;
@@ -34,6 +47,7 @@ int32_t FileIOStateManager::CheckOperationState(OperationType new_op,
 }
 
 void FileIOStateManager::SetPendingOperation(OperationType new_op) {
+  new_op = GetEffectiveOperation(new_op);
   DCHECK(pending_op_ == OPERATION_NONE ||
          (pending_op_ != OPERATION_EXCLUSIVE && pending_op_ == new_op));
   pending_op_ = new_op;
@@ -46,4 +60,13 @@ void FileIOStateManager::SetOperationFinished() {
     pending_op_ = OPERATION_NONE;
 }
 
+FileIOStateManager::OperationType FileIOStateManager::GetEffectiveOperation(
+    OperationType op) const {
+  if (concurrent_read_write() &&
+      (op == OPERATION_READ || op == OPERATION_WRITE)) {
+    return OPERATION_READ_WRITE;
+  }
+  return op;
+}
+
 }  // namespace ppapi
@@ -33,6 +33,10 @@ class PPAPI_SHARED_EXPORT FileIOStateManager {
     // allowed.
     OPERATION_WRITE,
 
+    // With concurrent reads and writes enabled, reads and writes are both
+    // reported as this, and may be pending at the same time.
+    OPERATION_READ_WRITE,
+
     // If there is a pending operation that is neither read nor write, no
     // further async operation is allowed.
     OPERATION_EXCLUSIVE
@@ -42,6 +46,13 @@ class PPAPI_SHARED_EXPORT FileIOStateManager {
 
   void SetOpenSucceed();
 
+  // Lets up to |max_pending_ops| reads and writes be pending at the same time,
+  // in any mix. Zero restores the default, where reads and writes exclude each
+  // other but any number of either may be pending. Must be called with no
+  // operation pending.
+  void SetConcurrentReadWrite(int max_pending_ops);
+  bool concurrent_read_write() const { return max_pending_ops_ > 0; }
+
   // Called at the beginning of each operation. It is responsible to make sure
   // that state is correct. For example, some operations are only valid after
   // the file is opened, or operations might need to run exclusively.
@@ -54,7 +65,11 @@ class PPAPI_SHARED_EXPORT FileIOStateManager {
   void SetOperationFinished();
 
  private:
+  // Maps reads and writes to OPERATION_READ_WRITE when they may be concurrent.
+  OperationType GetEffectiveOperation(OperationType op) const;
+
   int num_pending_ops_;
+  int max_pending_ops_;
   OperationType pending_op_;
 
   // Set to true when the file has been successfully opened.
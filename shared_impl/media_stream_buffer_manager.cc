@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <utility>
 
 #include "base/logging.h"
@@ -14,12 +15,66 @@
 
 namespace ppapi {
 
+namespace {
+
+// The rings' positions are kept on separate cache lines so that the producer
+// and consumer don't contend for them.
+const size_t kCacheLineSize = 64;
+
+// Both sides of the rings access them with lock-free atomics, which must also
+// have the same size in NaCl and trusted code.
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "ring positions must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "ring positions must be plain integers in shared memory");
+
+size_t AlignToCacheLine(size_t size) {
+  return (size + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+}
+
+uint32_t GetRingCapacity(int32_t number_of_buffers) {
+  uint32_t capacity = 1;
+  while (capacity < static_cast<uint32_t>(number_of_buffers))
+    capacity <<= 1;
+  return capacity;
+}
+
+}  // namespace
+
+// The layout of an index ring in shared memory. Positions are free running and
+// wrap at 2^32, which the capacity divides.
+struct MediaStreamBufferManager::Ring {
+  // Written by the consumer.
+  std::atomic<uint32_t> read_position;
+  // Zero while the consumer is waiting for buffers, in which case the producer
+  // has to wake it up with an IPC message. The producer sets it back, so only
+  // one message is sent per wait.
+  std::atomic<uint32_t> consumer_awake;
+  uint8_t padding0[kCacheLineSize - 2 * sizeof(uint32_t)];
+
+  // Written by the producer.
+  std::atomic<uint32_t> write_position;
+  uint8_t padding1[kCacheLineSize - sizeof(uint32_t)];
+
+  // The buffer indices, |ring_capacity_| of them.
+  int32_t indices[1];
+
+  static size_t GetSize(uint32_t capacity) {
+    return AlignToCacheLine(offsetof(Ring, indices) +
+                            capacity * sizeof(int32_t));
+  }
+};
+
 MediaStreamBufferManager::Delegate::~Delegate() {}
 
 void MediaStreamBufferManager::Delegate::OnNewBufferEnqueued() {}
 
 MediaStreamBufferManager::MediaStreamBufferManager(Delegate* delegate)
-    : delegate_(delegate), buffer_size_(0), number_of_buffers_(0) {
+    : delegate_(delegate),
+      buffer_size_(0),
+      number_of_buffers_(0),
+      incoming_ring_(nullptr),
+      outgoing_ring_(nullptr),
+      ring_capacity_(0) {
   DCHECK(delegate_);
 }
 
@@ -30,6 +85,49 @@ bool MediaStreamBufferManager::SetBuffers(
     int32_t buffer_size,
     std::unique_ptr<base::SharedMemory> shm,
     bool enqueue_all_buffers) {
+  return SetBuffersInternal(number_of_buffers, buffer_size, std::move(shm),
+                            enqueue_all_buffers,
+                            number_of_buffers * buffer_size);
+}
+
+// static
+size_t MediaStreamBufferManager::GetSharedMemorySizeWithRings(
+    int32_t number_of_buffers,
+    int32_t buffer_size) {
+  return AlignToCacheLine(number_of_buffers * buffer_size) +
+         2 * Ring::GetSize(GetRingCapacity(number_of_buffers));
+}
+
+bool MediaStreamBufferManager::SetBuffersWithRings(
+    int32_t number_of_buffers,
+    int32_t buffer_size,
+    std::unique_ptr<base::SharedMemory> shm,
+    bool enqueue_all_buffers,
+    RingSide side) {
+  if (!SetBuffersInternal(
+          number_of_buffers, buffer_size, std::move(shm), enqueue_all_buffers,
+          GetSharedMemorySizeWithRings(number_of_buffers, buffer_size))) {
+    return false;
+  }
+
+  // The host to plugin ring comes first.
+  ring_capacity_ = GetRingCapacity(number_of_buffers);
+  uint8_t* rings = reinterpret_cast<uint8_t*>(shm_->memory()) +
+                   AlignToCacheLine(number_of_buffers * buffer_size);
+  Ring* to_plugin = reinterpret_cast<Ring*>(rings);
+  Ring* to_host =
+      reinterpret_cast<Ring*>(rings + Ring::GetSize(ring_capacity_));
+  incoming_ring_ = side == RING_SIDE_PLUGIN ? to_plugin : to_host;
+  outgoing_ring_ = side == RING_SIDE_PLUGIN ? to_host : to_plugin;
+  return true;
+}
+
+bool MediaStreamBufferManager::SetBuffersInternal(
+    int32_t number_of_buffers,
+    int32_t buffer_size,
+    std::unique_ptr<base::SharedMemory> shm,
+    bool enqueue_all_buffers,
+    size_t size) {
   DCHECK(shm);
   DCHECK_GT(number_of_buffers, 0);
   DCHECK_GT(buffer_size,
@@ -39,7 +137,10 @@ bool MediaStreamBufferManager::SetBuffers(
   number_of_buffers_ = number_of_buffers;
   buffer_size_ = buffer_size;
 
-  size_t size = number_of_buffers_ * buffer_size;
+  incoming_ring_ = nullptr;
+  outgoing_ring_ = nullptr;
+  ring_capacity_ = 0;
+
   shm_ = std::move(shm);
   if (!shm_->Map(size))
     return false;
@@ -56,7 +157,73 @@ bool MediaStreamBufferManager::SetBuffers(
   return true;
 }
 
+bool MediaStreamBufferManager::PushBufferToPeer(int32_t index,
+                                                bool* wake_up_peer) {
+  DCHECK(has_rings());
+  DCHECK_GE(index, 0);
+  DCHECK_LT(index, number_of_buffers_);
+  *wake_up_peer = false;
+  // Only this side writes |write_position|.
+  uint32_t write =
+      outgoing_ring_->write_position.load(std::memory_order_relaxed);
+  uint32_t read = outgoing_ring_->read_position.load(std::memory_order_acquire);
+  if (write - read >= ring_capacity_)
+    return false;
+  outgoing_ring_->indices[write & (ring_capacity_ - 1)] = index;
+  // Sequentially consistent, so that either the consumer sees the new entry
+  // when it rechecks the ring before waiting, or this sees that it waits.
+  outgoing_ring_->write_position.store(write + 1);
+  *wake_up_peer = outgoing_ring_->consumer_awake.exchange(1) == 0;
+  return true;
+}
+
+void MediaStreamBufferManager::OnWakeUp() {
+  if (has_rings() && DrainIncomingRing() > 0)
+    delegate_->OnNewBufferEnqueued();
+}
+
+size_t MediaStreamBufferManager::DrainIncomingRing() {
+  uint32_t read = incoming_ring_->read_position.load(std::memory_order_relaxed);
+  uint32_t write =
+      incoming_ring_->write_position.load(std::memory_order_acquire);
+  // The other side isn't trusted, so skip over anything that can't have come
+  // from a well behaved producer.
+  if (write - read > ring_capacity_) {
+    DLOG(ERROR) << "Invalid ring position";
+    incoming_ring_->read_position.store(write, std::memory_order_release);
+    return 0;
+  }
+  size_t count = 0;
+  for (; read != write; ++read) {
+    int32_t index = incoming_ring_->indices[read & (ring_capacity_ - 1)];
+    if (index < 0 || index >= number_of_buffers_) {
+      DLOG(ERROR) << "Invalid buffer index " << index;
+      continue;
+    }
+    buffer_queue_.push_back(index);
+    ++count;
+  }
+  incoming_ring_->read_position.store(read, std::memory_order_release);
+  return count;
+}
+
+void MediaStreamBufferManager::RefillFromIncomingRing() {
+  if (!has_rings() || !buffer_queue_.empty())
+    return;
+  if (DrainIncomingRing() > 0)
+    return;
+  // Out of buffers, so ask to be woken up by the next push, then check again
+  // for one that came in before the producer could see that.
+  incoming_ring_->consumer_awake.store(0);
+  // DrainIncomingRing() loads |write_position| with acquire ordering, which
+  // could otherwise be reordered before the store above.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (DrainIncomingRing() > 0)
+    incoming_ring_->consumer_awake.store(1);
+}
+
 int32_t MediaStreamBufferManager::DequeueBuffer() {
+  RefillFromIncomingRing();
   if (buffer_queue_.empty())
     return PP_ERROR_FAILED;
   int32_t buffer = buffer_queue_.front();
@@ -65,6 +232,7 @@ int32_t MediaStreamBufferManager::DequeueBuffer() {
 }
 
 std::vector<int32_t> MediaStreamBufferManager::DequeueBuffers() {
+  RefillFromIncomingRing();
   std::vector<int32_t> buffers(buffer_queue_.begin(), buffer_queue_.end());
   buffer_queue_.clear();
   return buffers;
@@ -77,7 +245,20 @@ void MediaStreamBufferManager::EnqueueBuffer(int32_t index) {
   delegate_->OnNewBufferEnqueued();
 }
 
+void MediaStreamBufferManager::EnqueueBuffers(
+    const std::vector<int32_t>& indices) {
+  if (indices.empty())
+    return;
+  for (int32_t index : indices) {
+    CHECK_GE(index, 0) << "Invalid buffer index";
+    CHECK_LT(index, number_of_buffers_) << "Invalid buffer index";
+    buffer_queue_.push_back(index);
+  }
+  delegate_->OnNewBufferEnqueued();
+}
+
 bool MediaStreamBufferManager::HasAvailableBuffer() {
+  RefillFromIncomingRing();
   return !buffer_queue_.empty();
 }
 
@@ -5,6 +5,7 @@
 #ifndef PPAPI_SHARED_IMPL_MEDIA_STREAM_BUFFER_MANAGER_H_
 #define PPAPI_SHARED_IMPL_MEDIA_STREAM_BUFFER_MANAGER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -37,6 +38,12 @@ union MediaStreamBuffer;
 //  7. The writer receives the buffer index and puts it back to the writer's
 //     free buffer queue by calling the writer's |buffer_manager_.Enqueue()|.
 //  8. Go back to step 1.
+//
+// When set up with SetBuffersWithRings(), the shared memory also holds a
+// single-producer/single-consumer ring of buffer indices in each direction, and
+// steps 3 and 6 push the index into the ring with PushBufferToPeer() instead.
+// An IPC message is then only needed to wake the other side up when it has run
+// out of buffers and is waiting for more; it calls OnWakeUp() in response.
 class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
  public:
   class PPAPI_SHARED_EXPORT Delegate {
@@ -52,6 +59,9 @@ class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
 
   ~MediaStreamBufferManager();
 
+  // Which side of the rings set up by SetBuffersWithRings() a manager is on.
+  enum RingSide { RING_SIDE_HOST, RING_SIDE_PLUGIN };
+
   int32_t number_of_buffers() const { return number_of_buffers_; }
 
   int32_t buffer_size() const { return buffer_size_; }
@@ -64,6 +74,32 @@ class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
                   std::unique_ptr<base::SharedMemory> shm,
                   bool enqueue_all_buffers);
 
+  // Returns the size of the shared memory needed by SetBuffersWithRings().
+  static size_t GetSharedMemorySizeWithRings(int32_t number_of_buffers,
+                                             int32_t buffer_size);
+
+  // Like SetBuffers(), but |shm| also holds the index rings after the buffers.
+  // It must be writable and zero filled when created. |side| tells which ring
+  // this manager consumes.
+  bool SetBuffersWithRings(int32_t number_of_buffers,
+                           int32_t buffer_size,
+                           std::unique_ptr<base::SharedMemory> shm,
+                           bool enqueue_all_buffers,
+                           RingSide side);
+
+  bool has_rings() const { return incoming_ring_ != nullptr; }
+
+  // Passes |index| to the other side through the outgoing ring. Sets
+  // |*wake_up_peer| if the other side is waiting for buffers and must be sent
+  // an IPC message to call OnWakeUp(). Returns false if the ring is full, which
+  // only happens if the other side isn't draining it; the caller should then
+  // send the index in an IPC message instead.
+  bool PushBufferToPeer(int32_t index, bool* wake_up_peer);
+
+  // Moves the buffers the other side has pushed into |buffer_queue_|, and
+  // notifies the delegate if there were any.
+  void OnWakeUp();
+
   // Dequeues a buffer from |buffer_queue_|.
   int32_t DequeueBuffer();
 
@@ -73,6 +109,9 @@ class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
   // Puts a buffer into |buffer_queue_|.
   void EnqueueBuffer(int32_t index);
 
+  // Puts several buffers into |buffer_queue_|, notifying the delegate once.
+  void EnqueueBuffers(const std::vector<int32_t>& indices);
+
   // Queries whether a buffer will be returned by DequeueBuffer().
   bool HasAvailableBuffer();
 
@@ -80,6 +119,23 @@ class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
   MediaStreamBuffer* GetBufferPointer(int32_t index);
 
  private:
+  struct Ring;
+
+  bool SetBuffersInternal(int32_t number_of_buffers,
+                          int32_t buffer_size,
+                          std::unique_ptr<base::SharedMemory> shm,
+                          bool enqueue_all_buffers,
+                          size_t size);
+
+  // Moves buffers from |incoming_ring_| into |buffer_queue_|. Returns the
+  // number of buffers moved.
+  size_t DrainIncomingRing();
+
+  // Called when |buffer_queue_| may need buffers from |incoming_ring_|. If
+  // there are none, marks this side as waiting so that the next push wakes it
+  // up.
+  void RefillFromIncomingRing();
+
   Delegate* delegate_;
 
   // A queue of buffer indices.
@@ -97,6 +153,12 @@ class PPAPI_SHARED_EXPORT MediaStreamBufferManager {
   // A memory block shared between renderer process and plugin process.
   std::unique_ptr<base::SharedMemory> shm_;
 
+  // The rings in |shm_|, if it has them. |ring_capacity_| is the number of
+  // entries in each, a power of two.
+  Ring* incoming_ring_;
+  Ring* outgoing_ring_;
+  uint32_t ring_capacity_;
+
   DISALLOW_COPY_AND_ASSIGN(MediaStreamBufferManager);
 };
 
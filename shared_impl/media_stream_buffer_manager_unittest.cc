@@ -180,4 +180,81 @@ TEST(MediaStreamBufferManager, ResetBuffers) {
   }
 }
 
+TEST(MediaStreamBufferManager, Rings) {
+  const int32_t kNumberOfBuffers = 5;
+  const int32_t kBufferSize = 128;
+  std::unique_ptr<SharedMemory> host_memory(new SharedMemory());
+  SharedMemoryCreateOptions options;
+  options.size = MediaStreamBufferManager::GetSharedMemorySizeWithRings(
+      kNumberOfBuffers, kBufferSize);
+  options.executable = false;
+  ASSERT_TRUE(host_memory->Create(options));
+  std::unique_ptr<SharedMemory> plugin_memory(
+      new SharedMemory(host_memory->handle().Duplicate(), false));
+
+  // The host writes buffers for the plugin to read.
+  MockDelegate host_delegate;
+  MediaStreamBufferManager host(&host_delegate);
+  ASSERT_TRUE(host.SetBuffersWithRings(
+      kNumberOfBuffers, kBufferSize, std::move(host_memory), true,
+      MediaStreamBufferManager::RING_SIDE_HOST));
+  MockDelegate plugin_delegate;
+  MediaStreamBufferManager plugin(&plugin_delegate);
+  ASSERT_TRUE(plugin.SetBuffersWithRings(
+      kNumberOfBuffers, kBufferSize, std::move(plugin_memory), false,
+      MediaStreamBufferManager::RING_SIDE_PLUGIN));
+  EXPECT_TRUE(plugin.has_rings());
+  EXPECT_FALSE(plugin.HasAvailableBuffer());
+
+  // The plugin is waiting, so the first push wakes it up and the following
+  // ones don't.
+  bool wake_up = false;
+  EXPECT_TRUE(host.PushBufferToPeer(host.DequeueBuffer(), &wake_up));
+  EXPECT_TRUE(wake_up);
+  EXPECT_TRUE(host.PushBufferToPeer(host.DequeueBuffer(), &wake_up));
+  EXPECT_FALSE(wake_up);
+  plugin.OnWakeUp();
+  EXPECT_EQ(1, plugin_delegate.new_buffer_enqueue_counter_);
+  EXPECT_TRUE(host.PushBufferToPeer(host.DequeueBuffer(), &wake_up));
+  EXPECT_FALSE(wake_up);
+
+  // Buffers pushed while the plugin was awake are picked up without a wakeup.
+  EXPECT_EQ(0, plugin.DequeueBuffer());
+  EXPECT_EQ(1, plugin.DequeueBuffer());
+  EXPECT_EQ(2, plugin.DequeueBuffer());
+  EXPECT_EQ(PP_ERROR_FAILED, plugin.DequeueBuffer());
+
+  // And once the plugin has run out, it needs waking up again.
+  EXPECT_TRUE(host.PushBufferToPeer(host.DequeueBuffer(), &wake_up));
+  EXPECT_TRUE(wake_up);
+  EXPECT_EQ(3, plugin.DequeueBuffer());
+
+  // The other ring returns buffers to the host the same way. Zero filled
+  // memory starts with both sides waiting.
+  EXPECT_TRUE(plugin.PushBufferToPeer(0, &wake_up));
+  EXPECT_TRUE(wake_up);
+  host.OnWakeUp();
+  EXPECT_EQ(1, host_delegate.new_buffer_enqueue_counter_);
+  EXPECT_EQ(4, host.DequeueBuffer());
+  EXPECT_EQ(0, host.DequeueBuffer());
+  EXPECT_EQ(PP_ERROR_FAILED, host.DequeueBuffer());
+  EXPECT_TRUE(plugin.PushBufferToPeer(1, &wake_up));
+  EXPECT_TRUE(wake_up);
+  EXPECT_EQ(1, host.DequeueBuffer());
+
+  // Batches are enqueued with a single notification.
+  plugin.EnqueueBuffers(std::vector<int32_t>{4, 2});
+  EXPECT_EQ(2, plugin_delegate.new_buffer_enqueue_counter_);
+  EXPECT_EQ(4, plugin.DequeueBuffer());
+  EXPECT_EQ(2, plugin.DequeueBuffer());
+
+  // Managers set up without rings don't have them.
+  MediaStreamBufferManager no_rings(&plugin_delegate);
+  ASSERT_TRUE(no_rings.SetBuffers(kNumberOfBuffers, kBufferSize,
+                                  CreateSharedMemory(kBufferSize,
+                                                     kNumberOfBuffers),
+                                  true));
+  EXPECT_FALSE(no_rings.has_rings());
+}
+
 }  // namespace ppapi
@@ -62,6 +62,10 @@ void PpapiGlobals::ResetMainThreadMessageLoopForTesting() {
   main_task_runner_ = base::ThreadTaskRunnerHandle::Get();
 }
 
+base::TaskRunner* PpapiGlobals::GetParallelFileTaskRunner(size_t index) {
+  return GetFileTaskRunner();
+}
+
 bool PpapiGlobals::IsHostGlobals() const { return false; }
 
 bool PpapiGlobals::IsPluginGlobals() const { return false; }
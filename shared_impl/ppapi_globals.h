@@ -117,6 +117,12 @@ class PPAPI_SHARED_EXPORT PpapiGlobals {
   // in-process plugins.
   virtual base::TaskRunner* GetFileTaskRunner() = 0;
 
+  // Returns one of a small set of task runners for file operations that may
+  // block and may run in parallel with each other, picked by |index| modulo
+  // the size of the set. The default implementation has only one, the file
+  // task runner.
+  virtual base::TaskRunner* GetParallelFileTaskRunner(size_t index);
+
   // Returns the command line for the process.
   virtual std::string GetCmdLine() = 0;
 
@@ -9,4 +9,9 @@ namespace switches {
 // Enables the testing interface for PPAPI.
 const char kEnablePepperTesting[] = "enable-pepper-testing";
 
+// Records ProxyLock wait and hold times in the plugin process. See
+// ppapi::ProxyLock::EnableInstrumentation.
+const char kEnableProxyLockInstrumentation[] =
+    "enable-pepper-proxy-lock-instrumentation";
+
 }  // namespace switches
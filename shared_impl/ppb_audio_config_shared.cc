@@ -24,7 +24,8 @@ PPB_AudioConfig_Shared::PPB_AudioConfig_Shared(ResourceObjectType type,
                                                PP_Instance instance)
     : Resource(type, instance),
       sample_rate_(PP_AUDIOSAMPLERATE_NONE),
-      sample_frame_count_(0) {}
+      sample_frame_count_(0),
+      sample_format_(PP_AUDIOSAMPLEFORMAT_DEV_INT16) {}
 
 PPB_AudioConfig_Shared::~PPB_AudioConfig_Shared() {}
 
@@ -32,9 +33,19 @@ PP_Resource PPB_AudioConfig_Shared::Create(ResourceObjectType type,
                                            PP_Instance instance,
                                            PP_AudioSampleRate sample_rate,
                                            uint32_t sample_frame_count) {
+  return Create(type, instance, sample_rate, sample_frame_count,
+                PP_AUDIOSAMPLEFORMAT_DEV_INT16);
+}
+
+PP_Resource PPB_AudioConfig_Shared::Create(
+    ResourceObjectType type,
+    PP_Instance instance,
+    PP_AudioSampleRate sample_rate,
+    uint32_t sample_frame_count,
+    PP_AudioSampleFormat_Dev sample_format) {
   scoped_refptr<PPB_AudioConfig_Shared> object(
       new PPB_AudioConfig_Shared(type, instance));
-  if (!object->Init(sample_rate, sample_frame_count))
+  if (!object->Init(sample_rate, sample_frame_count, sample_format))
     return 0;
   return object->GetReference();
 }
@@ -157,8 +168,13 @@ uint32_t PPB_AudioConfig_Shared::GetSampleFrameCount() {
   return sample_frame_count_;
 }
 
+PP_AudioSampleFormat_Dev PPB_AudioConfig_Shared::GetSampleFormat() {
+  return sample_format_;
+}
+
 bool PPB_AudioConfig_Shared::Init(PP_AudioSampleRate sample_rate,
-                                  uint32_t sample_frame_count) {
+                                  uint32_t sample_frame_count,
+                                  PP_AudioSampleFormat_Dev sample_format) {
   // TODO(brettw): Currently we don't actually check what the hardware
   // supports, so just allow sample rates of the "guaranteed working" ones.
   // TODO(dalecurtis): If sample rates are added RecommendSampleFrameCount_1_1()
@@ -173,8 +189,13 @@ bool PPB_AudioConfig_Shared::Init(PP_AudioSampleRate sample_rate,
       sample_frame_count < PP_AUDIOMINSAMPLEFRAMECOUNT)
     return false;
 
+  if (sample_format != PP_AUDIOSAMPLEFORMAT_DEV_INT16 &&
+      sample_format != PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32)
+    return false;
+
   sample_rate_ = sample_rate;
   sample_frame_count_ = sample_frame_count;
+  sample_format_ = sample_format;
   return true;
 }
 
@@ -32,6 +32,11 @@ class PPAPI_SHARED_EXPORT PPB_AudioConfig_Shared
                             PP_Instance instance,
                             PP_AudioSampleRate sample_rate,
                             uint32_t sample_frame_count);
+  static PP_Resource Create(ResourceObjectType type,
+                            PP_Instance instance,
+                            PP_AudioSampleRate sample_rate,
+                            uint32_t sample_frame_count,
+                            PP_AudioSampleFormat_Dev sample_format);
   static uint32_t RecommendSampleFrameCount_1_0(
       PP_AudioSampleRate sample_rate,
       uint32_t request_sample_frame_count);
@@ -47,6 +52,7 @@ class PPAPI_SHARED_EXPORT PPB_AudioConfig_Shared
   // PPB_AudioConfig_API implementation.
   PP_AudioSampleRate GetSampleRate() override;
   uint32_t GetSampleFrameCount() override;
+  PP_AudioSampleFormat_Dev GetSampleFormat() override;
 
  private:
   // You must call Init before using this object.
@@ -54,10 +60,13 @@ class PPAPI_SHARED_EXPORT PPB_AudioConfig_Shared
 
   // Returns false if the arguments are invalid, the object should not be
   // used in this case.
-  bool Init(PP_AudioSampleRate sample_rate, uint32_t sample_frame_count);
+  bool Init(PP_AudioSampleRate sample_rate,
+            uint32_t sample_frame_count,
+            PP_AudioSampleFormat_Dev sample_format);
 
   PP_AudioSampleRate sample_rate_;
   uint32_t sample_frame_count_;
+  PP_AudioSampleFormat_Dev sample_format_;
 
   DISALLOW_COPY_AND_ASSIGN(PPB_AudioConfig_Shared);
 };
@@ -7,9 +7,13 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "base/threading/platform_thread.h"
 #include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
 #include "media/base/audio_parameters.h"
+#include "ppapi/c/pp_errors.h"
 #include "ppapi/nacl_irt/public/irt_ppapi.h"
+#include "ppapi/shared_impl/audio_sample_conversion.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 #include "ppapi/shared_impl/ppb_audio_config_shared.h"
 #include "ppapi/shared_impl/proxy_lock.h"
@@ -57,9 +61,17 @@ PPB_Audio_Shared::PPB_Audio_Shared()
       nacl_thread_id_(0),
       nacl_thread_active_(false),
       user_data_(NULL),
+      sample_format_(PP_AUDIOSAMPLEFORMAT_DEV_INT16),
       client_buffer_size_bytes_(0),
       bytes_per_second_(0),
-      buffer_index_(0) {
+      buffer_index_(0),
+      requested_priority_(PP_AUDIOTHREADPRIORITY_DEV_NORMAL),
+      realtime_(false),
+      max_callback_us_(0),
+      total_callback_us_(0),
+      callback_count_(0),
+      late_callback_count_(0),
+      underrun_count_(0) {
 }
 
 PPB_Audio_Shared::~PPB_Audio_Shared() {
@@ -94,6 +106,12 @@ void PPB_Audio_Shared::SetStopPlaybackState() {
   playing_ = false;
 }
 
+void PPB_Audio_Shared::SetSampleFormat(
+    PP_AudioSampleFormat_Dev sample_format) {
+  DCHECK(!socket_.get());
+  sample_format_ = sample_format;
+}
+
 void PPB_Audio_Shared::SetStreamInfo(
     PP_Instance instance,
     base::UnsafeSharedMemoryRegion shared_memory_region,
@@ -105,7 +123,7 @@ void PPB_Audio_Shared::SetStreamInfo(
       kAudioOutputChannels, sample_frame_count);
   DCHECK_GE(shared_memory_region.GetSize(), shared_memory_size_);
   bytes_per_second_ =
-      kAudioOutputChannels * (kBitsPerAudioOutputSample / 8) * sample_rate;
+      kAudioOutputChannels * BytesPerAudioSample(sample_format_) * sample_rate;
   buffer_index_ = 0;
 
   shared_memory_ = shared_memory_region.MapAt(0, shared_memory_size_);
@@ -120,15 +138,47 @@ void PPB_Audio_Shared::SetStreamInfo(
         reinterpret_cast<media::AudioOutputBuffer*>(shared_memory_.memory());
     audio_bus_ = media::AudioBus::WrapMemory(kAudioOutputChannels,
                                              sample_frame_count, buffer->audio);
-    // Setup integer audio buffer for user audio data.
+    // Setup the interleaved buffer for user audio data.
     client_buffer_size_bytes_ = audio_bus_->frames() * audio_bus_->channels() *
-                                kBitsPerAudioOutputSample / 8;
+                                BytesPerAudioSample(sample_format_);
     client_buffer_.reset(new uint8_t[client_buffer_size_bytes_]);
   }
 
   StartThread();
 }
 
+int32_t PPB_Audio_Shared::SetThreadPriority(
+    PP_AudioThreadPriority_Dev priority) {
+  // NaCl threads are created through the IRT, which has no way to change
+  // their priority.
+  if (g_nacl_mode)
+    return PP_ERROR_NOTSUPPORTED;
+  if (priority != PP_AUDIOTHREADPRIORITY_DEV_NORMAL &&
+      priority != PP_AUDIOTHREADPRIORITY_DEV_REALTIME)
+    return PP_ERROR_BADARGUMENT;
+  requested_priority_.store(priority, std::memory_order_relaxed);
+  return PP_OK;
+}
+
+int32_t PPB_Audio_Shared::GetStats(PP_AudioStats_Dev* stats) {
+  if (!stats)
+    return PP_ERROR_BADARGUMENT;
+  stats->max_callback_duration =
+      base::TimeDelta::FromMicroseconds(
+          max_callback_us_.load(std::memory_order_relaxed))
+          .InSecondsF();
+  stats->total_callback_duration =
+      base::TimeDelta::FromMicroseconds(
+          total_callback_us_.load(std::memory_order_relaxed))
+          .InSecondsF();
+  stats->callback_count = callback_count_.load(std::memory_order_relaxed);
+  stats->late_callback_count =
+      late_callback_count_.load(std::memory_order_relaxed);
+  stats->underrun_count = underrun_count_.load(std::memory_order_relaxed);
+  stats->realtime = PP_FromBool(realtime_.load(std::memory_order_relaxed));
+  return PP_OK;
+}
+
 void PPB_Audio_Shared::StartThread() {
   // Don't start the thread unless all our state is set up correctly.
   if (!playing_ || !callback_.IsValid() || !socket_.get() ||
@@ -214,6 +264,13 @@ void PPB_Audio_Shared::CallRun(void* self) {
 }
 
 void PPB_Audio_Shared::Run() {
+  // Each thread starts out at normal priority, whatever the previous one had.
+  PP_AudioThreadPriority_Dev applied_priority =
+      PP_AUDIOTHREADPRIORITY_DEV_NORMAL;
+  realtime_.store(false, std::memory_order_relaxed);
+  const base::TimeDelta period = base::TimeDelta::FromSecondsD(
+      static_cast<double>(client_buffer_size_bytes_) / bytes_per_second_);
+
   int control_signal = 0;
   while (sizeof(control_signal) ==
          socket_->Receive(&control_signal, sizeof(control_signal))) {
@@ -223,21 +280,28 @@ void PPB_Audio_Shared::Run() {
     if (control_signal < 0)
       break;
 
+    UpdateThreadPriority(&applied_priority);
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    base::TimeDelta delay;
     {
-      TRACE_EVENT0("audio", "PPB_Audio_Shared::FireRenderCallback");
+      TRACE_EVENT1("audio", "PPB_Audio_Shared::FireRenderCallback",
+                   "buffer_index", buffer_index_);
       media::AudioOutputBuffer* buffer =
           reinterpret_cast<media::AudioOutputBuffer*>(shared_memory_.memory());
-      base::TimeDelta delay =
-          base::TimeDelta::FromMicroseconds(buffer->params.delay_us);
+      delay = base::TimeDelta::FromMicroseconds(buffer->params.delay_us);
 
       callback_.Run(client_buffer_.get(), client_buffer_size_bytes_,
                     delay.InSecondsF(), user_data_);
     }
+    base::TimeTicks callback_end = base::TimeTicks::Now();
 
     // Deinterleave the audio data into the shared memory as floats.
-    audio_bus_->FromInterleaved(client_buffer_.get(),
-                                audio_bus_->frames(),
-                                kBitsPerAudioOutputSample / 8);
+    DeinterleaveToAudioBus(client_buffer_.get(), sample_format_,
+                           audio_bus_.get());
+
+    RecordPeriod(callback_end - start, base::TimeTicks::Now() - start, delay,
+                 period);
 
     // Let the other end know which buffer we just filled.  The buffer index is
     // used to ensure the other end is getting the buffer it expects.  For more
@@ -248,4 +312,63 @@ void PPB_Audio_Shared::Run() {
   }
 }
 
+void PPB_Audio_Shared::UpdateThreadPriority(
+    PP_AudioThreadPriority_Dev* applied) {
+  auto requested = static_cast<PP_AudioThreadPriority_Dev>(
+      requested_priority_.load(std::memory_order_relaxed));
+  if (requested == *applied)
+    return;
+  *applied = requested;
+#if !defined(OS_NACL)
+  // base falls back to the highest non-realtime priority the process may use
+  // if realtime scheduling is refused, e.g. by the sandbox or rlimits.
+  base::PlatformThread::SetCurrentThreadPriority(
+      requested == PP_AUDIOTHREADPRIORITY_DEV_REALTIME
+          ? base::ThreadPriority::REALTIME_AUDIO
+          : base::ThreadPriority::NORMAL);
+  realtime_.store(base::PlatformThread::GetCurrentThreadPriority() ==
+                      base::ThreadPriority::REALTIME_AUDIO,
+                  std::memory_order_relaxed);
+#endif
+  TRACE_EVENT_INSTANT1("audio", "PPB_Audio_Shared::SetThreadPriority",
+                       TRACE_EVENT_SCOPE_THREAD, "realtime",
+                       realtime_.load(std::memory_order_relaxed));
+}
+
+void PPB_Audio_Shared::RecordPeriod(base::TimeDelta callback_duration,
+                                    base::TimeDelta fill_duration,
+                                    base::TimeDelta delay,
+                                    base::TimeDelta period) {
+  // This is the only thread that writes the statistics, so plain loads and
+  // stores are enough to update them.
+  int64_t callback_us = callback_duration.InMicroseconds();
+  if (callback_us > max_callback_us_.load(std::memory_order_relaxed))
+    max_callback_us_.store(callback_us, std::memory_order_relaxed);
+  total_callback_us_.store(
+      total_callback_us_.load(std::memory_order_relaxed) + callback_us,
+      std::memory_order_relaxed);
+  callback_count_.store(callback_count_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+
+  if (fill_duration > period) {
+    late_callback_count_.store(
+        late_callback_count_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    TRACE_EVENT_INSTANT2("audio", "PPB_Audio_Shared::LateCallback",
+                         TRACE_EVENT_SCOPE_THREAD, "buffer_index",
+                         buffer_index_, "fill_us",
+                         fill_duration.InMicroseconds());
+  }
+
+  // A zero delay means the browser doesn't know the output latency, e.g. for
+  // a fake audio sink, so nothing can be said about underruns.
+  if (!delay.is_zero() && fill_duration > delay) {
+    underrun_count_.store(underrun_count_.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+    TRACE_EVENT_INSTANT2("audio", "PPB_Audio_Shared::Underrun",
+                         TRACE_EVENT_SCOPE_THREAD, "buffer_index",
+                         buffer_index_, "delay_us", delay.InMicroseconds());
+  }
+}
+
 }  // namespace ppapi
@@ -8,13 +8,17 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 
 #include "base/macros.h"
 #include "base/memory/unsafe_shared_memory_region.h"
 #include "base/sync_socket.h"
 #include "base/threading/simple_thread.h"
+#include "base/time/time.h"
 #include "media/base/audio_bus.h"
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
+#include "ppapi/c/dev/ppb_audio_dev.h"
 #include "ppapi/c/ppb_audio.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/shared_impl/resource.h"
@@ -73,6 +77,11 @@ class PPAPI_SHARED_EXPORT PPB_Audio_Shared
   void SetStartPlaybackState();
   void SetStopPlaybackState();
 
+  // Sets the format of the samples the callback writes. Must be called before
+  // SetStreamInfo(), which sizes the client buffer from it. Defaults to
+  // PP_AUDIOSAMPLEFORMAT_DEV_INT16.
+  void SetSampleFormat(PP_AudioSampleFormat_Dev sample_format);
+
   // Sets the shared memory and socket handles. This will automatically start
   // playback if we're currently set to play.
   void SetStreamInfo(PP_Instance instance,
@@ -81,6 +90,11 @@ class PPAPI_SHARED_EXPORT PPB_Audio_Shared
                      PP_AudioSampleRate sample_rate,
                      int sample_frame_count);
 
+  // PPB_Audio_API implementation of the dev functions. The statistics are
+  // kept for the life of the object, across Start/StopPlayback.
+  int32_t SetThreadPriority(PP_AudioThreadPriority_Dev priority) override;
+  int32_t GetStats(PP_AudioStats_Dev* stats) override;
+
   // Returns whether a thread can be created on the client context.
   // In trusted plugin, this should always return true, as it uses Chrome's
   // thread library. In NaCl plugin, this returns whether SetThreadFunctions
@@ -106,6 +120,20 @@ class PPAPI_SHARED_EXPORT PPB_Audio_Shared
   // DelegateSimpleThread::Delegate implementation. Run on the audio thread.
   virtual void Run();
 
+  // Run on the audio thread before each callback. Switches the thread to
+  // |requested_priority_| if it isn't running at it already; |*applied| is
+  // the priority the thread currently has.
+  void UpdateThreadPriority(PP_AudioThreadPriority_Dev* applied);
+
+  // Run on the audio thread after each period. |callback_duration| is the time
+  // spent in the plugin's callback and |fill_duration| that plus the
+  // conversion into shared memory. |delay| is the delay the browser reported
+  // for the buffer and |period| the duration of audio in it.
+  void RecordPeriod(base::TimeDelta callback_duration,
+                    base::TimeDelta fill_duration,
+                    base::TimeDelta delay,
+                    base::TimeDelta period);
+
   // True if playing the stream.
   bool playing_;
 
@@ -137,7 +165,10 @@ class PPAPI_SHARED_EXPORT PPB_Audio_Shared
   // AudioBus for shuttling data across the shared memory.
   std::unique_ptr<media::AudioBus> audio_bus_;
 
-  // Internal buffer for client's integer audio data.
+  // Format of the samples in |client_buffer_|.
+  PP_AudioSampleFormat_Dev sample_format_;
+
+  // Internal buffer for client's interleaved audio data.
   int client_buffer_size_bytes_;
   std::unique_ptr<uint8_t[]> client_buffer_;
 
@@ -147,6 +178,20 @@ class PPAPI_SHARED_EXPORT PPB_Audio_Shared
   // Buffer index used to coordinate with the browser side audio receiver.
   uint32_t buffer_index_;
 
+  // Set on the plugin thread and applied by the audio thread, so that the
+  // audio thread's priority is only ever changed from the thread itself.
+  std::atomic<int> requested_priority_;
+
+  // Statistics returned by GetStats(). They are written by the audio thread
+  // only and read from any thread, so they are atomic but not updated
+  // together.
+  std::atomic<bool> realtime_;
+  std::atomic<int64_t> max_callback_us_;
+  std::atomic<int64_t> total_callback_us_;
+  std::atomic<uint32_t> callback_count_;
+  std::atomic<uint32_t> late_callback_count_;
+  std::atomic<uint32_t> underrun_count_;
+
   DISALLOW_COPY_AND_ASSIGN(PPB_Audio_Shared);
 };
 
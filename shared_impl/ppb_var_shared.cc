@@ -24,14 +24,24 @@ namespace {
 
 // PPB_Var methods -------------------------------------------------------------
 
+// AddRef, Release and VarToUtf8 are called at a high rate from plugin worker
+// threads, so they first try the VarTracker's fine-grained lock and only fall
+// back to the ProxyLock when an object var is involved or a Var is created or
+// destroyed.
 void AddRefVar(PP_Var var) {
+  VarTracker* tracker = PpapiGlobals::Get()->GetVarTracker();
+  if (tracker->AddRefVarWithoutProxyLock(var))
+    return;
   ProxyAutoLock lock;
-  PpapiGlobals::Get()->GetVarTracker()->AddRefVar(var);
+  tracker->AddRefVar(var);
 }
 
 void ReleaseVar(PP_Var var) {
+  VarTracker* tracker = PpapiGlobals::Get()->GetVarTracker();
+  if (tracker->ReleaseVarWithoutProxyLock(var))
+    return;
   ProxyAutoLock lock;
-  PpapiGlobals::Get()->GetVarTracker()->ReleaseVar(var);
+  tracker->ReleaseVar(var);
 }
 
 PP_Var VarFromUtf8(const char* data, uint32_t len) {
@@ -44,8 +54,8 @@ PP_Var VarFromUtf8_1_0(PP_Module /*module*/, const char* data, uint32_t len) {
 }
 
 const char* VarToUtf8(PP_Var var, uint32_t* len) {
-  ProxyAutoLock lock;
-  StringVar* str = StringVar::FromPPVar(var);
+  StringVar* str =
+      PpapiGlobals::Get()->GetVarTracker()->GetStringVarWithoutProxyLock(var);
   if (str) {
     *len = static_cast<uint32_t>(str->value().size());
     return str->value().c_str();
@@ -4,13 +4,119 @@
 
 #include "ppapi/shared_impl/proxy_lock.h"
 
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
 #include "base/lazy_instance.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
 
 namespace ppapi {
 
+namespace {
+
+// Histogram bucket i counts samples in [2^(i-1), 2^i) microseconds; bucket 0
+// counts samples under 1us and the last bucket everything above.
+const size_t kNumHistogramBuckets = 24;
+
+const char kUnknownSite[] = "(unattributed)";
+
+struct Histogram {
+  Histogram() : count(0), buckets() {}
+
+  void Add(base::TimeDelta sample) {
+    int64_t us = sample.InMicroseconds();
+    size_t bucket = 0;
+    while (us > 0 && bucket < kNumHistogramBuckets - 1) {
+      us >>= 1;
+      ++bucket;
+    }
+    ++buckets[bucket];
+    ++count;
+    total += sample;
+    max = std::max(max, sample);
+  }
+
+  std::string ToString() const {
+    std::string result;
+    for (size_t i = 0; i < kNumHistogramBuckets; ++i) {
+      if (!buckets[i])
+        continue;
+      base::StringAppendF(&result, " <%" PRId64 "us:%" PRIu64,
+                          static_cast<int64_t>(1) << i, buckets[i]);
+    }
+    return result;
+  }
+
+  uint64_t count;
+  base::TimeDelta total;
+  base::TimeDelta max;
+  uint64_t buckets[kNumHistogramBuckets];
+};
+
+struct SiteStats {
+  Histogram wait;
+  Histogram hold;
+};
+
+// Keyed by the site string's address; sites are static strings, so lookups
+// don't need to compare contents.
+typedef std::map<const char*, SiteStats> SiteStatsMap;
+
+bool g_instrumentation_enabled = false;
+
+base::LazyInstance<base::Lock>::Leaky g_stats_lock = LAZY_INSTANCE_INITIALIZER;
+base::LazyInstance<SiteStatsMap>::Leaky g_site_stats =
+    LAZY_INSTANCE_INITIALIZER;
+
+base::LazyInstance<base::ThreadLocalPointer<const char>>::Leaky
+    g_current_site = LAZY_INSTANCE_INITIALIZER;
+
+// Information about the current holder of the lock. These are protected by
+// the proxy lock itself.
+const char* g_holder_site = NULL;
+base::TimeTicks g_hold_start;
+base::TimeDelta g_holder_wait;
+
+void RecordSample(const char* site,
+                  base::TimeDelta wait,
+                  base::TimeDelta hold) {
+  // |site| has static storage, so it can be used as the event name.
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("ppapi.proxy_lock"), site,
+                       TRACE_EVENT_SCOPE_THREAD, "wait_us",
+                       wait.InMicroseconds(), "hold_us",
+                       hold.InMicroseconds());
+  base::AutoLock lock(g_stats_lock.Get());
+  SiteStats& stats = g_site_stats.Get()[site];
+  stats.wait.Add(wait);
+  stats.hold.Add(hold);
+}
+
+// Enter* objects name their site after the API type using a compiler-generated
+// function signature (see GetProxyLockSiteName in ppapi/thunk/enter.h). Reduce
+// those to just the type name for reporting.
+std::string GetSiteDisplayName(const char* site) {
+  std::string name(site);
+  size_t type_start = name.rfind("= ");
+  if (type_start == std::string::npos)
+    return name;
+  name = name.substr(type_start + 2);
+  base::TrimString(name, "]>", &name);
+  return name;
+}
+
+}  // namespace
+
 base::LazyInstance<base::Lock>::Leaky g_proxy_lock = LAZY_INSTANCE_INITIALIZER;
 
 bool g_disable_locking = false;
@@ -42,8 +148,18 @@ void ProxyLock::Acquire() {
     const bool deadlock = g_proxy_locked_on_thread.Get().Get();
     CHECK(!deadlock);
 
+    if (!g_instrumentation_enabled) {
+      lock->Acquire();
+      g_proxy_locked_on_thread.Get().Set(true);
+      return;
+    }
+
+    base::TimeTicks wait_start = base::TimeTicks::Now();
     lock->Acquire();
     g_proxy_locked_on_thread.Get().Set(true);
+    g_hold_start = base::TimeTicks::Now();
+    g_holder_wait = g_hold_start - wait_start;
+    g_holder_site = g_current_site.Get().Get();
   }
 }
 
@@ -55,8 +171,23 @@ void ProxyLock::Release() {
     const bool locked = g_proxy_locked_on_thread.Get().Get();
     CHECK(locked);
 
+    // |g_hold_start| is null if instrumentation was enabled while this thread
+    // held the lock.
+    if (!g_instrumentation_enabled || g_hold_start.is_null()) {
+      g_proxy_locked_on_thread.Get().Set(false);
+      lock->Release();
+      return;
+    }
+
+    const char* site = g_holder_site ? g_holder_site : kUnknownSite;
+    base::TimeDelta wait = g_holder_wait;
+    base::TimeDelta hold = base::TimeTicks::Now() - g_hold_start;
+    g_hold_start = base::TimeTicks();
     g_proxy_locked_on_thread.Get().Set(false);
     lock->Release();
+    // Record after releasing so that instrumentation doesn't add to the hold
+    // time of other threads.
+    RecordSample(site, wait, hold);
   }
 }
 
@@ -79,6 +210,72 @@ void ProxyLock::DisableLocking() {
   g_disable_locking = true;
 }
 
+// static
+void ProxyLock::EnableInstrumentation() {
+  g_instrumentation_enabled = true;
+}
+
+// static
+bool ProxyLock::IsInstrumentationEnabled() {
+  return g_instrumentation_enabled;
+}
+
+// static
+std::string ProxyLock::GetInstrumentationReport() {
+  if (!g_instrumentation_enabled)
+    return std::string();
+
+  // Merge entries by name; the same site string may have several addresses if
+  // it is used from more than one module.
+  std::map<std::string, SiteStats> merged;
+  {
+    base::AutoLock lock(g_stats_lock.Get());
+    for (const auto& entry : g_site_stats.Get()) {
+      SiteStats& stats = merged[GetSiteDisplayName(entry.first)];
+      for (size_t i = 0; i < kNumHistogramBuckets; ++i) {
+        stats.wait.buckets[i] += entry.second.wait.buckets[i];
+        stats.hold.buckets[i] += entry.second.hold.buckets[i];
+      }
+      stats.wait.count += entry.second.wait.count;
+      stats.wait.total += entry.second.wait.total;
+      stats.wait.max = std::max(stats.wait.max, entry.second.wait.max);
+      stats.hold.count += entry.second.hold.count;
+      stats.hold.total += entry.second.hold.total;
+      stats.hold.max = std::max(stats.hold.max, entry.second.hold.max);
+    }
+  }
+
+  std::vector<std::pair<std::string, SiteStats>> sorted(merged.begin(),
+                                                        merged.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::string, SiteStats>& a,
+               const std::pair<std::string, SiteStats>& b) {
+              return a.second.hold.total > b.second.hold.total;
+            });
+
+  std::string report;
+  for (const auto& entry : sorted) {
+    const SiteStats& stats = entry.second;
+    base::StringAppendF(
+        &report,
+        "%s: count=%" PRIu64 " hold_total=%" PRId64 "us hold_max=%" PRId64
+        "us wait_total=%" PRId64 "us wait_max=%" PRId64 "us\n",
+        entry.first.c_str(), stats.hold.count,
+        stats.hold.total.InMicroseconds(), stats.hold.max.InMicroseconds(),
+        stats.wait.total.InMicroseconds(), stats.wait.max.InMicroseconds());
+    report += "  hold:" + stats.hold.ToString() + "\n";
+    report += "  wait:" + stats.wait.ToString() + "\n";
+  }
+  return report;
+}
+
+// static
+void ProxyLock::ResetInstrumentationForTest() {
+  g_instrumentation_enabled = false;
+  base::AutoLock lock(g_stats_lock.Get());
+  g_site_stats.Get().clear();
+}
+
 ProxyLock::LockingDisablerForTest::LockingDisablerForTest() {
   // Note, we don't DCHECK that this flag isn't already set, because multiple
   // unit tests may run in succession and all set it.
@@ -89,6 +286,19 @@ ProxyLock::LockingDisablerForTest::~LockingDisablerForTest() {
   g_disable_locking_for_thread.Get().Set(false);
 }
 
+ScopedProxyLockSite::ScopedProxyLockSite(const char* site)
+    : active_(g_instrumentation_enabled && site), previous_site_(NULL) {
+  if (!active_)
+    return;
+  previous_site_ = g_current_site.Get().Get();
+  g_current_site.Get().Set(site);
+}
+
+ScopedProxyLockSite::~ScopedProxyLockSite() {
+  if (active_)
+    g_current_site.Get().Set(previous_site_);
+}
+
 void CallWhileUnlocked(const base::Closure& closure) {
   ProxyAutoUnlock lock;
   closure.Run();
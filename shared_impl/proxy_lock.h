@@ -6,6 +6,7 @@
 #define PPAPI_SHARED_IMPL_PROXY_LOCK_H_
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
@@ -29,9 +30,11 @@ namespace ppapi {
 // is normally accomplished by using an appropriate Enter RAII object at the
 // beginning of each thunk function.
 //
-// TODO(dmichael): If this turns out to be too slow and contentious, we'll want
-// to use multiple locks. E.g., one for the var tracker, one for the resource
-// tracker, etc.
+// The ResourceTracker, VarTracker and CallbackTracker additionally have their
+// own locks for their internal bookkeeping. This lets the hottest calls (e.g.,
+// PPB_Var AddRef/Release/VarToUtf8 and PPB_Core AddRefResource/
+// ReleaseResource) skip the ProxyLock entirely unless they create or destroy
+// an object. The lock order is always ProxyLock first, then the tracker lock.
 class PPAPI_SHARED_EXPORT ProxyLock {
  public:
   // Return the global ProxyLock. Normally, you should not access this
@@ -58,6 +61,24 @@ class PPAPI_SHARED_EXPORT ProxyLock {
 #endif
   }
 
+  // Opt-in instrumentation of lock contention. When enabled, Acquire() and
+  // Release() measure how long the calling thread waited for the lock and how
+  // long it then held it, attributed to the site that is current on the thread
+  // (see ScopedProxyLockSite; Enter* objects set this automatically). Samples
+  // go into per-site log2 histograms, and each hold is emitted as a trace
+  // event in the "disabled-by-default-ppapi.proxy_lock" category.
+  //
+  // Like DisableLocking, this must be called at startup, before other threads
+  // have had a chance to use the lock.
+  static void EnableInstrumentation();
+  static bool IsInstrumentationEnabled();
+
+  // Returns the collected per-site statistics as human-readable text, sorted
+  // by total hold time. Returns an empty string if instrumentation is off.
+  static std::string GetInstrumentationReport();
+  // Turns instrumentation off and drops the collected statistics.
+  static void ResetInstrumentationForTest();
+
   // We have some unit tests where one thread pretends to be the host and one
   // pretends to be the plugin. This allows the lock to do nothing on only one
   // thread to support these tests. See TwoWayTest for more information.
@@ -77,6 +98,23 @@ class PPAPI_SHARED_EXPORT ProxyLock {
   DISALLOW_IMPLICIT_CONSTRUCTORS(ProxyLock);
 };
 
+// Attributes ProxyLock instrumentation samples taken on the current thread to
+// |site| for the lifetime of this object. Sites nest; the innermost one wins.
+// |site| must have static storage duration (e.g., a string literal), and may
+// be NULL to leave the current site unchanged. This does nothing unless
+// ProxyLock::EnableInstrumentation has been called.
+class PPAPI_SHARED_EXPORT ScopedProxyLockSite {
+ public:
+  explicit ScopedProxyLockSite(const char* site);
+  ~ScopedProxyLockSite();
+
+ private:
+  bool active_;
+  const char* previous_site_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedProxyLockSite);
+};
+
 // A simple RAII class for locking the PPAPI proxy lock on entry and releasing
 // on exit. This is for simple interfaces that don't use the 'thunk' system,
 // such as PPB_Var and PPB_Core.
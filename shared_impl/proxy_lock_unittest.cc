@@ -182,4 +182,29 @@ TEST_F(PpapiProxyLockTest, Unlocking) {
   }
 }
 
+TEST_F(PpapiProxyLockTest, Instrumentation) {
+  TestGlobals globals;
+  ProxyLock::ResetInstrumentationForTest();
+  ProxyLock::EnableInstrumentation();
+
+  {
+    ScopedProxyLockSite outer_site("OuterSite");
+    ProxyAutoLock lock;
+    {
+      // Re-acquiring after the unlock is attributed to the inner site.
+      ScopedProxyLockSite inner_site("InnerSite");
+      ProxyAutoUnlock unlock;
+    }
+  }
+  {
+    ScopedProxyLockSite site("OuterSite");
+    ProxyAutoLock lock;
+  }
+
+  std::string report = ProxyLock::GetInstrumentationReport();
+  EXPECT_NE(std::string::npos, report.find("OuterSite: count=2 "));
+  EXPECT_NE(std::string::npos, report.find("InnerSite: count=1 "));
+  ProxyLock::ResetInstrumentationForTest();
+}
+
 }  // namespace ppapi
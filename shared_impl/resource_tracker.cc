@@ -45,22 +45,27 @@ void ResourceTracker::AddRefResource(PP_Resource res) {
 
   DCHECK(CanOperateOnResource(res));
 
-  ResourceMap::iterator i = live_resources_.find(res);
-  if (i == live_resources_.end())
-    return;
-
-  // Prevent overflow of refcount.
-  if (i->second.second ==
-      std::numeric_limits<ResourceAndRefCount::second_type>::max())
-    return;
+  Resource* object = NULL;
+  {
+    base::AutoLock lock(live_resources_lock_);
+    ResourceMap::iterator i = live_resources_.find(res);
+    if (i == live_resources_.end())
+      return;
+
+    // Prevent overflow of refcount.
+    if (i->second.second ==
+        std::numeric_limits<ResourceAndRefCount::second_type>::max())
+      return;
+
+    if (i->second.second == 0)
+      object = i->second.first;
+    i->second.second++;
+  }
 
   // When we go from 0 to 1 plugin ref count, keep an additional "real" ref
   // on its behalf.
-  if (i->second.second == 0)
-    i->second.first->AddRef();
-
-  i->second.second++;
-  return;
+  if (object)
+    object->AddRef();
 }
 
 void ResourceTracker::ReleaseResource(PP_Resource res) {
@@ -70,23 +75,57 @@ void ResourceTracker::ReleaseResource(PP_Resource res) {
 
   DCHECK(CanOperateOnResource(res));
 
+  Resource* object = NULL;
+  {
+    base::AutoLock lock(live_resources_lock_);
+    ResourceMap::iterator i = live_resources_.find(res);
+    if (i == live_resources_.end())
+      return;
+
+    // Prevent underflow of refcount.
+    if (i->second.second == 0)
+      return;
+
+    i->second.second--;
+    if (i->second.second != 0)
+      return;
+    object = i->second.first;
+  }
+
+  LastPluginRefWasDeleted(object);
+
+  // When we go from 1 to 0 plugin ref count, free the additional "real" ref
+  // on its behalf. THIS WILL MOST LIKELY RELEASE THE OBJECT AND REMOVE IT
+  // FROM OUR LIST.
+  object->Release();
+}
+
+bool ResourceTracker::AddRefResourceWithoutProxyLock(PP_Resource res) {
+  DCHECK(!thread_checker_ || thread_checker_->CalledOnValidThread());
+  DCHECK(CanOperateOnResource(res));
+
+  base::AutoLock lock(live_resources_lock_);
   ResourceMap::iterator i = live_resources_.find(res);
-  if (i == live_resources_.end())
-    return;
+  if (i == live_resources_.end() || i->second.second == 0 ||
+      i->second.second ==
+          std::numeric_limits<ResourceAndRefCount::second_type>::max())
+    return false;
+  i->second.second++;
+  return true;
+}
 
-  // Prevent underflow of refcount.
-  if (i->second.second == 0)
-    return;
+bool ResourceTracker::ReleaseResourceWithoutProxyLock(PP_Resource res) {
+  DCHECK(!thread_checker_ || thread_checker_->CalledOnValidThread());
+  DCHECK(CanOperateOnResource(res));
 
+  base::AutoLock lock(live_resources_lock_);
+  ResourceMap::iterator i = live_resources_.find(res);
+  // Dropping the last plugin ref notifies the Resource, which needs the
+  // ProxyLock.
+  if (i == live_resources_.end() || i->second.second <= 1)
+    return false;
   i->second.second--;
-  if (i->second.second == 0) {
-    LastPluginRefWasDeleted(i->second.first);
-
-    // When we go from 1 to 0 plugin ref count, free the additional "real" ref
-    // on its behalf. THIS WILL MOST LIKELY RELEASE THE OBJECT AND REMOVE IT
-    // FROM OUR LIST.
-    i->second.first->Release();
-  }
+  return true;
 }
 
 void ResourceTracker::DidCreateInstance(PP_Instance instance) {
@@ -122,18 +161,26 @@ void ResourceTracker::DidDeleteInstance(PP_Instance instance) {
     // the last ref to another. When we release the first one, it will release
     // the second one. So the second one will be gone when we eventually get
     // to it.
-    ResourceMap::iterator found_resource = live_resources_.find(*cur);
-    if (found_resource != live_resources_.end()) {
-      Resource* resource = found_resource->second.first;
-      if (found_resource->second.second > 0) {
-        LastPluginRefWasDeleted(resource);
+    Resource* resource = NULL;
+    {
+      // The refcount may be changed concurrently by the *WithoutProxyLock
+      // functions, so it is read and cleared under the lock, as in
+      // ReleaseResource().
+      base::AutoLock lock(live_resources_lock_);
+      ResourceMap::iterator found_resource = live_resources_.find(*cur);
+      if (found_resource != live_resources_.end() &&
+          found_resource->second.second > 0) {
+        resource = found_resource->second.first;
         found_resource->second.second = 0;
-
-        // This will most likely delete the resource object and remove it
-        // from the live_resources_ list.
-        resource->Release();
       }
     }
+    if (resource) {
+      LastPluginRefWasDeleted(resource);
+
+      // This will most likely delete the resource object and remove it
+      // from the live_resources_ list.
+      resource->Release();
+    }
 
     cur++;
   }
@@ -198,6 +245,7 @@ PP_Resource ResourceTracker::AddResource(Resource* object) {
     found->second->resources.insert(new_id);
   }
 
+  base::AutoLock lock(live_resources_lock_);
   live_resources_[new_id] = ResourceAndRefCount(object, 0);
   return new_id;
 }
@@ -208,6 +256,7 @@ void ResourceTracker::RemoveResource(Resource* object) {
   InstanceMap::iterator found = instance_map_.find(object->pp_instance());
   if (found != instance_map_.end())
     found->second->resources.erase(pp_resource);
+  base::AutoLock lock(live_resources_lock_);
   live_resources_.erase(pp_resource);
 }
 
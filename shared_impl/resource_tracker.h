@@ -13,6 +13,7 @@
 #include "base/containers/hash_tables.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
 #include "base/threading/thread_checker_impl.h"
 #include "ppapi/c/pp_instance.h"
@@ -47,6 +48,14 @@ class PPAPI_SHARED_EXPORT ResourceTracker {
   // ResourceHost.
   void ReleaseResource(PP_Resource res);
 
+  // Versions of AddRefResource and ReleaseResource which may be called without
+  // holding the ProxyLock. They only handle the case where the plugin refcount
+  // stays above zero, which doesn't touch the Resource object itself (see
+  // |live_resources_lock_|). They return false if the caller must instead
+  // take the ProxyLock and use the regular version.
+  bool AddRefResourceWithoutProxyLock(PP_Resource res);
+  bool ReleaseResourceWithoutProxyLock(PP_Resource res);
+
   // Notifies the tracker that a new instance has been created. This must be
   // called before creating any resources associated with the instance.
   void DidCreateInstance(PP_Instance instance);
@@ -123,6 +132,12 @@ class PPAPI_SHARED_EXPORT ResourceTracker {
   typedef base::hash_map<PP_Resource, ResourceAndRefCount> ResourceMap;
   ResourceMap live_resources_;
 
+  // Inserting into or erasing from |live_resources_|, and changing a plugin
+  // refcount, requires |live_resources_lock_| in addition to the ProxyLock.
+  // This lets the *WithoutProxyLock functions above run concurrently with the
+  // rest of the tracker. Never call in to a Resource while holding it.
+  base::Lock live_resources_lock_;
+
   int32_t last_resource_value_;
 
   // On the host side, we want to check that we are only called on the main
@@ -35,6 +35,9 @@ ScopedPPVar::ScopedPPVar(const ScopedPPVar& other) : var_(other.var_) {
   CallAddRef(var_);
 }
 
+ScopedPPVar::ScopedPPVar(ScopedPPVar&& other) noexcept
+    : var_(other.Release()) {}
+
 ScopedPPVar::~ScopedPPVar() { CallRelease(var_); }
 
 ScopedPPVar& ScopedPPVar::operator=(const PP_Var& v) {
@@ -44,6 +47,14 @@ ScopedPPVar& ScopedPPVar::operator=(const PP_Var& v) {
   return *this;
 }
 
+ScopedPPVar& ScopedPPVar::operator=(ScopedPPVar&& other) noexcept {
+  if (this != &other) {
+    CallRelease(var_);
+    var_ = other.Release();
+  }
+  return *this;
+}
+
 PP_Var ScopedPPVar::Release() {
   PP_Var result = var_;
   var_ = PP_MakeUndefined();
@@ -29,12 +29,17 @@ class PPAPI_SHARED_EXPORT ScopedPPVar {
   // Implicit copy constructor allowed.
   ScopedPPVar(const ScopedPPVar& other);
 
+  // Moves take over |other|'s reference without touching the var tracker, so
+  // containers can shift ScopedPPVars around without refcount traffic.
+  ScopedPPVar(ScopedPPVar&& other) noexcept;
+
   ~ScopedPPVar();
 
   ScopedPPVar& operator=(const PP_Var& r);
   ScopedPPVar& operator=(const ScopedPPVar& other) {
     return operator=(other.var_);
   }
+  ScopedPPVar& operator=(ScopedPPVar&& other) noexcept;
 
   const PP_Var& get() const { return var_; }
 
@@ -7,6 +7,10 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <memory>
+#include <utility>
+
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/shared_memory.h"
@@ -19,8 +23,13 @@ namespace ppapi {
 
 class TestVarTracker : public VarTracker {
  public:
-  TestVarTracker() : VarTracker(THREAD_SAFE) {}
-  ~TestVarTracker() override {}
+  TestVarTracker() : VarTracker(THREAD_SAFE), last_shared_memory_id_(0) {}
+  ~TestVarTracker() override {
+    for (SharedMemoryMap::iterator it = shared_memory_.begin();
+         it != shared_memory_.end(); ++it) {
+      it->second.first.Close();
+    }
+  }
   PP_Var MakeResourcePPVarFromMessage(
       PP_Instance instance,
       const IPC::Message& creation_message,
@@ -49,8 +58,41 @@ class TestVarTracker : public VarTracker {
                                       PP_Instance instance,
                                       base::SharedMemoryHandle* handle,
                                       uint32_t* size_in_bytes) override {
-    return false;
+    SharedMemoryMap::iterator found = shared_memory_.find(id);
+    if (found == shared_memory_.end())
+      return false;
+    *handle = found->second.first;
+    *size_in_bytes = found->second.second;
+    shared_memory_.erase(found);
+    return true;
+  }
+  // Acts as both sides of the proxy: the region is kept under an id like the
+  // host would, and mapped for the caller like the plugin would.
+  bool CreateSharedMemoryForTransfer(
+      PP_Instance instance,
+      uint32_t size_in_bytes,
+      std::unique_ptr<base::SharedMemory>* shm,
+      int* host_handle_id,
+      base::SharedMemoryHandle* plugin_handle) override {
+    std::unique_ptr<base::SharedMemory> region(new base::SharedMemory);
+    if (!region->CreateAndMapAnonymous(size_in_bytes))
+      return false;
+    *host_handle_id = ++last_shared_memory_id_;
+    shared_memory_[*host_handle_id] =
+        std::make_pair(region->handle().Duplicate(), size_in_bytes);
+    *shm = std::move(region);
+    *plugin_handle = base::SharedMemoryHandle();
+    return true;
   }
+
+  // The number of regions created by CreateSharedMemoryForTransfer().
+  int shared_memory_created() const { return last_shared_memory_id_; }
+
+ private:
+  typedef std::map<int, std::pair<base::SharedMemoryHandle, uint32_t>>
+      SharedMemoryMap;
+  SharedMemoryMap shared_memory_;
+  int last_shared_memory_id_;
 };
 
 // Implementation of PpapiGlobals for tests that don't need either the host- or
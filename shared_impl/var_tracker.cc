@@ -66,22 +66,30 @@ bool VarTracker::AddRefVar(int32_t var_id) {
 
   DLOG_IF(ERROR, !CheckIdType(var_id, PP_ID_TYPE_VAR))
       << var_id << " is not a PP_Var ID.";
-  VarMap::iterator found = live_vars_.find(var_id);
-  if (found == live_vars_.end()) {
-    NOTREACHED();  // Invalid var.
-    return false;
+  VarMap::iterator found;
+  {
+    base::AutoLock lock(live_vars_lock_);
+    found = live_vars_.find(var_id);
+    if (found == live_vars_.end()) {
+      NOTREACHED();  // Invalid var.
+      return false;
+    }
+
+    // Basic refcount increment.
+    if (found->second.ref_count != 0) {
+      found->second.ref_count++;
+      return true;
+    }
   }
 
+  // All live vars with no refcount should be tracked objects. Those are only
+  // touched with the ProxyLock held, so we can notify without
+  // |live_vars_lock_|.
   VarInfo& info = found->second;
-  if (info.ref_count == 0) {
-    // All live vars with no refcount should be tracked objects.
-    DCHECK(info.track_with_no_reference_count > 0);
-    DCHECK(info.var->GetType() == PP_VARTYPE_OBJECT);
-
-    TrackedObjectGettingOneRef(found);
-  }
+  DCHECK(info.track_with_no_reference_count > 0);
+  DCHECK(info.var->GetType() == PP_VARTYPE_OBJECT);
 
-  // Basic refcount increment.
+  TrackedObjectGettingOneRef(found);
   info.ref_count++;
   return true;
 }
@@ -99,33 +107,40 @@ bool VarTracker::ReleaseVar(int32_t var_id) {
 
   DLOG_IF(ERROR, !CheckIdType(var_id, PP_ID_TYPE_VAR))
       << var_id << " is not a PP_Var ID.";
-  VarMap::iterator found = live_vars_.find(var_id);
-  if (found == live_vars_.end())
-    return false;
+  // Hold a reference to the Var until it is erased so that we don't re-enter
+  // live_vars_.erase() during deletion. This is declared outside of the lock
+  // scope below so that the Var is destroyed after the lock is released.
+  // TODO(raymes): Make deletion of Vars iterative instead of recursive.
+  scoped_refptr<Var> var;
+  VarMap::iterator found;
+  {
+    base::AutoLock lock(live_vars_lock_);
+    found = live_vars_.find(var_id);
+    if (found == live_vars_.end())
+      return false;
+
+    VarInfo& info = found->second;
+    if (info.ref_count == 0) {
+      NOTREACHED() << "Releasing an object with zero ref";
+      return false;
+    }
+    info.ref_count--;
+    if (info.ref_count != 0)
+      return true;
 
-  VarInfo& info = found->second;
-  if (info.ref_count == 0) {
-    NOTREACHED() << "Releasing an object with zero ref";
-    return false;
-  }
-  info.ref_count--;
-
-  if (info.ref_count == 0) {
-    // Hold a reference to the Var until it is erased so that we don't re-enter
-    // live_vars_.erase() during deletion.
-    // TODO(raymes): Make deletion of Vars iterative instead of recursive.
-    scoped_refptr<Var> var(info.var);
-    if (var->GetType() == PP_VARTYPE_OBJECT) {
-      // Objects have special requirements and may not necessarily be released
-      // when the refcount goes to 0.
-      ObjectGettingZeroRef(found);
-    } else {
+    var = info.var;
+    if (var->GetType() != PP_VARTYPE_OBJECT) {
       // All other var types can just be released.
       DCHECK(info.track_with_no_reference_count == 0);
       var->ResetVarID();
       live_vars_.erase(found);
+      return true;
     }
   }
+
+  // Objects have special requirements and may not necessarily be released
+  // when the refcount goes to 0.
+  ObjectGettingZeroRef(found);
   return true;
 }
 
@@ -137,12 +152,56 @@ bool VarTracker::ReleaseVar(const PP_Var& var) {
   return ReleaseVar(static_cast<int32_t>(var.value.as_id));
 }
 
+bool VarTracker::AddRefVarWithoutProxyLock(const PP_Var& var) {
+  DCHECK(!thread_checker_ || thread_checker_->CalledOnValidThread());
+  if (!IsVarTypeRefcounted(var.type))
+    return true;
+  if (var.type == PP_VARTYPE_OBJECT)
+    return false;
+
+  base::AutoLock lock(live_vars_lock_);
+  VarMap::iterator found = GetLiveVar(var);
+  if (found == live_vars_.end() || found->second.ref_count == 0)
+    return false;
+  found->second.ref_count++;
+  return true;
+}
+
+bool VarTracker::ReleaseVarWithoutProxyLock(const PP_Var& var) {
+  DCHECK(!thread_checker_ || thread_checker_->CalledOnValidThread());
+  if (!IsVarTypeRefcounted(var.type))
+    return true;
+  if (var.type == PP_VARTYPE_OBJECT)
+    return false;
+
+  base::AutoLock lock(live_vars_lock_);
+  VarMap::iterator found = GetLiveVar(var);
+  // Dropping the last reference destroys the Var, which needs the ProxyLock.
+  if (found == live_vars_.end() || found->second.ref_count <= 1)
+    return false;
+  found->second.ref_count--;
+  return true;
+}
+
+StringVar* VarTracker::GetStringVarWithoutProxyLock(const PP_Var& var) {
+  DCHECK(!thread_checker_ || thread_checker_->CalledOnValidThread());
+  if (var.type != PP_VARTYPE_STRING)
+    return NULL;
+
+  base::AutoLock lock(live_vars_lock_);
+  VarMap::const_iterator found = GetLiveVar(var);
+  if (found == live_vars_.end() || !found->second.var.get())
+    return NULL;
+  return found->second.var->AsStringVar();
+}
+
 int32_t VarTracker::AddVarInternal(Var* var, AddVarRefMode mode) {
   // If the plugin manages to create millions of strings.
   if (last_var_id_ == std::numeric_limits<int32_t>::max() >> kPPIdTypeBits)
     return 0;
 
   int32_t new_id = MakeTypedId(++last_var_id_, PP_ID_TYPE_VAR);
+  base::AutoLock lock(live_vars_lock_);
   std::pair<VarMap::iterator, bool> was_inserted =
       live_vars_.insert(std::make_pair(
           new_id, VarInfo(var, mode == ADD_VAR_TAKE_ONE_REFERENCE ? 1 : 0)));
@@ -159,6 +218,7 @@ VarTracker::VarMap::iterator VarTracker::GetLiveVar(int32_t id) {
 int VarTracker::GetRefCountForObject(const PP_Var& plugin_object) {
   CheckThreadingPreconditions();
 
+  base::AutoLock lock(live_vars_lock_);
   VarMap::iterator found = GetLiveVar(plugin_object);
   if (found == live_vars_.end())
     return -1;
@@ -235,6 +295,15 @@ PP_Var VarTracker::MakeResourcePPVar(PP_Resource pp_resource) {
   return resource_var ? resource_var->GetPPVar() : PP_MakeNull();
 }
 
+bool VarTracker::CreateSharedMemoryForTransfer(
+    PP_Instance instance,
+    uint32_t size_in_bytes,
+    std::unique_ptr<base::SharedMemory>* shm,
+    int* host_handle_id,
+    base::SharedMemoryHandle* plugin_handle) {
+  return false;
+}
+
 std::vector<PP_Var> VarTracker::GetLiveVars() {
   CheckThreadingPreconditions();
 
@@ -261,7 +330,10 @@ bool VarTracker::DeleteObjectInfoIfNecessary(VarMap::iterator iter) {
   if (iter->second.ref_count != 0 ||
       iter->second.track_with_no_reference_count != 0)
     return false;  // Object still alive.
-  iter->second.var->ResetVarID();
+  // Keep the Var alive until |live_vars_lock_| is released.
+  scoped_refptr<Var> var(iter->second.var);
+  var->ResetVarID();
+  base::AutoLock lock(live_vars_lock_);
   live_vars_.erase(iter);
   return true;
 }
@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
 #include "ppapi/c/pp_instance.h"
 #include "ppapi/c/pp_module.h"
@@ -75,6 +76,19 @@ class PPAPI_SHARED_EXPORT VarTracker {
   bool ReleaseVar(int32_t var_id);
   bool ReleaseVar(const PP_Var& var);
 
+  // Versions of AddRefVar, ReleaseVar and StringVar lookup which may be called
+  // without holding the ProxyLock. They only handle the common case of a
+  // non-object var whose refcount stays above zero, which touches nothing but
+  // the tracker's own bookkeeping (see |live_vars_lock_|). They return false
+  // (or NULL) if the caller must instead take the ProxyLock and use the
+  // regular version.
+  //
+  // The caller must own a reference to |var|; the returned StringVar is only
+  // valid for as long as that reference is held.
+  bool AddRefVarWithoutProxyLock(const PP_Var& var);
+  bool ReleaseVarWithoutProxyLock(const PP_Var& var);
+  StringVar* GetStringVarWithoutProxyLock(const PP_Var& var);
+
   // Create a new array buffer of size |size_in_bytes|. Return a PP_Var that
   // that references it and has an initial reference-count of 1.
   PP_Var MakeArrayBufferPPVar(uint32_t size_in_bytes);
@@ -150,6 +164,18 @@ class PPAPI_SHARED_EXPORT VarTracker {
                                               base::SharedMemoryHandle* handle,
                                               uint32_t* size_in_bytes) = 0;
 
+  // Creates a shared memory region of |size_in_bytes| that can be sent to the
+  // other side of |instance| and maps it into |shm|, without copying anything
+  // into it. On success, sets either |host_handle_id| or |plugin_handle| like
+  // ArrayBufferVar::CopyToNewShmem() does. Returns false if the region
+  // couldn't be created, which is always the case unless overridden.
+  virtual bool CreateSharedMemoryForTransfer(
+      PP_Instance instance,
+      uint32_t size_in_bytes,
+      std::unique_ptr<base::SharedMemory>* shm,
+      int* host_handle_id,
+      base::SharedMemoryHandle* plugin_handle);
+
  protected:
   struct PPAPI_SHARED_EXPORT VarInfo {
     VarInfo();
@@ -217,7 +243,13 @@ class PPAPI_SHARED_EXPORT VarTracker {
   // Overridden by the PluginVarTracker to also clean up the host info map.
   virtual bool DeleteObjectInfoIfNecessary(VarMap::iterator iter);
 
+  // Inserting into or erasing from |live_vars_|, and changing the refcount of
+  // a non-object var, requires |live_vars_lock_| in addition to the ProxyLock.
+  // This lets the *WithoutProxyLock functions above run concurrently with the
+  // rest of the tracker. Never call out of the tracker (in particular, never
+  // destroy a Var) while holding it.
   VarMap live_vars_;
+  mutable base::Lock live_vars_lock_;
 
   // Last assigned var ID.
   int32_t last_var_id_;
@@ -15,16 +15,24 @@
 #include "ppapi/cpp/compositor.h"
 #include "ppapi/cpp/compositor_layer.h"
 #include "ppapi/cpp/core.h"
+#include "ppapi/cpp/dev/audio_config_dev.h"
+#include "ppapi/cpp/dev/audio_dev.h"
 #include "ppapi/cpp/dev/buffer_dev.h"
 #include "ppapi/cpp/dev/device_ref_dev.h"
 #include "ppapi/cpp/dev/file_chooser_dev.h"
+#include "ppapi/cpp/dev/file_io_dev.h"
+#include "ppapi/cpp/dev/graphics_2d_dev.h"
 #include "ppapi/cpp/dev/ime_input_event_dev.h"
+#include "ppapi/cpp/dev/media_stream_video_track_dev.h"
 #include "ppapi/cpp/dev/memory_dev.h"
 #include "ppapi/cpp/dev/printing_dev.h"
 #include "ppapi/cpp/dev/scriptable_object_deprecated.h"
 #include "ppapi/cpp/dev/text_input_dev.h"
+#include "ppapi/cpp/dev/udp_socket_dev.h"
 #include "ppapi/cpp/dev/url_util_dev.h"
 #include "ppapi/cpp/dev/video_decoder_dev.h"
+#include "ppapi/cpp/dev/video_decoder_pipeline_dev.h"
+#include "ppapi/cpp/dev/video_encoder_stream_dev.h"
 #include "ppapi/cpp/dev/view_dev.h"
 #include "ppapi/cpp/directory_entry.h"
 #include "ppapi/cpp/file_io.h"
@@ -7,6 +7,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "ppapi/c/dev/ppb_audio_dev.h"
+#include "ppapi/c/pp_errors.h"
 #include "ppapi/c/ppb_audio.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/cpp/module.h"
@@ -103,6 +105,7 @@ TestAudio::TestAudio(TestingInstance* instance)
       test_done_(false),
       audio_interface_(NULL),
       audio_interface_1_0_(NULL),
+      audio_dev_interface_(NULL),
       audio_config_interface_(NULL),
       core_interface_(NULL) {
 }
@@ -115,6 +118,8 @@ bool TestAudio::Init() {
       pp::Module::Get()->GetBrowserInterface(PPB_AUDIO_INTERFACE_1_1));
   audio_interface_1_0_ = static_cast<const PPB_Audio_1_0*>(
       pp::Module::Get()->GetBrowserInterface(PPB_AUDIO_INTERFACE_1_0));
+  audio_dev_interface_ = static_cast<const PPB_Audio_Dev_0_1*>(
+      pp::Module::Get()->GetBrowserInterface(PPB_AUDIO_DEV_INTERFACE_0_1));
   audio_config_interface_ = static_cast<const PPB_AudioConfig*>(
       pp::Module::Get()->GetBrowserInterface(PPB_AUDIO_CONFIG_INTERFACE));
   core_interface_ = static_cast<const PPB_Core*>(
@@ -131,6 +136,7 @@ void TestAudio::RunTests(const std::string& filter) {
   RUN_TEST(AudioCallback2, filter);
   RUN_TEST(AudioCallback3, filter);
   RUN_TEST(AudioCallback4, filter);
+  RUN_TEST(ThreadPriorityAndStats, filter);
 
 #if defined(__native_client__)
   RUN_TEST(AudioThreadCreatorIsRequired, filter);
@@ -402,6 +408,56 @@ std::string TestAudio::TestAudioCallback4() {
   PASS();
 }
 
+std::string TestAudio::TestThreadPriorityAndStats() {
+  if (!audio_dev_interface_)
+    PASS();
+  PP_Resource ac = CreateAudioConfig(PP_AUDIOSAMPLERATE_44100, 1024);
+  ASSERT_TRUE(ac);
+  audio_callback_method_ = NULL;
+  PP_Resource audio = audio_interface_->Create(
+      instance_->pp_instance(), ac, AudioCallbackTrampoline, this);
+  core_interface_->ReleaseResource(ac);
+  ac = 0;
+
+  PP_AudioStats_Dev stats = {};
+  ASSERT_EQ(PP_OK, audio_dev_interface_->GetStats(audio, &stats));
+  ASSERT_EQ(0u, stats.callback_count);
+  ASSERT_EQ(PP_FALSE, stats.realtime);
+
+  // Whether realtime priority is granted depends on the system, so only check
+  // that the request is accepted, or refused as unsupported.
+  int32_t result = audio_dev_interface_->SetThreadPriority(
+      audio, PP_AUDIOTHREADPRIORITY_DEV_REALTIME);
+  ASSERT_TRUE(result == PP_OK || result == PP_ERROR_NOTSUPPORTED);
+
+  audio_callback_event_.Reset();
+  test_done_ = false;
+
+  audio_callback_method_ = &TestAudio::AudioCallbackTest;
+  ASSERT_TRUE(audio_interface_->StartPlayback(audio));
+
+  // Wait for the audio callback to be called.
+  audio_callback_event_.Wait();
+  ASSERT_TRUE(audio_interface_->StopPlayback(audio));
+  test_done_ = true;
+
+  // If any more audio callbacks are generated, we should crash (which is good).
+  audio_callback_method_ = NULL;
+
+  ASSERT_EQ(PP_OK, audio_dev_interface_->GetStats(audio, &stats));
+  ASSERT_GE(stats.callback_count, 1u);
+  ASSERT_GE(stats.total_callback_duration, stats.max_callback_duration);
+  ASSERT_GE(stats.callback_count, stats.late_callback_count);
+  ASSERT_GE(stats.callback_count, stats.underrun_count);
+
+  core_interface_->ReleaseResource(audio);
+
+  // Invalid resources are rejected.
+  ASSERT_EQ(PP_ERROR_BADRESOURCE, audio_dev_interface_->GetStats(0, &stats));
+
+  PASS();
+}
+
 #if defined(__native_client__)
 // Tests the behavior of the thread_create functions.
 // For PPB_Audio_Shared to work properly, the user code must call
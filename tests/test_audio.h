@@ -9,6 +9,7 @@
 
 #include <string>
 
+#include "ppapi/c/dev/ppb_audio_dev.h"
 #include "ppapi/c/ppb_audio.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/c/ppb_core.h"
@@ -31,6 +32,7 @@ class TestAudio : public TestCase {
   std::string TestAudioCallback2();
   std::string TestAudioCallback3();
   std::string TestAudioCallback4();
+  std::string TestThreadPriorityAndStats();
 
 #if defined(__native_client__)
   std::string TestAudioThreadCreatorIsRequired();
@@ -76,6 +78,7 @@ class TestAudio : public TestCase {
   // Raw C-level interfaces, set in |Init()|; do not modify them elsewhere.
   const PPB_Audio_1_1* audio_interface_;
   const PPB_Audio_1_0* audio_interface_1_0_;
+  const PPB_Audio_Dev_0_1* audio_dev_interface_;
   const PPB_AudioConfig* audio_config_interface_;
   const PPB_Core* core_interface_;
 };
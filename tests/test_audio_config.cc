@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/cpp/module.h"
 #include "ppapi/tests/testing_instance.h"
@@ -16,8 +17,11 @@ REGISTER_TEST_CASE(AudioConfig);
 bool TestAudioConfig::Init() {
   audio_config_interface_ = static_cast<const PPB_AudioConfig*>(
       pp::Module::Get()->GetBrowserInterface(PPB_AUDIO_CONFIG_INTERFACE));
+  audio_config_dev_interface_ = static_cast<const PPB_AudioConfig_Dev*>(
+      pp::Module::Get()->GetBrowserInterface(PPB_AUDIOCONFIG_DEV_INTERFACE));
   core_interface_ = static_cast<const PPB_Core*>(
       pp::Module::Get()->GetBrowserInterface(PPB_CORE_INTERFACE));
+  // The Dev interface is optional; only the float32 tests need it.
   return audio_config_interface_ && core_interface_;
 }
 
@@ -25,6 +29,7 @@ void TestAudioConfig::RunTests(const std::string& filter) {
   RUN_TEST(RecommendSampleRate, filter);
   RUN_TEST(ValidConfigs, filter);
   RUN_TEST(InvalidConfigs, filter);
+  RUN_TEST(Float32Configs, filter);
 }
 
 std::string TestAudioConfig::TestRecommendSampleRate() {
@@ -109,3 +114,41 @@ std::string TestAudioConfig::TestInvalidConfigs() {
 
   PASS();
 }
+
+std::string TestAudioConfig::TestFloat32Configs() {
+  if (!audio_config_dev_interface_)
+    PASS();
+  uint32_t frame_count = audio_config_interface_->RecommendSampleFrameCount(
+      instance_->pp_instance(), PP_AUDIOSAMPLERATE_48000, 1024);
+  PP_Resource ac = audio_config_dev_interface_->CreateStereoFloat32(
+      instance_->pp_instance(), PP_AUDIOSAMPLERATE_48000, frame_count);
+  ASSERT_TRUE(ac);
+  ASSERT_TRUE(audio_config_interface_->IsAudioConfig(ac));
+  ASSERT_EQ(PP_AUDIOSAMPLERATE_48000,
+            audio_config_interface_->GetSampleRate(ac));
+  ASSERT_EQ(frame_count, audio_config_interface_->GetSampleFrameCount(ac));
+  ASSERT_EQ(PP_AUDIOSAMPLEFORMAT_DEV_FLOAT32,
+            audio_config_dev_interface_->GetSampleFormat(ac));
+  core_interface_->ReleaseResource(ac);
+
+  // Configs from PPB_AudioConfig are 16-bit.
+  ac = audio_config_interface_->CreateStereo16Bit(
+      instance_->pp_instance(), PP_AUDIOSAMPLERATE_48000, frame_count);
+  ASSERT_TRUE(ac);
+  ASSERT_EQ(PP_AUDIOSAMPLEFORMAT_DEV_INT16,
+            audio_config_dev_interface_->GetSampleFormat(ac));
+  core_interface_->ReleaseResource(ac);
+
+  // The same limits apply as for 16-bit configs.
+  ac = audio_config_dev_interface_->CreateStereoFloat32(
+      instance_->pp_instance(), PP_AUDIOSAMPLERATE_NONE, frame_count);
+  ASSERT_EQ(0, ac);
+  ac = audio_config_dev_interface_->CreateStereoFloat32(
+      instance_->pp_instance(), PP_AUDIOSAMPLERATE_44100,
+      PP_AUDIOMAXSAMPLEFRAMECOUNT + 1u);
+  ASSERT_EQ(0, ac);
+  ASSERT_EQ(PP_AUDIOSAMPLEFORMAT_DEV_INT16,
+            audio_config_dev_interface_->GetSampleFormat(0));
+
+  PASS();
+}
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/c/ppb_core.h"
 #include "ppapi/tests/test_case.h"
@@ -23,8 +24,10 @@ class TestAudioConfig : public TestCase {
   std::string TestRecommendSampleRate();
   std::string TestValidConfigs();
   std::string TestInvalidConfigs();
+  std::string TestFloat32Configs();
 
   const PPB_AudioConfig* audio_config_interface_;
+  const PPB_AudioConfig_Dev* audio_config_dev_interface_;
   const PPB_Core* core_interface_;
 };
 
@@ -19,6 +19,7 @@
 #include "ppapi/c/ppb_file_io.h"
 #include "ppapi/c/private/pp_file_handle.h"
 #include "ppapi/c/private/ppb_testing_private.h"
+#include "ppapi/cpp/dev/file_io_dev.h"
 #include "ppapi/cpp/file_io.h"
 #include "ppapi/cpp/file_ref.h"
 #include "ppapi/cpp/file_system.h"
@@ -186,6 +187,11 @@ void TestFileIO::RunTests(const std::string& filter) {
   RUN_CALLBACK_TEST(TestFileIO, ParallelReads, filter);
   RUN_CALLBACK_TEST(TestFileIO, ParallelWrites, filter);
   RUN_CALLBACK_TEST(TestFileIO, NotAllowMixedReadWrite, filter);
+  RUN_CALLBACK_TEST(TestFileIO, ConcurrentReadWrite, filter);
+  RUN_CALLBACK_TEST(TestFileIO, AbortInPlaceRead, filter);
+  RUN_CALLBACK_TEST(TestFileIO, AbortRunningRead, filter);
+  RUN_CALLBACK_TEST(TestFileIO, MapRange, filter);
+  RUN_CALLBACK_TEST(TestFileIO, ReadWriteV, filter);
   RUN_CALLBACK_TEST(TestFileIO, RequestOSFileHandle, filter);
   RUN_CALLBACK_TEST(TestFileIO, RequestOSFileHandleWithOpenExclusive, filter);
   RUN_CALLBACK_TEST(TestFileIO, Mmap, filter);
@@ -1009,6 +1015,388 @@ std::string TestFileIO::TestNotAllowMixedReadWrite() {
   PASS();
 }
 
+std::string TestFileIO::TestConcurrentReadWrite() {
+  if (callback_type() == PP_BLOCKING) {
+    // This test does not make sense for blocking callbacks.
+    PASS();
+  }
+  if (!pp::FileIODev::IsAvailable())
+    PASS();
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+
+  pp::FileSystem file_system(instance_, PP_FILESYSTEMTYPE_LOCALTEMPORARY);
+  pp::FileRef file_ref(file_system, "/file_concurrent_read_write");
+  callback.WaitForResult(file_system.Open(1024, callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  pp::FileIO plain_file_io(instance_);
+  pp::FileIODev file_io(plain_file_io);
+  callback.WaitForResult(file_io.Open(file_ref,
+                                      PP_FILEOPENFLAG_CREATE |
+                                      PP_FILEOPENFLAG_TRUNCATE |
+                                      PP_FILEOPENFLAG_READ |
+                                      PP_FILEOPENFLAG_WRITE,
+                                      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.SetMaxPendingOperations(65));
+  ASSERT_EQ(PP_OK, file_io.SetMaxPendingOperations(4));
+
+  // A read and write may now be pending at once. The read overlaps the first
+  // write, so it must see the data written.
+  TestCompletionCallback callback_1(instance_->pp_instance(), PP_REQUIRED);
+  const char* buf_1 = "abcdefghij";
+  int32_t rv_1 = file_io.Write(0, buf_1, static_cast<int32_t>(strlen(buf_1)),
+                               callback_1.GetCallback());
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_1);
+
+  TestCompletionCallback callback_2(instance_->pp_instance(), PP_REQUIRED);
+  char buf_2[3];
+  int32_t rv_2 = file_io.Read(2, buf_2, sizeof(buf_2),
+                              callback_2.GetCallback());
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_2);
+
+  TestCompletionCallback callback_3(instance_->pp_instance(), PP_REQUIRED);
+  const char* buf_3 = "xyz";
+  int32_t rv_3 = file_io.Write(20, buf_3, static_cast<int32_t>(strlen(buf_3)),
+                               callback_3.GetCallback());
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_3);
+
+  TestCompletionCallback callback_4(instance_->pp_instance(), PP_REQUIRED);
+  char buf_4[3];
+  int32_t rv_4 = file_io.Read(4, buf_4, sizeof(buf_4),
+                              callback_4.GetCallback());
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_4);
+
+  // Cannot go over the limit, or change it while operations are pending.
+  char buf_5[3];
+  ASSERT_EQ(PP_ERROR_INPROGRESS,
+            file_io.Read(0, buf_5, sizeof(buf_5), callback.GetCallback()));
+  ASSERT_EQ(PP_ERROR_INPROGRESS, file_io.SetMaxPendingOperations(0));
+
+  callback_1.WaitForResult(rv_1);
+  CHECK_CALLBACK_BEHAVIOR(callback_1);
+  ASSERT_EQ(static_cast<int32_t>(strlen(buf_1)), callback_1.result());
+  callback_2.WaitForResult(rv_2);
+  CHECK_CALLBACK_BEHAVIOR(callback_2);
+  ASSERT_EQ(static_cast<int32_t>(sizeof(buf_2)), callback_2.result());
+  ASSERT_EQ(std::string("cde"), std::string(buf_2, sizeof(buf_2)));
+  callback_3.WaitForResult(rv_3);
+  CHECK_CALLBACK_BEHAVIOR(callback_3);
+  ASSERT_EQ(static_cast<int32_t>(strlen(buf_3)), callback_3.result());
+  callback_4.WaitForResult(rv_4);
+  CHECK_CALLBACK_BEHAVIOR(callback_4);
+  ASSERT_EQ(static_cast<int32_t>(sizeof(buf_4)), callback_4.result());
+  ASSERT_EQ(std::string("efg"), std::string(buf_4, sizeof(buf_4)));
+
+  // Back to the default, reads and writes exclude each other again.
+  ASSERT_EQ(PP_OK, file_io.SetMaxPendingOperations(0));
+  rv_1 = file_io.Write(0, buf_1, static_cast<int32_t>(strlen(buf_1)),
+                       callback_1.GetCallback());
+  ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_1);
+  ASSERT_EQ(PP_ERROR_INPROGRESS,
+            file_io.Read(0, buf_5, sizeof(buf_5), callback.GetCallback()));
+  callback_1.WaitForResult(rv_1);
+  CHECK_CALLBACK_BEHAVIOR(callback_1);
+
+  PASS();
+}
+
+std::string TestFileIO::TestMapRange() {
+  if (!pp::FileIODev::IsAvailable())
+    PASS();
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+
+  pp::FileSystem file_system(instance_, PP_FILESYSTEMTYPE_LOCALTEMPORARY);
+  pp::FileRef file_ref(file_system, "/file_map_range");
+  callback.WaitForResult(file_system.Open(1024, callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  pp::FileIO plain_file_io(instance_);
+  pp::FileIODev file_io(plain_file_io);
+  callback.WaitForResult(file_io.Open(file_ref,
+                                      PP_FILEOPENFLAG_CREATE |
+                                      PP_FILEOPENFLAG_TRUNCATE |
+                                      PP_FILEOPENFLAG_READ |
+                                      PP_FILEOPENFLAG_WRITE,
+                                      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  ASSERT_EQ(PP_OK, WriteEntireBuffer(instance_->pp_instance(), &file_io, 0,
+                                     "hello world", callback_type()));
+
+  // Map a range that doesn't start on a page boundary.
+  const void* address = NULL;
+  ASSERT_EQ(PP_OK, file_io.MapRange(6, 5, &address));
+  ASSERT_TRUE(address != NULL);
+  ASSERT_EQ(std::string("world"),
+            std::string(static_cast<const char*>(address), 5));
+
+  // Writes show through the mapping.
+  ASSERT_EQ(PP_OK, WriteEntireBuffer(instance_->pp_instance(), &file_io, 6,
+                                     "there", callback_type()));
+  ASSERT_EQ(std::string("there"),
+            std::string(static_cast<const char*>(address), 5));
+
+  ASSERT_EQ(PP_OK, file_io.UnmapRange(address));
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.UnmapRange(address));
+
+  // The range must lie within the file.
+  const void* bad_address = NULL;
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.MapRange(6, 6, &bad_address));
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.MapRange(-1, 5, &bad_address));
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.MapRange(0, 0, &bad_address));
+  ASSERT_TRUE(bad_address == NULL);
+
+  // Mappings are released when the file is closed.
+  ASSERT_EQ(PP_OK, file_io.MapRange(0, 11, &address));
+  file_io.Close();
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, file_io.UnmapRange(address));
+  ASSERT_EQ(PP_ERROR_FAILED, file_io.MapRange(0, 11, &address));
+
+  PASS();
+}
+
+std::string TestFileIO::TestAbortInPlaceRead() {
+  if (callback_type() == PP_BLOCKING) {
+    // Blocking reads can't be aborted.
+    PASS();
+  }
+  if (!pp::FileIODev::IsAvailable())
+    PASS();
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+
+  pp::FileSystem file_system(instance_, PP_FILESYSTEMTYPE_LOCALTEMPORARY);
+  pp::FileRef file_ref(file_system, "/file_abort_in_place_read");
+  callback.WaitForResult(file_system.Open(1024, callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  // Read() reads straight into the caller's buffer. Queue the read behind an
+  // overlapping write, so that it can't have started when |file_io| is
+  // destroyed, and check it never touches the buffer afterwards.
+  char buf[3] = { 0 };
+  const char* data = "abc";
+  TestCompletionCallback write_callback(instance_->pp_instance(), PP_REQUIRED);
+  TestCompletionCallback read_callback(instance_->pp_instance(), PP_REQUIRED);
+  int32_t rv_write;
+  int32_t rv_read;
+  {
+    pp::FileIO plain_file_io(instance_);
+    pp::FileIODev file_io(plain_file_io);
+    callback.WaitForResult(file_io.Open(file_ref,
+                                        PP_FILEOPENFLAG_CREATE |
+                                        PP_FILEOPENFLAG_TRUNCATE |
+                                        PP_FILEOPENFLAG_READ |
+                                        PP_FILEOPENFLAG_WRITE,
+                                        callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_EQ(PP_OK, callback.result());
+    ASSERT_EQ(PP_OK, file_io.SetMaxPendingOperations(2));
+
+    rv_write = file_io.Write(0, data, static_cast<int32_t>(strlen(data)),
+                             write_callback.GetCallback());
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_write);
+    rv_read = file_io.Read(0, buf, sizeof(buf), read_callback.GetCallback());
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_read);
+  }  // Destroy |file_io|.
+  write_callback.WaitForAbortResult(rv_write);
+  CHECK_CALLBACK_BEHAVIOR(write_callback);
+  read_callback.WaitForResult(rv_read);
+  CHECK_CALLBACK_BEHAVIOR(read_callback);
+  ASSERT_EQ(PP_ERROR_ABORTED, read_callback.result());
+
+  // Reading the file again gives the write, and the queued read behind it,
+  // time to finish.
+  pp::FileIO file_io(instance_);
+  callback.WaitForResult(file_io.Open(file_ref, PP_FILEOPENFLAG_READ,
+                                      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+  std::string read_buffer;
+  int32_t rv = ReadEntireFile(instance_->pp_instance(), &file_io, 0,
+                              &read_buffer, callback_type());
+  ASSERT_EQ(PP_OK, rv);
+  char zeros[3] = { 0 };
+  ASSERT_EQ(0, memcmp(zeros, buf, sizeof(buf)));
+
+  PASS();
+}
+
+std::string TestFileIO::TestAbortRunningRead() {
+  if (callback_type() == PP_BLOCKING) {
+    // Blocking reads can't be aborted.
+    PASS();
+  }
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+
+  pp::FileSystem file_system(instance_, PP_FILESYSTEMTYPE_LOCALTEMPORARY);
+  pp::FileRef file_ref(file_system, "/file_abort_running_read");
+  callback.WaitForResult(file_system.Open(1024, callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  // A read big enough that it is usually still running when |file_io| is
+  // destroyed right after it is issued.
+  const int32_t kFileSize = 8 * 1024 * 1024;
+  {
+    pp::FileIO file_io(instance_);
+    callback.WaitForResult(file_io.Open(file_ref,
+                                        PP_FILEOPENFLAG_CREATE |
+                                        PP_FILEOPENFLAG_TRUNCATE |
+                                        PP_FILEOPENFLAG_WRITE,
+                                        callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_EQ(PP_OK, callback.result());
+    int32_t rv = WriteEntireBuffer(instance_->pp_instance(), &file_io, 0,
+                                   std::string(kFileSize, 'a'),
+                                   callback_type());
+    ASSERT_EQ(PP_OK, rv);
+  }
+
+  std::vector<char> buf(kFileSize, 0);
+  TestCompletionCallback read_callback(instance_->pp_instance(), PP_REQUIRED);
+  int32_t rv_read;
+  {
+    pp::FileIO file_io(instance_);
+    callback.WaitForResult(file_io.Open(file_ref, PP_FILEOPENFLAG_READ,
+                                        callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_EQ(PP_OK, callback.result());
+    rv_read = file_io.Read(0, &buf[0], kFileSize,
+                           read_callback.GetCallback());
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_read);
+  }  // Destroy |file_io|.
+  read_callback.WaitForResult(rv_read);
+  CHECK_CALLBACK_BEHAVIOR(read_callback);
+  ASSERT_EQ(PP_ERROR_ABORTED, read_callback.result());
+
+  // Once the callback has run the buffer is the plugin's again. Reuse it, and
+  // check that the aborted read doesn't write into it afterwards.
+  std::fill(buf.begin(), buf.end(), 'x');
+  pp::FileIO file_io(instance_);
+  callback.WaitForResult(file_io.Open(file_ref, PP_FILEOPENFLAG_READ,
+                                      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+  std::string read_buffer;
+  int32_t rv = ReadEntireFile(instance_->pp_instance(), &file_io, 0,
+                              &read_buffer, callback_type());
+  ASSERT_EQ(PP_OK, rv);
+  ASSERT_EQ(std::string(kFileSize, 'a'), read_buffer);
+  ASSERT_EQ(std::string(kFileSize, 'x'), std::string(buf.begin(), buf.end()));
+
+  if (!pp::FileIODev::IsAvailable())
+    PASS();
+
+  // ReadV() also reads straight into the caller's segments.
+  {
+    pp::FileIO plain_file_io(instance_);
+    pp::FileIODev vectored_file_io(plain_file_io);
+    callback.WaitForResult(vectored_file_io.Open(file_ref,
+                                                 PP_FILEOPENFLAG_READ,
+                                                 callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_EQ(PP_OK, callback.result());
+    PP_FileIOSegment_Dev segments[] = {
+        {&buf[0], kFileSize / 2}, {&buf[kFileSize / 2], kFileSize / 2}};
+    rv_read = vectored_file_io.ReadV(0, segments, 2,
+                                     read_callback.GetCallback());
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING, rv_read);
+  }  // Destroy |vectored_file_io|.
+  read_callback.WaitForResult(rv_read);
+  CHECK_CALLBACK_BEHAVIOR(read_callback);
+  ASSERT_EQ(PP_ERROR_ABORTED, read_callback.result());
+
+  std::fill(buf.begin(), buf.end(), 'y');
+  read_buffer.clear();
+  rv = ReadEntireFile(instance_->pp_instance(), &file_io, 0, &read_buffer,
+                      callback_type());
+  ASSERT_EQ(PP_OK, rv);
+  ASSERT_EQ(std::string(kFileSize, 'y'), std::string(buf.begin(), buf.end()));
+
+  PASS();
+}
+
+std::string TestFileIO::TestReadWriteV() {
+  if (!pp::FileIODev::IsAvailable())
+    PASS();
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+
+  pp::FileSystem file_system(instance_, PP_FILESYSTEMTYPE_LOCALTEMPORARY);
+  pp::FileRef file_ref(file_system, "/file_read_write_v");
+  callback.WaitForResult(file_system.Open(1024, callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  pp::FileIO plain_file_io(instance_);
+  pp::FileIODev file_io(plain_file_io);
+  callback.WaitForResult(file_io.Open(file_ref,
+                                      PP_FILEOPENFLAG_CREATE |
+                                      PP_FILEOPENFLAG_TRUNCATE |
+                                      PP_FILEOPENFLAG_READ |
+                                      PP_FILEOPENFLAG_WRITE,
+                                      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_OK, callback.result());
+
+  // Write a header, payload and trailer with one call. Empty segments are
+  // allowed.
+  char header[] = "head";
+  char payload[] = "payload";
+  char trailer[] = "tail";
+  PP_FileIOSegment_Dev write_segments[] = {
+      {header, 4}, {NULL, 0}, {payload, 7}, {trailer, 4}};
+  callback.WaitForResult(file_io.WriteV(2, write_segments, 4,
+                                        callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(15, callback.result());
+
+  std::string read_buffer;
+  int32_t rv = ReadEntireFile(instance_->pp_instance(), &file_io, 0,
+                              &read_buffer, callback_type());
+  ASSERT_EQ(PP_OK, rv);
+  ASSERT_EQ(std::string("\0\0headpayloadtail", 17), read_buffer);
+
+  // Scatter the file back into segments of different sizes. The read stops
+  // at the end of the file, partway through the last segment.
+  char first[6] = {0};
+  char second[5] = {0};
+  char third[8] = {0};
+  PP_FileIOSegment_Dev read_segments[] = {
+      {first, 6}, {second, 5}, {third, 8}};
+  callback.WaitForResult(file_io.ReadV(2, read_segments, 3,
+                                       callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(15, callback.result());
+  ASSERT_EQ(std::string("headpa"), std::string(first, 6));
+  ASSERT_EQ(std::string("yload"), std::string(second, 5));
+  ASSERT_EQ(std::string("tail"), std::string(third, 4));
+
+  // Reading past the end of the file reads nothing.
+  callback.WaitForResult(file_io.ReadV(17, read_segments, 3,
+                                       callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(0, callback.result());
+
+  // Bad segment lists are rejected up front.
+  callback.WaitForResult(file_io.ReadV(0, read_segments, 0,
+                                       callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, callback.result());
+  PP_FileIOSegment_Dev negative_segment[] = {{first, -1}};
+  callback.WaitForResult(file_io.WriteV(0, negative_segment, 1,
+                                        callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, callback.result());
+
+  PASS();
+}
+
 std::string TestFileIO::TestRequestOSFileHandle() {
   TestCompletionCallback callback(instance_->pp_instance(), callback_type());
 
@@ -47,6 +47,11 @@ class TestFileIO : public TestCase {
   std::string TestParallelReads();
   std::string TestParallelWrites();
   std::string TestNotAllowMixedReadWrite();
+  std::string TestConcurrentReadWrite();
+  std::string TestAbortInPlaceRead();
+  std::string TestAbortRunningRead();
+  std::string TestMapRange();
+  std::string TestReadWriteV();
   std::string TestRequestOSFileHandle();
   std::string TestRequestOSFileHandleWithOpenExclusive();
   std::string TestMmap();
@@ -8,10 +8,12 @@
 #include <string.h>
 
 #include <set>
+#include <vector>
 
 #include "ppapi/c/pp_errors.h"
 #include "ppapi/c/ppb_graphics_2d.h"
 #include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/dev/graphics_2d_dev.h"
 #include "ppapi/cpp/graphics_2d.h"
 #include "ppapi/cpp/graphics_3d.h"
 #include "ppapi/cpp/image_data.h"
@@ -64,6 +66,7 @@ void TestGraphics2D::RunTests(const std::string& filter) {
   RUN_TEST(Describe, filter);
   RUN_TEST(Scale, filter);
   RUN_TEST_FORCEASYNC_AND_NOT(Paint, filter);
+  RUN_TEST_FORCEASYNC_AND_NOT(PaintRects, filter);
   RUN_TEST_FORCEASYNC_AND_NOT(Scroll, filter);
   RUN_TEST_FORCEASYNC_AND_NOT(Replace, filter);
   RUN_TEST_FORCEASYNC_AND_NOT(Flush, filter);
@@ -437,6 +440,43 @@ std::string TestGraphics2D::TestPaint() {
   PASS();
 }
 
+// Tests painting several parts of one image through the Dev interface.
+std::string TestGraphics2D::TestPaintRects() {
+  const int w = 16, h = 16;
+  pp::Graphics2DDev dc(pp::Graphics2D(instance_, pp::Size(w, h), false));
+  ASSERT_FALSE(dc.is_null());
+
+  const uint32_t background_color = 0xFFFFFFFF;
+  pp::ImageData background(instance_, PP_IMAGEDATAFORMAT_BGRA_PREMUL,
+                           pp::Size(w, h), false);
+  FillRectInImage(&background, pp::Rect(0, 0, w, h), background_color);
+  dc.PaintImageData(background, pp::Point(0, 0));
+  ASSERT_SUBTEST_SUCCESS(FlushAndWaitForDone(&dc));
+
+  pp::ImageData source(instance_, PP_IMAGEDATAFORMAT_BGRA_PREMUL,
+                       pp::Size(w, h), false);
+  ASSERT_FALSE(source.is_null());
+  FillImageWithGradient(&source);
+  std::vector<pp::Rect> rects;
+  rects.push_back(pp::Rect(1, 1, 3, 2));
+  rects.push_back(pp::Rect(8, 6, 4, 5));
+  dc.PaintImageDataRects(source, pp::Point(0, 0), rects);
+  ASSERT_SUBTEST_SUCCESS(FlushAndWaitForDone(&dc));
+
+  pp::ImageData readback(instance_, PP_IMAGEDATAFORMAT_BGRA_PREMUL,
+                         pp::Size(w, h), false);
+  ASSERT_FALSE(readback.is_null());
+  ASSERT_TRUE(ReadImageData(dc, &readback, pp::Point(0, 0)));
+  for (size_t i = 0; i < rects.size(); ++i)
+    ASSERT_TRUE(CompareImageRect(readback, rects[i], source, rects[i]));
+  // Only the rects were painted.
+  ASSERT_EQ(background_color, *readback.GetAddr32(pp::Point(0, 0)));
+  ASSERT_EQ(background_color, *readback.GetAddr32(pp::Point(5, 5)));
+  ASSERT_EQ(background_color, *readback.GetAddr32(pp::Point(w - 1, h - 1)));
+
+  PASS();
+}
+
 std::string TestGraphics2D::TestScroll() {
   const int w = 115, h = 117;
   pp::Graphics2D dc(instance_, pp::Size(w, h), false);
@@ -95,6 +95,7 @@ class TestGraphics2D : public TestCase {
   std::string TestDescribe();
   std::string TestScale();
   std::string TestPaint();
+  std::string TestPaintRects();
   std::string TestScroll();
   std::string TestReplace();
   std::string TestFlush();
@@ -9,8 +9,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "ppapi/c/private/ppb_testing_private.h"
 #include "ppapi/cpp/completion_callback.h"
+#include "ppapi/cpp/dev/media_stream_video_track_dev.h"
 #include "ppapi/cpp/instance.h"
 #include "ppapi/cpp/var.h"
 #include "ppapi/cpp/video_frame.h"
@@ -56,6 +59,7 @@ void TestMediaStreamVideoTrack::RunTests(const std::string& filter) {
   RUN_TEST(Create, filter);
   RUN_TEST(GetFrame, filter);
   RUN_TEST(Configure, filter);
+  RUN_TEST(GetFrames, filter);
 }
 
 void TestMediaStreamVideoTrack::HandleMessage(const pp::Var& message) {
@@ -237,3 +241,56 @@ std::string TestMediaStreamVideoTrack::TestConfigure() {
   video_track_ = pp::MediaStreamVideoTrack();
   PASS();
 }
+
+std::string TestMediaStreamVideoTrack::TestGetFrames() {
+  if (!pp::MediaStreamVideoTrackDev::IsAvailable())
+    PASS();
+
+  // Create a track.
+  instance_->EvalScript(kJSCode);
+  event_.Wait();
+  event_.Reset();
+
+  ASSERT_FALSE(video_track_.is_null());
+  pp::MediaStreamVideoTrackDev video_track_dev(video_track_);
+
+  // Get at least |kTimes| frames, in as many batches as it takes.
+  const uint32_t kMaxFrames = 4;
+  PP_TimeDelta timestamp = 0.0;
+  int32_t total_frames = 0;
+  while (total_frames < kTimes) {
+    PP_Resource resources[kMaxFrames] = {};
+    TestCompletionCallback cc(instance_->pp_instance(), false);
+    cc.WaitForResult(
+        video_track_dev.GetFrames(resources, kMaxFrames, cc.GetCallback()));
+    ASSERT_GT(cc.result(), 0);
+    ASSERT_LE(cc.result(), static_cast<int32_t>(kMaxFrames));
+
+    std::vector<pp::VideoFrame> frames;
+    for (int32_t i = 0; i < cc.result(); ++i) {
+      frames.push_back(pp::VideoFrame(pp::PASS_REF, resources[i]));
+      ASSERT_FALSE(frames.back().is_null());
+      ASSERT_GE(frames.back().GetTimestamp(), timestamp);
+      timestamp = frames.back().GetTimestamp();
+      ASSERT_TRUE(frames.back().GetDataBuffer() != NULL);
+    }
+    total_frames += cc.result();
+
+    ASSERT_EQ(PP_OK, video_track_dev.RecycleFrames(frames));
+
+    // Recycled frames should be invalidated, and can't be recycled again.
+    for (size_t i = 0; i < frames.size(); ++i) {
+      ASSERT_EQ(frames[i].GetFormat(), PP_VIDEOFRAME_FORMAT_UNKNOWN);
+      ASSERT_TRUE(frames[i].GetDataBuffer() == NULL);
+    }
+    ASSERT_EQ(PP_ERROR_BADRESOURCE, video_track_dev.RecycleFrames(frames));
+  }
+  ASSERT_EQ(PP_ERROR_BADARGUMENT,
+            video_track_dev.RecycleFrames(std::vector<pp::VideoFrame>()));
+
+  // Close the track.
+  video_track_.Close();
+  ASSERT_TRUE(video_track_.HasEnded());
+  video_track_ = pp::MediaStreamVideoTrack();
+  PASS();
+}
@@ -26,6 +26,7 @@ class TestMediaStreamVideoTrack : public TestCase {
   std::string TestCreate();
   std::string TestGetFrame();
   std::string TestConfigure();
+  std::string TestGetFrames();
 
   pp::MediaStreamVideoTrack video_track_;
 
@@ -34,6 +34,8 @@ void TestPaintAggregator::RunTests(const std::string& filter) {
   RUN_TEST(ContainedPaintEliminatedByScroll, filter);
   RUN_TEST(ContainedPaintAfterScrollTrimmedByScrollDamage, filter);
   RUN_TEST(ContainedPaintAfterScrollEliminatedByScrollDamage, filter);
+  RUN_TEST(CostCombinedInvalidation, filter);
+  RUN_TEST(CombineCheapestPaintRects, filter);
 }
 
 std::string TestPaintAggregator::TestInitialState() {
@@ -424,3 +426,50 @@ TestPaintAggregator::TestContainedPaintAfterScrollEliminatedByScrollDamage() {
   ASSERT_TRUE(expected_scroll_damage == greg.GetPendingUpdate().paint_rects[0]);
   PASS();
 }
+
+std::string TestPaintAggregator::TestCostCombinedInvalidation() {
+  pp::PaintAggregator greg;
+  greg.set_paint_rect_cost(100);
+
+  // Combining r1 and r2 paints 20 extra pixels, which is cheaper than another
+  // rect. Combining r3 with them would paint thousands.
+  pp::Rect r1(0, 0, 10, 10);
+  pp::Rect r2(12, 0, 10, 10);
+  pp::Rect r3(100, 100, 10, 10);
+
+  greg.InvalidateRect(r1);
+  greg.InvalidateRect(r2);
+  greg.InvalidateRect(r3);
+
+  ASSERT_TRUE(greg.HasPendingUpdate());
+  ASSERT_TRUE(greg.GetPendingUpdate().scroll_rect.IsEmpty());
+  ASSERT_TRUE(2U == greg.GetPendingUpdate().paint_rects.size());
+
+  ASSERT_TRUE(r1.Union(r2) == greg.GetPendingUpdate().paint_rects[0]);
+  ASSERT_TRUE(r3 == greg.GetPendingUpdate().paint_rects[1]);
+  PASS();
+}
+
+std::string TestPaintAggregator::TestCombineCheapestPaintRects() {
+  pp::PaintAggregator greg;
+  greg.set_max_paint_rects(2);
+
+  pp::Rect r1(0, 0, 10, 10);
+  pp::Rect r2(12, 0, 10, 10);
+  pp::Rect r3(100, 100, 10, 10);
+
+  greg.InvalidateRect(r1);
+  greg.InvalidateRect(r2);
+  greg.InvalidateRect(r3);
+
+  // Only the closest pair should be combined, rather than all three rects
+  // into their bounding box.
+  ASSERT_TRUE(greg.HasPendingUpdate());
+  ASSERT_TRUE(greg.GetPendingUpdate().scroll_rect.IsEmpty());
+  ASSERT_TRUE(2U == greg.GetPendingUpdate().paint_rects.size());
+
+  ASSERT_TRUE(r3 == greg.GetPendingUpdate().paint_rects[0]);
+  ASSERT_TRUE(r1.Union(r2) == greg.GetPendingUpdate().paint_rects[1]);
+  ASSERT_TRUE(r1.Union(r2).Union(r3) == greg.GetPendingUpdate().paint_bounds);
+  PASS();
+}
@@ -36,6 +36,8 @@ class TestPaintAggregator : public TestCase {
   std::string TestContainedPaintEliminatedByScroll();
   std::string TestContainedPaintAfterScrollTrimmedByScrollDamage();
   std::string TestContainedPaintAfterScrollEliminatedByScrollDamage();
+  std::string TestCostCombinedInvalidation();
+  std::string TestCombineCheapestPaintRects();
 };
 
 #endif  // PPAPI_TESTS_TEST_PAINT_AGGREGATOR_H_
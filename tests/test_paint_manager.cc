@@ -0,0 +1,149 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ppapi/tests/test_paint_manager.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "ppapi/cpp/core.h"
+#include "ppapi/cpp/graphics_2d.h"
+#include "ppapi/cpp/image_data.h"
+#include "ppapi/cpp/module.h"
+#include "ppapi/cpp/point.h"
+#include "ppapi/cpp/rect.h"
+#include "ppapi/cpp/size.h"
+#include "ppapi/tests/test_utils.h"
+#include "ppapi/tests/testing_instance.h"
+#include "ppapi/utility/graphics/paint_manager.h"
+#include "ppapi/utility/threading/lock.h"
+
+REGISTER_TEST_CASE(PaintManager);
+
+namespace {
+
+const int32_t kTileSize = 16;
+const uint32_t kTileColor = 0xFF00FF00;
+
+// Paints with either interface and signals |painted()| once the expected
+// area has been painted in tiles, or on each untiled paint.
+class PaintClient : public pp::PaintManager::Client,
+                    public pp::PaintManager::TileClient {
+ public:
+  explicit PaintClient(PP_Instance instance)
+      : painted_(instance),
+        expected_area_(0),
+        tiled_area_(0),
+        tiled_on_main_thread_(false),
+        paint_calls_(0) {}
+
+  void Reset(int32_t expected_area) {
+    pp::AutoLock lock(lock_);
+    painted_.Reset();
+    expected_area_ = expected_area;
+    tiled_area_ = 0;
+    tiles_.clear();
+  }
+
+  NestedEvent& painted() { return painted_; }
+  int paint_calls() const { return paint_calls_; }
+
+  std::vector<pp::Rect> tiles() {
+    pp::AutoLock lock(lock_);
+    return tiles_;
+  }
+
+  bool tiled_on_main_thread() {
+    pp::AutoLock lock(lock_);
+    return tiled_on_main_thread_;
+  }
+
+  // pp::PaintManager::Client implementation.
+  virtual bool OnPaint(pp::Graphics2D& graphics,
+                       const std::vector<pp::Rect>& paint_rects,
+                       const pp::Rect& paint_bounds) {
+    paint_calls_++;
+    painted_.Signal();
+    return false;
+  }
+
+  // pp::PaintManager::TileClient implementation.
+  virtual void OnPaintTile(pp::ImageData* image, const pp::Rect& tile) {
+    for (int32_t y = tile.y(); y < tile.bottom(); y++) {
+      for (int32_t x = tile.x(); x < tile.right(); x++)
+        *image->GetAddr32(pp::Point(x, y)) = kTileColor;
+    }
+
+    pp::AutoLock lock(lock_);
+    if (pp::Module::Get()->core()->IsMainThread())
+      tiled_on_main_thread_ = true;
+    tiles_.push_back(tile);
+    tiled_area_ += tile.width() * tile.height();
+    if (tiled_area_ == expected_area_)
+      painted_.Signal();
+  }
+
+ private:
+  NestedEvent painted_;
+
+  // Tiles are painted on several threads at once.
+  pp::Lock lock_;
+  int32_t expected_area_;
+  int32_t tiled_area_;
+  std::vector<pp::Rect> tiles_;
+  bool tiled_on_main_thread_;
+
+  int paint_calls_;
+};
+
+}  // namespace
+
+bool TestPaintManager::Init() {
+  return true;
+}
+
+void TestPaintManager::RunTests(const std::string& filter) {
+  RUN_TEST(TiledPainting, filter);
+}
+
+std::string TestPaintManager::TestTiledPainting() {
+  PaintClient client(instance_->pp_instance());
+  pp::PaintManager paint_manager(instance_, &client, false);
+  ASSERT_TRUE(paint_manager.EnableTiledPainting(&client, 2, kTileSize));
+
+  // Resizing paints the whole instance. The size isn't a multiple of the tile
+  // size, so the tiles on the right and bottom edges are cut short.
+  pp::Size size(40, 24);
+  client.Reset(size.GetArea());
+  paint_manager.SetSize(size);
+  client.painted().Wait();
+
+  ASSERT_EQ(0, client.paint_calls());
+  ASSERT_FALSE(client.tiled_on_main_thread());
+  std::vector<pp::Rect> tiles = client.tiles();
+  ASSERT_EQ(6U, tiles.size());
+  for (size_t i = 0; i < tiles.size(); i++) {
+    // Each tile is within one cell of the grid, and no two tiles overlap.
+    pp::Rect cell(tiles[i].x() / kTileSize * kTileSize,
+                  tiles[i].y() / kTileSize * kTileSize,
+                  kTileSize, kTileSize);
+    ASSERT_TRUE(cell.Contains(tiles[i]));
+    ASSERT_TRUE(pp::Rect(size).Contains(tiles[i]));
+    for (size_t j = 0; j < i; j++)
+      ASSERT_FALSE(tiles[i].Intersects(tiles[j]));
+  }
+
+  // Once tiled painting is disabled, the instance paints with OnPaint()
+  // again.
+  paint_manager.DisableTiledPainting();
+  client.Reset(0);
+  paint_manager.Invalidate();
+  client.painted().Wait();
+  ASSERT_EQ(1, client.paint_calls());
+  ASSERT_TRUE(client.tiles().empty());
+
+  PASS();
+}
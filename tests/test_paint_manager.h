@@ -0,0 +1,24 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PPAPI_TESTS_TEST_PAINT_MANAGER_H_
+#define PPAPI_TESTS_TEST_PAINT_MANAGER_H_
+
+#include <string>
+
+#include "ppapi/tests/test_case.h"
+
+class TestPaintManager : public TestCase {
+ public:
+  explicit TestPaintManager(TestingInstance* instance) : TestCase(instance) {}
+
+  // TestCase implementation.
+  virtual bool Init();
+  virtual void RunTests(const std::string& filter);
+
+ private:
+  std::string TestTiledPainting();
+};
+
+#endif  // PPAPI_TESTS_TEST_PAINT_MANAGER_H_
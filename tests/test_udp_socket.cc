@@ -4,8 +4,12 @@
 
 #include "ppapi/tests/test_udp_socket.h"
 
+#include <stdio.h>
+
+#include <algorithm>
 #include <vector>
 
+#include "ppapi/cpp/dev/udp_socket_dev.h"
 #include "ppapi/cpp/pass_ref.h"
 #include "ppapi/cpp/tcp_socket.h"
 #include "ppapi/cpp/udp_socket.h"
@@ -104,6 +108,8 @@ void TestUDPSocket::RunTests(const std::string& filter) {
   RUN_CALLBACK_TEST(TestUDPSocket, SetOption, filter);
   RUN_CALLBACK_TEST(TestUDPSocket, ParallelSend, filter);
   RUN_CALLBACK_TEST(TestUDPSocket, Multicast, filter);
+  RUN_CALLBACK_TEST(TestUDPSocket, RecvFromBatch, filter);
+  RUN_CALLBACK_TEST(TestUDPSocket, SendToBatch, filter);
 
   // Failure tests. Generally can only be run individually, since they require
   // specific socket failures to be injected into the UDP code.
@@ -524,6 +530,131 @@ std::string TestUDPSocket::TestMulticast() {
   PASS();
 }
 
+std::string TestUDPSocket::TestRecvFromBatch() {
+  if (!pp::UDPSocketDev::IsAvailable())
+    PASS();
+
+  pp::UDPSocketDev server_socket(instance_);
+  pp::UDPSocket client_socket(instance_);
+  pp::NetAddress server_address, client_address;
+
+  ASSERT_SUBTEST_SUCCESS(
+      LookupPortAndBindUDPSocket(&server_socket, &server_address));
+  ASSERT_SUBTEST_SUCCESS(
+      LookupPortAndBindUDPSocket(&client_socket, &client_address));
+
+  // Messages of different sizes, so that offsets are checked too.
+  const size_t kMessages = 10;
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < kMessages; ++i)
+    messages.push_back(std::string(i + 1, static_cast<char>('a' + i)));
+
+  for (size_t i = 0; i < kMessages; ++i) {
+    TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+    callback.WaitForResult(client_socket.SendTo(
+        messages[i].c_str(), static_cast<int32_t>(messages[i].size()),
+        server_address, callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_EQ(messages[i].size(), static_cast<size_t>(callback.result()));
+  }
+
+  // However the datagrams get split into batches, they must all come back in
+  // order, from the client.
+  std::vector<char> buffer(1024);
+  std::vector<PP_UDPSocket_Datagram_Dev> datagrams(kMessages);
+  size_t received = 0;
+  while (received < kMessages) {
+    TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+    callback.WaitForResult(server_socket.RecvFromBatch(
+        &buffer[0], static_cast<int32_t>(buffer.size()), &datagrams[0],
+        static_cast<uint32_t>(datagrams.size()), callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_GT(callback.result(), 0);
+    ASSERT_TRUE(received + callback.result() <= kMessages);
+    for (int32_t i = 0; i < callback.result(); ++i, ++received) {
+      const PP_UDPSocket_Datagram_Dev& datagram = datagrams[i];
+      pp::NetAddress recvfrom_address(pp::PASS_REF, datagram.addr);
+      ASSERT_TRUE(EqualNetAddress(recvfrom_address, client_address));
+      ASSERT_EQ(messages[received],
+                std::string(&buffer[datagram.offset], datagram.size));
+    }
+  }
+
+  server_socket.Close();
+  client_socket.Close();
+
+  PASS();
+}
+
+std::string TestUDPSocket::TestSendToBatch() {
+  if (!pp::UDPSocketDev::IsAvailable())
+    PASS();
+
+  pp::UDPSocket server_socket(instance_);
+  pp::UDPSocketDev client_socket(instance_);
+  pp::NetAddress server_address, client_address;
+
+  ASSERT_SUBTEST_SUCCESS(
+      LookupPortAndBindUDPSocket(&server_socket, &server_address));
+  ASSERT_SUBTEST_SUCCESS(
+      LookupPortAndBindUDPSocket(&client_socket, &client_address));
+
+  // More datagrams than there are send slots, so the batch has to wait for
+  // replies part way through.
+  const size_t kMessages = 20;
+  const size_t kMessageSize = 10;
+  std::string buffer;
+  std::vector<std::string> messages;
+  std::vector<PP_UDPSocket_Datagram_Dev> datagrams(kMessages);
+  for (size_t i = 0; i < kMessages; ++i) {
+    char message[kMessageSize + 1];
+    snprintf(message, sizeof(message), "message %02d", static_cast<int>(i));
+    messages.push_back(message);
+    datagrams[i].offset = static_cast<int32_t>(buffer.size());
+    datagrams[i].size = static_cast<int32_t>(kMessageSize);
+    datagrams[i].addr = server_address.pp_resource();
+    buffer += message;
+  }
+
+  // A batch may be cut short, so keep sending until every datagram is out.
+  TestCompletionCallback callback(instance_->pp_instance(), callback_type());
+  size_t sent = 0;
+  while (sent < kMessages) {
+    callback.WaitForResult(client_socket.SendToBatch(
+        buffer.data(), static_cast<int32_t>(buffer.size()), &datagrams[sent],
+        static_cast<uint32_t>(kMessages - sent), callback.GetCallback()));
+    CHECK_CALLBACK_BEHAVIOR(callback);
+    ASSERT_GT(callback.result(), 0);
+    sent += static_cast<size_t>(callback.result());
+  }
+  ASSERT_EQ(kMessages, sent);
+
+  std::vector<std::string> received;
+  for (size_t i = 0; i < kMessages; ++i) {
+    pp::NetAddress recvfrom_address;
+    std::string str;
+    ASSERT_SUBTEST_SUCCESS(
+        ReadSocket(&server_socket, &recvfrom_address, kMessageSize, &str));
+    ASSERT_TRUE(EqualNetAddress(recvfrom_address, client_address));
+    received.push_back(str);
+  }
+  std::sort(received.begin(), received.end());
+  ASSERT_TRUE(messages == received);
+
+  // A datagram that runs past the end of the buffer is rejected up front.
+  datagrams[0].size = static_cast<int32_t>(buffer.size()) + 1;
+  callback.WaitForResult(client_socket.SendToBatch(
+      buffer.data(), static_cast<int32_t>(buffer.size()), &datagrams[0], 1,
+      callback.GetCallback()));
+  CHECK_CALLBACK_BEHAVIOR(callback);
+  ASSERT_EQ(PP_ERROR_BADARGUMENT, callback.result());
+
+  server_socket.Close();
+  client_socket.Close();
+
+  PASS();
+}
+
 std::string TestUDPSocket::TestBindFails() {
   pp::UDPSocket socket(instance_);
 
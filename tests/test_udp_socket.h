@@ -62,6 +62,8 @@ class TestUDPSocket: public TestCase {
   std::string TestSetOption();
   std::string TestParallelSend();
   std::string TestMulticast();
+  std::string TestRecvFromBatch();
+  std::string TestSendToBatch();
 
   // Error cases. It's up to the parent test fixture to ensure that these events
   // result in errors.
@@ -261,14 +261,16 @@ void EnterBase::SetStateForFunctionError(PP_Instance pp_instance,
 }  // namespace subtle
 
 EnterInstance::EnterInstance(PP_Instance instance)
-    : EnterBase(),
+    : subtle::LockOnEntry<true>("EnterInstance"),
+      EnterBase(),
       functions_(PpapiGlobals::Get()->GetInstanceAPI(instance)) {
   SetStateForFunctionError(instance, functions_, true);
 }
 
 EnterInstance::EnterInstance(PP_Instance instance,
                              const PP_CompletionCallback& callback)
-    : EnterBase(0 /* resource */, callback),
+    : subtle::LockOnEntry<true>("EnterInstance"),
+      EnterBase(0 /* resource */, callback),
       // TODO(dmichael): This means that the callback_ we get is not associated
       //                 even with the instance, but we should handle that for
       //                 MouseLock (maybe others?).
@@ -300,7 +302,8 @@ EnterInstanceNoLock::~EnterInstanceNoLock() {
 }
 
 EnterResourceCreation::EnterResourceCreation(PP_Instance instance)
-    : EnterBase(),
+    : subtle::LockOnEntry<true>("EnterResourceCreation"),
+      EnterBase(),
       functions_(PpapiGlobals::Get()->GetResourceCreationAPI(instance)) {
   SetStateForFunctionError(instance, functions_, true);
 }
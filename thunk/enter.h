@@ -11,6 +11,7 @@
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "build/build_config.h"
 #include "ppapi/c/pp_errors.h"
 #include "ppapi/c/pp_resource.h"
 #include "ppapi/shared_impl/ppapi_globals.h"
@@ -59,11 +60,14 @@ struct LockOnEntry;
 
 template <>
 struct LockOnEntry<false> {
+  // |site| is ignored; see LockOnEntry<true>.
+  explicit LockOnEntry(const char* site = nullptr) {
 #if (!NDEBUG)
-  LockOnEntry() {
     // You must already hold the lock to use Enter*NoLock.
     ProxyLock::AssertAcquired();
+#endif
   }
+#if (!NDEBUG)
   ~LockOnEntry() {
     // You must not release the lock before leaving the scope of the
     // Enter*NoLock.
@@ -74,14 +78,33 @@ struct LockOnEntry<false> {
 
 template <>
 struct LockOnEntry<true> {
-  LockOnEntry() {
+  // |site| names the caller for ProxyLock instrumentation; see
+  // ScopedProxyLockSite. It is set before the lock is acquired and restored
+  // after it is released, since |site_| outlives the constructor and
+  // destructor bodies.
+  explicit LockOnEntry(const char* site = nullptr) : site_(site) {
     ppapi::ProxyLock::Acquire();
   }
   ~LockOnEntry() {
     ppapi::ProxyLock::Release();
   }
+
+  ScopedProxyLockSite site_;
 };
 
+// Returns a ProxyLock instrumentation site name for the Enter* objects that
+// are templatized on |ApiT|. This is a compiler-generated signature which
+// contains the name of |ApiT|; ProxyLock reduces it to just the type name when
+// reporting. Being a string literal, it is also a cheap, stable key.
+template <typename ApiT>
+const char* GetProxyLockSiteName() {
+#if defined(COMPILER_MSVC) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
 // Keep non-templatized since we need non-inline functions here.
 class PPAPI_THUNK_EXPORT EnterBase {
  public:
@@ -177,12 +200,16 @@ class EnterResource
       public subtle::EnterBase {
  public:
   EnterResource(PP_Resource resource, bool report_error)
-      : EnterBase(resource) {
+      : subtle::LockOnEntry<lock_on_entry>(
+            subtle::GetProxyLockSiteName<ResourceT>()),
+        EnterBase(resource) {
     Init(resource, report_error);
   }
   EnterResource(PP_Resource resource, const PP_CompletionCallback& callback,
                 bool report_error)
-      : EnterBase(resource, callback) {
+      : subtle::LockOnEntry<lock_on_entry>(
+            subtle::GetProxyLockSiteName<ResourceT>()),
+        EnterBase(resource, callback) {
     Init(resource, report_error);
   }
   ~EnterResource() {}
@@ -265,13 +292,17 @@ class EnterInstanceAPI
       public subtle::EnterBase {
  public:
   explicit EnterInstanceAPI(PP_Instance instance)
-      : EnterBase(instance, ApiT::kSingletonResourceID) {
+      : subtle::LockOnEntry<lock_on_entry>(
+            subtle::GetProxyLockSiteName<ApiT>()),
+        EnterBase(instance, ApiT::kSingletonResourceID) {
     if (resource_)
       functions_ = resource_->GetAs<ApiT>();
     SetStateForFunctionError(instance, functions_, true);
   }
   EnterInstanceAPI(PP_Instance instance, const PP_CompletionCallback& callback)
-      : EnterBase(instance, ApiT::kSingletonResourceID, callback) {
+      : subtle::LockOnEntry<lock_on_entry>(
+            subtle::GetProxyLockSiteName<ApiT>()),
+        EnterBase(instance, ApiT::kSingletonResourceID, callback) {
     if (resource_)
       functions_ = resource_->GetAs<ApiT>();
     SetStateForFunctionError(instance, functions_, true);
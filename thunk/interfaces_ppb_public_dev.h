@@ -10,14 +10,26 @@
 // Map the old dev console interface to the stable one (which is the same) to
 // keep Flash, etc. working.
 PROXIED_IFACE("PPB_Console(Dev);0.1", PPB_Console_1_0)
+PROXIED_IFACE(PPB_AUDIOCONFIG_DEV_INTERFACE_0_1, PPB_AudioConfig_Dev_0_1)
+PROXIED_IFACE(PPB_AUDIO_DEV_INTERFACE_0_1, PPB_Audio_Dev_0_1)
 PROXIED_IFACE(PPB_CURSOR_CONTROL_DEV_INTERFACE_0_4, PPB_CursorControl_Dev_0_4)
 PROXIED_IFACE(PPB_FILECHOOSER_DEV_INTERFACE_0_5, PPB_FileChooser_Dev_0_5)
 PROXIED_IFACE(PPB_FILECHOOSER_DEV_INTERFACE_0_6, PPB_FileChooser_Dev_0_6)
+PROXIED_IFACE(PPB_FILEIO_DEV_INTERFACE_0_1, PPB_FileIO_Dev_0_1)
+PROXIED_IFACE(PPB_GRAPHICS2D_DEV_INTERFACE_0_1, PPB_Graphics2D_Dev_0_1)
+PROXIED_IFACE(PPB_IMAGEDATA_DEV_INTERFACE_0_1, PPB_ImageData_Dev_0_1)
 PROXIED_IFACE(PPB_IME_INPUT_EVENT_DEV_INTERFACE_0_2, PPB_IMEInputEvent_Dev_0_2)
+PROXIED_IFACE(PPB_MEDIASTREAMVIDEOTRACK_DEV_INTERFACE_0_1,
+              PPB_MediaStreamVideoTrack_Dev_0_1)
 PROXIED_IFACE(PPB_MEMORY_DEV_INTERFACE_0_1, PPB_Memory_Dev_0_1)
 PROXIED_IFACE(PPB_PRINTING_DEV_INTERFACE_0_7, PPB_Printing_Dev_0_7)
 PROXIED_IFACE(PPB_TEXTINPUT_DEV_INTERFACE_0_2, PPB_TextInput_Dev_0_2)
 PROXIED_IFACE(PPB_TRUETYPEFONT_DEV_INTERFACE_0_1, PPB_TrueTypeFont_Dev_0_1)
+PROXIED_IFACE(PPB_UDPSOCKET_DEV_INTERFACE_0_1, PPB_UDPSocket_Dev_0_1)
+PROXIED_IFACE(PPB_VIDEODECODERPIPELINE_DEV_INTERFACE_0_1,
+              PPB_VideoDecoderPipeline_Dev_0_1)
+PROXIED_IFACE(PPB_VIDEOENCODERSTREAM_DEV_INTERFACE_0_1,
+              PPB_VideoEncoderStream_Dev_0_1)
 PROXIED_IFACE(PPB_VIEW_DEV_INTERFACE_0_1, PPB_View_Dev_0_1)
 
 #if !defined(OS_NACL)
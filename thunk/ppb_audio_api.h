@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/memory/ref_counted.h"
+#include "ppapi/c/dev/ppb_audio_dev.h"
 #include "ppapi/c/pp_completion_callback.h"
 #include "ppapi/c/ppb_audio.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
@@ -30,6 +31,10 @@ class PPAPI_THUNK_EXPORT PPB_Audio_API {
   virtual PP_Bool StartPlayback() = 0;
   virtual PP_Bool StopPlayback() = 0;
 
+  // Dev API.
+  virtual int32_t SetThreadPriority(PP_AudioThreadPriority_Dev priority) = 0;
+  virtual int32_t GetStats(PP_AudioStats_Dev* stats) = 0;
+
   // Trusted API.
   virtual int32_t Open(
       PP_Resource config_id,
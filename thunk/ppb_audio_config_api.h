@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
 #include "ppapi/c/ppb_audio_config.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
 
@@ -19,6 +20,10 @@ class PPAPI_THUNK_EXPORT PPB_AudioConfig_API {
 
   virtual PP_AudioSampleRate GetSampleRate() = 0;
   virtual uint32_t GetSampleFrameCount() = 0;
+  // Configs that can't hold float32 samples are always 16-bit.
+  virtual PP_AudioSampleFormat_Dev GetSampleFormat() {
+    return PP_AUDIOSAMPLEFORMAT_DEV_INT16;
+  }
 };
 
 }  // namespace thunk
@@ -0,0 +1,51 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_audio_config_dev.idl modified Thu May 17 10:21:36 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_audio_config_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+PP_Resource CreateStereoFloat32(PP_Instance instance,
+                                PP_AudioSampleRate sample_rate,
+                                uint32_t sample_frame_count) {
+  VLOG(4) << "PPB_AudioConfig_Dev::CreateStereoFloat32()";
+  EnterResourceCreation enter(instance);
+  if (enter.failed())
+    return 0;
+  return enter.functions()->CreateAudioConfigFloat32(instance, sample_rate,
+                                                     sample_frame_count);
+}
+
+PP_AudioSampleFormat_Dev GetSampleFormat(PP_Resource config) {
+  VLOG(4) << "PPB_AudioConfig_Dev::GetSampleFormat()";
+  EnterResource<PPB_AudioConfig_API> enter(config, true);
+  if (enter.failed())
+    return PP_AUDIOSAMPLEFORMAT_DEV_INT16;
+  return enter.object()->GetSampleFormat();
+}
+
+const PPB_AudioConfig_Dev_0_1 g_ppb_audioconfig_dev_thunk_0_1 = {
+    &CreateStereoFloat32, &GetSampleFormat};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_AudioConfig_Dev_0_1*
+GetPPB_AudioConfig_Dev_0_1_Thunk() {
+  return &g_ppb_audioconfig_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
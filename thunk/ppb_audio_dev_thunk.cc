@@ -0,0 +1,48 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_audio_dev.idl modified Fri May 18 11:42:08 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_audio_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_audio_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t SetThreadPriority(PP_Resource audio,
+                          PP_AudioThreadPriority_Dev priority) {
+  VLOG(4) << "PPB_Audio_Dev::SetThreadPriority()";
+  EnterResource<PPB_Audio_API> enter(audio, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->SetThreadPriority(priority);
+}
+
+int32_t GetStats(PP_Resource audio, struct PP_AudioStats_Dev* stats) {
+  VLOG(4) << "PPB_Audio_Dev::GetStats()";
+  EnterResource<PPB_Audio_API> enter(audio, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->GetStats(stats);
+}
+
+const PPB_Audio_Dev_0_1 g_ppb_audio_dev_thunk_0_1 = {&SetThreadPriority,
+                                                      &GetStats};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_Audio_Dev_0_1* GetPPB_Audio_Dev_0_1_Thunk() {
+  return &g_ppb_audio_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
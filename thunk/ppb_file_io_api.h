@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/memory/ref_counted.h"
+#include "ppapi/c/dev/ppb_file_io_dev.h"
 #include "ppapi/c/ppb_file_io.h"
 #include "ppapi/c/private/pp_file_handle.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
@@ -55,6 +56,19 @@ class PPAPI_THUNK_EXPORT PPB_FileIO_API {
   virtual int32_t RequestOSFileHandle(
       PP_FileHandle* handle,
       scoped_refptr<TrackedCallback> callback) = 0;
+
+  // Dev API.
+  virtual int32_t SetMaxPendingOperations(uint32_t max_pending_operations) = 0;
+  virtual int32_t MapRange(int64_t offset, int64_t length, void** address) = 0;
+  virtual int32_t UnmapRange(void* address) = 0;
+  virtual int32_t ReadV(int64_t offset,
+                        const PP_FileIOSegment_Dev segments[],
+                        uint32_t segment_count,
+                        scoped_refptr<TrackedCallback> callback) = 0;
+  virtual int32_t WriteV(int64_t offset,
+                         const PP_FileIOSegment_Dev segments[],
+                         uint32_t segment_count,
+                         scoped_refptr<TrackedCallback> callback) = 0;
 };
 
 }  // namespace thunk
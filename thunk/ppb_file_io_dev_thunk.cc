@@ -0,0 +1,87 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_file_io_dev.idl modified Tue Jul 10 11:48:19 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_file_io_dev.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_file_io_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t SetMaxPendingOperations(PP_Resource file_io,
+                                uint32_t max_pending_operations) {
+  VLOG(4) << "PPB_FileIO_Dev::SetMaxPendingOperations()";
+  EnterResource<PPB_FileIO_API> enter(file_io, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->SetMaxPendingOperations(max_pending_operations);
+}
+
+int32_t MapRange(PP_Resource file_io,
+                 int64_t offset,
+                 int64_t length,
+                 void** address) {
+  VLOG(4) << "PPB_FileIO_Dev::MapRange()";
+  EnterResource<PPB_FileIO_API> enter(file_io, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->MapRange(offset, length, address);
+}
+
+int32_t UnmapRange(PP_Resource file_io, void* address) {
+  VLOG(4) << "PPB_FileIO_Dev::UnmapRange()";
+  EnterResource<PPB_FileIO_API> enter(file_io, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->UnmapRange(address);
+}
+
+int32_t ReadV(PP_Resource file_io,
+              int64_t offset,
+              const struct PP_FileIOSegment_Dev segments[],
+              uint32_t segment_count,
+              struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_FileIO_Dev::ReadV()";
+  EnterResource<PPB_FileIO_API> enter(file_io, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->ReadV(offset, segments, segment_count,
+                                               enter.callback()));
+}
+
+int32_t WriteV(PP_Resource file_io,
+               int64_t offset,
+               const struct PP_FileIOSegment_Dev segments[],
+               uint32_t segment_count,
+               struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_FileIO_Dev::WriteV()";
+  EnterResource<PPB_FileIO_API> enter(file_io, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->WriteV(offset, segments,
+                                                segment_count,
+                                                enter.callback()));
+}
+
+const PPB_FileIO_Dev_0_1 g_ppb_fileio_dev_thunk_0_1 = {
+    &SetMaxPendingOperations, &MapRange, &UnmapRange, &ReadV, &WriteV};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_FileIO_Dev_0_1* GetPPB_FileIO_Dev_0_1_Thunk() {
+  return &g_ppb_fileio_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
@@ -26,6 +26,9 @@ class PPB_FileSystem_API {
   virtual PP_FileSystemType GetType() = 0;
   virtual void OpenQuotaFile(PP_Resource file_io) = 0;
   virtual void CloseQuotaFile(PP_Resource file_io) = 0;
+  // Takes |amount| out of the quota already reserved, without waiting.
+  // Returns false if that isn't possible, and RequestQuota() is needed.
+  virtual bool ConsumeReservedQuota(int64_t amount) = 0;
   typedef base::Callback<void(int64_t)> RequestQuotaCallback;
   virtual int64_t RequestQuota(int64_t amount,
                                const RequestQuotaCallback& callback) = 0;
@@ -40,6 +40,18 @@ class PPAPI_THUNK_EXPORT PPB_Graphics2D_API {
                                     const PP_Point* origin,
                                     const PP_Point* translate) = 0;
 
+  // Dev API. Paints each rect in turn unless the implementation has a better
+  // way.
+  virtual void PaintImageDataRects(PP_Resource image_data,
+                                   const PP_Point* top_left,
+                                   const PP_Rect src_rects[],
+                                   uint32_t num_rects) {
+    if (!src_rects)
+      return;
+    for (uint32_t i = 0; i < num_rects; ++i)
+      PaintImageData(image_data, top_left, &src_rects[i]);
+  }
+
   // Test only
   virtual bool ReadImageData(PP_Resource image, const PP_Point* top_left) = 0;
 };
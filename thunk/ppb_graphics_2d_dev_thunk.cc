@@ -0,0 +1,45 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_graphics_2d_dev.idl modified Mon Jul  9 10:12:44 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_graphics_2d_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_graphics_2d_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+void PaintImageDataRects(PP_Resource graphics_2d,
+                         PP_Resource image_data,
+                         const struct PP_Point* top_left,
+                         const struct PP_Rect src_rects[],
+                         uint32_t num_rects) {
+  VLOG(4) << "PPB_Graphics2D_Dev::PaintImageDataRects()";
+  EnterResource<PPB_Graphics2D_API> enter(graphics_2d, true);
+  if (enter.failed())
+    return;
+  enter.object()->PaintImageDataRects(image_data, top_left, src_rects,
+                                      num_rects);
+}
+
+const PPB_Graphics2D_Dev_0_1 g_ppb_graphics2d_dev_thunk_0_1 = {
+    &PaintImageDataRects};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_Graphics2D_Dev_0_1*
+GetPPB_Graphics2D_Dev_0_1_Thunk() {
+  return &g_ppb_graphics2d_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
@@ -0,0 +1,63 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_image_data_dev.idl modified Fri Jul 13 11:02:18 2018.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ppapi/c/dev/ppb_image_data_dev.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/resource_creation_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+void PrewarmCache(PP_Instance instance,
+                  PP_ImageDataFormat format,
+                  const struct PP_Size* size,
+                  uint32_t count) {
+  VLOG(4) << "PPB_ImageData_Dev::PrewarmCache()";
+  EnterResourceCreation enter(instance);
+  if (enter.failed())
+    return;
+  enter.functions()->PrewarmImageDataCache(instance, format, size, count);
+}
+
+void SetCacheBudget(PP_Instance instance, uint32_t budget_bytes) {
+  VLOG(4) << "PPB_ImageData_Dev::SetCacheBudget()";
+  EnterResourceCreation enter(instance);
+  if (enter.failed())
+    return;
+  enter.functions()->SetImageDataCacheBudget(instance, budget_bytes);
+}
+
+PP_Bool GetCacheStats(PP_Instance instance,
+                      struct PP_ImageDataCacheStats_Dev* stats) {
+  VLOG(4) << "PPB_ImageData_Dev::GetCacheStats()";
+  EnterResourceCreation enter(instance);
+  if (enter.failed()) {
+    memset(stats, 0, sizeof(*stats));
+    return PP_FALSE;
+  }
+  return enter.functions()->GetImageDataCacheStats(instance, stats);
+}
+
+const PPB_ImageData_Dev_0_1 g_ppb_imagedata_dev_thunk_0_1 = {
+    &PrewarmCache, &SetCacheBudget, &GetCacheStats};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_ImageData_Dev_0_1*
+GetPPB_ImageData_Dev_0_1_Thunk() {
+  return &g_ppb_imagedata_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
@@ -29,6 +29,13 @@ class PPAPI_THUNK_EXPORT PPB_MediaStreamVideoTrack_API {
       PP_Resource* frame,
       scoped_refptr<ppapi::TrackedCallback> callback) = 0;
   virtual int32_t PutFrame(PP_Resource frame) = 0;
+
+  // Dev API.
+  virtual int32_t GetFrames(PP_Resource frames[],
+                            uint32_t max_frames,
+                            scoped_refptr<ppapi::TrackedCallback> callback) = 0;
+  virtual int32_t RecycleFrames(const PP_Resource frames[],
+                                uint32_t num_frames) = 0;
 };
 
 }  // namespace thunk
@@ -0,0 +1,57 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_media_stream_video_track_dev.idl modified Wed Jun 27 10:41:18
+// 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_media_stream_video_track_dev.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_media_stream_video_track_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t GetFrames(PP_Resource video_track,
+                  PP_Resource frames[],
+                  uint32_t max_frames,
+                  struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_MediaStreamVideoTrack_Dev::GetFrames()";
+  EnterResource<PPB_MediaStreamVideoTrack_API> enter(video_track, callback,
+                                                     true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(
+      enter.object()->GetFrames(frames, max_frames, enter.callback()));
+}
+
+int32_t RecycleFrames(PP_Resource video_track,
+                      const PP_Resource frames[],
+                      uint32_t num_frames) {
+  VLOG(4) << "PPB_MediaStreamVideoTrack_Dev::RecycleFrames()";
+  EnterResource<PPB_MediaStreamVideoTrack_API> enter(video_track, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->RecycleFrames(frames, num_frames);
+}
+
+const PPB_MediaStreamVideoTrack_Dev_0_1
+    g_ppb_mediastreamvideotrack_dev_thunk_0_1 = {&GetFrames, &RecycleFrames};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_MediaStreamVideoTrack_Dev_0_1*
+GetPPB_MediaStreamVideoTrack_Dev_0_1_Thunk() {
+  return &g_ppb_mediastreamvideotrack_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
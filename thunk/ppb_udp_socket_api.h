@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/memory/ref_counted.h"
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
 #include "ppapi/c/ppb_udp_socket.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
 
@@ -46,6 +47,18 @@ class PPAPI_THUNK_EXPORT PPB_UDPSocket_API {
                             scoped_refptr<TrackedCallback> callback) = 0;
   virtual int32_t LeaveGroup(PP_Resource group,
                             scoped_refptr<TrackedCallback> callback) = 0;
+
+  // PPB_UDPSocket_Dev.
+  virtual int32_t RecvFromBatch(char* buffer,
+                                int32_t num_bytes,
+                                PP_UDPSocket_Datagram_Dev datagrams[],
+                                uint32_t max_datagrams,
+                                scoped_refptr<TrackedCallback> callback) = 0;
+  virtual int32_t SendToBatch(const char* buffer,
+                              int32_t num_bytes,
+                              const PP_UDPSocket_Datagram_Dev datagrams[],
+                              uint32_t num_datagrams,
+                              scoped_refptr<TrackedCallback> callback) = 0;
 };
 
 }  // namespace thunk
@@ -0,0 +1,61 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_udp_socket_dev.idl modified Tue May 15 14:03:52 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_udp_socket_dev.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_udp_socket_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t RecvFromBatch(PP_Resource udp_socket,
+                      char* buffer,
+                      int32_t num_bytes,
+                      struct PP_UDPSocket_Datagram_Dev datagrams[],
+                      uint32_t max_datagrams,
+                      struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_UDPSocket_Dev::RecvFromBatch()";
+  EnterResource<PPB_UDPSocket_API> enter(udp_socket, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->RecvFromBatch(
+      buffer, num_bytes, datagrams, max_datagrams, enter.callback()));
+}
+
+int32_t SendToBatch(PP_Resource udp_socket,
+                    const char* buffer,
+                    int32_t num_bytes,
+                    const struct PP_UDPSocket_Datagram_Dev datagrams[],
+                    uint32_t num_datagrams,
+                    struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_UDPSocket_Dev::SendToBatch()";
+  EnterResource<PPB_UDPSocket_API> enter(udp_socket, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->SendToBatch(
+      buffer, num_bytes, datagrams, num_datagrams, enter.callback()));
+}
+
+const PPB_UDPSocket_Dev_0_1 g_ppb_udpsocket_dev_thunk_0_1 = {&RecvFromBatch,
+                                                              &SendToBatch};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_UDPSocket_Dev_0_1*
+GetPPB_UDPSocket_Dev_0_1_Thunk() {
+  return &g_ppb_udpsocket_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
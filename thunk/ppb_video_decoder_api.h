@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include "ppapi/c/dev/ppb_video_decoder_pipeline_dev.h"
 #include "ppapi/c/pp_codecs.h"
 #include "ppapi/c/ppb_video_decoder.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
@@ -45,6 +46,21 @@ class PPAPI_THUNK_EXPORT PPB_VideoDecoder_API {
   virtual void RecyclePicture(const PP_VideoPicture* picture) = 0;
   virtual int32_t Flush(scoped_refptr<TrackedCallback> callback) = 0;
   virtual int32_t Reset(scoped_refptr<TrackedCallback> callback) = 0;
+
+  // Dev API.
+  virtual int32_t SetPipelineOptions(
+      const PP_VideoDecoderPipelineOptions_Dev* options) = 0;
+  virtual int32_t GetPipelineStats(
+      PP_VideoDecoderPipelineStats_Dev* stats) = 0;
+  virtual int32_t AcquireBitstreamBuffer(
+      uint32_t size,
+      uint32_t* buffer_id,
+      void** buffer,
+      scoped_refptr<TrackedCallback> callback) = 0;
+  virtual int32_t SubmitBitstreamBuffer(uint32_t buffer_id,
+                                        uint32_t decode_id,
+                                        uint32_t size) = 0;
+  virtual int32_t ReleaseBitstreamBuffer(uint32_t buffer_id) = 0;
 };
 
 }  // namespace thunk
@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_video_decoder_pipeline_dev.idl modified Thu Jul  5 16:22:37
+// 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_video_decoder_pipeline_dev.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_video_decoder_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t SetOptions(PP_Resource video_decoder,
+                   const struct PP_VideoDecoderPipelineOptions_Dev* options) {
+  VLOG(4) << "PPB_VideoDecoderPipeline_Dev::SetOptions()";
+  EnterResource<PPB_VideoDecoder_API> enter(video_decoder, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->SetPipelineOptions(options);
+}
+
+int32_t GetStats(PP_Resource video_decoder,
+                 struct PP_VideoDecoderPipelineStats_Dev* stats) {
+  VLOG(4) << "PPB_VideoDecoderPipeline_Dev::GetStats()";
+  EnterResource<PPB_VideoDecoder_API> enter(video_decoder, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->GetPipelineStats(stats);
+}
+
+int32_t AcquireBitstreamBuffer(PP_Resource video_decoder,
+                               uint32_t size,
+                               uint32_t* buffer_id,
+                               void** buffer,
+                               struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_VideoDecoderPipeline_Dev::AcquireBitstreamBuffer()";
+  EnterResource<PPB_VideoDecoder_API> enter(video_decoder, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->AcquireBitstreamBuffer(
+      size, buffer_id, buffer, enter.callback()));
+}
+
+int32_t SubmitBitstreamBuffer(PP_Resource video_decoder,
+                              uint32_t buffer_id,
+                              uint32_t decode_id,
+                              uint32_t size) {
+  VLOG(4) << "PPB_VideoDecoderPipeline_Dev::SubmitBitstreamBuffer()";
+  EnterResource<PPB_VideoDecoder_API> enter(video_decoder, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->SubmitBitstreamBuffer(buffer_id, decode_id, size);
+}
+
+int32_t ReleaseBitstreamBuffer(PP_Resource video_decoder, uint32_t buffer_id) {
+  VLOG(4) << "PPB_VideoDecoderPipeline_Dev::ReleaseBitstreamBuffer()";
+  EnterResource<PPB_VideoDecoder_API> enter(video_decoder, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->ReleaseBitstreamBuffer(buffer_id);
+}
+
+const PPB_VideoDecoderPipeline_Dev_0_1
+    g_ppb_videodecoderpipeline_dev_thunk_0_1 = {
+        &SetOptions, &GetStats, &AcquireBitstreamBuffer,
+        &SubmitBitstreamBuffer, &ReleaseBitstreamBuffer};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_VideoDecoderPipeline_Dev_0_1*
+GetPPB_VideoDecoderPipeline_Dev_0_1_Thunk() {
+  return &g_ppb_videodecoderpipeline_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include "ppapi/c/dev/ppb_video_encoder_stream_dev.h"
 #include "ppapi/c/pp_codecs.h"
 #include "ppapi/c/ppb_video_encoder.h"
 #include "ppapi/thunk/ppapi_thunk_export.h"
@@ -50,6 +51,13 @@ class PPAPI_THUNK_EXPORT PPB_VideoEncoder_API {
   virtual void RequestEncodingParametersChange(uint32_t bitrate,
                                                uint32_t framerate) = 0;
   virtual void Close() = 0;
+
+  // Dev API.
+  virtual int32_t GetBitstreamBuffers(
+      PP_BitstreamBuffer buffers[],
+      uint32_t max_buffers,
+      const scoped_refptr<TrackedCallback>& callback) = 0;
+  virtual int32_t GetStats(PP_VideoEncoderStats_Dev* stats) = 0;
 };
 
 }  // namespace thunk
@@ -0,0 +1,54 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// From dev/ppb_video_encoder_stream_dev.idl modified Fri Jul  6 11:04:52 2018.
+
+#include <stdint.h>
+
+#include "ppapi/c/dev/ppb_video_encoder_stream_dev.h"
+#include "ppapi/c/pp_completion_callback.h"
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/shared_impl/tracked_callback.h"
+#include "ppapi/thunk/enter.h"
+#include "ppapi/thunk/ppapi_thunk_export.h"
+#include "ppapi/thunk/ppb_video_encoder_api.h"
+
+namespace ppapi {
+namespace thunk {
+
+namespace {
+
+int32_t GetBitstreamBuffers(PP_Resource video_encoder,
+                            struct PP_BitstreamBuffer buffers[],
+                            uint32_t max_buffers,
+                            struct PP_CompletionCallback callback) {
+  VLOG(4) << "PPB_VideoEncoderStream_Dev::GetBitstreamBuffers()";
+  EnterResource<PPB_VideoEncoder_API> enter(video_encoder, callback, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.SetResult(enter.object()->GetBitstreamBuffers(
+      buffers, max_buffers, enter.callback()));
+}
+
+int32_t GetStats(PP_Resource video_encoder,
+                 struct PP_VideoEncoderStats_Dev* stats) {
+  VLOG(4) << "PPB_VideoEncoderStream_Dev::GetStats()";
+  EnterResource<PPB_VideoEncoder_API> enter(video_encoder, true);
+  if (enter.failed())
+    return enter.retval();
+  return enter.object()->GetStats(stats);
+}
+
+const PPB_VideoEncoderStream_Dev_0_1 g_ppb_videoencoderstream_dev_thunk_0_1 = {
+    &GetBitstreamBuffers, &GetStats};
+
+}  // namespace
+
+PPAPI_THUNK_EXPORT const PPB_VideoEncoderStream_Dev_0_1*
+GetPPB_VideoEncoderStream_Dev_0_1_Thunk() {
+  return &g_ppb_videoencoderstream_dev_thunk_0_1;
+}
+
+}  // namespace thunk
+}  // namespace ppapi
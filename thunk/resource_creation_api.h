@@ -11,7 +11,9 @@
 #include "build/build_config.h"
 #include "gpu/command_buffer/common/command_buffer_id.h"
 #include "ppapi/c/dev/pp_video_dev.h"
+#include "ppapi/c/dev/ppb_audio_config_dev.h"
 #include "ppapi/c/dev/ppb_file_chooser_dev.h"
+#include "ppapi/c/dev/ppb_image_data_dev.h"
 #include "ppapi/c/dev/ppb_truetype_font_dev.h"
 #include "ppapi/c/pp_bool.h"
 #include "ppapi/c/pp_instance.h"
@@ -132,6 +134,13 @@ class ResourceCreationAPI {
   virtual PP_Resource CreateAudioConfig(PP_Instance instance,
                                         PP_AudioSampleRate sample_rate,
                                         uint32_t sample_frame_count) = 0;
+  // Returns 0 where float32 audio isn't supported.
+  virtual PP_Resource CreateAudioConfigFloat32(
+      PP_Instance instance,
+      PP_AudioSampleRate sample_rate,
+      uint32_t sample_frame_count) {
+    return 0;
+  }
   virtual PP_Resource CreateCameraDevicePrivate(PP_Instance instance) = 0;
   virtual PP_Resource CreateCompositor(PP_Instance instance) = 0;
   virtual PP_Resource CreateFileChooser(PP_Instance instance,
@@ -160,6 +169,19 @@ class ResourceCreationAPI {
                                             PP_ImageDataFormat format,
                                             const PP_Size* size,
                                             PP_Bool init_to_zero) = 0;
+  // Only the plugin side pools image datas for re-use, so these do nothing
+  // elsewhere.
+  virtual void PrewarmImageDataCache(PP_Instance instance,
+                                     PP_ImageDataFormat format,
+                                     const PP_Size* size,
+                                     uint32_t count) {}
+  virtual void SetImageDataCacheBudget(PP_Instance instance,
+                                       uint32_t budget_bytes) {}
+  virtual PP_Bool GetImageDataCacheStats(PP_Instance instance,
+                                         PP_ImageDataCacheStats_Dev* stats) {
+    *stats = PP_ImageDataCacheStats_Dev();
+    return PP_FALSE;
+  }
   virtual PP_Resource CreateMediaStreamVideoTrack(PP_Instance instance) = 0;
   virtual PP_Resource CreateNetAddressFromIPv4Address(
       PP_Instance instance,
@@ -23,10 +23,24 @@
 //
 // We only support scrolling along one axis at a time.  A diagonal scroll will
 // therefore be treated as an invalidation.
+//
+// Merging two paint rects into their bounding box saves the per-rect overhead
+// of painting (a PaintImageData call, an OnPaint callback) at the cost of the
+// extra pixels the bounding box covers.  Disjoint rects are merged when the
+// extra pixels cost less than paint_rect_cost_, and when there are too many
+// rects, the pairs with the fewest extra pixels are merged first.
 // ----------------------------------------------------------------------------
 
 namespace pp {
 
+namespace {
+
+int64_t GetArea(const Rect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+}  // namespace
+
 PaintAggregator::PaintUpdate::PaintUpdate() : has_scroll(false) {}
 
 PaintAggregator::PaintUpdate::~PaintUpdate() {}
@@ -80,7 +94,8 @@ Rect PaintAggregator::InternalPaintUpdate::GetPaintBounds() const {
 
 PaintAggregator::PaintAggregator()
     : max_redundant_paint_to_scroll_area_(0.8f),
-      max_paint_rects_(10) {
+      max_paint_rects_(10),
+      paint_rect_cost_(0) {
 }
 
 bool PaintAggregator::HasPendingUpdate() const {
@@ -130,6 +145,27 @@ void PaintAggregator::InvalidateRect(const Rect& rect) {
     }
   }
 
+  // Merge with the disjoint paint whose bounding box with |rect| paints the
+  // fewest extra pixels, if that's cheaper than painting another rect.
+  size_t best_index = update_.paint_rects.size();
+  int64_t best_cost = paint_rect_cost_;
+  for (size_t i = 0; i < update_.paint_rects.size(); ++i) {
+    const Rect& existing_rect = update_.paint_rects[i];
+    if (!CanCombinePaintRects(existing_rect, rect))
+      continue;
+    int64_t cost = GetCombineCost(existing_rect, rect);
+    if (cost <= best_cost) {
+      best_index = i;
+      best_cost = cost;
+    }
+  }
+  if (best_index < update_.paint_rects.size()) {
+    Rect combined_rect = update_.paint_rects[best_index].Union(rect);
+    update_.paint_rects.erase(update_.paint_rects.begin() + best_index);
+    InvalidateRect(combined_rect);
+    return;
+  }
+
   // Add a non-overlapping paint.
   update_.paint_rects.push_back(rect);
 
@@ -203,6 +239,12 @@ void PaintAggregator::ScrollRect(const Rect& clip_rect, const Point& amount) {
     InvalidateScrollRect();
 }
 
+// static
+int64_t PaintAggregator::GetCombineCost(const Rect& a, const Rect& b) {
+  return GetArea(a.Union(b)) - GetArea(a) - GetArea(b) +
+         GetArea(a.Intersect(b));
+}
+
 Rect PaintAggregator::ScrollPaintRect(const Rect& paint_rect,
                                       const Point& amount) const {
   Rect result = paint_rect;
@@ -214,6 +256,23 @@ Rect PaintAggregator::ScrollPaintRect(const Rect& paint_rect,
   return result.Subtract(update_.GetScrollDamage());
 }
 
+bool PaintAggregator::CanCombinePaintRects(const Rect& a,
+                                           const Rect& b) const {
+  if (update_.scroll_rect.IsEmpty())
+    return true;
+
+  // Rects inside the scroll rect are scrolled before painting, so they can
+  // only be combined with each other. Rects outside it can be combined as long
+  // as the result doesn't force an invalidation of the scroll.
+  bool a_contained = update_.scroll_rect.Contains(a);
+  bool b_contained = update_.scroll_rect.Contains(b);
+  if (a_contained && b_contained)
+    return true;
+  if (a_contained || b_contained)
+    return false;
+  return !update_.scroll_rect.Intersects(a.Union(b));
+}
+
 bool PaintAggregator::ShouldInvalidateScrollRect(const Rect& rect) const {
   if (!rect.IsEmpty()) {
     if (!update_.scroll_rect.Intersects(rect))
@@ -246,15 +305,57 @@ void PaintAggregator::InvalidateScrollRect() {
 }
 
 void PaintAggregator::CombinePaintRects() {
-  // Combine paint rects down to at most two rects: one inside the scroll_rect
-  // and one outside the scroll_rect.  If there is no scroll_rect, then just
-  // use the smallest bounding box for all paint rects.
-  //
-  // NOTE: This is a fairly simple algorithm.  We could get fancier by only
-  // combining two rects to get us under the max_paint_rects limit, but if we
-  // reach this method then it means we're hitting a rare case, so there's no
-  // need to over-optimize it.
-  //
+  // Combine the pair of paint rects whose bounding box paints the fewest extra
+  // pixels until we're within the max_paint_rects limit. This keeps scattered
+  // small paints apart instead of painting everything between them.
+  while (update_.paint_rects.size() > max_paint_rects_) {
+    size_t best_i = 0;
+    size_t best_j = 0;
+    int64_t best_cost = -1;
+    for (size_t i = 0; i < update_.paint_rects.size(); ++i) {
+      for (size_t j = i + 1; j < update_.paint_rects.size(); ++j) {
+        const Rect& a = update_.paint_rects[i];
+        const Rect& b = update_.paint_rects[j];
+        if (!CanCombinePaintRects(a, b))
+          continue;
+        int64_t cost = GetCombineCost(a, b);
+        if (best_cost < 0 || cost < best_cost) {
+          best_i = i;
+          best_j = j;
+          best_cost = cost;
+        }
+      }
+    }
+    if (best_cost < 0)
+      break;
+
+    Rect combined_rect =
+        update_.paint_rects[best_i].Union(update_.paint_rects[best_j]);
+    update_.paint_rects.erase(update_.paint_rects.begin() + best_j);
+    update_.paint_rects.erase(update_.paint_rects.begin() + best_i);
+
+    // The bounding box may overlap other paint rects; fold them in so that
+    // no pixel is painted twice.
+    for (size_t i = 0; i < update_.paint_rects.size();) {
+      const Rect& existing_rect = update_.paint_rects[i];
+      if (combined_rect.Intersects(existing_rect) &&
+          CanCombinePaintRects(combined_rect, existing_rect)) {
+        combined_rect = combined_rect.Union(existing_rect);
+        update_.paint_rects.erase(update_.paint_rects.begin() + i);
+        i = 0;
+      } else {
+        ++i;
+      }
+    }
+    update_.paint_rects.push_back(combined_rect);
+  }
+  if (update_.paint_rects.size() <= max_paint_rects_)
+    return;
+
+  // No pair could be combined without crossing the scroll_rect. Fall back to
+  // at most two rects: one inside the scroll_rect and one outside it. If
+  // there is no scroll_rect, then just use the smallest bounding box for all
+  // paint rects.
   if (update_.scroll_rect.IsEmpty()) {
     Rect bounds = update_.GetPaintBounds();
     update_.paint_rects.clear();
@@ -6,6 +6,7 @@
 #define PPAPI_UTILITY_GRAPHICS_PAINT_AGGREGATOR_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <vector>
 
 #include "ppapi/cpp/point.h"
@@ -90,6 +91,17 @@ class PaintAggregator {
     max_paint_rects_ = max_rects;
   }
 
+  /// Setter function for the overhead of painting one more rect, expressed as
+  /// a number of pixels. An invalidation that doesn't touch any pending paint
+  /// rect is merged into the one whose bounding box with it paints the fewest
+  /// extra pixels, as long as that is no more than this cost. The default is 0,
+  /// which only merges rects that overlap or share an edge.
+  ///
+  /// @param[in] cost The number of pixels painting one more rect is worth.
+  void set_paint_rect_cost(int32_t cost) {
+    paint_rect_cost_ = cost;
+  }
+
   /// This function determines if there is a pending update. There is a
   /// PendingUpdate if InvalidateRect or ScrollRect were called and
   /// ClearPendingUpdate was not called.
@@ -147,7 +159,12 @@ class PaintAggregator {
     std::vector<Rect> paint_rects;
   };
 
+  // Returns the number of extra pixels painted if |a| and |b| are replaced by
+  // their bounding box.
+  static int64_t GetCombineCost(const Rect& a, const Rect& b);
+
   Rect ScrollPaintRect(const Rect& paint_rect, const Point& amount) const;
+  bool CanCombinePaintRects(const Rect& a, const Rect& b) const;
   bool ShouldInvalidateScrollRect(const Rect& rect) const;
   void InvalidateScrollRect();
   void CombinePaintRects();
@@ -167,6 +184,10 @@ class PaintAggregator {
   // threshold, if your plugin is slow, lower it (probably requires some
   // tuning to find the right value).
   size_t max_paint_rects_;
+
+  // The overhead of painting one more rect, in pixels. Disjoint paint rects
+  // are merged when their bounding box paints no more extra pixels than this.
+  int32_t paint_rect_cost_;
 };
 
 }  // namespace pp
@@ -0,0 +1,274 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays invalidation traces through PaintAggregator and reports how many
+// pixels and rects it asks the plugin to paint, and how long aggregation
+// takes, for several per-rect costs.
+//
+// A recorded trace can be replayed with --paint-trace=<file>. Each line of the
+// file is one of:
+//   invalidate <x> <y> <width> <height>
+//   scroll <x> <y> <width> <height> <dx> <dy>
+//   flush
+// where "flush" ends a frame, i.e. the point at which the plugin paints.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "ppapi/cpp/point.h"
+#include "ppapi/cpp/rect.h"
+#include "ppapi/utility/graphics/paint_aggregator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace pp {
+namespace {
+
+struct TraceCommand {
+  enum Type { INVALIDATE, SCROLL, FLUSH };
+
+  Type type;
+  Rect rect;
+  Point amount;
+};
+
+typedef std::vector<TraceCommand> Trace;
+
+int GetIntSwitch(const char* name, int default_value) {
+  int value = default_value;
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line && command_line->HasSwitch(name))
+    base::StringToInt(command_line->GetSwitchValueASCII(name), &value);
+  return value;
+}
+
+// A small deterministic generator, so that every run replays the same
+// synthetic traces.
+class TraceRandom {
+ public:
+  TraceRandom() : state_(12345) {}
+
+  int32_t Next(int32_t max) {
+    state_ = state_ * 1103515245 + 12345;
+    return static_cast<int32_t>((state_ >> 16) % static_cast<uint32_t>(max));
+  }
+
+ private:
+  uint32_t state_;
+};
+
+void AddInvalidate(Trace* trace, int32_t x, int32_t y, int32_t w, int32_t h) {
+  TraceCommand command;
+  command.type = TraceCommand::INVALIDATE;
+  command.rect = Rect(x, y, w, h);
+  trace->push_back(command);
+}
+
+void AddScroll(Trace* trace, const Rect& clip, const Point& amount) {
+  TraceCommand command;
+  command.type = TraceCommand::SCROLL;
+  command.rect = clip;
+  command.amount = amount;
+  trace->push_back(command);
+}
+
+void AddFlush(Trace* trace) {
+  TraceCommand command;
+  command.type = TraceCommand::FLUSH;
+  trace->push_back(command);
+}
+
+// Text being typed: a glyph and the caret per frame, with the occasional
+// status line update far away.
+Trace MakeTypingTrace() {
+  Trace trace;
+  TraceRandom random;
+  for (int frame = 0; frame < 1000; ++frame) {
+    int32_t column = frame % 100;
+    int32_t line = (frame / 100) % 40;
+    AddInvalidate(&trace, 8 * column, 16 * line, 8, 16);
+    AddInvalidate(&trace, 8 * (column + 1), 16 * line, 2, 16);
+    if (random.Next(10) == 0)
+      AddInvalidate(&trace, 0, 740, 200 + random.Next(600), 20);
+    AddFlush(&trace);
+  }
+  return trace;
+}
+
+// Small sprites moving all over the screen.
+Trace MakeScatteredTrace() {
+  Trace trace;
+  TraceRandom random;
+  for (int frame = 0; frame < 1000; ++frame) {
+    for (int i = 0; i < 30; ++i) {
+      AddInvalidate(&trace, random.Next(1008), random.Next(752),
+                    4 + random.Next(12), 4 + random.Next(12));
+    }
+    AddFlush(&trace);
+  }
+  return trace;
+}
+
+// Several widgets, each repainting a handful of nearby cells.
+Trace MakeClusteredTrace() {
+  Trace trace;
+  TraceRandom random;
+  const int32_t kCenters[][2] = {{100, 100}, {800, 120}, {400, 600}};
+  for (int frame = 0; frame < 1000; ++frame) {
+    for (size_t c = 0; c < arraysize(kCenters); ++c) {
+      for (int i = 0; i < 8; ++i) {
+        AddInvalidate(&trace, kCenters[c][0] + 12 * random.Next(10),
+                      kCenters[c][1] + 12 * random.Next(10), 10, 10);
+      }
+    }
+    AddFlush(&trace);
+  }
+  return trace;
+}
+
+// A scrolling document with a few repaints inside and outside the view.
+Trace MakeScrollingTrace() {
+  Trace trace;
+  TraceRandom random;
+  Rect view(0, 40, 1024, 700);
+  for (int frame = 0; frame < 1000; ++frame) {
+    AddScroll(&trace, view, Point(0, -(8 + random.Next(24))));
+    for (int i = 0; i < 4; ++i) {
+      AddInvalidate(&trace, random.Next(1000), 40 + random.Next(680),
+                    8 + random.Next(16), 8 + random.Next(16));
+    }
+    AddInvalidate(&trace, 16 * random.Next(60), 0, 16, 40);
+    AddFlush(&trace);
+  }
+  return trace;
+}
+
+bool ParseTrace(const std::string& contents, Trace* trace) {
+  std::vector<std::string> lines = base::SplitString(
+      contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    std::vector<std::string> fields = base::SplitString(
+        lines[i], " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    std::vector<int> values;
+    for (size_t j = 1; j < fields.size(); ++j) {
+      int value = 0;
+      if (!base::StringToInt(fields[j], &value))
+        return false;
+      values.push_back(value);
+    }
+    if (fields[0] == "invalidate" && values.size() == 4) {
+      AddInvalidate(trace, values[0], values[1], values[2], values[3]);
+    } else if (fields[0] == "scroll" && values.size() == 6) {
+      AddScroll(trace, Rect(values[0], values[1], values[2], values[3]),
+                Point(values[4], values[5]));
+    } else if (fields[0] == "flush" && values.empty()) {
+      AddFlush(trace);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t GetArea(const Rect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+// Replays |trace| with the given per-rect cost and reports the pixels and
+// rects painted per frame and the time taken.
+void Replay(const std::string& name, const Trace& trace, int32_t rect_cost) {
+  const int kIterations = GetIntSwitch("iterations", 20);
+  std::string trace_name = base::StringPrintf("%s_cost%d", name.c_str(),
+                                              rect_cost);
+
+  int64_t painted_pixels = 0;
+  int64_t painted_rects = 0;
+  int64_t frames = 0;
+  base::PerfTimeLogger logger(
+      ("PaintAggregatorPerfTest." + trace_name).c_str());
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    PaintAggregator aggregator;
+    aggregator.set_paint_rect_cost(rect_cost);
+    for (size_t i = 0; i < trace.size(); ++i) {
+      const TraceCommand& command = trace[i];
+      if (command.type == TraceCommand::INVALIDATE) {
+        aggregator.InvalidateRect(command.rect);
+      } else if (command.type == TraceCommand::SCROLL) {
+        aggregator.ScrollRect(command.rect, command.amount);
+      } else if (aggregator.HasPendingUpdate()) {
+        PaintAggregator::PaintUpdate update = aggregator.GetPendingUpdate();
+        aggregator.ClearPendingUpdate();
+        if (iteration != 0)
+          continue;
+        for (size_t j = 0; j < update.paint_rects.size(); ++j)
+          painted_pixels += GetArea(update.paint_rects[j]);
+        painted_rects += update.paint_rects.size();
+        ++frames;
+      }
+    }
+  }
+  logger.Done();
+
+  ASSERT_GT(frames, 0);
+  perf_test::PrintResult("PaintAggregatorPerfTest", "",
+                         trace_name + "_pixels_per_frame",
+                         static_cast<double>(painted_pixels) / frames,
+                         "pixels", true);
+  perf_test::PrintResult("PaintAggregatorPerfTest", "",
+                         trace_name + "_rects_per_frame",
+                         static_cast<double>(painted_rects) / frames, "rects",
+                         false);
+}
+
+const int32_t kRectCosts[] = {0, 256, 1024, 4096};
+
+void ReplayAllCosts(const std::string& name, const Trace& trace) {
+  for (size_t i = 0; i < arraysize(kRectCosts); ++i)
+    Replay(name, trace, kRectCosts[i]);
+}
+
+}  // namespace
+
+TEST(PaintAggregatorPerfTest, Typing) {
+  ReplayAllCosts("Typing", MakeTypingTrace());
+}
+
+TEST(PaintAggregatorPerfTest, Scattered) {
+  ReplayAllCosts("Scattered", MakeScatteredTrace());
+}
+
+TEST(PaintAggregatorPerfTest, Clustered) {
+  ReplayAllCosts("Clustered", MakeClusteredTrace());
+}
+
+TEST(PaintAggregatorPerfTest, Scrolling) {
+  ReplayAllCosts("Scrolling", MakeScrollingTrace());
+}
+
+// Replays the trace given with --paint-trace, if any.
+TEST(PaintAggregatorPerfTest, RecordedTrace) {
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (!command_line || !command_line->HasSwitch("paint-trace"))
+    return;
+
+  base::FilePath path = command_line->GetSwitchValuePath("paint-trace");
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  Trace trace;
+  ASSERT_TRUE(ParseTrace(contents, &trace));
+  ReplayAllCosts("Recorded", trace);
+}
+
+}  // namespace pp
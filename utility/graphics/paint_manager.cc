@@ -5,9 +5,14 @@
 #include "ppapi/utility/graphics/paint_manager.h"
 
 #include "ppapi/c/pp_errors.h"
+#include "ppapi/cpp/dev/graphics_2d_dev.h"
 #include "ppapi/cpp/instance.h"
+#include "ppapi/cpp/instance_handle.h"
 #include "ppapi/cpp/logging.h"
 #include "ppapi/cpp/module.h"
+#include "ppapi/cpp/point.h"
+#include "ppapi/cpp/rect.h"
+#include "ppapi/utility/threading/simple_thread.h"
 
 namespace pp {
 
@@ -18,7 +23,13 @@ PaintManager::PaintManager()
       callback_factory_(NULL),
       manual_callback_pending_(false),
       flush_pending_(false),
-      has_pending_resize_(false) {
+      has_pending_resize_(false),
+      tile_client_(NULL),
+      tile_size_(0),
+      tiles_pending_(false),
+      tiles_need_binding_(false),
+      next_tile_(0),
+      tiles_remaining_(0) {
   // Set the callback object outside of the initializer list to avoid a
   // compiler warning about using "this" in an initializer list.
   callback_factory_.Initialize(this);
@@ -33,7 +44,13 @@ PaintManager::PaintManager(Instance* instance,
       callback_factory_(NULL),
       manual_callback_pending_(false),
       flush_pending_(false),
-      has_pending_resize_(false) {
+      has_pending_resize_(false),
+      tile_client_(NULL),
+      tile_size_(0),
+      tiles_pending_(false),
+      tiles_need_binding_(false),
+      next_tile_(0),
+      tiles_remaining_(0) {
   // Set the callback object outside of the initializer list to avoid a
   // compiler warning about using "this" in an initializer list.
   callback_factory_.Initialize(this);
@@ -43,6 +60,8 @@ PaintManager::PaintManager(Instance* instance,
 }
 
 PaintManager::~PaintManager() {
+  // The worker threads use this object, so they must be gone before it is.
+  StopTileThreads();
 }
 
 void PaintManager::Initialize(Instance* instance,
@@ -54,6 +73,33 @@ void PaintManager::Initialize(Instance* instance,
   is_always_opaque_ = is_always_opaque;
 }
 
+bool PaintManager::EnableTiledPainting(TileClient* tile_client,
+                                       int32_t num_threads,
+                                       int32_t tile_size) {
+  PP_DCHECK(instance_);  // You must call Initialize first.
+  PP_DCHECK(tile_client && num_threads > 0 && tile_size > 0);
+
+  DisableTiledPainting();
+  for (int32_t i = 0; i < num_threads; ++i) {
+    SimpleThread* thread = new SimpleThread(InstanceHandle(instance_));
+    if (!thread->Start()) {
+      delete thread;
+      StopTileThreads();
+      return false;
+    }
+    tile_threads_.push_back(thread);
+  }
+  tile_client_ = tile_client;
+  tile_size_ = tile_size;
+  return true;
+}
+
+void PaintManager::DisableTiledPainting() {
+  StopTileThreads();
+  tile_client_ = NULL;
+  tile_size_ = 0;
+}
+
 void PaintManager::SetSize(const Size& new_size) {
   if (GetEffectiveSize() == new_size)
     return;
@@ -100,8 +146,9 @@ Size PaintManager::GetEffectiveSize() const {
 void PaintManager::EnsureCallbackPending() {
   // The best way for us to do the next update is to get a notification that
   // a previous one has completed. So if we're already waiting for one, we
-  // don't have to do anything differently now.
-  if (flush_pending_)
+  // don't have to do anything differently now. Tiles being painted end in a
+  // flush too.
+  if (flush_pending_ || tiles_pending_)
     return;
 
   // If no flush is pending, we need to do a manual call to get back to the
@@ -150,33 +197,162 @@ void PaintManager::DoPaint() {
   if (update.has_scroll)
     graphics_.Scroll(update.scroll_rect, update.scroll_delta);
 
+  if (tile_client_ && PaintTiles(update, needs_binding))
+    return;
+
   if (client_->OnPaint(graphics_, update.paint_rects, update.paint_bounds)) {
     // Something was painted, schedule a flush.
-    int32_t result = graphics_.Flush(
-        callback_factory_.NewOptionalCallback(&PaintManager::OnFlushComplete));
-
-    // If you trigger this assertion, then your plugin has called Flush()
-    // manually. When using the PaintManager, you should not call Flush, it
-    // will handle that for you because it needs to know when it can do the
-    // next paint by implementing the flush callback.
-    //
-    // Another possible cause of this assertion is re-using devices. If you
-    // use one device, swap it with another, then swap it back, we won't know
-    // that we've already scheduled a Flush on the first device. It's best to
-    // not re-use devices in this way.
-    PP_DCHECK(result != PP_ERROR_INPROGRESS);
-
-    if (result == PP_OK_COMPLETIONPENDING) {
-      flush_pending_ = true;
-    } else {
-      PP_DCHECK(result == PP_OK);  // Catch all other errors in debug mode.
-    }
+    FlushGraphics();
   }
 
   if (needs_binding)
     instance_->BindGraphics(graphics_);
 }
 
+void PaintManager::FlushGraphics() {
+  int32_t result = graphics_.Flush(
+      callback_factory_.NewOptionalCallback(&PaintManager::OnFlushComplete));
+
+  // If you trigger this assertion, then your plugin has called Flush()
+  // manually. When using the PaintManager, you should not call Flush, it
+  // will handle that for you because it needs to know when it can do the
+  // next paint by implementing the flush callback.
+  //
+  // Another possible cause of this assertion is re-using devices. If you
+  // use one device, swap it with another, then swap it back, we won't know
+  // that we've already scheduled a Flush on the first device. It's best to
+  // not re-use devices in this way.
+  PP_DCHECK(result != PP_ERROR_INPROGRESS);
+
+  if (result == PP_OK_COMPLETIONPENDING) {
+    flush_pending_ = true;
+  } else {
+    PP_DCHECK(result == PP_OK);  // Catch all other errors in debug mode.
+  }
+}
+
+bool PaintManager::PaintTiles(const PaintAggregator::PaintUpdate& update,
+                              bool needs_binding) {
+  PP_DCHECK(!tiles_pending_);
+
+  Size size = graphics_.size();
+  if (tile_image_.is_null() || tile_image_.size() != size) {
+    tile_image_ = ImageData(instance_, ImageData::GetNativeImageDataFormat(),
+                            size, false);
+    if (tile_image_.is_null())
+      return false;
+  }
+
+  // Split the update along a grid, so that the tiles never overlap even if the
+  // paint rects do. Each tile is the part of its grid cell that needs
+  // painting.
+  tiles_.clear();
+  Rect bounds = update.paint_bounds.Intersect(Rect(size));
+  if (!bounds.IsEmpty()) {
+    int32_t left = bounds.x() / tile_size_ * tile_size_;
+    int32_t top = bounds.y() / tile_size_ * tile_size_;
+    for (int32_t y = top; y < bounds.bottom(); y += tile_size_) {
+      for (int32_t x = left; x < bounds.right(); x += tile_size_) {
+        Rect cell = Rect(x, y, tile_size_, tile_size_).Intersect(bounds);
+        Rect tile;
+        for (size_t i = 0; i < update.paint_rects.size(); ++i)
+          tile = tile.Union(cell.Intersect(update.paint_rects[i]));
+        if (!tile.IsEmpty())
+          tiles_.push_back(tile);
+      }
+    }
+  }
+  if (tiles_.empty()) {
+    if (needs_binding)
+      instance_->BindGraphics(graphics_);
+    return true;
+  }
+
+  tiles_pending_ = true;
+  tiles_need_binding_ = needs_binding;
+  next_tile_ = 0;
+  tiles_remaining_ = tiles_.size();
+  tiles_done_callback_ =
+      callback_factory_.NewCallback(&PaintManager::OnTilesComplete);
+
+  size_t posted = 0;
+  for (size_t i = 0; i < tile_threads_.size(); ++i) {
+    int32_t result = tile_threads_[i]->message_loop().PostWork(
+        CompletionCallback(&PaintManager::PaintQueuedTilesOnThread, this));
+    if (result == PP_OK)
+      ++posted;
+  }
+  // If no worker could take the tiles, paint them here rather than never.
+  if (!posted)
+    PaintQueuedTiles();
+  return true;
+}
+
+void PaintManager::PaintQueuedTiles() {
+  for (;;) {
+    Rect tile;
+    {
+      AutoLock lock(tile_lock_);
+      if (next_tile_ == tiles_.size())
+        return;
+      tile = tiles_[next_tile_++];
+    }
+
+    tile_client_->OnPaintTile(&tile_image_, tile);
+
+    AutoLock lock(tile_lock_);
+    if (--tiles_remaining_ == 0)
+      Module::Get()->core()->CallOnMainThread(0, tiles_done_callback_, PP_OK);
+  }
+}
+
+// static
+void PaintManager::PaintQueuedTilesOnThread(void* user_data, int32_t result) {
+  if (result == PP_OK)
+    static_cast<PaintManager*>(user_data)->PaintQueuedTiles();
+}
+
+void PaintManager::OnTilesComplete(int32_t result) {
+  PP_DCHECK(tiles_pending_);
+  tiles_pending_ = false;
+
+  // Hand all the tiles to the device in one call when the browser supports
+  // it, then flush them together.
+  Graphics2DDev(graphics_).PaintImageDataRects(tile_image_, Point(), tiles_);
+  FlushGraphics();
+
+  if (tiles_need_binding_)
+    instance_->BindGraphics(graphics_);
+
+  // Invalidations made while the tiles were painting wait for the flush to
+  // complete, or for a manual callback if the flush didn't go asynchronous.
+  if (!flush_pending_ && aggregator_.HasPendingUpdate())
+    EnsureCallbackPending();
+}
+
+void PaintManager::StopTileThreads() {
+  // Take the tiles no worker has started on out of the queue, so that joining
+  // only waits for the tiles being painted right now.
+  std::vector<Rect> skipped_tiles;
+  if (tiles_pending_) {
+    AutoLock lock(tile_lock_);
+    skipped_tiles.assign(tiles_.begin() + next_tile_, tiles_.end());
+    tiles_.resize(next_tile_);
+    tiles_remaining_ -= skipped_tiles.size();
+    // If no tile is being painted, no worker is left to say we're done.
+    if (!skipped_tiles.empty() && tiles_remaining_ == 0)
+      Module::Get()->core()->CallOnMainThread(0, tiles_done_callback_, PP_OK);
+  }
+
+  for (size_t i = 0; i < tile_threads_.size(); ++i)
+    delete tile_threads_[i];  // Joins the thread.
+  tile_threads_.clear();
+
+  // The skipped tiles are painted with the next update instead.
+  for (size_t i = 0; i < skipped_tiles.size(); ++i)
+    aggregator_.InvalidateRect(skipped_tiles[i]);
+}
+
 void PaintManager::OnFlushComplete(int32_t result) {
   PP_DCHECK(flush_pending_);
   flush_pending_ = false;
@@ -201,7 +377,7 @@ void PaintManager::OnManualCallbackComplete(int32_t) {
   // invalid regions. Even though we only schedule this callback when something
   // is pending, a Flush callback could have come in before this callback was
   // executed and that could have cleared the queue.
-  if (aggregator_.HasPendingUpdate() && !flush_pending_)
+  if (aggregator_.HasPendingUpdate() && !flush_pending_ && !tiles_pending_)
     DoPaint();
 }
 
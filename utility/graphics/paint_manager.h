@@ -10,9 +10,12 @@
 
 #include <vector>
 
+#include "ppapi/cpp/completion_callback.h"
 #include "ppapi/cpp/graphics_2d.h"
+#include "ppapi/cpp/image_data.h"
 #include "ppapi/utility/completion_callback_factory.h"
 #include "ppapi/utility/graphics/paint_aggregator.h"
+#include "ppapi/utility/threading/lock.h"
 
 /// @file
 /// This file defines the API to convert the "plugin push" model of painting
@@ -24,6 +27,7 @@ class Graphics2D;
 class Instance;
 class Point;
 class Rect;
+class SimpleThread;
 
 /// This class converts the "instance push" model of painting in PPAPI to a
 /// paint request at a later time. Usage is that you call Invalidate and
@@ -107,6 +111,30 @@ class PaintManager {
     virtual ~Client() {}
   };
 
+  /// The interface used instead of <code>Client</code> to paint when tiled
+  /// painting is enabled with EnableTiledPainting().
+  class TileClient {
+   public:
+    /// OnPaintTile() paints one tile of the invalid area into
+    /// <code>image</code>, at the same position as in the instance. The
+    /// image is the size of the instance and is then painted to the graphics
+    /// device and flushed by the <code>PaintManager</code>.
+    ///
+    /// This is called on one of the <code>PaintManager</code>'s worker
+    /// threads, at the same time as other tiles are painted on other threads
+    /// and the main thread keeps running, so it must only use state that is
+    /// safe to use from several threads. Tiles never overlap, so writing to
+    /// the pixels of the tile is safe.
+    ///
+    /// @param[in] image The <code>ImageData</code> to paint into.
+    /// @param[in] tile The rect of the tile to paint.
+    virtual void OnPaintTile(ImageData* image, const Rect& tile) = 0;
+
+   protected:
+    // You shouldn't be doing deleting through this interface.
+    virtual ~TileClient() {}
+  };
+
   /// Default constructor for creating an is_null() <code>PaintManager</code>
   /// object. If you use this version of the constructor, you must call
   /// Initialize() below.
@@ -195,6 +223,37 @@ class PaintManager {
     aggregator_.set_max_paint_rects(max_rects);
   }
 
+  /// EnableTiledPainting() switches to painting on worker threads. The invalid
+  /// area is split along a grid of <code>tile_size</code> square tiles, which
+  /// <code>num_threads</code> threads paint into an image with
+  /// <code>TileClient::OnPaintTile()</code> instead of the
+  /// <code>Client::OnPaint()</code> call. Once all the tiles are painted, the
+  /// image is painted to the device and flushed on the main thread. This lets
+  /// an instance that rasterizes on the CPU use several cores. If that image
+  /// can't be allocated, the update is painted with
+  /// <code>Client::OnPaint()</code> instead.
+  ///
+  /// Initialize() must be called first. Calling it again replaces the worker
+  /// threads like DisableTiledPainting() does.
+  ///
+  /// @param[in] tile_client A non-owning pointer that must remain valid until
+  /// tiled painting is disabled or the <code>PaintManager</code> is destroyed.
+  /// @param[in] num_threads The number of worker threads to paint with.
+  /// @param[in] tile_size The width and height of the tiles, in pixels.
+  ///
+  /// @return true if the worker threads were started, otherwise false, in
+  /// which case tiled painting is disabled.
+  bool EnableTiledPainting(TileClient* tile_client,
+                           int32_t num_threads,
+                           int32_t tile_size);
+
+  /// DisableTiledPainting() goes back to painting with
+  /// <code>Client::OnPaint()</code>. Tiles the worker threads haven't started
+  /// on are painted with the next update instead, but this blocks until the
+  /// <code>TileClient::OnPaintTile()</code> calls already running return and
+  /// the threads exit. Destroying the <code>PaintManager</code> does the same.
+  void DisableTiledPainting();
+
   /// SetSize() sets the size of the instance. If the size is the same as the
   /// previous call, this will be a NOP. If the size has changed, a new device
   /// will be allocated to the given size and a paint to that device will be
@@ -262,6 +321,27 @@ class PaintManager {
   // Does the client paint and executes a Flush if necessary.
   void DoPaint();
 
+  // Flushes the device, noting whether the flush callback is pending.
+  void FlushGraphics();
+
+  // Splits the update into tiles and posts them to the worker threads. Returns
+  // false without painting anything if the image to paint the tiles into
+  // can't be allocated, in which case the update is painted without tiles.
+  bool PaintTiles(const PaintAggregator::PaintUpdate& update,
+                  bool needs_binding);
+
+  // Paints queued tiles until there are none left. Runs on the worker threads,
+  // and tells the main thread once the last tile is painted.
+  void PaintQueuedTiles();
+  static void PaintQueuedTilesOnThread(void* user_data, int32_t result);
+
+  // Called on the main thread once all the tiles are painted.
+  void OnTilesComplete(int32_t result);
+
+  // Stops and deletes the worker threads, blocking on the tiles being painted.
+  // Tiles that haven't been started on are invalidated again.
+  void StopTileThreads();
+
   // Callback for asynchronous completion of Flush.
   void OnFlushComplete(int32_t result);
 
@@ -293,6 +373,26 @@ class PaintManager {
   // paint operation. When true, the new size is in pending_size_.
   bool has_pending_resize_;
   Size pending_size_;
+
+  // Non-owning pointer, or NULL if tiled painting is disabled. See
+  // EnableTiledPainting().
+  TileClient* tile_client_;
+  int32_t tile_size_;
+  std::vector<SimpleThread*> tile_threads_;
+
+  // The image the tiles are painted into, and the tiles of the update being
+  // painted. While tiles_pending_ is set, the worker threads own these, and
+  // take tiles in order, starting at next_tile_, under tile_lock_.
+  ImageData tile_image_;
+  std::vector<Rect> tiles_;
+  bool tiles_pending_;
+  bool tiles_need_binding_;
+  Lock tile_lock_;
+  size_t next_tile_;
+  size_t tiles_remaining_;
+
+  // Created on the main thread for the worker that paints the last tile.
+  CompletionCallback tiles_done_callback_;
 };
 
 }  // namespace pp